@@ -26,4 +26,7 @@ HAL/LCD \
 MCAL/GPIO \
 MCAL/TIMER1 \
 MCAL/UART \
+SERVICE/FRAME \
+SERVICE/PROF \
+SERVICE/SCHEDULER \
 
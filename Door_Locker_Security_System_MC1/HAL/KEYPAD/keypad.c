@@ -10,8 +10,28 @@
  */
 
 #include "keypad.h"
-#include "../../MCAL/GPIO/gpio.h"
-#include <util/delay.h>
+#include "../../MCAL/GPIO/gpio_fast.h"
+#include "../../MCAL/TIMER1/timer1_service.h"
+#include "../../SERVICE/PROF/prof.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define KEYPAD_NUM_KEYS          (KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS)
+#define KEYPAD_EVENT_BUFFER_MASK (KEYPAD_EVENT_BUFFER_SIZE - 1)
+
+/* Number of scans of the button row in the long press time */
+#define KEYPAD_LONG_PRESS_SCANS \
+	(KEYPAD_LONG_PRESS_MS / (KEYPAD_SCAN_PERIOD_MS * KEYPAD_NUM_ROWS))
+
+#if (KEYPAD_EVENT_BUFFER_SIZE & KEYPAD_EVENT_BUFFER_MASK) != 0
+#error "KEYPAD_EVENT_BUFFER_SIZE must be power of 2"
+#endif
+
+#if (KEYPAD_LONG_PRESS_SCANS > 255) || (KEYPAD_LONG_PRESS_SCANS == 0)
+#error "KEYPAD_LONG_PRESS_MS is out of range of the scan period"
+#endif
 
 /*******************************************************************************
  *                      Functions Prototypes(Private)                          *
@@ -35,74 +55,235 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
 
 #endif /* STANDARD_KEYPAD */
 
+/*
+ * Function responsible for mapping the row and column of the button to its key value
+ */
+static uint8 KEYPAD_keyValue(uint8 row, uint8 col);
+
+/*
+ * Function responsible for pushing one key event to the FIFO
+ */
+static void KEYPAD_pushEvent(uint8 key, KEYPAD_EventKindType kind);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The row which is driven now and read in the next scan */
+static uint8 g_row = 0;
+
+/* Integrating debounce counter of each button, from 0 to KEYPAD_DEBOUNCE_SAMPLES */
+static uint8 g_keyCounter[KEYPAD_NUM_KEYS];
+/* Number of scans since each button is pressed, for the long press event */
+static uint8 g_keyHold[KEYPAD_NUM_KEYS];
+/* Debounced state of the buttons, one bit for each button */
+static uint16 g_keyPressed = 0;
+
+/* FIFO of key events, filled in the timer interrupt and emptied by the application */
+static volatile KEYPAD_EventType g_eventBuffer[KEYPAD_EVENT_BUFFER_SIZE];
+static volatile uint8 g_eventHead = 0;
+static volatile uint8 g_eventTail = 0;
+
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
 
-uint8 KEYPAD_getPressedKey(void)
+/*
+ * Description :
+ * Setup the keypad pins and start the periodic scan on a TIMER1 software timer,
+ * Timer1_serviceInit must be called before it.
+ */
+void KEYPAD_init(void)
 {
-	uint8 col, row;
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID,
-			PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + 1,
-			PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + 2,
-			PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + 3,
-			PIN_INPUT);
-
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID,
-			PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID + 1,
-			PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID + 2,
-			PIN_INPUT);
-#if(KEYPAD_NUM_COLS == 4)
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID + 3,
-			PIN_INPUT);
-#endif
-	while (1)
+	uint8 i, timerId;
+	/* all keypad pins are inputs, only the scanned row will be output pin */
+	for (i = 0; i < KEYPAD_NUM_ROWS; i++)
 	{
-		for (row = 0; row < KEYPAD_NUM_ROWS; row++) /* loop for rows */
-		{
-			/*
-			 * Each time setup the direction for all keypad port as input pins,
-			 * except this row will be output pin
-			 */
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,
-			KEYPAD_FIRST_ROW_PIN_ID + row, PIN_OUTPUT);
-
-			/* Set/Clear the row output pin */
-			GPIO_writePin(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + row,
+		GPIO_fastSetupPinDirection(KEYPAD_ROW_PORT_ID,
+				KEYPAD_FIRST_ROW_PIN_ID + i, PIN_INPUT);
+	}
+	for (i = 0; i < KEYPAD_NUM_COLS; i++)
+	{
+		GPIO_fastSetupPinDirection(KEYPAD_COL_PORT_ID,
+				KEYPAD_FIRST_COL_PIN_ID + i, PIN_INPUT);
+	}
+	/* drive the first row to be read in the first scan */
+	g_row = 0;
+	GPIO_fastSetupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID,
+			PIN_OUTPUT);
+	GPIO_fastWritePin(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID,
 			KEYPAD_BUTTON_PRESSED);
 
-			for (col = 0; col < KEYPAD_NUM_COLS; col++) /* loop for columns */
+	timerId = Timer1_createTimer(TIMER1_PERIODIC, KEYPAD_scan);
+	Timer1_startTimer(timerId, KEYPAD_SCAN_PERIOD_MS);
+}
+
+/*
+ * Description :
+ * Scan one row of the keypad and push the debounced key events to the FIFO,
+ * called each KEYPAD_SCAN_PERIOD_MS from the timer interrupt.
+ */
+void KEYPAD_scan(void)
+{
+	uint8 col, key, cols;
+	uint16 keyMask;
+
+	PROF_BEGIN(PROF_KEYPAD_SCAN);
+
+	/*
+	 * the row is driven since the previous scan, so its columns are settled now,
+	 * all columns are sampled together by one read of the port
+	 */
+	cols = GPIO_fastReadPort(KEYPAD_COL_PORT_ID) >> KEYPAD_FIRST_COL_PIN_ID;
+#if (KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+	cols = ~cols;
+#endif
+	for (col = 0; col < KEYPAD_NUM_COLS; col++)
+	{
+		key = (g_row * KEYPAD_NUM_COLS) + col;
+		keyMask = (uint16) 1 << key;
+		if (cols & (1 << col))
+		{
+			if (g_keyCounter[key] < KEYPAD_DEBOUNCE_SAMPLES)
 			{
-				/* Check if the switch is pressed in this column */
-				if (GPIO_readPin(KEYPAD_COL_PORT_ID,
-				KEYPAD_FIRST_COL_PIN_ID + col) == KEYPAD_BUTTON_PRESSED)
+				g_keyCounter[key]++;
+			}
+			if (!(g_keyPressed & keyMask))
+			{
+				if (g_keyCounter[key] == KEYPAD_DEBOUNCE_SAMPLES)
 				{
-#if (KEYPAD_NUM_COLS == 3)
-#ifdef STANDARD_KEYPAD
-					return ((row*KEYPAD_NUM_COLS)+col+1);
-#else
-					return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-#endif
-#elif (KEYPAD_NUM_COLS == 4)
-#ifdef STANDARD_KEYPAD
-					return ((row * KEYPAD_NUM_COLS) + col + 1);
-#else
-					return KEYPAD_4x4_adjustKeyNumber(
-							(row * KEYPAD_NUM_COLS) + col + 1);
-#endif
-#endif
+					/* the button is stable pressed */
+					g_keyPressed |= keyMask;
+					g_keyHold[key] = 0;
+					KEYPAD_pushEvent(KEYPAD_keyValue(g_row, col),
+							KEYPAD_KEY_PRESSED);
+				}
+			}
+			else if (g_keyHold[key] < KEYPAD_LONG_PRESS_SCANS)
+			{
+				g_keyHold[key]++;
+				if (g_keyHold[key] == KEYPAD_LONG_PRESS_SCANS)
+				{
+					KEYPAD_pushEvent(KEYPAD_keyValue(g_row, col),
+							KEYPAD_KEY_LONG_PRESSED);
 				}
 			}
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,
-			KEYPAD_FIRST_ROW_PIN_ID + row, PIN_INPUT);
-			_delay_ms(5); /* Add small delay to fix CPU load issue in proteus */
 		}
+		else
+		{
+			if (g_keyCounter[key] > 0)
+			{
+				g_keyCounter[key]--;
+			}
+			if ((g_keyPressed & keyMask) && (g_keyCounter[key] == 0))
+			{
+				/* the button is stable released */
+				g_keyPressed &= ~keyMask;
+				KEYPAD_pushEvent(KEYPAD_keyValue(g_row, col),
+						KEYPAD_KEY_RELEASED);
+			}
+		}
+	}
+
+	/* release this row and drive the next one */
+	GPIO_fastSetupPinDirection(KEYPAD_ROW_PORT_ID,
+			KEYPAD_FIRST_ROW_PIN_ID + g_row, PIN_INPUT);
+	g_row++;
+	if (g_row == KEYPAD_NUM_ROWS)
+	{
+		g_row = 0;
+	}
+	GPIO_fastSetupPinDirection(KEYPAD_ROW_PORT_ID,
+			KEYPAD_FIRST_ROW_PIN_ID + g_row, PIN_OUTPUT);
+	GPIO_fastWritePin(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + g_row,
+			KEYPAD_BUTTON_PRESSED);
+	PROF_END(PROF_KEYPAD_SCAN);
+}
+
+/*
+ * Description :
+ * Take the oldest key event from the FIFO without waiting.
+ * Return TRUE if an event is taken or FALSE if the FIFO is empty.
+ */
+uint8 KEYPAD_getEvent(KEYPAD_EventType *a_event)
+{
+	uint8 tail = g_eventTail;
+	if (tail == g_eventHead)
+	{
+		return FALSE;
+	}
+	a_event->key = g_eventBuffer[tail].key;
+	a_event->kind = g_eventBuffer[tail].kind;
+	/* the tail is only written here, and one byte write is atomic */
+	g_eventTail = (tail + 1) & KEYPAD_EVENT_BUFFER_MASK;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Copy the oldest key event from the FIFO without taking it, so it stays in
+ * the FIFO until KEYPAD_getEvent takes it.
+ * Return TRUE if an event is copied or FALSE if the FIFO is empty.
+ */
+uint8 KEYPAD_peekEvent(KEYPAD_EventType *a_event)
+{
+	uint8 tail = g_eventTail;
+	if (tail == g_eventHead)
+	{
+		return FALSE;
+	}
+	a_event->key = g_eventBuffer[tail].key;
+	a_event->kind = g_eventBuffer[tail].kind;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Get the Keypad pressed button, wait until a button is pressed
+ */
+uint8 KEYPAD_getPressedKey(void)
+{
+	KEYPAD_EventType event;
+	while (1)
+	{
+		if ((KEYPAD_getEvent(&event) == TRUE)
+				&& (event.kind == KEYPAD_KEY_PRESSED))
+		{
+			return event.key;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Map the row and column of the button to its key value
+ */
+static uint8 KEYPAD_keyValue(uint8 row, uint8 col)
+{
+#ifdef STANDARD_KEYPAD
+	return ((row * KEYPAD_NUM_COLS) + col + 1);
+#elif (KEYPAD_NUM_COLS == 3)
+	return KEYPAD_4x3_adjustKeyNumber((row * KEYPAD_NUM_COLS) + col + 1);
+#elif (KEYPAD_NUM_COLS == 4)
+	return KEYPAD_4x4_adjustKeyNumber((row * KEYPAD_NUM_COLS) + col + 1);
+#endif
+}
+
+/*
+ * Description :
+ * Push one key event to the FIFO, the event is dropped if the FIFO is full
+ */
+static void KEYPAD_pushEvent(uint8 key, KEYPAD_EventKindType kind)
+{
+	uint8 head = g_eventHead;
+	uint8 next = (head + 1) & KEYPAD_EVENT_BUFFER_MASK;
+	if (next == g_eventTail)
+	{
+		return;
 	}
+	g_eventBuffer[head].key = key;
+	g_eventBuffer[head].kind = kind;
+	g_eventHead = next;
 }
 
 #ifndef STANDARD_KEYPAD
@@ -39,13 +39,72 @@
 #define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
 #define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
 
+/* Period of the scan in ms, one row of the keypad is scanned each period */
+#define KEYPAD_SCAN_PERIOD_MS            2
+
+/*
+ * Number of equal samples of a button before its new state is accepted,
+ * each button is sampled once every (KEYPAD_SCAN_PERIOD_MS * KEYPAD_NUM_ROWS) ms
+ */
+#define KEYPAD_DEBOUNCE_SAMPLES          3
+
+/* Holding time of a button in ms before the long press event */
+#define KEYPAD_LONG_PRESS_MS             1000
+
+/* Number of key events the FIFO can hold, must be power of 2 */
+#define KEYPAD_EVENT_BUFFER_SIZE         16
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	KEYPAD_KEY_PRESSED, KEYPAD_KEY_RELEASED, KEYPAD_KEY_LONG_PRESSED
+} KEYPAD_EventKindType;
+
+typedef struct
+{
+	uint8 key;
+	KEYPAD_EventKindType kind;
+} KEYPAD_EventType;
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 
 /*
  * Description :
- * Get the Keypad pressed button
+ * Setup the keypad pins and start the periodic scan on a TIMER1 software timer,
+ * Timer1_serviceInit must be called before it.
+ */
+void KEYPAD_init(void);
+
+/*
+ * Description :
+ * Scan one row of the keypad and push the debounced key events to the FIFO,
+ * called each KEYPAD_SCAN_PERIOD_MS from the timer interrupt.
+ */
+void KEYPAD_scan(void);
+
+/*
+ * Description :
+ * Take the oldest key event from the FIFO without waiting.
+ * Return TRUE if an event is taken or FALSE if the FIFO is empty.
+ */
+uint8 KEYPAD_getEvent(KEYPAD_EventType *a_event);
+
+/*
+ * Description :
+ * Copy the oldest key event from the FIFO without taking it, so it stays in
+ * the FIFO until KEYPAD_getEvent takes it.
+ * Return TRUE if an event is copied or FALSE if the FIFO is empty.
+ */
+uint8 KEYPAD_peekEvent(KEYPAD_EventType *a_event);
+
+/*
+ * Description :
+ * Get the Keypad pressed button, wait until a button is pressed
  */
 uint8 KEYPAD_getPressedKey(void);
 
@@ -11,9 +11,64 @@
 
 #include <util/delay.h>	   /* For the delay functions */
 #include <stdlib.h>		   /* For itoa functions */
-#include "../../LIB/common_macros.h" /* For GET_BIT Macro */
+#include "../../LIB/common_macros.h" /* For GET_BIT, SET_BIT and CLEAR_BIT Macros */
 #include "lcd.h"
-#include "../../MCAL/GPIO/gpio.h"
+#include "../../MCAL/GPIO/gpio_fast.h"
+#include "../../SERVICE/PROF/prof.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for writing one byte to the LCD as instruction (RS=0)
+ * or as data (RS=1) without waiting for its execution
+ */
+static void LCD_writeByte(uint8 a_byte, uint8 a_rs);
+
+#if (LCD_DATA_BITS_MODE == 4)
+/*
+ * Function responsible for writing the low 4 bits of the value to DB4 --> DB7
+ * with one enable pulse
+ */
+static void LCD_writeNibble(uint8 a_nibble);
+#endif
+
+/*
+ * Function responsible for waiting until the LCD executes the last byte
+ */
+static void LCD_waitReady(uint8 a_longExecution);
+
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+/*
+ * Function responsible for reading the busy flag of the LCD,
+ * the data pins must be input pins
+ */
+static uint8 LCD_readBusyFlag(void);
+#endif
+
+/*
+ * Function responsible for calculating the LCD DDRAM address of a row and column
+ */
+static uint8 LCD_cellAddress(uint8 a_row, uint8 a_col);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The DDRAM address of the LCD cursor, updated by each command and character */
+static uint8 g_lcdAddress = 0;
+
+/* The frame buffer and one changed flag bit for each cell not sent to the screen yet */
+static uint8 g_frameBuffer[LCD_ROWS * LCD_COLS];
+static uint8 g_dirtyCells[((LCD_ROWS * LCD_COLS) + 7) / 8];
+/* The cursor of the frame buffer as index of cell */
+static uint8 g_bufferCursor = 0;
+
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+/* The busy flag can't be read until the function set instruction is executed */
+static uint8 g_busyFlagReady = FALSE;
+#endif
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -27,37 +82,70 @@
  */
 void LCD_init(void)
 {
+	uint8 i;
 	/* Configure the direction for RS and E pins as output pins */
-	GPIO_setupPinDirection(LCD_RS_PORT_ID, LCD_RS_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_E_PORT_ID, LCD_E_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_RS_PORT_ID, LCD_RS_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_E_PORT_ID, LCD_E_PIN_ID, PIN_OUTPUT);
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+	/* Configure the direction for RW pin as output pin, RW=0 to write */
+	GPIO_fastSetupPinDirection(LCD_RW_PORT_ID, LCD_RW_PIN_ID, PIN_OUTPUT);
+	GPIO_fastWritePin(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_LOW);
+	g_busyFlagReady = FALSE;
+#endif
 
 	_delay_ms(20); /* LCD Power ON delay always > 15ms */
 
 #if (LCD_DATA_BITS_MODE == 4)
 	/* Configure 4 pins in the data port as output pins */
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, PIN_OUTPUT);
 
-	/* Send for 4 bit initialization of LCD  */
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
-	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2);
+	/*
+	 * Send for 4 bit initialization of LCD, the nibbles of INIT1 and INIT2
+	 * are sent one by one with the waits of the datasheet between them
+	 */
+	GPIO_fastWritePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW); /* Instruction Mode RS=0 */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 >> 4);
+	_delay_ms(5); /* delay for processing > 4.1ms */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 & 0x0F);
+	_delay_us(100); /* delay for processing > 100us */
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2 >> 4);
+	_delay_us(LCD_EXECUTION_TIME_US);
+	LCD_writeNibble(LCD_TWO_LINES_FOUR_BITS_MODE_INIT2 & 0x0F);
+	_delay_us(LCD_EXECUTION_TIME_US);
 
 	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
 	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE);
 
 #elif (LCD_DATA_BITS_MODE == 8)
 	/* Configure the data port as output port */
-	GPIO_setupPortDirection(LCD_DATA_PORT_ID, PORT_OUTPUT);
+	GPIO_fastSetupPortDirection(LCD_DATA_PORT_ID, PORT_OUTPUT);
 
 	/* use 2-lines LCD + 8-bits Data Mode + 5*7 dot display Mode */
 	LCD_sendCommand(LCD_TWO_LINES_EIGHT_BITS_MODE);
 
 #endif
 
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+	/* the function set is executed, the busy flag can be read from now */
+	g_busyFlagReady = TRUE;
+#endif
+
 	LCD_sendCommand(LCD_CURSOR_OFF); /* cursor off */
 	LCD_sendCommand(LCD_CLEAR_COMMAND); /* clear LCD at the beginning */
+
+	/* the screen is clear, so the frame buffer is spaces with no changed cells */
+	for (i = 0; i < (LCD_ROWS * LCD_COLS); i++)
+	{
+		g_frameBuffer[i] = ' ';
+	}
+	for (i = 0; i < sizeof(g_dirtyCells); i++)
+	{
+		g_dirtyCells[i] = 0;
+	}
+	g_bufferCursor = 0;
 }
 
 /*
@@ -66,38 +154,21 @@ void LCD_init(void)
  */
 void LCD_sendCommand(uint8 a_command)
 {
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW); /* Instruction Mode RS=0 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if (LCD_DATA_BITS_MODE == 4)
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(a_command, 4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(a_command, 5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(a_command, 6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(a_command, 7));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(a_command, 0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(a_command, 1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(a_command, 2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(a_command, 3));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif (LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID, a_command);		   /* out the required command to the data bus D0 --> D7 */
-	_delay_ms(1);										   /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1);										   /* delay for processing Th = 13ns */
-#endif
+	PROF_BEGIN(PROF_LCD_SEND_COMMAND);
+	LCD_writeByte(a_command, LOGIC_LOW); /* Instruction Mode RS=0 */
+	/* keep track of the cursor address for the frame buffer flush */
+	if (a_command & LCD_SET_CURSOR_LOCATION)
+	{
+		g_lcdAddress = a_command & (~LCD_SET_CURSOR_LOCATION);
+	}
+	else if ((a_command == LCD_CLEAR_COMMAND) || (a_command == LCD_GO_TO_HOME))
+	{
+		g_lcdAddress = 0;
+	}
+	/* the clear and return home commands take much longer than the others */
+	LCD_waitReady(
+			(a_command == LCD_CLEAR_COMMAND) || (a_command == LCD_GO_TO_HOME));
+	PROF_END(PROF_LCD_SEND_COMMAND);
 }
 
 /*
@@ -106,38 +177,9 @@ void LCD_sendCommand(uint8 a_command)
  */
 void LCD_displayCharacter(uint8 a_data)
 {
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_HIGH); /* Data Mode RS=1 */
-	_delay_ms(1); /* delay for processing Tas = 50ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-#if (LCD_DATA_BITS_MODE == 4)
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(a_data, 4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(a_data, 5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(a_data, 6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(a_data, 7));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
-	_delay_ms(1); /* delay for processing Tpw - Tdws = 190ns */
-
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(a_data, 0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(a_data, 1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(a_data, 2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(a_data, 3));
-
-	_delay_ms(1); /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1); /* delay for processing Th = 13ns */
-
-#elif (LCD_DATA_BITS_MODE == 8)
-	GPIO_writePort(LCD_DATA_PORT_ID, a_data);			   /* out the required command to the data bus D0 --> D7 */
-	_delay_ms(1);										   /* delay for processing Tdsw = 100ns */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
-	_delay_ms(1);										   /* delay for processing Th = 13ns */
-#endif
+	LCD_writeByte(a_data, LOGIC_HIGH); /* Data Mode RS=1 */
+	g_lcdAddress++; /* the LCD increments its cursor after each character */
+	LCD_waitReady(FALSE);
 }
 
 /*
@@ -160,26 +202,8 @@ void LCD_displayString(const char *a_str)
  */
 void LCD_moveCursor(uint8 a_row, uint8 a_col)
 {
-	uint8 lcd_memory_address;
-
-	/* Calculate the required address in the LCD DDRAM */
-	switch (a_row)
-	{
-	case 0:
-		lcd_memory_address = a_col;
-		break;
-	case 1:
-		lcd_memory_address = a_col + 0x40;
-		break;
-	case 2:
-		lcd_memory_address = a_col + 0x10;
-		break;
-	case 3:
-		lcd_memory_address = a_col + 0x50;
-		break;
-	}
-	/* Move the LCD cursor to this specific address */
-	LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
+	/* Move the LCD cursor to the required address in the LCD DDRAM */
+	LCD_sendCommand(LCD_cellAddress(a_row, a_col) | LCD_SET_CURSOR_LOCATION);
 }
 
 /*
@@ -211,3 +235,287 @@ void LCD_clearScreen(void)
 {
 	LCD_sendCommand(LCD_CLEAR_COMMAND); /* Send clear display command */
 }
+
+/*
+ * Description :
+ * Clear the frame buffer, the cells are written to the screen on the next flush
+ */
+void LCD_bufferClear(void)
+{
+	g_bufferCursor = 0;
+	while (g_bufferCursor < (LCD_ROWS * LCD_COLS))
+	{
+		LCD_bufferDisplayCharacter(' ');
+	}
+	g_bufferCursor = 0;
+}
+
+/*
+ * Description :
+ * Move the cursor of the frame buffer to a specified row and column index
+ */
+void LCD_bufferMoveCursor(uint8 a_row, uint8 a_col)
+{
+	g_bufferCursor = (a_row * LCD_COLS) + a_col;
+}
+
+/*
+ * Description :
+ * Write the required character in the frame buffer at its cursor
+ */
+void LCD_bufferDisplayCharacter(uint8 a_data)
+{
+	if (g_bufferCursor >= (LCD_ROWS * LCD_COLS))
+	{
+		return; /* the characters after the last cell are ignored */
+	}
+	/* only a changed cell is marked to be sent to the screen */
+	if (g_frameBuffer[g_bufferCursor] != a_data)
+	{
+		g_frameBuffer[g_bufferCursor] = a_data;
+		SET_BIT(g_dirtyCells[g_bufferCursor / 8], g_bufferCursor % 8);
+	}
+	g_bufferCursor++;
+}
+
+/*
+ * Description :
+ * Write the required string in the frame buffer at its cursor
+ */
+void LCD_bufferDisplayString(const char *a_str)
+{
+	uint8 i = 0;
+	while (a_str[i] != '\0')
+	{
+		LCD_bufferDisplayCharacter(a_str[i]);
+		i++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string in the frame buffer in a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn(uint8 a_row, uint8 a_col,
+		const char *a_str)
+{
+	LCD_bufferMoveCursor(a_row, a_col);
+	LCD_bufferDisplayString(a_str);
+}
+
+/*
+ * Description :
+ * Write the required decimal value in the frame buffer at its cursor
+ */
+void LCD_bufferIntgerToString(int a_data)
+{
+	char buff[16]; /* String to hold the ascii result */
+	itoa(a_data, buff, 10); /* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
+	LCD_bufferDisplayString(buff);
+}
+
+/*
+ * Description :
+ * Send the changed cells of the frame buffer to the screen, sending at most
+ * a_maxBytes commands and characters so it can be called from a periodic tick.
+ * Return TRUE if the screen is up to date or FALSE if cells are still changed.
+ */
+uint8 LCD_flush(uint8 a_maxBytes)
+{
+	uint8 cell, address;
+	for (cell = 0; cell < (LCD_ROWS * LCD_COLS); cell++)
+	{
+		if (g_dirtyCells[cell / 8] == 0)
+		{
+			/* no changed cells in these 8 cells */
+			cell |= 7;
+			continue;
+		}
+		if (BIT_IS_CLEAR(g_dirtyCells[cell / 8], cell % 8))
+		{
+			continue;
+		}
+		address = LCD_cellAddress(cell / LCD_COLS, cell % LCD_COLS);
+		/*
+		 * the cursor is moved only at the start of a run of changed cells,
+		 * the next cells of the run use the auto increment of the LCD cursor
+		 */
+		if (address != g_lcdAddress)
+		{
+			if (a_maxBytes < 2)
+			{
+				return FALSE;
+			}
+			LCD_sendCommand(address | LCD_SET_CURSOR_LOCATION);
+			a_maxBytes--;
+		}
+		if (a_maxBytes == 0)
+		{
+			return FALSE;
+		}
+		LCD_displayCharacter(g_frameBuffer[cell]);
+		CLEAR_BIT(g_dirtyCells[cell / 8], cell % 8);
+		a_maxBytes--;
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Write one byte to the LCD as instruction (RS=0) or as data (RS=1)
+ * without waiting for its execution
+ */
+static void LCD_writeByte(uint8 a_byte, uint8 a_rs)
+{
+	GPIO_fastWritePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, a_rs);
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+#if (LCD_DATA_BITS_MODE == 4)
+	LCD_writeNibble(a_byte >> 4); /* the high 4 bits first */
+	LCD_writeNibble(a_byte & 0x0F);
+
+#elif (LCD_DATA_BITS_MODE == 8)
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+	GPIO_fastWritePort(LCD_DATA_PORT_ID, a_byte); /* out the required byte to the data bus D0 --> D7 */
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns */
+#endif
+}
+
+#if (LCD_DATA_BITS_MODE == 4)
+/*
+ * Description :
+ * Write the low 4 bits of the value to DB4 --> DB7 with one enable pulse
+ */
+static void LCD_writeNibble(uint8 a_nibble)
+{
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+
+	GPIO_fastWritePin(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, GET_BIT(a_nibble, 0));
+	GPIO_fastWritePin(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, GET_BIT(a_nibble, 1));
+	GPIO_fastWritePin(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, GET_BIT(a_nibble, 2));
+	GPIO_fastWritePin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, GET_BIT(a_nibble, 3));
+
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns and the enable cycle time */
+}
+#endif
+
+/*
+ * Description :
+ * Wait until the LCD executes the last byte, by reading the busy flag
+ * or by waiting the execution time of the datasheet
+ */
+static void LCD_waitReady(uint8 a_longExecution)
+{
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+	uint16 reads;
+	if (g_busyFlagReady == TRUE)
+	{
+		/* Configure the data pins as input pins to read the busy flag */
+#if (LCD_DATA_BITS_MODE == 4)
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, PIN_INPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, PIN_INPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, PIN_INPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, PIN_INPUT);
+#elif (LCD_DATA_BITS_MODE == 8)
+		GPIO_fastSetupPortDirection(LCD_DATA_PORT_ID, PORT_INPUT);
+#endif
+
+		/* the reads are limited, so a disconnected LCD will not block the program */
+		for (reads = 0; reads < LCD_BUSY_FLAG_MAX_READS; reads++)
+		{
+			if (LCD_readBusyFlag() == LOGIC_LOW)
+			{
+				break;
+			}
+		}
+
+		/* Configure the data pins as output pins again */
+#if (LCD_DATA_BITS_MODE == 4)
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID, PIN_OUTPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID, PIN_OUTPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID, PIN_OUTPUT);
+		GPIO_fastSetupPinDirection(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID, PIN_OUTPUT);
+#elif (LCD_DATA_BITS_MODE == 8)
+		GPIO_fastSetupPortDirection(LCD_DATA_PORT_ID, PORT_OUTPUT);
+#endif
+		return;
+	}
+#endif
+
+	if (a_longExecution)
+	{
+		_delay_us(LCD_CLEAR_EXECUTION_TIME_US);
+	}
+	else
+	{
+		_delay_us(LCD_EXECUTION_TIME_US);
+	}
+}
+
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+/*
+ * Description :
+ * Read the busy flag of the LCD, the data pins must be input pins
+ */
+static uint8 LCD_readBusyFlag(void)
+{
+	uint8 busyFlag;
+	GPIO_fastWritePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW); /* Instruction Mode RS=0 */
+	GPIO_fastWritePin(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_HIGH); /* Read Mode RW=1 */
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tddr = 160ns */
+#if (LCD_DATA_BITS_MODE == 4)
+	busyFlag = GPIO_fastReadPin(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID);
+#elif (LCD_DATA_BITS_MODE == 8)
+	busyFlag = GPIO_fastReadPin(LCD_DATA_PORT_ID, PIN7_ID);
+#endif
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns */
+
+#if (LCD_DATA_BITS_MODE == 4)
+	/* the second nibble is the low bits of the address counter, it is not needed */
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1);
+	GPIO_fastWritePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1);
+#endif
+
+	GPIO_fastWritePin(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_LOW); /* Write Mode RW=0 */
+	return busyFlag;
+}
+#endif
+
+/*
+ * Description :
+ * Calculate the LCD DDRAM address of a row and column
+ */
+static uint8 LCD_cellAddress(uint8 a_row, uint8 a_col)
+{
+	uint8 lcd_memory_address;
+
+	/* Calculate the required address in the LCD DDRAM */
+	switch (a_row)
+	{
+	case 0:
+		lcd_memory_address = a_col;
+		break;
+	case 1:
+		lcd_memory_address = a_col + 0x40;
+		break;
+	case 2:
+		lcd_memory_address = a_col + LCD_COLS;
+		break;
+	default:
+		lcd_memory_address = a_col + 0x40 + LCD_COLS;
+		break;
+	}
+	return lcd_memory_address;
+}
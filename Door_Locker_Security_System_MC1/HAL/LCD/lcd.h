@@ -27,6 +27,42 @@
 
 #endif
 
+/*
+ * LCD wait configuration after each command or character:
+ * LCD_WAIT_TIMING     : wait the execution time of the datasheet.
+ * LCD_WAIT_BUSY_FLAG  : read the busy flag over the RW pin, the RW pin must be connected.
+ */
+#define LCD_WAIT_TIMING		0
+#define LCD_WAIT_BUSY_FLAG	1
+
+/* it can also be given by the build, the host benchmark builds both modes */
+#ifndef LCD_WAIT_MODE
+#define LCD_WAIT_MODE LCD_WAIT_TIMING
+#endif
+
+#if ((LCD_WAIT_MODE != LCD_WAIT_TIMING) && (LCD_WAIT_MODE != LCD_WAIT_BUSY_FLAG))
+
+#error "LCD wait mode should be LCD_WAIT_TIMING or LCD_WAIT_BUSY_FLAG"
+
+#endif
+
+/* Execution times of the datasheet in us, with margin */
+#define LCD_EXECUTION_TIME_US		40
+#define LCD_CLEAR_EXECUTION_TIME_US	1600
+
+/* Maximum reads of the busy flag before the LCD is taken as ready */
+#define LCD_BUSY_FLAG_MAX_READS		1000
+
+/* LCD size configuration, up to 4 rows and 20 columns */
+#define LCD_ROWS	2
+#define LCD_COLS	16
+
+#if ((LCD_ROWS > 4) || (LCD_COLS > 20))
+
+#error "LCD size should be up to 4 rows and 20 columns"
+
+#endif
+
 /* LCD HW Ports and Pins Ids */
 #define LCD_RS_PORT_ID		PORTA_ID
 #define LCD_RS_PIN_ID 		PIN1_ID
@@ -34,6 +70,13 @@
 #define LCD_E_PORT_ID 		PORTA_ID
 #define LCD_E_PIN_ID 		PIN2_ID
 
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+
+#define LCD_RW_PORT_ID 		PORTA_ID
+#define LCD_RW_PIN_ID 		PIN0_ID
+
+#endif
+
 #define LCD_DATA_PORT_ID 	PORTA_ID
 
 #if (LCD_DATA_BITS_MODE == 4)
@@ -110,4 +153,49 @@ void LCD_intgerToString(int a_data);
  */
 void LCD_clearScreen(void);
 
+/*
+ * Description :
+ * Clear the frame buffer, the cells are written to the screen on the next flush
+ */
+void LCD_bufferClear(void);
+
+/*
+ * Description :
+ * Move the cursor of the frame buffer to a specified row and column index
+ */
+void LCD_bufferMoveCursor(uint8 a_row, uint8 a_col);
+
+/*
+ * Description :
+ * Write the required character in the frame buffer at its cursor
+ */
+void LCD_bufferDisplayCharacter(uint8 a_data);
+
+/*
+ * Description :
+ * Write the required string in the frame buffer at its cursor
+ */
+void LCD_bufferDisplayString(const char *a_str);
+
+/*
+ * Description :
+ * Write the required string in the frame buffer in a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn(uint8 a_row, uint8 a_col,
+		const char *a_str);
+
+/*
+ * Description :
+ * Write the required decimal value in the frame buffer at its cursor
+ */
+void LCD_bufferIntgerToString(int a_data);
+
+/*
+ * Description :
+ * Send the changed cells of the frame buffer to the screen, sending at most
+ * a_maxBytes commands and characters so it can be called from a periodic tick.
+ * Return TRUE if the screen is up to date or FALSE if cells are still changed.
+ */
+uint8 LCD_flush(uint8 a_maxBytes);
+
 #endif /* LCD_H_ */
@@ -11,38 +11,121 @@
 #include "HAL/LCD/lcd.h" /* to use LCD functions */
 #include "HAL/KEYPAD/keypad.h" /* to use KEYPAD functions */
 #include "MCAL/UART/uart.h" /* to use UART functions */
-#include "MCAL/TIMER1/timer1.h" /* to use TIMER1 init function */
+#include "SERVICE/FRAME/frame.h" /* to use frames over UART */
+#include "SERVICE/SCHEDULER/scheduler.h" /* to use the events */
+#include "SERVICE/PROF/prof.h" /* to use the execution time probes */
+#include "MCAL/TIMER1/timer1_service.h" /* to use the software timers of TIMER1 */
 #include "MCAL/GPIO/gpio_private.h" /* to use the declaration of SREG register */
 #include "LIB/std_types.h" /* to use standard types */
-#include <util/delay.h> /* to use delay functions */
-
-/*******************************************************************************
- *                           Global Variables                                  *
- *******************************************************************************/
-
-static volatile uint8 g_ticks = 0;
 
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
 
-#define START_COMMNUCATION			    0x15
-#define CTC_VALUE_FOR_ONE_SECOND 		31250
-#define CTC_INITIAL_VALUE 				0
 #define PASSWORD_CORRECT            	0xAA
 #define PASSWORD_INCORRECT          	0xBB
+/* control ECU can't check the password now, it is not counted as a wrong password */
+#define PASSWORD_UNCHECKED				0x9C
 #define CRETAE_PASSWORD_ACTION      	0xCC
 #define CHECK_PASSWORD_ACTION       	0xDD
 #define CHANGE_PASSWORD_MODE        	0xEE
 #define OPEN_DOOR_MODE              	0xFF
+/* the check password mode of the admin menu */
+#define ADMIN_MODE						0xAD
+/* control ECU answers a correct password of another user in admin mode by NOT_ADMIN */
+#define NOT_ADMIN						0x9A
 #define BUZZER_ON                   	0x68
-#define BUZZER_OFF               	   	0x69
+/* request of the admin password state, answered by TRUE if it is set */
+#define GET_PASSWORD_STATE				0x53
+/*
+ * requests of the admin menu, the users are changed only by the request after
+ * the admin password check, the diagnostic requests are answered by a 16-bit value
+ */
+#define USER_ADD                    	0x55
+#define USER_REVOKE                 	0x56
+#define GET_DISPATCH_LATENCY        	0x4C
+#define GET_VERIFY_TIME             	0x54
+/* the audit query is answered by one event frame per event then an ACK with their number */
+#define AUDIT_QUERY                 	0x51
+#define AUDIT_EVENT_FRAME           	0x45
+#define AUDIT_EVENT_SIZE				8
 #define PASSWORD_LENGTH					5
+/* the probes of this ECU in the table of the admin menu, none when they are not built in */
+#if (PROF_ENABLE == 1)
+#define HMI_PROBES						PROF_NUM_PROBES
+#else
+#define HMI_PROBES						0
+#endif
+/* the probes of control ECU which are kept, the others are not shown */
+#define CONTROL_MAX_PROBES				4
+/* the user slots of control ECU, entered as 2 digits, slot 0 is the admin */
+#define MAX_USERS						64
+#define SLOT_DIGITS						2
 #define DOOR_UNLOKING_PERIOD        	15
 #define DOOR_LOKING_PERIOD          	15
 #define DOOR_HOLD_PERIOD            	3
-#define NUMBER_OF_TRIES_FOR_PASSWORD 	3
-#define BUZZER_ACTIVE_PERIOD			60
+#define MESSAGE_PERIOD_MS				250
+#define ONE_SECOND_IN_MS				1000
+#define LCD_FLUSH_PERIOD_MS				2
+/* time to wait for the reply of control ECU before the request is sent again */
+#define REPLY_TIMEOUT_MS				500
+/* posted as the reply when control ECU doesn't answer after all the retries */
+#define NO_REPLY						0xFE
+/* maximum LCD bytes sent each flush period, about 45 us each */
+#define LCD_FLUSH_MAX_BYTES				8
+
+/* Events of the HMI state machine */
+#define EVENT_KEY						0
+#define EVENT_REPLY						1
+#define EVENT_TIMER						2
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	STATE_MESSAGE,
+	STATE_WAIT_SETUP,
+	STATE_CREATE_PASSWORD,
+	STATE_CONFIRM_PASSWORD,
+	STATE_WAIT_SAVE,
+	STATE_MAIN_MENU,
+	STATE_ENTER_PASSWORD,
+	STATE_WAIT_CHECK,
+	STATE_DOOR_UNLOCKING,
+	STATE_DOOR_HOLDING,
+	STATE_DOOR_LOCKING,
+	STATE_LOCKED_OUT,
+	STATE_ADMIN_MENU,
+	STATE_ENTER_SLOT,
+	STATE_WAIT_DIAGNOSTICS,
+	STATE_SHOW_DIAGNOSTICS,
+	STATE_WAIT_PROBES,
+	STATE_SHOW_PROBES,
+	NUMBER_OF_STATES
+} HMI_StateIdType;
+
+/* Steps of the diagnostic requests, one request each */
+typedef enum
+{
+	DIAGNOSTIC_VERIFY_TIME,
+	DIAGNOSTIC_DISPATCH_LATENCY,
+	DIAGNOSTIC_AUDIT,
+	NUMBER_OF_DIAGNOSTICS
+} HMI_DiagnosticIdType;
+
+/*
+ * Each state is one row of the state table, a NULL_PTR handler means
+ * the event is ignored in this state.
+ */
+typedef struct
+{
+	void (*onEnter)(void);
+	void (*onKey)(uint8 key);
+	void (*onReply)(uint8 reply);
+	void (*onTimer)(void);
+} HMI_StateType;
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -50,64 +133,240 @@ static volatile uint8 g_ticks = 0;
 
 /*
  * Description :
- * Function to create password and save it to EEPROM following this steps:
- * 1. Take password and confirm password from user.
- * 2. Compare the two passwords.
- * 3. If the two passwords are matched, then send it through UART
- * 	  to control ECU and save it to EEPROM.
- * 4. If the two passwords are not matched, then repeat step1.
- * Function input:  void.
+ * Task which passes the events to the handler of the current state.
+ * Function input:  the dispatched event.
  * Function output: void.
  */
-uint8 createPassword(void);
+void hmiTask(const SCHEDULER_EventType *event);
 
 /*
  * Description :
- * Function to active keypad to get input number from it.
- * Function input:  array of uint8 to save numbers from keypad on it.
+ * Function to leave the current state and run the entry action of the new one.
+ * Function input:  the new state.
  * Function output: void.
  */
-void getPasswordFromKeyPad(uint8 password[]);
+void enterState(HMI_StateIdType state);
 
 /*
  * Description :
- * Function to take confirm password then compare it with password and return if matched or not.
+ * Function to show a message on the two LCD lines for a short period then enter the next state.
+ * Function input:  the two lines of the message and the state after the message.
+ * Function output: void.
+ */
+void showMessage(const char *line1, const char *line2,
+		HMI_StateIdType nextState);
+
+/*
+ * Description :
+ * Function to take one key of the password, digits are saved and displayed as '*'
+ * and the enter key '#' completes the password after its 5 digits.
+ * Function input:  the pressed key and array of uint8 to save the digits on it.
+ * Function output: uint8 flag which is TRUE when the password is completed.
+ */
+uint8 collectPasswordKey(uint8 key, uint8 password[]);
+
+/*
+ * Description :
+ * Function to compare two passwords.
  * Function input:  two arrays of uint8 to compare between them.
  * Function output: uint8 flag that indicate the matching of passwords.
  */
-uint8 comparePasswords(uint8 password[], uint8 confirmPassword[]);
+uint8 comparePasswords(const uint8 password[], const uint8 confirmPassword[]);
 
 /*
  * Description :
- * Function to send password through UART to control ECU.
- * Function input:  array of uint8 to send it to control ECU.
+ * Function to send a request frame to control ECU without waiting for the reply,
+ * the reply comes later as EVENT_REPLY.
+ * Function input:  the request type and its payload.
  * Function output: void.
  */
-void sendPasswordToControlECU(uint8 password[]);
+void sendRequestToControlECU(uint8 type, const uint8 payload[], uint8 length);
 
 /*
  * Description :
- * Function to count a number of seconds which passed to it.
- * Function input:  number of seconds.
+ * Function to send the last request again when it is NACKed or not answered in time,
+ * after FRAME_MAX_RETRIES the state machine gets NO_REPLY as the reply.
+ * Function input:  void.
  * Function output: void.
  */
-void timer1DelaySecond(uint8 n);
+void resendRequestToControlECU(void);
 
 /*
  * Description :
- * This is the call back function which will be executed each interrupt in timer1.
+ * Function to send password in one frame to control ECU.
+ * Function input:  the action byte, the mode byte (check action) or the slot (USER_ADD) and array of uint8 to send.
+ * Function output: void.
+ */
+void sendPasswordToControlECU(uint8 action, uint8 mode, uint8 password[]);
+
+/*
+ * Description :
+ * Function to start counting down the seconds of the current state then enter the next state.
+ * Function input:  the seconds of the state and the state after them.
+ * Function output: void.
+ */
+void startCountdown(uint16 seconds, HMI_StateIdType nextState);
+
+/*
+ * Description :
+ * Function to display the remaining seconds of the current state at the end of the second line.
+ * Function input:  void.
+ * Function output: void.
+ */
+void displayCountdown(void);
+
+/*
+ * Description :
+ * This is the call back function which will be executed when the state timer expires.
  * Function input:  void.
  * Function output: void.
  */
-void countOneSecond(void);
+void stateTimerExpired(void);
+
+/*
+ * Description :
+ * Function to display a 16-bit value without a sign at the cursor.
+ * Function input:  the value.
+ * Function output: void.
+ */
+void displayUnsigned(uint16 value);
+
+/* Entry actions and event handlers of the states */
+static void messageEnter(void);
+static void messageTimer(void);
+static void waitSetupEnter(void);
+static void waitSetupReply(uint8 reply);
+static void createPasswordEnter(void);
+static void createPasswordKey(uint8 key);
+static void confirmPasswordEnter(void);
+static void confirmPasswordKey(uint8 key);
+static void waitSaveReply(uint8 reply);
+static void mainMenuEnter(void);
+static void mainMenuKey(uint8 key);
+static void enterPasswordEnter(void);
+static void enterPasswordKey(uint8 key);
+static void waitCheckReply(uint8 reply);
+static void doorUnlockingEnter(void);
+static void doorHoldingEnter(void);
+static void doorLockingEnter(void);
+static void lockedOutEnter(void);
+static void countdownTimer(void);
+static void adminMenuEnter(void);
+static void adminMenuKey(uint8 key);
+static void enterSlotEnter(void);
+static void enterSlotKey(uint8 key);
+static void waitDiagnosticsEnter(void);
+static void waitDiagnosticsReply(uint8 reply);
+static void showDiagnosticsEnter(void);
+static void showDiagnosticsKey(uint8 key);
+static void waitProbesEnter(void);
+static void waitProbesReply(uint8 reply);
+static void showProbesEnter(void);
+static void showProbesKey(uint8 key);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const HMI_StateType g_states[NUMBER_OF_STATES] =
+{
+/*                           onEnter               onKey               onReply         onTimer        */
+/* STATE_MESSAGE          */ { messageEnter,        NULL_PTR,           NULL_PTR,       messageTimer },
+/* STATE_WAIT_SETUP       */ { waitSetupEnter,      NULL_PTR,           waitSetupReply, NULL_PTR },
+/* STATE_CREATE_PASSWORD  */ { createPasswordEnter, createPasswordKey,  NULL_PTR,       NULL_PTR },
+/* STATE_CONFIRM_PASSWORD */ { confirmPasswordEnter,confirmPasswordKey, NULL_PTR,       NULL_PTR },
+/* STATE_WAIT_SAVE        */ { NULL_PTR,            NULL_PTR,           waitSaveReply,  NULL_PTR },
+/* STATE_MAIN_MENU        */ { mainMenuEnter,       mainMenuKey,        NULL_PTR,       NULL_PTR },
+/* STATE_ENTER_PASSWORD   */ { enterPasswordEnter,  enterPasswordKey,   NULL_PTR,       NULL_PTR },
+/* STATE_WAIT_CHECK       */ { NULL_PTR,            NULL_PTR,           waitCheckReply, NULL_PTR },
+/* STATE_DOOR_UNLOCKING   */ { doorUnlockingEnter,  NULL_PTR,           NULL_PTR,       countdownTimer },
+/* STATE_DOOR_HOLDING     */ { doorHoldingEnter,    NULL_PTR,           NULL_PTR,       countdownTimer },
+/* STATE_DOOR_LOCKING     */ { doorLockingEnter,    NULL_PTR,           NULL_PTR,       countdownTimer },
+/* STATE_LOCKED_OUT       */ { lockedOutEnter,      NULL_PTR,           NULL_PTR,       countdownTimer },
+/* STATE_ADMIN_MENU       */ { adminMenuEnter,      adminMenuKey,       NULL_PTR,       NULL_PTR },
+/* STATE_ENTER_SLOT       */ { enterSlotEnter,      enterSlotKey,       NULL_PTR,       NULL_PTR },
+/* STATE_WAIT_DIAGNOSTICS */ { waitDiagnosticsEnter,NULL_PTR,           waitDiagnosticsReply, NULL_PTR },
+/* STATE_SHOW_DIAGNOSTICS */ { showDiagnosticsEnter,showDiagnosticsKey, NULL_PTR,       NULL_PTR },
+/* STATE_WAIT_PROBES      */ { waitProbesEnter,     NULL_PTR,           waitProbesReply, NULL_PTR },
+/* STATE_SHOW_PROBES      */ { showProbesEnter,     showProbesKey,      NULL_PTR,       NULL_PTR },
+};
+
+static HMI_StateIdType g_state;
+static uint8 g_hmiTask;
+static uint8 g_stateTimerId;
+static uint8 g_lcdTimerId;
+static uint8 g_replyTimerId;
+
+/* the state after the shown message */
+static HMI_StateIdType g_messageNextState;
+
+/*
+ * the remaining seconds of the countdown states, the digits they are displayed
+ * in and the state after them
+ */
+static uint16 g_countdown;
+static uint8 g_countdownDigits;
+static HMI_StateIdType g_countdownNextState;
+
+/* the seconds of the lockout told by control ECU with its BUZZER_ON reply */
+static uint16 g_lockoutSeconds;
+
+/* the password being entered and the number of its entered digits */
+static uint8 g_password[PASSWORD_LENGTH];
+static uint8 g_confirmPassword[PASSWORD_LENGTH];
+static uint8 g_digits;
+
+/* the mode of the check password flow (open door or change password) */
+static uint8 g_mode;
+/* TRUE while the new password is created in change password mode */
+static uint8 g_changingPassword;
+
+/* the request of the admin menu (USER_ADD or USER_REVOKE), or zero, and its slot */
+static uint8 g_userRequest;
+static uint8 g_slot;
+
+/*
+ * the step of the diagnostic requests, their values, the screen being shown,
+ * the number of the events of the audit query and the last one of them
+ */
+static uint8 g_diagnosticStep;
+static const uint8 g_diagnosticRequests[NUMBER_OF_DIAGNOSTICS] =
+{ GET_VERIFY_TIME, GET_DISPATCH_LATENCY, AUDIT_QUERY };
+static uint16 g_diagnostics[NUMBER_OF_DIAGNOSTICS];
+static uint8 g_diagnosticScreen;
+static uint16 g_auditEvents;
+static uint8 g_lastAuditEvent[AUDIT_EVENT_SIZE];
+
+/*
+ * the probe records of this ECU followed by the records of control ECU,
+ * the number of the records of control ECU and the record being shown
+ */
+static uint8 g_probes[HMI_PROBES + CONTROL_MAX_PROBES][PROF_PROBE_FRAME_SIZE];
+static uint8 g_controlProbes;
+static uint8 g_probeScreen;
+
+/*
+ * the last request frame, kept to be sent again if control ECU NACKs it or
+ * doesn't answer it, and TRUE while its reply is waited for
+ */
+static uint8 g_requestType;
+static uint8 g_requestPayload[FRAME_MAX_PAYLOAD];
+static uint8 g_requestLength;
+static uint8 g_requestRetries;
+static uint8 g_requestOpen = FALSE;
+
+/* the payload of the reply frame of the last request, no bytes after NO_REPLY */
+static uint8 g_replyPayload[FRAME_MAX_PAYLOAD];
+static uint8 g_replyLength;
 
 int main(void)
 {
 	/* Configuration and initialization functions */
 	/* enable global interrupt */
 	SREG_REG.Bits.I_Bit = 1;
-	uint8 temp, try, passwordIsCreated, passwordIsChanged;
-	uint8 password[5];
+	KEYPAD_EventType keyEvent;
+	FRAME_Type reply;
+	uint8 i;
 	/* select the configuration of UART */
 	UART_ConfigType UART_config =
 	{ ASYNCHRONOUS, DISABLED_PARITY, STOP_1_BIT, DATA_8_BIT, BAUD_RATE_9600 };
@@ -116,202 +375,110 @@ int main(void)
 	UART_init(&UART_config);
 	/* call the initialization function of LCD */
 	LCD_init();
+	/* start the 1 ms tick of TIMER1 and reserve the software timers */
+	Timer1_serviceInit();
+	g_stateTimerId = Timer1_createTimer(TIMER1_ONE_SHOT, stateTimerExpired);
+	g_lcdTimerId = Timer1_createTimer(TIMER1_PERIODIC, NULL_PTR);
+	Timer1_startTimer(g_lcdTimerId, LCD_FLUSH_PERIOD_MS);
+	g_replyTimerId = Timer1_createTimer(TIMER1_ONE_SHOT, NULL_PTR);
+	/* start the periodic scan of the keypad */
+	KEYPAD_init();
+
+	/*
+	 * the waiting events are one reply, one state timer expiry and the keys,
+	 * the keys are held in the keypad FIFO when the queue is full
+	 */
+	g_hmiTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_HIGH, hmiTask);
+
+	/*
+	 * the splash screens at the start of program, then the admin password is
+	 * created if control ECU has none, otherwise the main menu
+	 */
+	showMessage("  Final Project ", "Edges Diploma 79", STATE_MESSAGE);
 
-	LCD_clearScreen();
-	LCD_displayString("  Final Project ");
-	LCD_moveCursor(1, 0);
-	LCD_displayString("Edges Diploma 79");
-	_delay_ms(250);
-	LCD_clearScreen();
-	LCD_displayString("     Made By    ");
-	LCD_moveCursor(1, 0);
-	LCD_displayString("    Ahmed Ali   ");
-	_delay_ms(250);
 	while (1)
 	{
 		/*
-		 * select the action of create password at the start of program.
-		 * the byte which sent to control ECU tell him to be ready to receive password
-		 * after check matching here.
+		 * take the key presses which are debounced by the keypad scan, a key
+		 * stays in the keypad FIFO until the event queue has room for it
 		 */
-		UART_sendByte(CRETAE_PASSWORD_ACTION);
-		/* at first we don't create any password */
-		passwordIsCreated = FALSE;
-		/* loop until the password is created and saved successfully to EEPROM */
-		while (passwordIsCreated == FALSE)
+		while ((KEYPAD_peekEvent(&keyEvent) == TRUE)
+				&& ((keyEvent.kind != KEYPAD_KEY_PRESSED)
+						|| (SCHEDULER_post(g_hmiTask, EVENT_KEY, keyEvent.key) == TRUE)))
 		{
-			passwordIsCreated = createPassword();
+			KEYPAD_getEvent(&keyEvent);
 		}
-
-		/* the main menu of program which contain open door and change password options */
-		while (1)
+		/* take the reply frames of control ECU */
+		if (FRAME_poll(&reply) == FRAME_RECEIVED)
 		{
-			LCD_clearScreen();
-			LCD_displayString("+ : Open Door");
-			LCD_moveCursor(1, 0);
-			LCD_displayString("- : Change Pass");
-			/* get the option from user using keypad */
-			temp = KEYPAD_getPressedKey();
-			/* if choosing first option => open door */
-			if (temp == '+')
+			if ((reply.type == FRAME_NACK) && (g_requestOpen == TRUE))
 			{
-				/* variable which count the number of tries for user for enter password */
-				try = 0;
-				/*
-				 * select the action of check password.
-				 * the byte which sent to control ECU tell him to be ready to check
-				 * the received password with the password in EEPROM.
-				 */
-				UART_sendByte(CHECK_PASSWORD_ACTION);
-				/*
-				 * select the mode of open door.
-				 * the byte which sent to control ECU tell him to be ready for
-				 * open door mode.
-				 */
-				UART_sendByte(OPEN_DOOR_MODE);
-				while (1)
+				/* the request is corrupted on the wire, send it again */
+				resendRequestToControlECU();
+			}
+			/*
+			 * the events of the audit query come before its ACK, each one shows
+			 * that control ECU is still answering so the request is not sent again
+			 */
+			else if ((reply.type == AUDIT_EVENT_FRAME) && (g_requestOpen == TRUE)
+					&& (reply.length == AUDIT_EVENT_SIZE))
+			{
+				for (i = 0; i < AUDIT_EVENT_SIZE; i++)
 				{
-					LCD_clearScreen();
-					LCD_displayString("plz enter pass:");
-					LCD_moveCursor(1, 0);
-					/* take the password from user using keypad */
-					getPasswordFromKeyPad(password);
-					/* send the password to control ECU to check if correct or not */
-					sendPasswordToControlECU(password);
-					/* the control ECU will replay with a byte which indicate if password correct or not */
-					if (UART_recieveByte() == PASSWORD_CORRECT)
-					{
-						/* the password is correct, then start open door mode */
-						LCD_clearScreen();
-						LCD_displayString("    Door is     ");
-						LCD_moveCursor(1, 0);
-						LCD_displayString("   Unlocking    ");
-						/* waiting for 15 seconds until the door is unlocking */
-						timer1DelaySecond(DOOR_UNLOKING_PERIOD);
-						/* waiting for 3 seconds the hold period of the door */
-						timer1DelaySecond(DOOR_HOLD_PERIOD);
-						LCD_clearScreen();
-						LCD_displayString("    Door is     ");
-						LCD_moveCursor(1, 0);
-						LCD_displayString("    locking     ");
-						/* waiting for 15 seconds until the door is locking */
-						timer1DelaySecond(DOOR_LOKING_PERIOD);
-						/* reset the tries variable */
-						try = 0;
-						break;
-					}
-					else
-					{
-						LCD_clearScreen();
-						LCD_displayString("Wrong Password");
-						_delay_ms(250);
-						/* each time the entered password is incorrect, the try variable increment by 1 */
-						try++;
-						/* if the tries reach to 3, send to control ECU to enable the buzzer */
-						if (try == NUMBER_OF_TRIES_FOR_PASSWORD)
-						{
-							UART_sendByte(BUZZER_ON);
-						}
-						else
-						{
-							UART_sendByte(BUZZER_OFF);
-						}
-					}
-					/* if the tries reach to 3, display error massage on LCD */
-					if (try == NUMBER_OF_TRIES_FOR_PASSWORD)
-					{
-						LCD_clearScreen();
-						LCD_displayString("     ERROR      ");
-						LCD_moveCursor(1, 0);
-						LCD_displayString(" WRONG 3 TRIES  ");
-						/* waiting for 1 minute for the */
-						timer1DelaySecond(BUZZER_ACTIVE_PERIOD);
-						/* reset the tries variable */
-						try = 0;
-						break;
-					}
+					g_lastAuditEvent[i] = reply.payload[i];
 				}
+				g_auditEvents++;
+				Timer1_startTimer(g_replyTimerId, REPLY_TIMEOUT_MS);
 			}
-			/* if choosing second option => change password */
-			else if (temp == '-')
+			/* the same for the probe frames of the probe table of control ECU */
+			else if ((reply.type == PROF_PROBE_FRAME) && (g_requestOpen == TRUE)
+					&& (reply.length == PROF_PROBE_FRAME_SIZE))
 			{
-				/* variable which count the number of tries for user for enter password */
-				try = 0;
-				/*
-				 * select the action of check password.
-				 * the byte which sent to control ECU tell him to be ready to check
-				 * the received password with the password in EEPROM.
-				 */
-				UART_sendByte(CHECK_PASSWORD_ACTION);
-				/*
-				 * select the mode of open door.
-				 * the byte which sent to control ECU tell him to be ready for
-				 * change password mode.
-				 */
-				UART_sendByte(CHANGE_PASSWORD_MODE);
-				while (1)
+				if (g_controlProbes < CONTROL_MAX_PROBES)
 				{
-					LCD_clearScreen();
-					LCD_displayString("plz enter pass:");
-					LCD_moveCursor(1, 0);
-					/* take the password from user using keypad */
-					getPasswordFromKeyPad(password);
-					/* send the password to control ECU to check if correct or not */
-					sendPasswordToControlECU(password);
-					/* the control ECU will replay with a byte which indicate if password correct or not */
-					if (UART_recieveByte() == PASSWORD_CORRECT)
+					for (i = 0; i < PROF_PROBE_FRAME_SIZE; i++)
 					{
-						LCD_clearScreen();
-						LCD_displayString("Correct Password");
-						_delay_ms(250);
-						passwordIsChanged = FALSE;
-						/* loop until the password is changed and saved successfully to EEPROM */
-						while (passwordIsChanged == FALSE)
-						{
-							passwordIsChanged = createPassword();
-						}
-						LCD_clearScreen();
-						LCD_displayString("Password Changed");
-						LCD_moveCursor(1, 0);
-						LCD_displayString("  Successfully  ");
-						_delay_ms(250);
-						/* reset the tries variable */
-						try = 0;
-						break;
-					}
-					else
-					{
-						LCD_clearScreen();
-						LCD_displayString("Wrong Password");
-						_delay_ms(250);
-						/* each time the entered password is incorrect, the try variable increment by 1 */
-						try++;
-						/* if the tries reach to 3, send to control ECU to enable the buzzer */
-						if (try == NUMBER_OF_TRIES_FOR_PASSWORD)
-						{
-							UART_sendByte(BUZZER_ON);
-						}
-						else
-						{
-							UART_sendByte(BUZZER_OFF);
-						}
-					}
-					/* if the tries reach to 3, display error massage on LCD */
-					if (try == NUMBER_OF_TRIES_FOR_PASSWORD)
-					{
-						LCD_clearScreen();
-						LCD_displayString("     ERROR      ");
-						LCD_moveCursor(1, 0);
-						LCD_displayString(" WRONG 3 TRIES  ");
-						/* waiting for 1 minute for the */
-						timer1DelaySecond(BUZZER_ACTIVE_PERIOD);
-						/* reset the tries variable */
-						try = 0;
-						break;
+						g_probes[HMI_PROBES + g_controlProbes][i] = reply.payload[i];
 					}
+					g_controlProbes++;
 				}
+				Timer1_startTimer(g_replyTimerId, REPLY_TIMEOUT_MS);
 			}
-
+			/*
+			 * the first reply ends the request, a repeated reply is ignored, and a
+			 * reply which doesn't fit the event queue is taken from the reply sent
+			 * again after the timeout of the request
+			 */
+			else if ((reply.type == FRAME_ACK) && (reply.length >= 1)
+					&& (g_requestOpen == TRUE)
+					&& (SCHEDULER_post(g_hmiTask, EVENT_REPLY, reply.payload[0]) == TRUE))
+			{
+				g_requestOpen = FALSE;
+				Timer1_stopTimer(g_replyTimerId);
+				for (i = 0; i < reply.length; i++)
+				{
+					g_replyPayload[i] = reply.payload[i];
+				}
+				g_replyLength = reply.length;
+				/* the lockout reply carries its seconds after the reply byte */
+				if ((reply.payload[0] == BUZZER_ON) && (reply.length == 3))
+				{
+					g_lockoutSeconds = reply.payload[1]
+							| ((uint16) reply.payload[2] << 8);
+				}
+			}
+		}
+		/* the request or its reply is lost on the wire, send the request again */
+		if (Timer1_isTimerExpired(g_replyTimerId))
+		{
+			resendRequestToControlECU();
+		}
+		/* run one event of the state machine */
+		SCHEDULER_dispatch();
+		/* send the changed cells of the screen a few at a time */
+		if (Timer1_isTimerExpired(g_lcdTimerId))
+		{
+			LCD_flush(LCD_FLUSH_MAX_BYTES);
 		}
 	}
 }
@@ -322,190 +489,779 @@ int main(void)
 
 /*
  * Description :
- * Function to create password and save it to EEPROM following this steps:
- * 1. Take password and confirm password from user.
- * 2. Compare the two passwords.
- * 3. If the two passwords are matched, then send it through UART
- * 	  to control ECU and save it to EEPROM.
- * 4. If the two passwords are not matched, then repeat step1.
- * Function input:  void.
+ * Task which passes the events to the handler of the current state.
+ * Function input:  the dispatched event.
  * Function output: void.
  */
-uint8 createPassword()
+void hmiTask(const SCHEDULER_EventType *event)
 {
-	uint8 password[5]; /* array to save password on it */
-	uint8 confirmPassword[5]; /* array to save confirm password on it */
-	uint8 flag; /* flag to indicate the matching of two passwords */
-	while (1)
+	const HMI_StateType *state = &g_states[g_state];
+
+	if ((event->signal == EVENT_KEY) && (state->onKey != NULL_PTR))
 	{
-		LCD_clearScreen();
-		LCD_displayString("plz enter pass:");
-		LCD_moveCursor(1, 0);
-		/* take the password form keypad and save it to password array */
-		getPasswordFromKeyPad(password);
-		LCD_clearScreen();
-		LCD_displayString("plz re-enter pass the:");
-		LCD_moveCursor(1, 0);
-		LCD_displayString("same pass: ");
-		LCD_moveCursor(1, 11);
-		/* take the confirm password form keypad and compare it with password */
-		flag = comparePasswords(password, confirmPassword);
-		/* if flag became true, that mean the two passwords are matched */
-		if (flag == TRUE)
-		{
-			/* then send password to control ECU to save it in EEPROM */
-			sendPasswordToControlECU(password);
-			LCD_clearScreen();
-			LCD_displayString("The 2 Passwords");
-			LCD_moveCursor(1, 0);
-			LCD_displayString("Are Equal :)");
-			_delay_ms(250);
-			/* return true to not repeat this step as password created successfully */
-			return TRUE;
-			break;
-		}
-		else
-		{
-			LCD_clearScreen();
-			LCD_displayString("The 2 Passwords");
-			LCD_moveCursor(1, 0);
-			LCD_displayString("Are Not Equal :(");
-			_delay_ms(250);
-			/* return false to repeat this step as password is not created successfully */
-			return FALSE;
-		}
+		state->onKey(event->param);
+	}
+	else if ((event->signal == EVENT_REPLY) && (state->onReply != NULL_PTR))
+	{
+		state->onReply(event->param);
+	}
+	else if ((event->signal == EVENT_TIMER) && (state->onTimer != NULL_PTR))
+	{
+		state->onTimer();
 	}
 }
 
 /*
  * Description :
- * Function to active keypad to get input number from it.
- * Function input:  array of uint8 to save numbers from keypad on it.
+ * Function to leave the current state and run the entry action of the new one.
+ * Function input:  the new state.
  * Function output: void.
  */
-void getPasswordFromKeyPad(uint8 password[])
-{
-	uint8 i, temp;
-	i = 0; /* the index and counter for the loop and equal 5 as password is 5 numbers */
-	while (i < PASSWORD_LENGTH)
-	{
-		/* take the input number form keypad */
-		temp = KEYPAD_getPressedKey();
-		/* wait 250msec before getting a new press from the keypad buttons, Press time is 250msec */
-		_delay_ms(250);
-		/* if the input is not a number form 0 to 9 then repeat taking input step */
-		/* ^ for the keys don't have a number or # or - or + */
-		if (temp == '^' || temp == '#' || temp == '-' || temp == '+')
-		{
-			continue;
-		}
-		/* the input is a number, then save it to its index in array */
-		password[i] = temp;
-		/* display the * char in LCD */
-		LCD_displayCharacter('*');
-		/* increment the index */
-		i++;
+void enterState(HMI_StateIdType state)
+{
+	/* a timer of the old state must not reach the new one */
+	Timer1_stopTimer(g_stateTimerId);
+	g_state = state;
+	if (g_states[state].onEnter != NULL_PTR)
+	{
+		g_states[state].onEnter();
 	}
-	/* waiting for pressing enter key */
-	while (KEYPAD_getPressedKey() != '#')
-		;
 }
 
 /*
  * Description :
- * Function to take confirm password then compare it with password and return if matched or not.
+ * Function to show a message on the two LCD lines for a short period then enter the next state.
+ * Function input:  the two lines of the message and the state after the message.
+ * Function output: void.
+ */
+void showMessage(const char *line1, const char *line2,
+		HMI_StateIdType nextState)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString(line1);
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString(line2);
+	g_messageNextState = nextState;
+	enterState(STATE_MESSAGE);
+}
+
+/*
+ * Description :
+ * Function to take one key of the password, digits are saved and displayed as '*'
+ * and the enter key '#' completes the password after its 5 digits.
+ * Function input:  the pressed key and array of uint8 to save the digits on it.
+ * Function output: uint8 flag which is TRUE when the password is completed.
+ */
+uint8 collectPasswordKey(uint8 key, uint8 password[])
+{
+	if (g_digits == PASSWORD_LENGTH)
+	{
+		/* waiting for pressing enter key */
+		return (key == '#') ? TRUE : FALSE;
+	}
+	/* if the input is not a number form 0 to 9 then wait for another key */
+	/* ^ for the keys don't have a number or # or - or + */
+	if (key == '^' || key == '#' || key == '-' || key == '+')
+	{
+		return FALSE;
+	}
+	/* the input is a number, then save it to its index in array */
+	password[g_digits] = key;
+	/* display the * char in LCD */
+	LCD_bufferDisplayCharacter('*');
+	g_digits++;
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Function to compare two passwords.
  * Function input:  two arrays of uint8 to compare between them.
  * Function output: uint8 flag that indicate the matching of passwords.
  */
-uint8 comparePasswords(uint8 password[], uint8 confirmPassword[])
-{
-	uint8 i, temp, matchingFlag = TRUE;
-	i = 0;
-	while (i < PASSWORD_LENGTH)
-	{
-		/* take the input number form keypad */
-		temp = KEYPAD_getPressedKey();
-		/* wait 250msec before getting a new press from the keypad buttons, Press time is 250msec */
-		_delay_ms(250);
-		/* if the input is not a number form 0 to 9 then repeat taking input step */
-		if (temp == '^' || temp == '#' || temp == '-' || temp == '+')
-		{
-			continue;
-		}
-		/* the input is a number, then save it to its index in array */
-		confirmPassword[i] = temp;
+uint8 comparePasswords(const uint8 password[], const uint8 confirmPassword[])
+{
+	uint8 i, matchingFlag = TRUE;
+	for (i = 0; i < PASSWORD_LENGTH; i++)
+	{
 		/* check each element of both array if equal or not */
 		if (confirmPassword[i] != password[i])
 		{
 			/* if not equal then two passwords are not matched and flag become false */
 			matchingFlag = FALSE;
 		}
-		/* display the * char in LCD */
-		LCD_displayCharacter('*');
-		/* increment the index */
-		i++;
-	}
-	/* waiting for pressing enter key */
-	while (KEYPAD_getPressedKey() != '#')
-		;
+	}
 	/* return the matching flag */
 	return matchingFlag;
 }
 
 /*
  * Description :
- * Function to send password through UART to control ECU.
- * Function input:  array of uint8 to send it to control ECU.
+ * Function to send a request frame to control ECU without waiting for the reply,
+ * the reply comes later as EVENT_REPLY.
+ * Function input:  the request type and its payload.
  * Function output: void.
  */
-void sendPasswordToControlECU(uint8 password[])
+void sendRequestToControlECU(uint8 type, const uint8 payload[], uint8 length)
 {
 	uint8 i;
-	i = 0;
-	while (i < PASSWORD_LENGTH)
+	/* keep a copy of the request to send it again if it is NACKed or not answered */
+	g_requestType = type;
+	g_requestLength = length;
+	g_requestRetries = 0;
+	for (i = 0; i < length; i++)
+	{
+		g_requestPayload[i] = payload[i];
+	}
+	g_requestOpen = TRUE;
+	FRAME_send(type, payload, length);
+	Timer1_startTimer(g_replyTimerId, REPLY_TIMEOUT_MS);
+}
+
+/*
+ * Description :
+ * Function to send the last request again when it is NACKed or not answered in time,
+ * after FRAME_MAX_RETRIES the state machine gets NO_REPLY as the reply.
+ * Function input:  void.
+ * Function output: void.
+ */
+void resendRequestToControlECU(void)
+{
+	if (g_requestRetries < FRAME_MAX_RETRIES)
+	{
+		g_requestRetries++;
+		FRAME_send(g_requestType, g_requestPayload, g_requestLength);
+		Timer1_startTimer(g_replyTimerId, REPLY_TIMEOUT_MS);
+	}
+	else
+	{
+		/* with the queue full the timer expires again and NO_REPLY is posted then */
+		if (SCHEDULER_post(g_hmiTask, EVENT_REPLY, NO_REPLY) == TRUE)
+		{
+			g_requestOpen = FALSE;
+			g_replyLength = 0;
+		}
+		else
+		{
+			Timer1_startTimer(g_replyTimerId, 1);
+		}
+	}
+}
+
+/*
+ * Description :
+ * Function to send password in one frame to control ECU.
+ * Function input:  the action byte, the mode byte (check action) or the slot (USER_ADD) and array of uint8 to send.
+ * Function output: void.
+ */
+void sendPasswordToControlECU(uint8 action, uint8 mode, uint8 password[])
+{
+	uint8 i, length;
+	uint8 payload[PASSWORD_LENGTH + 1];
+	length = 0;
+	/*
+	 * the check action carries the mode in front of the password and the user
+	 * add request carries the slot of the user in the same place
+	 */
+	if ((action == CHECK_PASSWORD_ACTION) || (action == USER_ADD))
+	{
+		payload[length] = mode;
+		length++;
+	}
+	for (i = 0; i < PASSWORD_LENGTH; i++)
 	{
-		/* send the password byte by byte to control ECU through UART  */
-		UART_sendByte(password[i]);
-		i++;
-		/* waiting the replay from control that it is ready to receive again */
-		while (UART_recieveByte() != START_COMMNUCATION)
-			;
+		payload[length] = password[i];
+		length++;
 	}
+	sendRequestToControlECU(action, payload, length);
 }
 
 /*
  * Description :
- * Function to count a number of seconds which passed to it.
- * Function input:  number of seconds.
+ * Function to start counting down the seconds of the current state then enter the next state.
+ * Function input:  the seconds of the state and the state after them.
  * Function output: void.
  */
-void timer1DelaySecond(uint8 n)
-{
-	/* select the configuration of TIMER1 */
-	TIMER1_ConfigType TIMER1_config =
-	{ CTC_INITIAL_VALUE, CTC_VALUE_FOR_ONE_SECOND, CTC_MODE,
-			TIMER1_PRESCALER_256 };
-	/* setup the call back function */
-	Timer1_setCallBack(countOneSecond);
-	/* passing the configuration to initialization function of TIMER1 */
-	Timer1_init(&TIMER1_config);
-	/* waiting for 15 seconds until the door is unlocking */
-	while (g_ticks < n)
-		;
-	/* reset the global variable of ticks */
-	g_ticks = 0;
-	/* stop the timer1 */
-	Timer1_deInit();
+void startCountdown(uint16 seconds, HMI_StateIdType nextState)
+{
+	/* a state without seconds (a lockout which just ended) is left at once */
+	if (seconds == 0)
+	{
+		enterState(nextState);
+		return;
+	}
+	g_countdown = seconds;
+	g_countdownDigits = (seconds >= 1000) ? 4 : (seconds >= 100) ? 3 : 2;
+	g_countdownNextState = nextState;
+	displayCountdown();
+	Timer1_startTimer(g_stateTimerId, ONE_SECOND_IN_MS);
 }
 
 /*
  * Description :
- * This is the call back function which will be executed each interrupt in timer1.
+ * Function to display the remaining seconds of the current state at the end of the second line.
  * Function input:  void.
  * Function output: void.
  */
-void countOneSecond()
+void displayCountdown(void)
+{
+	uint8 digits = (g_countdown >= 1000) ? 4 :
+			(g_countdown >= 100) ? 3 : (g_countdown >= 10) ? 2 : 1;
+
+	/* the seconds are right aligned, the left digits are cleared as they end */
+	LCD_bufferMoveCursor(1, 15 - g_countdownDigits);
+	for (; digits < g_countdownDigits; digits++)
+	{
+		LCD_bufferDisplayCharacter(' ');
+	}
+	LCD_bufferIntgerToString(g_countdown);
+	LCD_bufferDisplayCharacter('s');
+}
+
+/*
+ * Description :
+ * This is the call back function which will be executed when the state timer expires.
+ * Function input:  void.
+ * Function output: void.
+ */
+void stateTimerExpired(void)
+{
+	/* the event queue is full, try again at the next tick */
+	if (SCHEDULER_post(g_hmiTask, EVENT_TIMER, 0) == FALSE)
+	{
+		Timer1_startTimer(g_stateTimerId, 1);
+	}
+}
+
+/*
+ * Description :
+ * Function to display a 16-bit value without a sign at the cursor.
+ * Function input:  the value.
+ * Function output: void.
+ */
+void displayUnsigned(uint16 value)
+{
+	char digits[6];
+	uint8 i = sizeof(digits) - 1;
+
+	/* the digits are made from the lowest one */
+	digits[i] = '\0';
+	do
+	{
+		i--;
+		digits[i] = (char) ('0' + (value % 10));
+		value /= 10;
+	} while (value != 0);
+	LCD_bufferDisplayString(&digits[i]);
+}
+
+/*******************************************************************************
+ *                        States Functions Definitions                         *
+ *******************************************************************************/
+
+static void messageEnter(void)
+{
+	Timer1_startTimer(g_stateTimerId, MESSAGE_PERIOD_MS);
+}
+
+static void messageTimer(void)
 {
-	/* this function is executed each 1 second as the configuration that passed to timer1*/
-	g_ticks++;
+	/* the first splash screen is followed by the second one */
+	if (g_messageNextState == STATE_MESSAGE)
+	{
+		showMessage("     Made By    ", "    Ahmed Ali   ", STATE_WAIT_SETUP);
+		return;
+	}
+	enterState(g_messageNextState);
+}
+
+static void waitSetupEnter(void)
+{
+	sendRequestToControlECU(GET_PASSWORD_STATE, NULL_PTR, 0);
+}
+
+static void waitSetupReply(uint8 reply)
+{
+	if (reply == NO_REPLY)
+	{
+		/* ask again, control ECU may be still starting */
+		showMessage("  No Response   ", "From Control ECU", STATE_WAIT_SETUP);
+		return;
+	}
+	/* control ECU refuses to create the admin password again after the first start */
+	enterState((reply == TRUE) ? STATE_MAIN_MENU : STATE_CREATE_PASSWORD);
+}
+
+static void createPasswordEnter(void)
+{
+	g_digits = 0;
+	LCD_bufferClear();
+	LCD_bufferDisplayString("plz enter pass:");
+	LCD_bufferMoveCursor(1, 0);
+}
+
+static void createPasswordKey(uint8 key)
+{
+	if (collectPasswordKey(key, g_password) == TRUE)
+	{
+		enterState(STATE_CONFIRM_PASSWORD);
+	}
+}
+
+static void confirmPasswordEnter(void)
+{
+	g_digits = 0;
+	LCD_bufferClear();
+	LCD_bufferDisplayString("plz re-enter the");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("same pass: ");
+}
+
+static void confirmPasswordKey(uint8 key)
+{
+	if (collectPasswordKey(key, g_confirmPassword) == FALSE)
+	{
+		return;
+	}
+	if (comparePasswords(g_password, g_confirmPassword) == TRUE)
+	{
+		/* the two passwords are matched, send password to control ECU to save it in EEPROM */
+		if (g_userRequest == USER_ADD)
+		{
+			/* the password of the new user is sent after its slot */
+			sendPasswordToControlECU(USER_ADD, g_slot, g_password);
+		}
+		else
+		{
+			sendPasswordToControlECU(CRETAE_PASSWORD_ACTION, 0, g_password);
+		}
+		enterState(STATE_WAIT_SAVE);
+	}
+	else
+	{
+		/* repeat creating the password */
+		showMessage("The 2 Passwords", "Are Not Equal :(",
+				STATE_CREATE_PASSWORD);
+	}
+}
+
+static void waitSaveReply(uint8 reply)
+{
+	/* the user requests of the admin menu end in the main menu */
+	if (g_userRequest == USER_ADD)
+	{
+		g_userRequest = 0;
+		showMessage((reply == PASSWORD_CORRECT) ? "   User Added   " : " User Not Added ",
+				"", STATE_MAIN_MENU);
+	}
+	else if (g_userRequest == USER_REVOKE)
+	{
+		g_userRequest = 0;
+		showMessage((reply == PASSWORD_CORRECT) ? "  User Revoked  " : "User Not Revoked",
+				"", STATE_MAIN_MENU);
+	}
+	else if (reply != PASSWORD_CORRECT)
+	{
+		/*
+		 * control ECU refused the create or the EEPROM write failed, a change
+		 * is checked again from the main menu before it is sent again
+		 */
+		showMessage("Password Not Set", "   Try Again    ",
+				(g_changingPassword == TRUE) ? STATE_MAIN_MENU : STATE_CREATE_PASSWORD);
+		g_changingPassword = FALSE;
+	}
+	else if (g_changingPassword == TRUE)
+	{
+		g_changingPassword = FALSE;
+		showMessage("Password Changed", "  Successfully  ", STATE_MAIN_MENU);
+	}
+	else
+	{
+		showMessage("The 2 Passwords", "Are Equal :)", STATE_MAIN_MENU);
+	}
+}
+
+static void mainMenuEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("+ : Open Door");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("- : Change Pass");
+	/* the '#' key opens the admin menu, it is not shown to the users */
+}
+
+static void mainMenuKey(uint8 key)
+{
+	/*
+	 * the open door and change password options are the same check password
+	 * flow, only the mode which is sent with the password is different
+	 */
+	if (key == '+')
+	{
+		g_mode = OPEN_DOOR_MODE;
+	}
+	else if (key == '-')
+	{
+		g_mode = CHANGE_PASSWORD_MODE;
+	}
+	else if (key == '#')
+	{
+		g_mode = ADMIN_MODE;
+	}
+	else
+	{
+		return;
+	}
+	enterState(STATE_ENTER_PASSWORD);
+}
+
+static void enterPasswordEnter(void)
+{
+	g_digits = 0;
+	LCD_bufferClear();
+	LCD_bufferDisplayString("plz enter pass:");
+	LCD_bufferMoveCursor(1, 0);
+}
+
+static void enterPasswordKey(uint8 key)
+{
+	if (collectPasswordKey(key, g_password) == TRUE)
+	{
+		/* send the password with the mode in one frame to control ECU to check it */
+		sendPasswordToControlECU(CHECK_PASSWORD_ACTION, g_mode, g_password);
+		enterState(STATE_WAIT_CHECK);
+	}
+}
+
+static void waitCheckReply(uint8 reply)
+{
+	if (reply == PASSWORD_CORRECT)
+	{
+		if (g_mode == OPEN_DOOR_MODE)
+		{
+			/* the password is correct, then start open door mode */
+			enterState(STATE_DOOR_UNLOCKING);
+		}
+		else if (g_mode == ADMIN_MODE)
+		{
+			enterState(STATE_ADMIN_MENU);
+		}
+		else
+		{
+			/* the password is correct, then create the new password */
+			g_changingPassword = TRUE;
+			showMessage("Correct Password", "", STATE_CREATE_PASSWORD);
+		}
+		return;
+	}
+
+	/*
+	 * control ECU counts the wrong passwords, it answers by BUZZER_ON when they
+	 * start a lockout or while the lockout is running
+	 */
+	if (reply == BUZZER_ON)
+	{
+		enterState(STATE_LOCKED_OUT);
+	}
+	else if (reply == NOT_ADMIN)
+	{
+		showMessage("  Admin Only    ", "", STATE_MAIN_MENU);
+	}
+	else if ((reply == PASSWORD_UNCHECKED) || (reply == NO_REPLY))
+	{
+		showMessage("Can't Check Pass", "Try Again Later", STATE_MAIN_MENU);
+	}
+	else
+	{
+		showMessage("Wrong Password", "", STATE_ENTER_PASSWORD);
+	}
+}
+
+static void doorUnlockingEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("    Door is     ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("   Unlocking");
+	startCountdown(DOOR_UNLOKING_PERIOD, STATE_DOOR_HOLDING);
+}
+
+static void doorHoldingEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("    Door is     ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("  Open");
+	startCountdown(DOOR_HOLD_PERIOD, STATE_DOOR_LOCKING);
+}
+
+static void doorLockingEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("    Door is     ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("    locking");
+	startCountdown(DOOR_LOKING_PERIOD, STATE_MAIN_MENU);
+}
+
+static void lockedOutEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("   LOCKED OUT   ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString(" Wait");
+	/* waiting for the lockout period of control ECU */
+	startCountdown(g_lockoutSeconds, STATE_MAIN_MENU);
+}
+
+static void countdownTimer(void)
+{
+	g_countdown--;
+	if (g_countdown == 0)
+	{
+		enterState(g_countdownNextState);
+		return;
+	}
+	displayCountdown();
+	Timer1_startTimer(g_stateTimerId, ONE_SECOND_IN_MS);
+}
+
+static void adminMenuEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("1:Add  2:Revoke");
+	LCD_bufferMoveCursor(1, 0);
+	/* the '-' key goes back to the main menu */
+	LCD_bufferDisplayString("3:Diag 4:Probes");
+}
+
+static void adminMenuKey(uint8 key)
+{
+	/*
+	 * control ECU takes the admin check only for the next request, so each
+	 * option sends one request then ends in the main menu
+	 */
+	if ((key == 1) || (key == 2))
+	{
+		g_userRequest = (key == 1) ? USER_ADD : USER_REVOKE;
+		enterState(STATE_ENTER_SLOT);
+	}
+	else if (key == 3)
+	{
+		g_diagnosticStep = 0;
+		enterState(STATE_WAIT_DIAGNOSTICS);
+	}
+	else if (key == 4)
+	{
+		enterState(STATE_WAIT_PROBES);
+	}
+	else if (key == '-')
+	{
+		enterState(STATE_MAIN_MENU);
+	}
+}
+
+static void enterSlotEnter(void)
+{
+	g_digits = 0;
+	g_slot = 0;
+	LCD_bufferClear();
+	LCD_bufferDisplayString("user slot 00-63:");
+	LCD_bufferMoveCursor(1, 0);
+}
+
+static void enterSlotKey(uint8 key)
+{
+	if (key == '-')
+	{
+		g_userRequest = 0;
+		enterState(STATE_ADMIN_MENU);
+		return;
+	}
+	if (g_digits == SLOT_DIGITS)
+	{
+		if (key != '#')
+		{
+			return;
+		}
+		if (g_slot >= MAX_USERS)
+		{
+			showMessage("  Wrong Slot    ", "", STATE_ENTER_SLOT);
+		}
+		else if (g_userRequest == USER_ADD)
+		{
+			/* the password of the new user is created then sent with its slot */
+			enterState(STATE_CREATE_PASSWORD);
+		}
+		else
+		{
+			sendRequestToControlECU(USER_REVOKE, &g_slot, 1);
+			enterState(STATE_WAIT_SAVE);
+		}
+		return;
+	}
+	if (key == '^' || key == '#' || key == '+')
+	{
+		return;
+	}
+	g_slot = (uint8) ((g_slot * 10) + key);
+	LCD_bufferDisplayCharacter('0' + key);
+	g_digits++;
+}
+
+static void waitDiagnosticsEnter(void)
+{
+	LCD_bufferClear();
+	LCD_bufferDisplayString("  Diagnostics   ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("  Please Wait   ");
+	sendRequestToControlECU(g_diagnosticRequests[g_diagnosticStep], NULL_PTR, 0);
+}
+
+static void waitDiagnosticsReply(uint8 reply)
+{
+	(void) reply;
+	/* each diagnostic reply carries a 16-bit value, NO_REPLY has none */
+	if (g_replyLength < 2)
+	{
+		g_diagnosticStep = 0;
+		showMessage("  No Response   ", "From Control ECU", STATE_MAIN_MENU);
+		return;
+	}
+	g_diagnostics[g_diagnosticStep] = g_replyPayload[0]
+			| ((uint16) g_replyPayload[1] << 8);
+	g_diagnosticStep++;
+	if (g_diagnosticStep < NUMBER_OF_DIAGNOSTICS)
+	{
+		if (g_diagnosticRequests[g_diagnosticStep] == AUDIT_QUERY)
+		{
+			g_auditEvents = 0;
+		}
+		sendRequestToControlECU(g_diagnosticRequests[g_diagnosticStep], NULL_PTR, 0);
+		return;
+	}
+	g_diagnosticStep = 0;
+	g_diagnosticScreen = 0;
+	enterState(STATE_SHOW_DIAGNOSTICS);
+}
+
+static void showDiagnosticsEnter(void)
+{
+	LCD_bufferClear();
+	if (g_diagnosticScreen == 0)
+	{
+		/* the worst times in microseconds, the dispatch one since the last query */
+		LCD_bufferDisplayString("Verify us ");
+		displayUnsigned(g_diagnostics[DIAGNOSTIC_VERIFY_TIME]);
+		LCD_bufferMoveCursor(1, 0);
+		LCD_bufferDisplayString("Dispatch us ");
+		displayUnsigned(g_diagnostics[DIAGNOSTIC_DISPATCH_LATENCY]);
+	}
+	else
+	{
+		/* the number of the events in the log and the newest one */
+		LCD_bufferDisplayString("Audit events ");
+		displayUnsigned(g_diagnostics[DIAGNOSTIC_AUDIT]);
+		LCD_bufferMoveCursor(1, 0);
+		if (g_auditEvents != 0)
+		{
+			LCD_bufferDisplayString("last #");
+			displayUnsigned(g_lastAuditEvent[1] | ((uint16) g_lastAuditEvent[2] << 8));
+			LCD_bufferDisplayString(" t");
+			displayUnsigned(g_lastAuditEvent[0]);
+		}
+	}
+}
+
+static void showDiagnosticsKey(uint8 key)
+{
+	(void) key;
+	/* any key shows the next screen, the last one goes back to the main menu */
+	g_diagnosticScreen++;
+	if (g_diagnosticScreen < 2)
+	{
+		enterState(STATE_SHOW_DIAGNOSTICS);
+	}
+	else
+	{
+		enterState(STATE_MAIN_MENU);
+	}
+}
+
+static void waitProbesEnter(void)
+{
+#if (PROF_ENABLE == 1)
+	uint8 id;
+
+	/* the table of this ECU is taken when the table of control ECU is asked */
+	for (id = 0; id < HMI_PROBES; id++)
+	{
+		PROF_readProbe(id, g_probes[id]);
+	}
+#endif
+	g_controlProbes = 0;
+	LCD_bufferClear();
+	LCD_bufferDisplayString("     Probes     ");
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("  Please Wait   ");
+	sendRequestToControlECU(PROF_QUERY, NULL_PTR, 0);
+}
+
+static void waitProbesReply(uint8 reply)
+{
+	(void) reply;
+	/* the closing ACK carries the number of the probes, NO_REPLY has no bytes */
+	if (g_replyLength == 0)
+	{
+		showMessage("  No Response   ", "From Control ECU", STATE_MAIN_MENU);
+	}
+	else if ((HMI_PROBES + g_controlProbes) == 0)
+	{
+		showMessage("No Probes Built ", "", STATE_MAIN_MENU);
+	}
+	else
+	{
+		g_probeScreen = 0;
+		enterState(STATE_SHOW_PROBES);
+	}
+}
+
+static void showProbesEnter(void)
+{
+	const uint8 *record = g_probes[g_probeScreen];
+
+	/* one probe on each screen: its ECU, its id, then its times in microseconds */
+	LCD_bufferClear();
+	if (g_probeScreen < HMI_PROBES)
+	{
+		LCD_bufferDisplayString("HMI ");
+		displayUnsigned(g_probeScreen);
+	}
+	else
+	{
+		LCD_bufferDisplayString("CTRL ");
+		displayUnsigned(g_probeScreen - HMI_PROBES);
+	}
+	LCD_bufferDisplayString(" max ");
+	displayUnsigned(record[4] | ((uint16) record[5] << 8));
+	LCD_bufferMoveCursor(1, 0);
+	LCD_bufferDisplayString("avg ");
+	displayUnsigned(record[6] | ((uint16) record[7] << 8));
+	LCD_bufferDisplayString(" n");
+	displayUnsigned(record[0] | ((uint16) record[1] << 8));
+}
+
+static void showProbesKey(uint8 key)
+{
+	(void) key;
+	/* any key shows the next probe, the last one goes back to the main menu */
+	g_probeScreen++;
+	if (g_probeScreen < (HMI_PROBES + g_controlProbes))
+	{
+		enterState(STATE_SHOW_PROBES);
+	}
+	else
+	{
+		enterState(STATE_MAIN_MENU);
+	}
 }
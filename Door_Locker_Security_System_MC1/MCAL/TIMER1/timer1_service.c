@@ -0,0 +1,375 @@
+/*
+ ============================================================================
+ Name        : timer1_service.c
+ Author      : Ahmed Ali
+ Module Name : TIMER1
+ Layer       : MCAL
+ Date        : 18 Oct 2026
+ Description : Source file for the software timers service on top of TIMER1
+ ============================================================================
+ */
+
+#include "timer1_service.h"
+#include "timer1.h"
+#include "timer1_private.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* End of the active timers list */
+#define TIMER1_SERVICE_NONE		0xFF
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	void (*callBackPtr)(void);
+	uint16 period; /* milliseconds between two expiries */
+	uint16 delta; /* ticks after the expiry of the previous timer in the active list */
+	uint8 next; /* id of the next timer in the active list */
+	uint8 mode;
+	uint8 running;
+	volatile uint8 expired;
+} Timer1_SoftTimerType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static Timer1_SoftTimerType g_timers[TIMER1_SERVICE_MAX_TIMERS];
+
+/*
+ * The running timers are kept in a list sorted by expiry time, each one holds
+ * only the difference from the one before it. The tick decrements the head only
+ * and removes the timers whose difference reached zero, so a tick costs O(expired).
+ */
+static volatile uint8 g_activeHead = TIMER1_SERVICE_NONE;
+
+static uint8 g_createdTimers = 0;
+
+static volatile uint32 g_ticks = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The call back function of TIMER1 which is executed each 1 ms.
+ */
+static void Timer1_serviceTick(void);
+
+/*
+ * Description :
+ * Insert the timer in its place of the active list to expire after the required ticks.
+ */
+static void Timer1_insertTimer(uint8 id, uint16 a_ticks);
+
+/*
+ * Description :
+ * Remove the timer from the active list and give its ticks to the next timer.
+ */
+static void Timer1_removeTimer(uint8 id);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start TIMER1 as a free running 1 ms tick and stop all the software timers.
+ */
+void Timer1_serviceInit(void)
+{
+	/* select the configuration of TIMER1 */
+	TIMER1_ConfigType TIMER1_config =
+	{ 0, TIMER1_SERVICE_TICK_COMPARE, CTC_MODE, TIMER1_PRESCALER_8 };
+
+	g_activeHead = TIMER1_SERVICE_NONE;
+	g_createdTimers = 0;
+	g_ticks = 0;
+
+	/* setup the call back function */
+	Timer1_setCallBack(Timer1_serviceTick);
+	/* passing the configuration to initialization function of TIMER1 */
+	Timer1_init(&TIMER1_config);
+	/* The overflow never happens in CTC mode, use the compare match only */
+	TIMSK_REG.Bits.TOIE1_Bit = 0;
+}
+
+/*
+ * Description :
+ * Reserve one software timer with the required mode.
+ * The call back function (or NULL_PTR) is executed from the TIMER1 ISR at each expiry.
+ * Function output: the timer id, or TIMER1_SERVICE_INVALID_ID if no timer is free.
+ */
+uint8 Timer1_createTimer(TIMER1_TimerModeType mode, void (*a_ptr)(void))
+{
+	uint8 id;
+
+	if (g_createdTimers >= TIMER1_SERVICE_MAX_TIMERS)
+	{
+		return TIMER1_SERVICE_INVALID_ID;
+	}
+	id = g_createdTimers;
+	g_createdTimers++;
+
+	g_timers[id].callBackPtr = a_ptr;
+	g_timers[id].mode = mode;
+	g_timers[id].running = FALSE;
+	g_timers[id].expired = FALSE;
+	return id;
+}
+
+/*
+ * Description :
+ * Start (or restart) the software timer to expire after the required milliseconds,
+ * periodic timers are started again with the same period at each expiry.
+ */
+void Timer1_startTimer(uint8 id, uint16 a_ms)
+{
+	uint8 interruptState;
+
+	if (id >= g_createdTimers)
+	{
+		return;
+	}
+	/* the tick that is already running is counted as the first millisecond */
+	if (a_ms == 0)
+	{
+		a_ms = 1;
+	}
+
+	/* The active list is shared with the TIMER1 ISR */
+	interruptState = TIMSK_REG.Bits.OCIE1A_Bit;
+	TIMSK_REG.Bits.OCIE1A_Bit = 0;
+
+	if (g_timers[id].running)
+	{
+		Timer1_removeTimer(id);
+	}
+	g_timers[id].period = a_ms;
+	g_timers[id].expired = FALSE;
+	Timer1_insertTimer(id, a_ms);
+
+	TIMSK_REG.Bits.OCIE1A_Bit = interruptState;
+}
+
+/*
+ * Description :
+ * Stop the software timer without executing its call back function.
+ */
+void Timer1_stopTimer(uint8 id)
+{
+	uint8 interruptState;
+
+	if (id >= g_createdTimers)
+	{
+		return;
+	}
+
+	interruptState = TIMSK_REG.Bits.OCIE1A_Bit;
+	TIMSK_REG.Bits.OCIE1A_Bit = 0;
+
+	if (g_timers[id].running)
+	{
+		Timer1_removeTimer(id);
+	}
+	g_timers[id].expired = FALSE;
+
+	TIMSK_REG.Bits.OCIE1A_Bit = interruptState;
+}
+
+/*
+ * Description :
+ * Return the milliseconds remaining until the software timer expires, zero if stopped.
+ */
+uint16 Timer1_getRemainingTime(uint8 id)
+{
+	uint8 interruptState;
+	uint8 current;
+	uint16 remaining = 0;
+
+	if (id >= g_createdTimers)
+	{
+		return 0;
+	}
+
+	interruptState = TIMSK_REG.Bits.OCIE1A_Bit;
+	TIMSK_REG.Bits.OCIE1A_Bit = 0;
+
+	if (g_timers[id].running)
+	{
+		/* sum the differences of all the timers which expire before this one */
+		current = g_activeHead;
+		while (current != id)
+		{
+			remaining += g_timers[current].delta;
+			current = g_timers[current].next;
+		}
+		remaining += g_timers[id].delta;
+	}
+
+	TIMSK_REG.Bits.OCIE1A_Bit = interruptState;
+	return remaining;
+}
+
+/*
+ * Description :
+ * Return TRUE once if the software timer expired since the last call, then clear the flag.
+ */
+uint8 Timer1_isTimerExpired(uint8 id)
+{
+	if ((id < g_createdTimers) && (g_timers[id].expired))
+	{
+		g_timers[id].expired = FALSE;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Return the number of milliseconds passed since Timer1_serviceInit.
+ */
+uint32 Timer1_getTicks(void)
+{
+	uint32 ticks;
+	uint8 interruptState = TIMSK_REG.Bits.OCIE1A_Bit;
+
+	/* The 32-bit counter is updated by the TIMER1 ISR, read it atomically */
+	TIMSK_REG.Bits.OCIE1A_Bit = 0;
+	ticks = g_ticks;
+	TIMSK_REG.Bits.OCIE1A_Bit = interruptState;
+	return ticks;
+}
+
+/*
+ * Description :
+ * Return the number of TIMER1 counts (1 us each at 8 MHz) passed since Timer1_serviceInit.
+ */
+uint32 Timer1_getMicros(void)
+{
+	uint32 ticks;
+	uint16 counts;
+	uint8 interruptState = TIMSK_REG.Bits.OCIE1A_Bit;
+
+	TIMSK_REG.Bits.OCIE1A_Bit = 0;
+	ticks = g_ticks;
+	counts = TCNT1_REG;
+	/* a compare match which is not serviced yet belongs to the counted ticks */
+	if ((TIFR_REG.Bits.OCF1A_Bit) && (counts < (TIMER1_SERVICE_TICK_COMPARE / 2)))
+	{
+		ticks++;
+	}
+	TIMSK_REG.Bits.OCIE1A_Bit = interruptState;
+	return (ticks * ((uint32) TIMER1_SERVICE_TICK_COMPARE + 1)) + counts;
+}
+
+/*
+ * Description :
+ * The call back function of TIMER1 which is executed each 1 ms.
+ */
+static void Timer1_serviceTick(void)
+{
+	uint8 id;
+
+	g_ticks++;
+	if (g_activeHead == TIMER1_SERVICE_NONE)
+	{
+		return;
+	}
+
+	g_timers[g_activeHead].delta--;
+	/* remove all the timers which expire at this tick */
+	while ((g_activeHead != TIMER1_SERVICE_NONE)
+			&& (g_timers[g_activeHead].delta == 0))
+	{
+		id = g_activeHead;
+		g_activeHead = g_timers[id].next;
+		g_timers[id].running = FALSE;
+		g_timers[id].expired = TRUE;
+
+		if (g_timers[id].mode == TIMER1_PERIODIC)
+		{
+			Timer1_insertTimer(id, g_timers[id].period);
+		}
+		if (g_timers[id].callBackPtr != NULL_PTR)
+		{
+			(*g_timers[id].callBackPtr)();
+		}
+	}
+}
+
+/*
+ * Description :
+ * Insert the timer in its place of the active list to expire after the required ticks.
+ */
+static void Timer1_insertTimer(uint8 id, uint16 a_ticks)
+{
+	uint8 previous = TIMER1_SERVICE_NONE;
+	uint8 current = g_activeHead;
+
+	/* timers with the same expiry time keep their start order */
+	while ((current != TIMER1_SERVICE_NONE)
+			&& (g_timers[current].delta <= a_ticks))
+	{
+		a_ticks -= g_timers[current].delta;
+		previous = current;
+		current = g_timers[current].next;
+	}
+
+	g_timers[id].delta = a_ticks;
+	g_timers[id].next = current;
+	if (current != TIMER1_SERVICE_NONE)
+	{
+		g_timers[current].delta -= a_ticks;
+	}
+	if (previous == TIMER1_SERVICE_NONE)
+	{
+		g_activeHead = id;
+	}
+	else
+	{
+		g_timers[previous].next = id;
+	}
+	g_timers[id].running = TRUE;
+}
+
+/*
+ * Description :
+ * Remove the timer from the active list and give its ticks to the next timer.
+ */
+static void Timer1_removeTimer(uint8 id)
+{
+	uint8 previous = TIMER1_SERVICE_NONE;
+	uint8 current = g_activeHead;
+
+	while ((current != TIMER1_SERVICE_NONE) && (current != id))
+	{
+		previous = current;
+		current = g_timers[current].next;
+	}
+	if (current == TIMER1_SERVICE_NONE)
+	{
+		return;
+	}
+
+	current = g_timers[id].next;
+	if (current != TIMER1_SERVICE_NONE)
+	{
+		g_timers[current].delta += g_timers[id].delta;
+	}
+	if (previous == TIMER1_SERVICE_NONE)
+	{
+		g_activeHead = current;
+	}
+	else
+	{
+		g_timers[previous].next = current;
+	}
+	g_timers[id].running = FALSE;
+}
@@ -0,0 +1,80 @@
+/*
+ ============================================================================
+ Name        : frame.h
+ Author      : Ahmed Ali
+ Module Name : FRAME
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the framed UART link between the two ECUs
+ ============================================================================
+ */
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Frame format on the wire:
+ * | START | TYPE | LENGTH | PAYLOAD (LENGTH bytes) | CRC |
+ * The CRC is CRC-8 (polynomial 0x07) over TYPE, LENGTH and PAYLOAD.
+ */
+#define FRAME_START_BYTE		0x7E
+#define FRAME_MAX_PAYLOAD		8
+#define FRAME_OVERHEAD			4
+
+/* Reply frame types, the ACK payload carries the answer of the request */
+#define FRAME_ACK				0x06
+#define FRAME_NACK				0x15
+
+/* Number of times a request is sent again after being NACKed or not answered */
+#define FRAME_MAX_RETRIES		3
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 type;
+	uint8 length;
+	uint8 payload[FRAME_MAX_PAYLOAD];
+} FRAME_Type;
+
+typedef enum
+{
+	FRAME_INCOMPLETE, FRAME_RECEIVED, FRAME_CORRUPTED
+} FRAME_StatusType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Send one frame with the required type and payload through UART.
+ */
+void FRAME_send(uint8 type, const uint8 *payload, uint8 length);
+
+/*
+ * Description :
+ * Feed one received byte to the frame parser.
+ * Function output: FRAME_RECEIVED when a valid frame is completed in frame,
+ *                  FRAME_CORRUPTED when a frame failed its CRC or length check,
+ *                  otherwise FRAME_INCOMPLETE.
+ */
+FRAME_StatusType FRAME_parseByte(uint8 byte, FRAME_Type *frame);
+
+/*
+ * Description :
+ * Consume the bytes already received by UART without blocking.
+ * A corrupted frame is answered by a NACK frame so the sender repeats it.
+ * Function output: FRAME_RECEIVED when a valid frame is completed in frame.
+ */
+FRAME_StatusType FRAME_poll(FRAME_Type *frame);
+
+#endif /* FRAME_H_ */
@@ -0,0 +1,135 @@
+/*
+ ============================================================================
+ Name        : prof.c
+ Author      : Ahmed Ali
+ Module Name : PROF
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the execution time probes of the hot paths
+ ============================================================================
+ */
+
+#include "prof.h"
+
+#if (PROF_ENABLE == 1)
+
+#include "../../MCAL/TIMER1/timer1_service.h"
+#include "../../MCAL/GPIO/gpio_private.h" /* to use the declaration of SREG register */
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint32 start;
+	uint32 total;
+	uint32 count;
+	uint16 min;
+	uint16 max;
+} PROF_ProbeType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The probe table, the probes which end in an ISR are updated by that ISR */
+static volatile PROF_ProbeType g_probes[PROF_NUM_PROBES];
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Copy the probe then clear it, with the interrupts disabled so an ISR can't
+ * update it in between.
+ */
+static void PROF_takeProbe(uint8 id, PROF_ProbeType *a_probe);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Take the start time of the probe, it may be called from an ISR.
+ * The TIMER1 service must be initialized before it.
+ */
+void PROF_begin(uint8 id)
+{
+	g_probes[id].start = Timer1_getMicros();
+}
+
+/*
+ * Description :
+ * Add the time since PROF_begin of the probe to its minimum, maximum,
+ * total and count, it may be called from an ISR.
+ */
+void PROF_end(uint8 id)
+{
+	uint32 time = Timer1_getMicros() - g_probes[id].start;
+
+	/* the minimum and the maximum are kept in 16 bits, up to 65 ms */
+	if (time > 0xFFFF)
+	{
+		time = 0xFFFF;
+	}
+	if ((g_probes[id].count == 0) || (time < g_probes[id].min))
+	{
+		g_probes[id].min = (uint16) time;
+	}
+	if (time > g_probes[id].max)
+	{
+		g_probes[id].max = (uint16) time;
+	}
+	g_probes[id].total += time;
+	g_probes[id].count++;
+}
+
+/*
+ * Description :
+ * Write the probe in the PROF_PROBE_FRAME_SIZE bytes of the record then clear it.
+ */
+void PROF_readProbe(uint8 id, uint8 record[])
+{
+	uint16 count;
+	uint16 average;
+	PROF_ProbeType probe;
+
+	PROF_takeProbe(id, &probe);
+	count = (probe.count > 0xFFFF) ? 0xFFFF : (uint16) probe.count;
+	average = (probe.count == 0) ? 0 : (uint16) (probe.total / probe.count);
+	record[0] = (uint8) count;
+	record[1] = (uint8) (count >> 8);
+	record[2] = (uint8) probe.min;
+	record[3] = (uint8) (probe.min >> 8);
+	record[4] = (uint8) probe.max;
+	record[5] = (uint8) (probe.max >> 8);
+	record[6] = (uint8) average;
+	record[7] = (uint8) (average >> 8);
+}
+
+/*
+ * Description :
+ * Copy the probe then clear it, with the interrupts disabled so an ISR can't
+ * update it in between.
+ */
+static void PROF_takeProbe(uint8 id, PROF_ProbeType *a_probe)
+{
+	uint8 interruptState;
+
+	interruptState = SREG_REG.Bits.I_Bit;
+	SREG_REG.Bits.I_Bit = 0;
+	a_probe->total = g_probes[id].total;
+	a_probe->count = g_probes[id].count;
+	a_probe->min = g_probes[id].min;
+	a_probe->max = g_probes[id].max;
+	g_probes[id].total = 0;
+	g_probes[id].count = 0;
+	g_probes[id].min = 0;
+	g_probes[id].max = 0;
+	SREG_REG.Bits.I_Bit = interruptState;
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,89 @@
+/*
+ ============================================================================
+ Name        : prof.h
+ Author      : Ahmed Ali
+ Module Name : PROF
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the execution time probes of the hot paths
+ ============================================================================
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Set to 1 to build the probes in, with 0 PROF_BEGIN and PROF_END are
+ * empty and the module adds no code and no RAM.
+ */
+#define PROF_ENABLE					0
+
+/*
+ * The admin menu shows the probe table of this ECU, then the table of control
+ * ECU which it asks by PROF_QUERY. Control ECU answers by one probe frame per
+ * probe in the order of their ids then an ACK frame with the number of probes,
+ * no probes when they are not built in. A probe of both tables is:
+ * | COUNT (2 bytes) | MIN (2 bytes) | MAX (2 bytes) | AVERAGE (2 bytes) |
+ * The times are in microseconds (TIMER1 counts, 8 CPU cycles each at 8 MHz),
+ * the count stops at 0xFFFF. A table is cleared after it is read.
+ */
+#define PROF_QUERY					0x50
+#define PROF_PROBE_FRAME			0x52
+#define PROF_PROBE_FRAME_SIZE		8
+
+/* Ids of the probes */
+#define PROF_LCD_SEND_COMMAND		0
+#define PROF_KEYPAD_SCAN			1 /* the scan of one keypad row */
+#define PROF_UART_WRITE				2
+#define PROF_UART_READ				3
+#define PROF_NUM_PROBES				4
+
+#if (PROF_ENABLE == 1)
+
+/* Start the measure of the probe */
+#define PROF_BEGIN(id)				PROF_begin(id)
+/* End the measure of the probe and add it to the probe table */
+#define PROF_END(id)				PROF_end(id)
+
+#else
+
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (PROF_ENABLE == 1)
+
+/*
+ * Description :
+ * Take the start time of the probe, it may be called from an ISR.
+ * The TIMER1 service must be initialized before it.
+ */
+void PROF_begin(uint8 id);
+
+/*
+ * Description :
+ * Add the time since PROF_begin of the probe to its minimum, maximum,
+ * total and count, it may be called from an ISR.
+ */
+void PROF_end(uint8 id);
+
+/*
+ * Description :
+ * Write the probe in the PROF_PROBE_FRAME_SIZE bytes of the record then clear it.
+ */
+void PROF_readProbe(uint8 id, uint8 record[]);
+
+#endif
+
+#endif /* PROF_H_ */
@@ -10,42 +10,178 @@
 
 #include "HAL/BUZZER/buzzer.h" /* to use buzzer functions */
 #include "HAL/MOTOR/motor.h" /* to use motor functions */
-#include "HAL/EXTERNAL_EEPROM/external_eeprom.h" /* to use EEPROM functions */
 #include "MCAL/UART/uart.h"/* to use UART functions */
-#include "MCAL/TIMER1/timer1.h" /* to use TIMER1 init function */
+#include "SERVICE/FRAME/frame.h" /* to use frames over UART */
+#include "SERVICE/SCHEDULER/scheduler.h" /* to use the tasks and events */
+#include "SERVICE/CREDENTIAL/credential.h" /* to use the password storage */
+#include "HAL/EXTERNAL_EEPROM/eeprom_store.h" /* to use the EEPROM record store */
+#include "SERVICE/AUDIT/audit.h" /* to use the audit event log */
+#include "SERVICE/LOCKOUT/lockout.h" /* to use the lockout after the wrong passwords */
+#include "SERVICE/PROF/prof.h" /* to use the execution time probes */
+#include "MCAL/TIMER1/timer1_service.h" /* to use the software timers of TIMER1 */
 #include "MCAL/I2C/twi.h" /* to use TWI init function */
 #include "MCAL/TIMER0_PWM/timer0_pwm.h" /* to use PWM TIMER0 init function */
 #include "MCAL/GPIO/gpio_private.h" /* to use the declaration of SREG register */
 #include "LIB/std_types.h" /* to use standard types */
-#include <util/delay.h> /* to use delay functions */
-
-/*******************************************************************************
- *                           Global Variables                                  *
- *******************************************************************************/
-
-static volatile uint8 g_ticks = 0;
 
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
 
-#define EEPROM_FIRST_ADDRESS_VALUE  0x0015
-#define START_COMMNUCATION 			0x15
-#define CTC_VALUE_FOR_ONE_SECOND 	31250
-#define CTC_INITIAL_VALUE 			0
+/*
+ * the 24C16 EEPROM is rated for fast mode (400 kHz), but the TWI master at
+ * 8 MHz can't go above F_CPU / 36 with TWBR >= 10, 200 kHz gives TWBR = 12
+ */
+#define CONTROL_TWI_BIT_RATE        200000UL
+
+#if !TWI_BIT_RATE_IS_VALID(CONTROL_TWI_BIT_RATE)
+#error "The TWI bit rate can't be generated from F_CPU"
+#endif
 #define PASSWORD_CORRECT            0xAA
 #define PASSWORD_INCORRECT          0xBB
+/* the password can't be checked now, it is not counted as a wrong password */
+#define PASSWORD_UNCHECKED          0x9C
 #define CRETAE_PASSWORD_ACTION      0xCC
 #define CHECK_PASSWORD_ACTION       0xDD
 #define CHANGE_PASSWORD_MODE        0xEE
 #define OPEN_DOOR_MODE              0xFF
+/* the check of the admin menu, a correct password of another user is answered by NOT_ADMIN */
+#define ADMIN_MODE                  0xAD
+#define NOT_ADMIN                   0x9A
 #define BUZZER_ON                   0x68
-#define BUZZER_OFF                  0x69
-#define PASSWORD_LENGTH				5
+#define GET_DISPATCH_LATENCY        0x4C
+#define GET_VERIFY_TIME             0x54
+#define AUDIT_QUERY                 0x51
+#define AUDIT_EVENT_FRAME           0x45
+#define USER_ADD                    0x55
+#define USER_REVOKE                 0x56
+/* request of the admin password state, answered by TRUE if it is set */
+#define GET_PASSWORD_STATE          0x53
+
+#if (AUDIT_EVENT_SIZE > FRAME_MAX_PAYLOAD)
+#error "An audit event doesn't fit in one frame"
+#endif
+
+#if ((EEPROM_STORE_FIRST_PAGE + EEPROM_STORE_NUM_PAGES) > AUDIT_EEPROM_FIRST_PAGE)
+#error "The record store and the audit log overlap in the EEPROM"
+#endif
+#define PASSWORD_LENGTH				CREDENTIAL_PASSWORD_LENGTH
 #define DOOR_UNLOKING_PERIOD        15
 #define DOOR_LOKING_PERIOD          15
 #define DOOR_HOLD_PERIOD            3
 #define BUZZER_ACTIVE_PERIOD		60
+#define ONE_SECOND_IN_MS			1000
+
+/*
+ * HMI ECU sends a request again when its reply doesn't come in time, the same
+ * password request in this period after its reply is answered by that reply again
+ */
+#define REQUEST_REPEAT_PERIOD_MS	2000
+
+/*
+ * a scan of the EEPROM which fails on a read is tried again at once up to
+ * EEPROM_SCAN_TRIES times, then once per EEPROM_SCAN_RETRY_PERIOD_MS from the main loop
+ */
+#define EEPROM_SCAN_TRIES			3
+#define EEPROM_SCAN_RETRY_PERIOD_MS	1000
+
+/* Events of the tasks */
+#define EVENT_FRAME_RECEIVED		0
+#define EVENT_EEPROM_SAVED			1
+#define EVENT_DOOR_OPEN				2
+#define EVENT_DOOR_TIMER_EXPIRED	3
+#define EVENT_ALARM_START			4
+#define EVENT_ALARM_TIMER_EXPIRED	5
+#define EVENT_EEPROM_SAVE			6
+#define EVENT_AUDIT_DUMP			7
+
+/* Types of the audit events */
+#define AUDIT_POWER_ON				0
+#define AUDIT_DOOR_UNLOCKED			1
+#define AUDIT_WRONG_PASSWORD		2
+#define AUDIT_LOCKOUT				3
+#define AUDIT_PASSWORD_SAVED		4
+#define AUDIT_USER_ADDED			5
+#define AUDIT_USER_REVOKED			6
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	DOOR_LOCKED, DOOR_UNLOCKING, DOOR_HOLDING, DOOR_LOCKING
+} DOOR_StateType;
+
+typedef enum
+{
+	ALARM_OFF, ALARM_ON
+} ALARM_StateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* ids of the tasks */
+static uint8 g_linkTask;
+static uint8 g_doorTask;
+static uint8 g_alarmTask;
+static uint8 g_eepromTask;
+static uint8 g_auditTask;
+
+/* the one-shot software timers of the door periods and the buzzer period */
+static uint8 g_doorTimerId;
+static uint8 g_alarmTimerId;
+
+/*
+ * the last request frame received from HMI ECU, no new frame is taken
+ * from UART until this one is answered
+ */
+static FRAME_Type g_request;
+static uint8 g_requestPending = FALSE;
+
+/*
+ * the slot whose password is saved by the next create password frame, it is the
+ * admin on the first start or the user who checked the password in change password mode
+ */
+static uint8 g_passwordSlot = CREDENTIAL_ADMIN_SLOT;
+
+/* TRUE if the last request checked the password of the admin */
+static uint8 g_adminChecked = FALSE;
+
+/* TRUE if the last request checked a password in change password mode */
+static uint8 g_changeChecked = FALSE;
+
+/*
+ * the last reply frame with its request and its time, it is sent again when
+ * HMI ECU NACKs it as corrupted or sends the same request again
+ */
+static uint8 g_reply[FRAME_MAX_PAYLOAD];
+static uint8 g_replyLength = 0;
+static FRAME_Type g_answeredRequest;
+static uint32 g_replyTime;
+
+/* the worst time of a password check in microseconds */
+static uint16 g_maxVerifyTime = 0;
+
+/*
+ * the result of the last EEPROM save when it didn't fit the queue of the link task
+ * in the TWI ISR, it is posted again from the main loop
+ */
+static volatile uint8 g_savedResult;
+static volatile uint8 g_savedResultWaiting = FALSE;
+
+/* the start of the buzzer of a lockout when it didn't fit the queue, posted again from the main loop */
+static uint8 g_alarmStartWaiting = FALSE;
+
+/* number of events sent by the running audit dump */
+static uint16 g_auditDumpCount;
+
+/* TIMER1 milliseconds of the last scan tried from the main loop */
+static uint32 g_lastScanTime = 0;
+
+static DOOR_StateType g_doorState = DOOR_LOCKED;
+static ALARM_StateType g_alarmState = ALARM_OFF;
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -53,53 +189,156 @@ static volatile uint8 g_ticks = 0;
 
 /*
  * Description :
- * Function to save the received password through UART to EEPROM.
+ * Task which handles the request frames of HMI ECU and answers them.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void linkTask(const SCHEDULER_EventType *event);
+
+/*
+ * Description :
+ * Task which runs the state machine of the door (unlocking, holding and locking).
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void doorTask(const SCHEDULER_EventType *event);
+
+/*
+ * Description :
+ * Task which runs the state machine of the buzzer after 3 wrong tries.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void alarmTask(const SCHEDULER_EventType *event);
+
+/*
+ * Description :
+ * Task which saves the password or the user of the pending request frame to EEPROM.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void eepromTask(const SCHEDULER_EventType *event);
+
+/*
+ * Description :
+ * Task which streams the audit log to HMI ECU, one event frame per event.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void auditTask(const SCHEDULER_EventType *event);
+
+/*
+ * Description :
+ * This is the call back function which will be executed when the password write is completed.
+ * Function input:  the result of the write (SUCCESS or ERROR).
+ * Function output: void.
+ */
+void passwordSaved(uint8 result);
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by one ACK frame.
+ * Function input:  the reply byte carried by the ACK frame.
+ * Function output: void.
+ */
+void sendReplyToHMI(uint8 reply);
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by one ACK frame and keep
+ * the reply, so it can be sent again.
+ * Function input:  the payload of the ACK frame and its length.
+ * Function output: void.
+ */
+void sendReplyFrameToHMI(const uint8 reply[], uint8 length);
+
+/*
+ * Description :
+ * Function to tell if the request is a password request sent again by HMI ECU
+ * because the reply of its first copy was lost.
  * Function input:  void.
+ * Function output: uint8 flag which is TRUE if the request is answered already.
+ */
+uint8 isRepeatedRequest(void);
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by a BUZZER_ON reply with the lockout time.
+ * Function input:  the remaining seconds of the lockout.
  * Function output: void.
  */
-void savePasswordToEEPROM(void);
+void sendLockoutToHMI(uint16 seconds);
 
 /*
  * Description :
- * Function to receive password through UART and check
- * it with the one in EEPROM .
+ * This is the call back function which will be executed when the door timer expires.
  * Function input:  void.
- * Function output: uint8 flag which indicate password correct.
+ * Function output: void.
  */
-uint8 recivePasswordAndCheck(void);
+void doorTimerExpired(void);
 
 /*
  * Description :
- * Function to count a number of seconds which passed to it.
- * Function input:  number of seconds.
+ * This is the call back function which will be executed when the buzzer timer expires.
+ * Function input:  void.
  * Function output: void.
  */
-void timer1DelaySecond(uint8 n);
+void alarmTimerExpired(void);
 
 /*
  * Description :
- * This is the call back function which will be executed each interrupt in timer1.
+ * Function to scan the EEPROM record store and the audit log again after a
+ * failed scan, at most once per EEPROM_SCAN_RETRY_PERIOD_MS.
  * Function input:  void.
  * Function output: void.
  */
-void countOneSecond(void);
+void retryEepromScan(void);
 
 int main(void)
 {
+	uint8 scanTries;
+
 	/* Configuration and initialization functions */
 	/* enable global interrupt */
 	SREG_REG.Bits.I_Bit = 1;
-	uint8 flag, action, mode;
 	/* select the configuration of UART */
 	UART_ConfigType UART_config =
 	{ ASYNCHRONOUS, DISABLED_PARITY, STOP_1_BIT, DATA_8_BIT, BAUD_RATE_9600 };
 
 	/* select the configuration of TWI */
 	TWI_ConfigType TWI_config =
-	{ MC_ADDRESS, TWI_PRESCALER_1 };
+	{ MC_ADDRESS, CONTROL_TWI_BIT_RATE };
 
 	/* passing the configuration to initialization function of TWI */
-	TWI_init(&TWI_config);
+	if (TWI_init(&TWI_config) == FALSE)
+	{
+		/*
+		 * without the EEPROM no password can be checked, keep the door locked
+		 * and sound the buzzer until the ECU is repaired
+		 */
+		Buzzer_init();
+		Buzzer_on();
+		while (1)
+		{
+		}
+	}
+	/*
+	 * build the RAM index of the EEPROM record store by one scan, the records
+	 * can't be read or written until a scan is completed
+	 */
+	for (scanTries = 1;
+			(EEPROM_storeInit() == ERROR) && (scanTries < EEPROM_SCAN_TRIES);
+			scanTries++)
+	{
+	}
+	/* find the next page of the audit log by one scan, the events wait in RAM until it is completed */
+	for (scanTries = 1;
+			(AUDIT_init() == ERROR) && (scanTries < EEPROM_SCAN_TRIES);
+			scanTries++)
+	{
+	}
+	/* load the tags of the user table from the record store to its RAM index once */
+	CREDENTIAL_init();
 	/* passing the configuration to initialization function of UART */
 	UART_init(&UART_config);
 	/* call the initialization function of PWM TIMER0 */
@@ -108,204 +347,616 @@ int main(void)
 	Buzzer_init();
 	/* call the initialization function of DC-MOTOR */
 	DcMotor_Init();
+	/* start the 1 ms tick of TIMER1 and reserve the software timers */
+	Timer1_serviceInit();
+	g_doorTimerId = Timer1_createTimer(TIMER1_ONE_SHOT, doorTimerExpired);
+	g_alarmTimerId = Timer1_createTimer(TIMER1_ONE_SHOT, alarmTimerExpired);
+	AUDIT_log(AUDIT_POWER_ON);
+	/* a lockout which was running before the reset starts again */
+	LOCKOUT_init();
+
+	/*
+	 * the requests of HMI ECU have the highest priority, so they are answered
+	 * in a bounded time while the door or the buzzer is running.
+	 * The worst number of waiting events of each priority is below the queue size:
+	 * high 1 (one request or its save result at a time), medium 4 (door open,
+	 * door timer, alarm start, alarm timer) and low 2 (one save, one audit dump step)
+	 */
+	g_linkTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_HIGH, linkTask);
+	g_doorTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_MEDIUM, doorTask);
+	g_alarmTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_MEDIUM, alarmTask);
+	g_eepromTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_LOW, eepromTask);
+	g_auditTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_LOW, auditTask);
+
 	while (1)
 	{
-		/* receive the action from HMI ECU through UART */
-		action = UART_recieveByte();
-		/* if the action is create password, then receive and save it */
-		if (action == CRETAE_PASSWORD_ACTION)
+		/*
+		 * take the next request frame from UART when the last one is answered,
+		 * a request which doesn't fit the queue is sent again by HMI ECU after its timeout
+		 */
+		if ((g_requestPending == FALSE)
+				&& (FRAME_poll(&g_request) == FRAME_RECEIVED))
+		{
+			g_requestPending = SCHEDULER_post(g_linkTask, EVENT_FRAME_RECEIVED, 0);
+		}
+		/* post again the save result which didn't fit the queue in the TWI ISR */
+		if ((g_savedResultWaiting == TRUE)
+				&& (SCHEDULER_post(g_linkTask, EVENT_EEPROM_SAVED, g_savedResult) == TRUE))
+		{
+			g_savedResultWaiting = FALSE;
+		}
+		/* post again the start of the buzzer which didn't fit the queue */
+		if ((g_alarmStartWaiting == TRUE)
+				&& (SCHEDULER_post(g_alarmTask, EVENT_ALARM_START, 0) == TRUE))
+		{
+			g_alarmStartWaiting = FALSE;
+		}
+		/* run one event of the tasks */
+		SCHEDULER_dispatch();
+		/* write the waiting audit events to EEPROM in page batches */
+		AUDIT_poll();
+		/* save the changed lockout counters and end the lockout on time */
+		LOCKOUT_poll();
+		/* scan the EEPROM record store and the audit log again after a failed scan */
+		retryEepromScan();
+	}
+}
+
+/*******************************************************************************
+ *                           Functions Definitions                            *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Task which handles the request frames of HMI ECU and answers them.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void linkTask(const SCHEDULER_EventType *event)
+{
+	uint16 latency;
+	uint8 reply[2];
+	uint8 slot;
+	uint8 adminChecked;
+	uint8 changeChecked;
+	uint8 correct;
+	uint32 verifyTime;
+	uint16 lockoutTime;
+
+	if (event->signal == EVENT_EEPROM_SAVED)
+	{
+		if (event->param == SUCCESS)
 		{
-			savePasswordToEEPROM();
+			AUDIT_log((g_request.type == USER_ADD) ? AUDIT_USER_ADDED :
+					(g_request.type == USER_REVOKE) ? AUDIT_USER_REVOKED :
+							AUDIT_PASSWORD_SAVED);
 		}
-		if (action == CHECK_PASSWORD_ACTION)
+		/* tell HMI ECU if the password is saved */
+		sendReplyToHMI((event->param == SUCCESS) ? PASSWORD_CORRECT : PASSWORD_INCORRECT);
+		g_requestPending = FALSE;
+		return;
+	}
+
+	/* the last reply is corrupted on the wire or lost, send it again */
+	if ((g_request.type == FRAME_NACK) || (isRepeatedRequest() == TRUE))
+	{
+		FRAME_send(FRAME_ACK, g_reply, g_replyLength);
+		g_requestPending = FALSE;
+		return;
+	}
+
+	/*
+	 * the users can be changed only by the request after the admin password check,
+	 * and a password only by the request after its check in change password mode
+	 */
+	adminChecked = g_adminChecked;
+	g_adminChecked = FALSE;
+	changeChecked = g_changeChecked;
+	g_changeChecked = FALSE;
+
+	/*
+	 * if the action is create password, then save the password carried by the frame,
+	 * without a checked password it is accepted only for the admin on the first start
+	 */
+	if ((g_request.type == CRETAE_PASSWORD_ACTION)
+			&& (g_request.length == PASSWORD_LENGTH))
+	{
+		if (changeChecked == FALSE)
+		{
+			g_passwordSlot = CREDENTIAL_ADMIN_SLOT;
+		}
+		if ((changeChecked == TRUE)
+				|| (CREDENTIAL_isSlotFree(CREDENTIAL_ADMIN_SLOT) == TRUE))
+		{
+			/* the request stays pending until the EEPROM task saves the password */
+			if (SCHEDULER_post(g_eepromTask, EVENT_EEPROM_SAVE, 0) == TRUE)
+			{
+				return;
+			}
+		}
+		sendReplyToHMI(PASSWORD_INCORRECT);
+	}
+	/* HMI ECU asks at its start if it should create the admin password */
+	else if (g_request.type == GET_PASSWORD_STATE)
+	{
+		sendReplyToHMI(
+				(CREDENTIAL_isSlotFree(CREDENTIAL_ADMIN_SLOT) == TRUE) ? FALSE : TRUE);
+	}
+	/*
+	 * if the action is add user or revoke user, the frame carries the slot
+	 * followed by the password of the new user
+	 */
+	else if (((g_request.type == USER_ADD)
+			&& (g_request.length == PASSWORD_LENGTH + 1))
+			|| ((g_request.type == USER_REVOKE) && (g_request.length == 1)))
+	{
+		if (adminChecked == TRUE)
 		{
-			/* the action is check password */
-			/* receive the mode from HMI ECU through UART */
-			mode = UART_recieveByte();
-			if (mode == OPEN_DOOR_MODE)
+			if (SCHEDULER_post(g_eepromTask, EVENT_EEPROM_SAVE, 0) == TRUE)
 			{
-				/* mode is open door mode */
-				while (1)
+				return;
+			}
+		}
+		sendReplyToHMI(PASSWORD_INCORRECT);
+	}
+	/*
+	 * if the action is check password, the frame carries the mode
+	 * followed by the password
+	 */
+	else if ((g_request.type == CHECK_PASSWORD_ACTION)
+			&& (g_request.length == PASSWORD_LENGTH + 1))
+	{
+		/*
+		 * the wrong passwords before the reset can't be read from the EEPROM,
+		 * a check could pass the lockout so it is not done
+		 */
+		if (LOCKOUT_isKnown() == FALSE)
+		{
+			sendReplyToHMI(PASSWORD_UNCHECKED);
+			g_requestPending = FALSE;
+			return;
+		}
+		/* during a lockout the password is refused at once without checking it */
+		lockoutTime = LOCKOUT_getRemainingTime();
+		if (lockoutTime != 0)
+		{
+			sendLockoutToHMI(lockoutTime);
+			g_requestPending = FALSE;
+			return;
+		}
+		/* the password check does the same work for any password, its worst time is kept */
+		verifyTime = Timer1_getMicros();
+		correct = CREDENTIAL_check(&g_request.payload[1], &slot);
+		verifyTime = Timer1_getMicros() - verifyTime;
+		if (verifyTime > g_maxVerifyTime)
+		{
+			g_maxVerifyTime = (uint16) verifyTime;
+		}
+		if (correct == CREDENTIAL_UNAVAILABLE)
+		{
+			/* the user table can't be read from the EEPROM, the password is not known wrong */
+			sendReplyToHMI(PASSWORD_UNCHECKED);
+		}
+		else if (correct == FALSE)
+		{
+			AUDIT_log(AUDIT_WRONG_PASSWORD);
+			lockoutTime = LOCKOUT_recordFailure();
+			if (lockoutTime != 0)
+			{
+				/* the wrong passwords reached the limit, start the buzzer with the lockout */
+				sendLockoutToHMI(lockoutTime);
+				if (SCHEDULER_post(g_alarmTask, EVENT_ALARM_START, 0) == FALSE)
 				{
-					/* receive the password and check if equal to the one in EEPROM */
-					flag = recivePasswordAndCheck();
-					if (flag == TRUE)
-					{
-						/* the password is correct and send to HMI that password is correct */
-						UART_sendByte(PASSWORD_CORRECT);
-						/* turn on motor at max speed with clock wise direction */
-						DcMotor_Rotate(CLOCK_Wise, MOTOR_MAX_SPEED);
-						/* waiting for 15 seconds until the door is unlocking */
-						timer1DelaySecond(DOOR_UNLOKING_PERIOD);
-						/* hold the motor */
-						DcMotor_Rotate(STOP, MOTOR_MAX_SPEED);
-						/* waiting for 3 seconds the hold period of the door */
-						timer1DelaySecond(DOOR_HOLD_PERIOD);
-						/* turn on motor at max speed with anti clock wise direction */
-						DcMotor_Rotate(ANTI_CLOCK_WISE, MOTOR_MAX_SPEED);
-						/* waiting for 15 seconds until the door is locking  */
-						timer1DelaySecond(DOOR_LOKING_PERIOD);
-						/* stop the dc motor */
-						DcMotor_Rotate(STOP, 0);
-						break;
-					}
-					else
-					{
-						/* the password is incorrect and send to HMI that password is incorrect */
-						UART_sendByte(PASSWORD_INCORRECT);
-						/* wait for replay from HMI ECU to take an action of incorrect password */
-						if (UART_recieveByte() == BUZZER_ON)
-						{
-							/* if receiving buzzer on byte, that mean the 3 tries is made */
-							/* turn on the buzzer */
-							Buzzer_on();
-							/* waiting for 1 minute */
-							timer1DelaySecond(BUZZER_ACTIVE_PERIOD);
-							/* turn off the buzzer */
-							Buzzer_off();
-							break;
-						}
-						else
-						{
-							continue;
-						}
-					}
+					/* the lockout is already recorded, the buzzer starts from the main loop */
+					g_alarmStartWaiting = TRUE;
 				}
+				AUDIT_log(AUDIT_LOCKOUT);
 			}
-			else if (mode == CHANGE_PASSWORD_MODE)
+			else
 			{
-				/* mode is change password mode */
-				while (1)
+				/* the password is incorrect and send to HMI that password is incorrect */
+				sendReplyToHMI(PASSWORD_INCORRECT);
+			}
+		}
+		else
+		{
+			LOCKOUT_recordSuccess();
+			/*
+			 * the password is correct and send to HMI that password is correct,
+			 * in change password mode the new password will come in a create password frame
+			 */
+			if (g_request.payload[0] == OPEN_DOOR_MODE)
+			{
+				/*
+				 * the door is unlocked only if the door task takes the event, else
+				 * HMI ECU shows that the password can't be checked so the user tries again
+				 */
+				if (SCHEDULER_post(g_doorTask, EVENT_DOOR_OPEN, 0) == TRUE)
 				{
-					/* receive the password and check if equal to the one in EEPROM */
-					flag = recivePasswordAndCheck();
-
-					if (flag == TRUE)
-					{
-						/* the password is correct and send to HMI that password is correct */
-						UART_sendByte(PASSWORD_CORRECT);
-						/* start the action of change password */
-						savePasswordToEEPROM();
-						break;
-					}
-					else
-					{
-						/* the password is incorrect and send to HMI that password is incorrect */
-						UART_sendByte(PASSWORD_INCORRECT);
-						if (UART_recieveByte() == BUZZER_ON)
-						{
-							/* if receiving buzzer on byte, that mean the 3 tries is made */
-							/* turn on the buzzer */
-							Buzzer_on();
-							/* waiting for 1 minute */
-							timer1DelaySecond(BUZZER_ACTIVE_PERIOD);
-							/* turn off the buzzer */
-							Buzzer_off();
-							break;
-						}
-						else
-						{
-							continue;
-						}
-					}
+					sendReplyToHMI(PASSWORD_CORRECT);
+					AUDIT_log(AUDIT_DOOR_UNLOCKED);
 				}
+				else
+				{
+					sendReplyToHMI(PASSWORD_UNCHECKED);
+				}
+			}
+			else
+			{
+				sendReplyToHMI(((g_request.payload[0] == ADMIN_MODE)
+						&& (slot != CREDENTIAL_ADMIN_SLOT)) ? NOT_ADMIN : PASSWORD_CORRECT);
 			}
+			if (g_request.payload[0] == CHANGE_PASSWORD_MODE)
+			{
+				g_passwordSlot = slot;
+				g_changeChecked = TRUE;
+			}
+			g_adminChecked = (slot == CREDENTIAL_ADMIN_SLOT) ? TRUE : FALSE;
+		}
+	}
+	/* diagnostic request of the worst event dispatch latency in microseconds */
+	else if (g_request.type == GET_DISPATCH_LATENCY)
+	{
+		latency = SCHEDULER_getMaxLatency();
+		reply[0] = (uint8) latency;
+		reply[1] = (uint8) (latency >> 8);
+		sendReplyFrameToHMI(reply, 2);
+		SCHEDULER_resetMaxLatency();
+	}
+	/* diagnostic request of the worst password check time in microseconds */
+	else if (g_request.type == GET_VERIFY_TIME)
+	{
+		reply[0] = (uint8) g_maxVerifyTime;
+		reply[1] = (uint8) (g_maxVerifyTime >> 8);
+		sendReplyFrameToHMI(reply, 2);
+		g_maxVerifyTime = 0;
+	}
+	/*
+	 * diagnostic request of the audit log, the request stays pending until
+	 * the audit task sends all the events and the closing ACK frame
+	 */
+	else if (g_request.type == AUDIT_QUERY)
+	{
+		AUDIT_dumpStart();
+		g_auditDumpCount = 0;
+		if (SCHEDULER_post(g_auditTask, EVENT_AUDIT_DUMP, 0) == TRUE)
+		{
+			return;
 		}
+		AUDIT_dumpStop();
+		reply[0] = 0;
+		reply[1] = 0;
+		sendReplyFrameToHMI(reply, 2);
 	}
+	/* diagnostic request of the execution times of the probes */
+	else if (g_request.type == PROF_QUERY)
+	{
+		/* the closing ACK frame carries the number of the sent probes */
+#if (PROF_ENABLE == 1)
+		PROF_sendTable();
+		reply[0] = PROF_NUM_PROBES;
+#else
+		reply[0] = 0;
+#endif
+		sendReplyFrameToHMI(reply, 1);
+	}
+	g_requestPending = FALSE;
 }
 
-/*******************************************************************************
- *                           Functions Definitions                            *
- *******************************************************************************/
+/*
+ * Description :
+ * Task which runs the state machine of the door (unlocking, holding and locking).
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void doorTask(const SCHEDULER_EventType *event)
+{
+	switch (g_doorState)
+	{
+	case DOOR_LOCKED:
+		if (event->signal == EVENT_DOOR_OPEN)
+		{
+			/* turn on motor at max speed with clock wise direction */
+			DcMotor_Rotate(CLOCK_Wise, MOTOR_MAX_SPEED);
+			/* the door is unlocking for 15 seconds */
+			Timer1_startTimer(g_doorTimerId,
+					DOOR_UNLOKING_PERIOD * ONE_SECOND_IN_MS);
+			g_doorState = DOOR_UNLOCKING;
+		}
+		break;
+	case DOOR_UNLOCKING:
+		if (event->signal == EVENT_DOOR_TIMER_EXPIRED)
+		{
+			/* hold the motor */
+			DcMotor_Rotate(STOP, MOTOR_MAX_SPEED);
+			/* the door is held open for 3 seconds */
+			Timer1_startTimer(g_doorTimerId,
+					DOOR_HOLD_PERIOD * ONE_SECOND_IN_MS);
+			g_doorState = DOOR_HOLDING;
+		}
+		break;
+	case DOOR_HOLDING:
+		if (event->signal == EVENT_DOOR_TIMER_EXPIRED)
+		{
+			/* turn on motor at max speed with anti clock wise direction */
+			DcMotor_Rotate(ANTI_CLOCK_WISE, MOTOR_MAX_SPEED);
+			/* the door is locking for 15 seconds */
+			Timer1_startTimer(g_doorTimerId,
+					DOOR_LOKING_PERIOD * ONE_SECOND_IN_MS);
+			g_doorState = DOOR_LOCKING;
+		}
+		break;
+	case DOOR_LOCKING:
+		if (event->signal == EVENT_DOOR_TIMER_EXPIRED)
+		{
+			/* stop the dc motor */
+			DcMotor_Rotate(STOP, 0);
+			g_doorState = DOOR_LOCKED;
+		}
+		break;
+	}
+}
 
 /*
  * Description :
- * Function to save the received password through UART to EEPROM.
+ * Task which runs the state machine of the buzzer after 3 wrong tries.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void alarmTask(const SCHEDULER_EventType *event)
+{
+	switch (g_alarmState)
+	{
+	case ALARM_OFF:
+		if (event->signal == EVENT_ALARM_START)
+		{
+			/* turn on the buzzer for 1 minute */
+			Buzzer_on();
+			Timer1_startTimer(g_alarmTimerId,
+					(uint16) BUZZER_ACTIVE_PERIOD * ONE_SECOND_IN_MS);
+			g_alarmState = ALARM_ON;
+		}
+		break;
+	case ALARM_ON:
+		if (event->signal == EVENT_ALARM_TIMER_EXPIRED)
+		{
+			/* turn off the buzzer */
+			Buzzer_off();
+			g_alarmState = ALARM_OFF;
+		}
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Task which saves the password or the user of the pending request frame to EEPROM.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void eepromTask(const SCHEDULER_EventType *event)
+{
+	uint8 result;
+
+	if (event->signal != EVENT_EEPROM_SAVE)
+	{
+		return;
+	}
+	/*
+	 * the RAM index is updated at once and the record is written to EEPROM,
+	 * the link task is told by passwordSaved when the write cycle is completed
+	 */
+	if (g_request.type == USER_ADD)
+	{
+		result = CREDENTIAL_save(g_request.payload[0], &g_request.payload[1],
+				passwordSaved);
+	}
+	else if (g_request.type == USER_REVOKE)
+	{
+		result = CREDENTIAL_revoke(g_request.payload[0], passwordSaved);
+	}
+	else
+	{
+		result = CREDENTIAL_save(g_passwordSlot, g_request.payload, passwordSaved);
+	}
+
+	if (result == CREDENTIAL_BUSY)
+	{
+		/* the EEPROM is busy with another write, try again later */
+		if (SCHEDULER_post(g_eepromTask, EVENT_EEPROM_SAVE, 0) == FALSE)
+		{
+			passwordSaved(ERROR);
+		}
+	}
+	else if (result == ERROR)
+	{
+		/* the slot is not valid or the user table can't be read */
+		passwordSaved(ERROR);
+	}
+}
+
+/*
+ * Description :
+ * This is the call back function which will be executed when the password write is completed.
+ * Function input:  the result of the write (SUCCESS or ERROR).
+ * Function output: void.
+ */
+void passwordSaved(uint8 result)
+{
+	if (SCHEDULER_post(g_linkTask, EVENT_EEPROM_SAVED, result) == FALSE)
+	{
+		g_savedResult = result;
+		g_savedResultWaiting = TRUE;
+	}
+}
+
+/*
+ * Description :
+ * Task which streams the audit log to HMI ECU, one event frame per event.
+ * Function input:  the dispatched event.
+ * Function output: void.
+ */
+void auditTask(const SCHEDULER_EventType *event)
+{
+	uint8 auditEvent[AUDIT_EVENT_SIZE];
+	uint8 reply[2];
+
+	if (event->signal != EVENT_AUDIT_DUMP)
+	{
+		return;
+	}
+	/* one event per dispatch, so the other tasks run between the frames */
+	if (AUDIT_dumpNext(auditEvent) == TRUE)
+	{
+		if (SCHEDULER_post(g_auditTask, EVENT_AUDIT_DUMP, 0) == TRUE)
+		{
+			FRAME_send(AUDIT_EVENT_FRAME, auditEvent, AUDIT_EVENT_SIZE);
+			g_auditDumpCount++;
+			return;
+		}
+		/* the next step doesn't fit the queue, end the dump with the sent events */
+		AUDIT_dumpStop();
+	}
+	/* the closing ACK frame carries the number of the sent events */
+	reply[0] = (uint8) g_auditDumpCount;
+	reply[1] = (uint8) (g_auditDumpCount >> 8);
+	sendReplyFrameToHMI(reply, 2);
+	g_requestPending = FALSE;
+}
+
+/*
+ * Description :
+ * Function to scan the EEPROM record store and the audit log again after a
+ * failed scan, at most once per EEPROM_SCAN_RETRY_PERIOD_MS.
  * Function input:  void.
  * Function output: void.
  */
-void savePasswordToEEPROM(void)
+void retryEepromScan(void)
 {
-	uint8 i, temp;
-	i = 0;
-	while (i < PASSWORD_LENGTH)
-	{
-		/* revive password byte by byte through the UART */
-		temp = UART_recieveByte();
-		/* write byte by byte to the EEPROM */
-		EEPROM_writeByte(EEPROM_FIRST_ADDRESS_VALUE + i, temp);
-		_delay_ms(10);
-		i++;
-		/* send to HMI ECU that the control ECU is ready to receive the next byte */
-		UART_sendByte(START_COMMNUCATION);
+	if (((EEPROM_storeIsReady() == TRUE) && (AUDIT_isReady() == TRUE))
+			|| ((Timer1_getTicks() - g_lastScanTime) < EEPROM_SCAN_RETRY_PERIOD_MS))
+	{
+		return;
+	}
+	g_lastScanTime = Timer1_getTicks();
+	if (EEPROM_storeIsReady() == FALSE)
+	{
+		EEPROM_storeInit();
 	}
+	if (AUDIT_isReady() == FALSE)
+	{
+		AUDIT_init();
+	}
+}
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by one ACK frame.
+ * Function input:  the reply byte carried by the ACK frame.
+ * Function output: void.
+ */
+void sendReplyToHMI(uint8 reply)
+{
+	sendReplyFrameToHMI(&reply, 1);
+}
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by one ACK frame and keep
+ * the reply, so it can be sent again.
+ * Function input:  the payload of the ACK frame and its length.
+ * Function output: void.
+ */
+void sendReplyFrameToHMI(const uint8 reply[], uint8 length)
+{
+	uint8 i;
+
+	for (i = 0; i < length; i++)
+	{
+		g_reply[i] = reply[i];
+	}
+	g_replyLength = length;
+	g_answeredRequest = g_request;
+	g_replyTime = Timer1_getTicks();
+	FRAME_send(FRAME_ACK, reply, length);
 }
 
 /*
  * Description :
- * Function to receive password through UART and check
- * it with the one in EEPROM .
+ * Function to tell if the request is a password request sent again by HMI ECU
+ * because the reply of its first copy was lost.
  * Function input:  void.
- * Function output: uint8 flag which indicate password correct.
+ * Function output: uint8 flag which is TRUE if the request is answered already.
  */
-uint8 recivePasswordAndCheck()
+uint8 isRepeatedRequest(void)
 {
-	uint8 i, temp, temp2, flag;
-	i = 0;
-	/* we suppose at first the password is correct */
-	flag = TRUE;
-	while (i < PASSWORD_LENGTH)
-	{
-		/* revive password byte by byte through the UART */
-		temp = UART_recieveByte();
-		/* read byte by byte from the EEPROM */
-		EEPROM_readByte(EEPROM_FIRST_ADDRESS_VALUE + i, &temp2);
-		/* compare the received byte with the byte in EEPROM */
-		if (temp != temp2)
+	uint8 i;
+
+	/*
+	 * only the requests which change the state are answered again, the others
+	 * are idempotent and they are handled again
+	 */
+	if (((g_request.type != CRETAE_PASSWORD_ACTION)
+			&& (g_request.type != CHECK_PASSWORD_ACTION)
+			&& (g_request.type != USER_ADD) && (g_request.type != USER_REVOKE))
+			|| (g_request.type != g_answeredRequest.type)
+			|| (g_request.length != g_answeredRequest.length)
+			|| ((Timer1_getTicks() - g_replyTime) > REQUEST_REPEAT_PERIOD_MS))
+	{
+		return FALSE;
+	}
+	for (i = 0; i < g_request.length; i++)
+	{
+		if (g_request.payload[i] != g_answeredRequest.payload[i])
 		{
-			/* if not equal then two passwords are not equal and flag become false */
-			flag = FALSE;
+			return FALSE;
 		}
-		i++;
-		/* send to HMI ECU that the control ECU is ready to receive the next byte */
-		UART_sendByte(START_COMMNUCATION);
 	}
-	return flag;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Function to answer the request frame of HMI ECU by a BUZZER_ON reply with the lockout time.
+ * Function input:  the remaining seconds of the lockout.
+ * Function output: void.
+ */
+void sendLockoutToHMI(uint16 seconds)
+{
+	uint8 reply[3];
+
+	reply[0] = BUZZER_ON;
+	reply[1] = (uint8) seconds;
+	reply[2] = (uint8) (seconds >> 8);
+	sendReplyFrameToHMI(reply, 3);
 }
 
 /*
  * Description :
- * Function to count a number of seconds which passed to it.
- * Function input:  number of seconds.
+ * This is the call back function which will be executed when the door timer expires.
+ * Function input:  void.
  * Function output: void.
  */
-void timer1DelaySecond(uint8 n)
+void doorTimerExpired(void)
 {
-	/* select the configuration of TIMER1 */
-	TIMER1_ConfigType TIMER1_config =
-	{ CTC_INITIAL_VALUE, CTC_VALUE_FOR_ONE_SECOND, CTC_MODE,
-			TIMER1_PRESCALER_256 };
-	/* setup the call back function */
-	Timer1_setCallBack(countOneSecond);
-	/* passing the configuration to initialization function of TIMER1 */
-	Timer1_init(&TIMER1_config);
-	/* waiting for 15 seconds until the door is unlocking */
-	while (g_ticks < n)
-		;
-	/* reset the global variable of ticks */
-	g_ticks = 0;
-	/* stop the timer1 */
-	Timer1_deInit();
+	/* the event queue is full, try again at the next tick so the motor is stopped on time */
+	if (SCHEDULER_post(g_doorTask, EVENT_DOOR_TIMER_EXPIRED, 0) == FALSE)
+	{
+		Timer1_startTimer(g_doorTimerId, 1);
+	}
 }
 
 /*
  * Description :
- * This is the call back function which will be executed each interrupt in timer1.
+ * This is the call back function which will be executed when the buzzer timer expires.
  * Function input:  void.
  * Function output: void.
  */
-void countOneSecond()
+void alarmTimerExpired(void)
 {
-	/* this function is executed each 1 second as the configuration that passed to timer1*/
-	g_ticks++;
+	/* the event queue is full, try again at the next tick */
+	if (SCHEDULER_post(g_alarmTask, EVENT_ALARM_TIMER_EXPIRED, 0) == FALSE)
+	{
+		Timer1_startTimer(g_alarmTimerId, 1);
+	}
 }
@@ -4,12 +4,15 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../HAL/EXTERNAL_EEPROM/eeprom_store.c \
 ../HAL/EXTERNAL_EEPROM/external_eeprom.c 
 
 OBJS += \
+./HAL/EXTERNAL_EEPROM/eeprom_store.o \
 ./HAL/EXTERNAL_EEPROM/external_eeprom.o 
 
 C_DEPS += \
+./HAL/EXTERNAL_EEPROM/eeprom_store.d \
 ./HAL/EXTERNAL_EEPROM/external_eeprom.d 
 
 
@@ -4,13 +4,16 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../MCAL/TIMER1/timer1.c 
+../MCAL/TIMER1/timer1.c \
+../MCAL/TIMER1/timer1_service.c 
 
 OBJS += \
-./MCAL/TIMER1/timer1.o 
+./MCAL/TIMER1/timer1.o \
+./MCAL/TIMER1/timer1_service.o 
 
 C_DEPS += \
-./MCAL/TIMER1/timer1.d 
+./MCAL/TIMER1/timer1.d \
+./MCAL/TIMER1/timer1_service.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
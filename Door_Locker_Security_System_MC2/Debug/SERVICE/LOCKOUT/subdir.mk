@@ -0,0 +1,24 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../SERVICE/LOCKOUT/lockout.c 
+
+OBJS += \
+./SERVICE/LOCKOUT/lockout.o 
+
+C_DEPS += \
+./SERVICE/LOCKOUT/lockout.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+SERVICE/LOCKOUT/%.o: ../SERVICE/LOCKOUT/%.c SERVICE/LOCKOUT/subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
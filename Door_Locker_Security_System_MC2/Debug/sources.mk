@@ -29,4 +29,11 @@ MCAL/I2C \
 MCAL/TIMER0_PWM \
 MCAL/TIMER1 \
 MCAL/UART \
+SERVICE/AUDIT \
+SERVICE/CREDENTIAL \
+SERVICE/FRAME \
+SERVICE/HASH \
+SERVICE/LOCKOUT \
+SERVICE/PROF \
+SERVICE/SCHEDULER \
 
@@ -10,7 +10,7 @@
  */
 
 #include "buzzer.h"
-#include "../../MCAL/GPIO/gpio.h"
+#include "../../MCAL/GPIO/gpio_fast.h"
 
 /*
  * Description :
@@ -20,10 +20,10 @@
 void Buzzer_init()
 {
 	/* Setup the direction for the buzzer pin as output */
-	GPIO_setupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
 
 	/* Turn off the buzzer */
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+	GPIO_fastWritePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
 }
 
 /*
@@ -33,7 +33,7 @@ void Buzzer_init()
 void Buzzer_on(void)
 {
 	/* Turn on the buzzer */
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
+	GPIO_fastWritePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
 }
 
 /*
@@ -43,5 +43,5 @@ void Buzzer_on(void)
 void Buzzer_off(void)
 {
 	/* Turn off the buzzer */
-	GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+	GPIO_fastWritePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
 }
@@ -0,0 +1,348 @@
+/*
+ ============================================================================
+ File Name   : eeprom_store.c
+ Author      : Ahmed Ali
+ Module      : EEPROM
+ Layer       : HAL
+ Date        : 18 Oct 2026
+ Description : Source file for the log-structured record store on the External EEPROM
+ ============================================================================
+ */
+
+#include "eeprom_store.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Byte offsets inside the record */
+#define EEPROM_STORE_SEQUENCE_INDEX		0
+#define EEPROM_STORE_KEY_INDEX			4
+#define EEPROM_STORE_LENGTH_INDEX		5
+#define EEPROM_STORE_PAYLOAD_INDEX		6
+#define EEPROM_STORE_CRC_INDEX			(EEPROM_PAGE_SIZE - 2)
+
+#define EEPROM_STORE_NO_PAGE			0xFF
+
+#define EEPROM_STORE_PAGE_ADDRESS(page) \
+	((uint16) ((EEPROM_STORE_FIRST_PAGE + (page)) * EEPROM_PAGE_SIZE))
+
+#define EEPROM_STORE_SET_CURRENT(page) \
+	(g_currentPages[(page) / 8] |= (1 << ((page) % 8)))
+#define EEPROM_STORE_CLEAR_CURRENT(page) \
+	(g_currentPages[(page) / 8] &= ~(1 << ((page) % 8)))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for calculating the CRC-16 of the record.
+ */
+static uint16 EEPROM_storeCrc16(const uint8 record[]);
+
+/*
+ * Function responsible for checking the key, the length and the CRC of the record.
+ */
+static uint8 EEPROM_storeIsRecordValid(const uint8 record[]);
+
+/*
+ * Function responsible for reading the sequence of the record.
+ */
+static uint32 EEPROM_storeSequence(const uint8 record[]);
+
+/*
+ * Function responsible for checking if the page holds the current record of a key.
+ */
+static uint8 EEPROM_storeIsPageCurrent(uint8 page);
+
+/*
+ * Function responsible for ending the append, it is called from the TWI ISR.
+ */
+static void EEPROM_storeRecordWritten(uint8 result);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* RAM index, the page of the current record of each key */
+static uint8 g_index[EEPROM_STORE_MAX_KEYS];
+
+/* Bit map of the pages which hold the current record of a key */
+static uint8 g_currentPages[(EEPROM_STORE_NUM_PAGES + 7) / 8];
+
+/* The next page of the log and the sequence of the next record */
+static uint8 g_head = 0;
+static uint32 g_nextSequence = 1;
+
+/*
+ * TRUE after a complete scan. Until then the index and the next sequence are
+ * not known, a record written with a lower sequence than the records in the
+ * EEPROM would be taken as older than them after the next reset.
+ */
+static uint8 g_ready = FALSE;
+
+/* The record being written, it must not change until the write is completed */
+static uint8 g_writeRecord[EEPROM_PAGE_SIZE];
+static uint8 g_writePage;
+static volatile uint8 g_writeBusy = FALSE;
+static void (*g_writeCallBack)(uint8 result) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Scan the pages of the store once and build the RAM index of the current
+ * record of each key. The TWI driver must be initialized before it.
+ * Return ERROR if a page can't be read, the records can't be read or written
+ * until a next scan is completed.
+ */
+uint8 EEPROM_storeInit(void)
+{
+	uint8 record[EEPROM_PAGE_SIZE];
+	uint32 keySequence[EEPROM_STORE_MAX_KEYS];
+	uint32 sequence, lastSequence = 0;
+	uint8 page, key;
+
+	for (key = 0; key < EEPROM_STORE_MAX_KEYS; key++)
+	{
+		g_index[key] = EEPROM_STORE_NO_PAGE;
+		keySequence[key] = 0;
+	}
+	g_head = 0;
+	g_ready = FALSE;
+
+	for (page = 0; page < EEPROM_STORE_NUM_PAGES; page++)
+	{
+		if (EEPROM_readBlock(EEPROM_STORE_PAGE_ADDRESS(page), record,
+				EEPROM_PAGE_SIZE) == ERROR)
+		{
+			return ERROR;
+		}
+		/* the empty pages and the records cut by a reset are skipped */
+		if (EEPROM_storeIsRecordValid(record) == FALSE)
+		{
+			continue;
+		}
+		sequence = EEPROM_storeSequence(record);
+		key = record[EEPROM_STORE_KEY_INDEX];
+		if (sequence > keySequence[key])
+		{
+			keySequence[key] = sequence;
+			g_index[key] = page;
+		}
+		/* the log continues after the newest record */
+		if (sequence > lastSequence)
+		{
+			lastSequence = sequence;
+			g_head = (page + 1) % EEPROM_STORE_NUM_PAGES;
+		}
+	}
+	for (page = 0; page < sizeof(g_currentPages); page++)
+	{
+		g_currentPages[page] = 0;
+	}
+	for (key = 0; key < EEPROM_STORE_MAX_KEYS; key++)
+	{
+		if (g_index[key] != EEPROM_STORE_NO_PAGE)
+		{
+			EEPROM_STORE_SET_CURRENT(g_index[key]);
+		}
+	}
+	g_nextSequence = lastSequence + 1;
+	g_ready = TRUE;
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Return TRUE if the scan of the store is completed.
+ */
+uint8 EEPROM_storeIsReady(void)
+{
+	return g_ready;
+}
+
+/*
+ * Description :
+ * Return TRUE if the key has a record in the RAM index, it doesn't access the EEPROM.
+ */
+uint8 EEPROM_storeHasRecord(uint8 key)
+{
+	return ((g_ready == TRUE) && (key < EEPROM_STORE_MAX_KEYS)
+			&& (g_index[key] != EEPROM_STORE_NO_PAGE)) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Read the current record of the key, the page is found from the RAM index
+ * and read in one sequential read.
+ * Return ERROR if the key has no record or the store is not scanned.
+ */
+uint8 EEPROM_storeRead(uint8 key, uint8 *data, uint8 *length)
+{
+	uint8 record[EEPROM_PAGE_SIZE];
+	uint8 i;
+
+	if ((g_ready == FALSE) || (key >= EEPROM_STORE_MAX_KEYS)
+			|| (g_index[key] == EEPROM_STORE_NO_PAGE))
+		return ERROR;
+
+	if (EEPROM_readBlock(EEPROM_STORE_PAGE_ADDRESS(g_index[key]), record,
+			EEPROM_PAGE_SIZE) == ERROR)
+		return ERROR;
+
+	/* the page may be corrupted after the scan */
+	if ((EEPROM_storeIsRecordValid(record) == FALSE)
+			|| (record[EEPROM_STORE_KEY_INDEX] != key))
+		return ERROR;
+
+	*length = record[EEPROM_STORE_LENGTH_INDEX];
+	for (i = 0; i < *length; i++)
+	{
+		data[i] = record[EEPROM_STORE_PAYLOAD_INDEX + i];
+	}
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Append a new record of the key to the log and return at once, the call back
+ * is called from the TWI ISR with SUCCESS or ERROR when the write cycle is completed.
+ * Return ERROR if the previous write is not completed yet or the store is not scanned.
+ */
+uint8 EEPROM_storeWriteAsync(uint8 key, const uint8 *data, uint8 length,
+		void (*a_ptr)(uint8 result))
+{
+	uint8 i;
+	uint16 crc;
+
+	if ((g_ready == FALSE) || (g_writeBusy == TRUE) || (key >= EEPROM_STORE_MAX_KEYS)
+			|| (length > EEPROM_STORE_MAX_PAYLOAD))
+		return ERROR;
+
+	/*
+	 * the pages of the current records are kept, the next other page is
+	 * reused, there is always one as the keys are less than the pages
+	 */
+	while (EEPROM_storeIsPageCurrent(g_head) == TRUE)
+	{
+		g_head = (g_head + 1) % EEPROM_STORE_NUM_PAGES;
+	}
+
+	g_writeRecord[EEPROM_STORE_SEQUENCE_INDEX] = (uint8) (g_nextSequence >> 24);
+	g_writeRecord[EEPROM_STORE_SEQUENCE_INDEX + 1] = (uint8) (g_nextSequence >> 16);
+	g_writeRecord[EEPROM_STORE_SEQUENCE_INDEX + 2] = (uint8) (g_nextSequence >> 8);
+	g_writeRecord[EEPROM_STORE_SEQUENCE_INDEX + 3] = (uint8) (g_nextSequence);
+	g_writeRecord[EEPROM_STORE_KEY_INDEX] = key;
+	g_writeRecord[EEPROM_STORE_LENGTH_INDEX] = length;
+	for (i = 0; i < EEPROM_STORE_MAX_PAYLOAD; i++)
+	{
+		g_writeRecord[EEPROM_STORE_PAYLOAD_INDEX + i] =
+				(i < length) ? data[i] : 0xFF;
+	}
+	crc = EEPROM_storeCrc16(g_writeRecord);
+	g_writeRecord[EEPROM_STORE_CRC_INDEX] = (uint8) (crc >> 8);
+	g_writeRecord[EEPROM_STORE_CRC_INDEX + 1] = (uint8) crc;
+
+	g_writePage = g_head;
+	g_head = (g_head + 1) % EEPROM_STORE_NUM_PAGES;
+	g_nextSequence++;
+
+	/* the record is one aligned page, so it is written in one write cycle */
+	g_writeBusy = TRUE;
+	g_writeCallBack = a_ptr;
+	if (EEPROM_writeBlockAsync(EEPROM_STORE_PAGE_ADDRESS(g_writePage),
+			g_writeRecord, EEPROM_PAGE_SIZE, EEPROM_storeRecordWritten) == ERROR)
+	{
+		g_writeBusy = FALSE;
+		return ERROR;
+	}
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Calculate the CRC-16/CCITT of the record, without its CRC bytes.
+ */
+static uint16 EEPROM_storeCrc16(const uint8 record[])
+{
+	uint8 i, bit;
+	uint16 crc = 0xFFFF;
+	for (i = 0; i < EEPROM_STORE_CRC_INDEX; i++)
+	{
+		crc ^= (uint16) record[i] << 8;
+		for (bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/*
+ * Description :
+ * Check the key, the length and the CRC of the record.
+ */
+static uint8 EEPROM_storeIsRecordValid(const uint8 record[])
+{
+	uint16 crc;
+	if ((record[EEPROM_STORE_KEY_INDEX] >= EEPROM_STORE_MAX_KEYS)
+			|| (record[EEPROM_STORE_LENGTH_INDEX] > EEPROM_STORE_MAX_PAYLOAD))
+	{
+		return FALSE;
+	}
+	crc = EEPROM_storeCrc16(record);
+	return ((record[EEPROM_STORE_CRC_INDEX] == (uint8) (crc >> 8))
+			&& (record[EEPROM_STORE_CRC_INDEX + 1] == (uint8) crc)) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Read the sequence of the record.
+ */
+static uint32 EEPROM_storeSequence(const uint8 record[])
+{
+	return ((uint32) record[EEPROM_STORE_SEQUENCE_INDEX] << 24)
+			| ((uint32) record[EEPROM_STORE_SEQUENCE_INDEX + 1] << 16)
+			| ((uint32) record[EEPROM_STORE_SEQUENCE_INDEX + 2] << 8)
+			| record[EEPROM_STORE_SEQUENCE_INDEX + 3];
+}
+
+/*
+ * Description :
+ * Check if the page holds the current record of a key, from the bit map of
+ * the current pages so the time doesn't grow with the keys.
+ */
+static uint8 EEPROM_storeIsPageCurrent(uint8 page)
+{
+	return ((g_currentPages[page / 8] & (1 << (page % 8))) != 0) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * End the append, it is called from the TWI ISR.
+ */
+static void EEPROM_storeRecordWritten(uint8 result)
+{
+	uint8 key;
+
+	if (result == SUCCESS)
+	{
+		/* the new record is the current record of its key now */
+		key = g_writeRecord[EEPROM_STORE_KEY_INDEX];
+		if (g_index[key] != EEPROM_STORE_NO_PAGE)
+		{
+			EEPROM_STORE_CLEAR_CURRENT(g_index[key]);
+		}
+		g_index[key] = g_writePage;
+		EEPROM_STORE_SET_CURRENT(g_writePage);
+	}
+	g_writeBusy = FALSE;
+	if (g_writeCallBack != NULL_PTR)
+	{
+		g_writeCallBack(result);
+	}
+}
@@ -0,0 +1,96 @@
+/*
+ ============================================================================
+ File Name   : eeprom_store.h
+ Author      : Ahmed Ali
+ Module      : EEPROM
+ Layer       : HAL
+ Date        : 18 Oct 2026
+ Description : Header file for the log-structured record store on the External EEPROM
+ ============================================================================
+ */
+
+#ifndef EEPROM_STORE_H_
+#define EEPROM_STORE_H_
+
+#include "../../LIB/std_types.h"
+#include "external_eeprom.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * The store is a circular log of pages, each page holds one record:
+ * | SEQUENCE (4 bytes) | KEY | LENGTH | PAYLOAD (EEPROM_STORE_MAX_PAYLOAD bytes) | CRC-16 |
+ * The CRC is CRC-16/CCITT (polynomial 0x1021, initial 0xFFFF) over all the bytes
+ * before it. The record of a key with the highest sequence is its current record.
+ *
+ * A new record is written to the next page of the log, the pages which hold
+ * current records are skipped and the others are reused, so the writes are
+ * spread over the pages and the old record of a key stays valid until
+ * its new record is completed. A current record is never moved, so the
+ * records which are not written again, like the user records, keep their
+ * pages and the writes of the other keys are spread over the remaining pages.
+ */
+#define EEPROM_STORE_FIRST_PAGE		0
+#define EEPROM_STORE_NUM_PAGES		80
+
+/*
+ * The keys below EEPROM_STORE_SERVICE_KEYS are kept for the services, the
+ * others are one key for each user slot of the credential table
+ */
+#define EEPROM_STORE_SERVICE_KEYS	8
+#define EEPROM_STORE_MAX_KEYS		72
+#define EEPROM_STORE_MAX_PAYLOAD	(EEPROM_PAGE_SIZE - 8)
+
+#if (EEPROM_STORE_MAX_KEYS >= EEPROM_STORE_NUM_PAGES)
+#error "The store needs more pages than keys"
+#endif
+
+#if (EEPROM_STORE_NUM_PAGES >= 0xFF)
+#error "The pages of the store should be less than 255"
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Scan the pages of the store once and build the RAM index of the current
+ * record of each key. The TWI driver must be initialized before it.
+ * Return ERROR if a page can't be read, the records can't be read or written
+ * until a next scan is completed.
+ */
+uint8 EEPROM_storeInit(void);
+
+/*
+ * Description :
+ * Return TRUE if the scan of the store is completed.
+ */
+uint8 EEPROM_storeIsReady(void);
+
+/*
+ * Description :
+ * Return TRUE if the key has a record in the RAM index, it doesn't access the EEPROM.
+ */
+uint8 EEPROM_storeHasRecord(uint8 key);
+
+/*
+ * Description :
+ * Read the current record of the key, the page is found from the RAM index
+ * and read in one sequential read.
+ * Return ERROR if the key has no record or the store is not scanned.
+ */
+uint8 EEPROM_storeRead(uint8 key, uint8 *data, uint8 *length);
+
+/*
+ * Description :
+ * Append a new record of the key to the log and return at once, the call back
+ * is called from the TWI ISR with SUCCESS or ERROR when the write cycle is completed.
+ * Return ERROR if the previous write is not completed yet or the store is not scanned.
+ */
+uint8 EEPROM_storeWriteAsync(uint8 key, const uint8 *data, uint8 length,
+		void (*a_ptr)(uint8 result));
+
+#endif /* EEPROM_STORE_H_ */
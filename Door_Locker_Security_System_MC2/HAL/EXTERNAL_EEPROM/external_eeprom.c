@@ -12,72 +12,207 @@
 #include "../EXTERNAL_EEPROM/external_eeprom.h"
 
 #include "../../MCAL/I2C/twi.h"
+#include "../../SERVICE/PROF/prof.h"
 
-uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
-{
-	/* Send the Start Bit */
-	TWI_start();
-	if (TWI_getStatus() != TWI_START)
-		return ERROR;
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=0 (write) */
-	TWI_writeByte((uint8) (0xA0 | ((u16addr & 0x0700) >> 7)));
-	if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
-		return ERROR;
+/* Device address with A8 A9 A10 address bits from the memory location address and R/W=0 */
+#define EEPROM_DEVICE_ADDRESS(u16addr) ((uint8) (0xA0 | (((u16addr) & 0x0700) >> 7)))
 
-	/* Send the required memory location address */
-	TWI_writeByte((uint8) (u16addr));
-	if (TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
 
-	/* write byte to EEPROM */
-	TWI_writeByte(u8data);
-	if (TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+/*
+ * Function responsible for submitting the transaction of the next page of
+ * the block write, or the ACK polling of the last write cycle.
+ */
+static void EEPROM_writeNextPage(void);
 
-	/* Send the Stop Bit */
-	TWI_stop();
+/*
+ * Function responsible for continuing the block write after each transaction,
+ * it is called from the TWI ISR.
+ */
+static void EEPROM_pageWritten(TWI_TransactionType *a_transaction);
 
-	return SUCCESS;
+/*
+ * Function responsible for marking the end of a blocking block write.
+ */
+static void EEPROM_blockWritten(uint8 result);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The running block write and its transaction */
+static TWI_TransactionType g_writeTransaction;
+static uint16 g_writeAddress;
+static const uint8 *g_writeData;
+static uint16 g_writeLength;
+static void (*volatile g_writeCallBack)(uint8 result) = NULL_PTR;
+static volatile uint8 g_writeBusy = FALSE;
+static volatile uint8 g_writeResult;
+
+/* The transaction of the reads */
+static TWI_TransactionType g_readTransaction;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
+{
+	/* one byte is a block write of length one */
+	return EEPROM_writeBlock(u16addr, &u8data, 1);
 }
 
 uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
 {
-	/* Send the Start Bit */
-	TWI_start();
-	if (TWI_getStatus() != TWI_START)
-		return ERROR;
+	/* one byte is a sequential read of length one */
+	return EEPROM_readBlock(u16addr, u8data, 1);
+}
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=0 (write) */
-	TWI_writeByte((uint8) ((0xA0) | ((u16addr & 0x0700) >> 7)));
-	if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+/*
+ * Description :
+ * Write a block of bytes with page writes, the block is split at the page
+ * boundaries and the end of each write cycle is detected by ACK polling.
+ * The function returns after the last write cycle is completed.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *u8data, uint16 u16length)
+{
+	if (EEPROM_writeBlockAsync(u16addr, u8data, u16length,
+			EEPROM_blockWritten) == ERROR)
 		return ERROR;
 
-	/* Send the required memory location address */
-	TWI_writeByte((uint8) (u16addr));
-	if (TWI_getStatus() != TWI_MT_DATA_ACK)
-		return ERROR;
+	/* Wait until the TWI ISR completes the last write cycle */
+	while (g_writeBusy == TRUE)
+		;
+	return g_writeResult;
+}
 
-	/* Send the Repeated Start Bit */
-	TWI_start();
-	if (TWI_getStatus() != TWI_REP_START)
+/*
+ * Description :
+ * Read a block of bytes in one sequential read, the memory address is sent
+ * once then the bytes are received with ACK and the last one with NACK.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *u8data, uint16 u16length)
+{
+	if (u16length == 0)
+		return SUCCESS;
+
+	/*
+	 * Send the required memory location address then read the bytes after
+	 * a repeated start, the engine restarts the transaction while the EEPROM
+	 * NACKs its address during a write cycle
+	 */
+	g_readTransaction.slaveAddress = EEPROM_DEVICE_ADDRESS(u16addr);
+	g_readTransaction.command[0] = (uint8) (u16addr);
+	g_readTransaction.commandLength = 1;
+	g_readTransaction.writeLength = 0;
+	g_readTransaction.readData = u8data;
+	g_readTransaction.readLength = u16length;
+	g_readTransaction.callBack = NULL_PTR;
+	if (TWI_submitTransaction(&g_readTransaction) == FALSE)
 		return ERROR;
 
-	/* Send the device address, we need to get A8 A9 A10 address bits from the
-	 * memory location address and R/W=1 (Read) */
-	TWI_writeByte((uint8) ((0xA0) | ((u16addr & 0x0700) >> 7) | 1));
-	if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
-		return ERROR;
+	/* Wait until the TWI ISR completes the read */
+	while (g_readTransaction.status == TWI_TRANSACTION_PENDING)
+		;
+	return (g_readTransaction.status == TWI_TRANSACTION_DONE) ? SUCCESS : ERROR;
+}
 
-	/* Read Byte from Memory without send ACK */
-	*u8data = TWI_readByteWithNACK();
-	if (TWI_getStatus() != TWI_MR_DATA_NACK)
+/*
+ * Description :
+ * Start writing a block of bytes with page writes and return at once,
+ * the call back is called from the TWI ISR with SUCCESS or ERROR after
+ * the last write cycle is completed. The bytes must stay valid until then.
+ * Return ERROR if another block write is not completed yet.
+ */
+uint8 EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *u8data,
+		uint16 u16length, void (*a_ptr)(uint8 result))
+{
+	if (g_writeBusy == TRUE)
 		return ERROR;
 
-	/* Send the Stop Bit */
-	TWI_stop();
-
+	PROF_BEGIN(PROF_EEPROM_WRITE);
+	g_writeBusy = TRUE;
+	g_writeAddress = u16addr;
+	g_writeData = u8data;
+	g_writeLength = u16length;
+	g_writeCallBack = a_ptr;
+	EEPROM_writeNextPage();
 	return SUCCESS;
 }
+
+/*
+ * Description :
+ * Submit the transaction of the next page of the block write,
+ * or the ACK polling of the last write cycle.
+ */
+static void EEPROM_writeNextPage(void)
+{
+	uint16 pageLength;
+
+	/* write up to the end of the page, the address wraps inside the page after it */
+	pageLength = EEPROM_PAGE_SIZE - (g_writeAddress % EEPROM_PAGE_SIZE);
+	if (pageLength > g_writeLength)
+	{
+		pageLength = g_writeLength;
+	}
+
+	/*
+	 * The EEPROM NACKs its address until the write cycle of the previous page
+	 * is completed, so the engine restarts the transaction until the ACK.
+	 * After the last page, a transaction without bytes only waits for the ACK.
+	 */
+	g_writeTransaction.slaveAddress = EEPROM_DEVICE_ADDRESS(g_writeAddress);
+	g_writeTransaction.command[0] = (uint8) (g_writeAddress);
+	g_writeTransaction.commandLength = (pageLength > 0) ? 1 : 0;
+	g_writeTransaction.writeData = g_writeData;
+	g_writeTransaction.writeLength = pageLength;
+	g_writeTransaction.readLength = 0;
+	g_writeTransaction.callBack = EEPROM_pageWritten;
+
+	g_writeAddress += pageLength;
+	g_writeData += pageLength;
+	g_writeLength -= pageLength;
+
+	TWI_submitTransaction(&g_writeTransaction);
+}
+
+/*
+ * Description :
+ * Continue the block write after each transaction, it is called from the TWI ISR.
+ */
+static void EEPROM_pageWritten(TWI_TransactionType *a_transaction)
+{
+	uint8 result;
+
+	if ((a_transaction->status == TWI_TRANSACTION_DONE)
+			&& (a_transaction->writeLength > 0))
+	{
+		/* the page is sent, write the next one or wait for its write cycle */
+		EEPROM_writeNextPage();
+		return;
+	}
+
+	/* the last write cycle is completed or the block write failed */
+	result = (a_transaction->status == TWI_TRANSACTION_DONE) ? SUCCESS : ERROR;
+	PROF_END(PROF_EEPROM_WRITE);
+	g_writeBusy = FALSE;
+	if (g_writeCallBack != NULL_PTR)
+	{
+		g_writeCallBack(result);
+	}
+}
+
+/*
+ * Description :
+ * Mark the end of a blocking block write.
+ */
+static void EEPROM_blockWritten(uint8 result)
+{
+	g_writeResult = result;
+}
@@ -20,6 +20,12 @@
 #define ERROR 0
 #define SUCCESS 1
 
+/* 24C16 page size in bytes, one write cycle programs up to one page */
+#define EEPROM_PAGE_SIZE 16
+
+/* 24C16 size in bytes */
+#define EEPROM_SIZE 2048
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -28,4 +34,29 @@ uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data);
 
 uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data);
 
+/*
+ * Description :
+ * Write a block of bytes with page writes, the block is split at the page
+ * boundaries and the end of each write cycle is detected by ACK polling.
+ * The function returns after the last write cycle is completed.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *u8data, uint16 u16length);
+
+/*
+ * Description :
+ * Read a block of bytes in one sequential read, the memory address is sent
+ * once then the bytes are received with ACK and the last one with NACK.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *u8data, uint16 u16length);
+
+/*
+ * Description :
+ * Start writing a block of bytes with page writes and return at once,
+ * the call back is called from the TWI ISR with SUCCESS or ERROR after
+ * the last write cycle is completed. The bytes must stay valid until then.
+ * Return ERROR if another block write is not completed yet.
+ */
+uint8 EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *u8data,
+		uint16 u16length, void (*a_ptr)(uint8 result));
+
 #endif /* EXTERNAL_EEPROM_H_ */
@@ -11,7 +11,7 @@
 
 #include "motor.h"
 #include "../../LIB/common_macros.h"
-#include "../../MCAL/GPIO/gpio.h"
+#include "../../MCAL/GPIO/gpio_fast.h"
 #include "../../MCAL/TIMER0_PWM/timer0_pwm.h"
 
 /*
@@ -22,12 +22,12 @@
 void DcMotor_Init(void)
 {
 	/* Set IN1 and IN2 pins direction as output */
-	GPIO_setupPinDirection(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, PIN_OUTPUT);
+	GPIO_fastSetupPinDirection(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, PIN_OUTPUT);
 
 	/* Stop motor as initial state */
-	GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
-	GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
+	GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
+	GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
 }
 
 /*
@@ -42,18 +42,18 @@ void DcMotor_Rotate(DcMotor_State a_state, uint8 a_speed)
 	{
 	case CLOCK_Wise:
 		/* Clock wise mode => (IN1 = 1 and INT2 = 0) */
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_HIGH);
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_HIGH);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
 		break;
 	case ANTI_CLOCK_WISE:
 		/* Anti clock wise mode => (IN1 = 0 and INT2 = 1) */
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_HIGH);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_HIGH);
 		break;
 	default:
 		/* Any case else, the motor be in stop mode */
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN1_PIN_ID, LOGIC_LOW);
+		GPIO_fastWritePin(MOTOR_PORT_ID, MOTOR_IN2_PIN_ID, LOGIC_LOW);
 		break;
 	}
 	/* Call the PWM function and give it the speed */
@@ -0,0 +1,265 @@
+/*
+ ============================================================================
+ File Name   : gpio_fast.h
+ Author      : Ahmed Ali
+ Module      : GPIO
+ Layer       : MCAL
+ Date        : 18 Oct 2026
+ Description : Header only inline pin API of the AVR GPIO driver
+ ============================================================================
+ */
+
+#ifndef GPIO_FAST_H_
+#define GPIO_FAST_H_
+
+#include "gpio.h"
+#include "gpio_private.h" /* To use the IO Ports Registers */
+
+/*
+ * The functions of this file do the same work as the runtime API of gpio.h
+ * without its range checks, and they are always inlined.
+ * When the port and pin numbers are constants the switch on the port is removed
+ * by the compiler and each access is one SBI/CBI/SBIS/SBIC instruction,
+ * so they must be called with the constant Ids of the drivers configurations.
+ * A wrong constant Id is not checked, it is a configuration error.
+ *
+ * The switch is removed only by an optimized build (the release profile of the
+ * Makefile, -Os). Without optimization (-O0, the Debug configuration) the inlined
+ * switch stays in every caller and is larger than a call, so there the functions
+ * are mapped to the runtime API of gpio.h, with its range checks.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#ifdef __OPTIMIZE__
+
+#define GPIO_FAST_INLINE	static inline __attribute__((always_inline))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Setup the direction of the required pin input/output.
+ */
+GPIO_FAST_INLINE void GPIO_fastSetupPinDirection(uint8 port_num, uint8 pin_num,
+		GPIO_PinDirectionType direction)
+{
+	switch (port_num)
+	{
+	case PORTA_ID:
+		if (direction == PIN_OUTPUT)
+		{
+			DDRA_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		else
+		{
+			DDRA_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		break;
+	case PORTB_ID:
+		if (direction == PIN_OUTPUT)
+		{
+			DDRB_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		else
+		{
+			DDRB_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		break;
+	case PORTC_ID:
+		if (direction == PIN_OUTPUT)
+		{
+			DDRC_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		else
+		{
+			DDRC_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		break;
+	case PORTD_ID:
+		if (direction == PIN_OUTPUT)
+		{
+			DDRD_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		else
+		{
+			DDRD_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Write the value Logic High or Logic Low on the required pin.
+ * If the pin is input, this function will enable/disable the internal pull-up resistor.
+ */
+GPIO_FAST_INLINE void GPIO_fastWritePin(uint8 port_num, uint8 pin_num,
+		uint8 value)
+{
+	switch (port_num)
+	{
+	case PORTA_ID:
+		if (value == LOGIC_LOW)
+		{
+			PORTA_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		else
+		{
+			PORTA_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		break;
+	case PORTB_ID:
+		if (value == LOGIC_LOW)
+		{
+			PORTB_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		else
+		{
+			PORTB_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		break;
+	case PORTC_ID:
+		if (value == LOGIC_LOW)
+		{
+			PORTC_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		else
+		{
+			PORTC_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		break;
+	case PORTD_ID:
+		if (value == LOGIC_LOW)
+		{
+			PORTD_REG.Byte &= (uint8) ~(1 << pin_num);
+		}
+		else
+		{
+			PORTD_REG.Byte |= (uint8) (1 << pin_num);
+		}
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Read and return the value for the required pin, it should be Logic High or Logic Low.
+ */
+GPIO_FAST_INLINE uint8 GPIO_fastReadPin(uint8 port_num, uint8 pin_num)
+{
+	uint8 pinValue = LOGIC_LOW;
+
+	switch (port_num)
+	{
+	case PORTA_ID:
+		pinValue = (PINA_REG.Byte & (1 << pin_num)) ? LOGIC_HIGH : LOGIC_LOW;
+		break;
+	case PORTB_ID:
+		pinValue = (PINB_REG.Byte & (1 << pin_num)) ? LOGIC_HIGH : LOGIC_LOW;
+		break;
+	case PORTC_ID:
+		pinValue = (PINC_REG.Byte & (1 << pin_num)) ? LOGIC_HIGH : LOGIC_LOW;
+		break;
+	case PORTD_ID:
+		pinValue = (PIND_REG.Byte & (1 << pin_num)) ? LOGIC_HIGH : LOGIC_LOW;
+		break;
+	}
+	return pinValue;
+}
+
+/*
+ * Description :
+ * Read and return the value of the required port, one IN instruction.
+ */
+GPIO_FAST_INLINE uint8 GPIO_fastReadPort(uint8 port_num)
+{
+	uint8 value = 0;
+
+	switch (port_num)
+	{
+	case PORTA_ID:
+		value = PINA_REG.Byte;
+		break;
+	case PORTB_ID:
+		value = PINB_REG.Byte;
+		break;
+	case PORTC_ID:
+		value = PINC_REG.Byte;
+		break;
+	case PORTD_ID:
+		value = PIND_REG.Byte;
+		break;
+	}
+	return value;
+}
+
+/*
+ * Description :
+ * Write the value on the required port, one OUT instruction.
+ */
+GPIO_FAST_INLINE void GPIO_fastWritePort(uint8 port_num, uint8 value)
+{
+	switch (port_num)
+	{
+	case PORTA_ID:
+		PORTA_REG.Byte = value;
+		break;
+	case PORTB_ID:
+		PORTB_REG.Byte = value;
+		break;
+	case PORTC_ID:
+		PORTC_REG.Byte = value;
+		break;
+	case PORTD_ID:
+		PORTD_REG.Byte = value;
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Setup the direction of the required port all pins input/output, one OUT instruction.
+ */
+GPIO_FAST_INLINE void GPIO_fastSetupPortDirection(uint8 port_num,
+		GPIO_PortDirectionType direction)
+{
+	switch (port_num)
+	{
+	case PORTA_ID:
+		DDRA_REG.Byte = direction;
+		break;
+	case PORTB_ID:
+		DDRB_REG.Byte = direction;
+		break;
+	case PORTC_ID:
+		DDRC_REG.Byte = direction;
+		break;
+	case PORTD_ID:
+		DDRD_REG.Byte = direction;
+		break;
+	}
+}
+
+#else /* not optimized build */
+
+#define GPIO_fastSetupPinDirection(port_num, pin_num, direction) \
+	GPIO_setupPinDirection(port_num, pin_num, direction)
+#define GPIO_fastWritePin(port_num, pin_num, value) \
+	GPIO_writePin(port_num, pin_num, value)
+#define GPIO_fastReadPin(port_num, pin_num) \
+	GPIO_readPin(port_num, pin_num)
+#define GPIO_fastReadPort(port_num) \
+	GPIO_readPort(port_num)
+#define GPIO_fastWritePort(port_num, value) \
+	GPIO_writePort(port_num, value)
+#define GPIO_fastSetupPortDirection(port_num, direction) \
+	GPIO_setupPortDirection(port_num, direction)
+
+#endif /* __OPTIMIZE__ */
+
+#endif /* GPIO_FAST_H_ */
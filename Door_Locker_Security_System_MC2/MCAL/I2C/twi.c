@@ -11,49 +11,217 @@
 
 #include "../I2C/twi.h"
 #include "../I2C/twi_private.h"
+#include "../GPIO/gpio_private.h" /* to use the declaration of SREG register */
+#include "../../SERVICE/PROF/prof.h"
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
 
 /*
- * Description : Function to initialize the TWI driver
- * 	1. Set the required address.
- * 	2. Set the required Prescaler.
- * 	3. Set the required Prescaler bit_rate.
- * 	4. Enable TWI.
+ * TWCR values of the interrupt driven engine, all of them have
+ * TWINT = 1, TWEN = 1 and TWIE = 1 except the final stop
+ */
+#define TWI_TWCR_START			0xA5 /* TWSTA = 1 generating start condition */
+#define TWI_TWCR_STOP_START		0xB5 /* TWSTO = 1 and TWSTA = 1 stop then start condition */
+#define TWI_TWCR_SEND			0x85 /* send the byte in TWDR */
+#define TWI_TWCR_READ_ACK		0xC5 /* TWEA = 1 receive a byte and send ACK */
+#define TWI_TWCR_READ_NACK		0x85 /* TWEA = 0 receive a byte and send NACK */
+#define TWI_TWCR_STOP			0x94 /* TWSTO = 1 and TWIE = 0 stop condition */
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for preparing the first transaction of the queue
+ * to start from its beginning.
+ */
+static void TWI_beginTransaction(void);
+
+/*
+ * Function responsible for completing the first transaction of the queue
+ * and starting the next one or sending the stop condition.
  */
-void TWI_init(const TWI_ConfigType *Config_Ptr)
+static void TWI_completeTransaction(TWI_TransactionStatusType status);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Queue of the transactions, the first one is the running transaction */
+static TWI_TransactionType *volatile g_queueHead = NULL_PTR;
+static TWI_TransactionType *volatile g_queueTail = NULL_PTR;
+
+/* TRUE from the start of the first transaction until the final stop */
+static volatile uint8 g_busy = FALSE;
+
+/* TRUE while the running transaction is in its read part */
+static uint8 g_reading = FALSE;
+/* Index of the next byte in the command and write bytes or in the read bytes */
+static uint16 g_index = 0;
+/* Number of restarts of the running transaction */
+static uint8 g_retries = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(TWI_vect)
 {
-	/*
-	 * Bit Rate: 400.000 kbps and F_CPU=8Mhz
-	 * Insert the prescaler in (TWPS0 and TWPS1) Bits in TWSR register.
-	 */
-	switch (Config_Ptr->Prescaler)
+	TWI_TransactionType *transaction = g_queueHead;
+	uint8 status;
+	uint16 writeIndex;
+
+	PROF_BEGIN(PROF_TWI_ISR);
+	status = TWI_getStatus();
+	switch (status)
 	{
-	case TWI_PRESCALER_1:
-		TWBR_REG.Byte = 0x02;
-		TWSR_REG.Bits.TWPS0_Bit = 0;
-		TWSR_REG.Bits.TWPS1_Bit = 0;
+	case TWI_START:
+	case TWI_REP_START:
+		/* Send the slave address with R/W=1 in the read part or R/W=0 else */
+		TWDR_REG.Byte = transaction->slaveAddress | g_reading;
+		TWCR_REG.Byte = TWI_TWCR_SEND;
+		break;
+
+	case TWI_MT_SLA_W_ACK:
+	case TWI_MT_DATA_ACK:
+		if (g_index < transaction->commandLength)
+		{
+			TWDR_REG.Byte = transaction->command[g_index];
+			g_index++;
+			TWCR_REG.Byte = TWI_TWCR_SEND;
+			break;
+		}
+		writeIndex = g_index - transaction->commandLength;
+		if (writeIndex < transaction->writeLength)
+		{
+			TWDR_REG.Byte = transaction->writeData[writeIndex];
+			g_index++;
+			TWCR_REG.Byte = TWI_TWCR_SEND;
+		}
+		else if (transaction->readLength > 0)
+		{
+			/* Send the repeated start of the read part */
+			g_reading = TRUE;
+			g_index = 0;
+			TWCR_REG.Byte = TWI_TWCR_START;
+		}
+		else
+		{
+			TWI_completeTransaction(TWI_TRANSACTION_DONE);
+		}
+		break;
+
+	case TWI_MT_SLA_R_ACK:
+		/* the last byte is received with NACK */
+		TWCR_REG.Byte =
+				(transaction->readLength > 1) ?
+						TWI_TWCR_READ_ACK : TWI_TWCR_READ_NACK;
+		break;
+
+	case TWI_MR_DATA_ACK:
+		transaction->readData[g_index] = TWDR_REG.Byte;
+		g_index++;
+		TWCR_REG.Byte =
+				(g_index < (transaction->readLength - 1)) ?
+						TWI_TWCR_READ_ACK : TWI_TWCR_READ_NACK;
 		break;
-	case TWI_PRESCALER_4:
-		TWBR_REG.Byte = 0x00;
-		TWSR_REG.Bits.TWPS0_Bit = 1;
-		TWSR_REG.Bits.TWPS1_Bit = 0;
+
+	case TWI_MR_DATA_NACK:
+		transaction->readData[g_index] = TWDR_REG.Byte;
+		TWI_completeTransaction(TWI_TRANSACTION_DONE);
 		break;
-	case TWI_PRESCALER_16:
-		TWBR_REG.Byte = 0x00;
-		TWSR_REG.Bits.TWPS0_Bit = 0;
-		TWSR_REG.Bits.TWPS1_Bit = 1;
+
+	case TWI_MT_SLA_W_NACK:
+	case TWI_MT_SLA_R_NACK:
+	case TWI_ARB_LOST:
+		/* the slave is busy or another master has the bus, restart the transaction */
+		if (g_retries < TWI_MAX_RETRIES)
+		{
+			g_retries++;
+			TWI_beginTransaction();
+			/* the bus is already released if the arbitration is lost */
+			TWCR_REG.Byte =
+					(status == TWI_ARB_LOST) ?
+							TWI_TWCR_START : TWI_TWCR_STOP_START;
+		}
+		else
+		{
+			TWI_completeTransaction(TWI_TRANSACTION_FAILED);
+		}
 		break;
-	case TWI_PRESCALER_64:
-		TWBR_REG.Byte = 0x00;
-		TWSR_REG.Bits.TWPS0_Bit = 1;
-		TWSR_REG.Bits.TWPS1_Bit = 1;
+
+	default:
+		/* data NACK or bus error */
+		TWI_completeTransaction(TWI_TRANSACTION_FAILED);
 		break;
 	}
+	PROF_END(PROF_TWI_ISR);
+}
+
+/*
+ * Description : Function to initialize the TWI driver
+ * 	1. Set the required address.
+ * 	2. Calculate the smallest Prescaler and the bit_rate for the required SCL frequency.
+ * 	3. Enable TWI.
+ * Return FALSE and keep TWI disabled if the SCL frequency can't be generated from F_CPU
+ * with TWBR from TWI_MIN_TWBR to 255.
+ */
+uint8 TWI_init(const TWI_ConfigType *Config_Ptr)
+{
+	TWI_Prescaler_Type prescaler;
+	uint32 twbr = 0;
+
+	/* the SCL frequency can't be higher than F_CPU / 16 (TWBR = 0) */
+	if ((Config_Ptr->bitRate == 0) || ((16UL * Config_Ptr->bitRate) > F_CPU))
+	{
+		return FALSE;
+	}
+
+	/* take the smallest prescaler (1, 4, 16 or 64) that has TWBR value fits in 8 bits */
+	for (prescaler = TWI_PRESCALER_1; prescaler <= TWI_PRESCALER_64;
+			prescaler++)
+	{
+		twbr = TWI_TWBR_VALUE(Config_Ptr->bitRate, 1UL << (2 * prescaler));
+		if (twbr <= 255)
+		{
+			break;
+		}
+	}
+	if (twbr > 255)
+	{
+		/* the SCL frequency is lower than the minimum */
+		return FALSE;
+	}
+	if (twbr < TWI_MIN_TWBR)
+	{
+		/* the SCL frequency is higher than the master mode allows */
+		return FALSE;
+	}
+
+	/* Insert the prescaler in (TWPS0 and TWPS1) Bits in TWSR register */
+	TWBR_REG.Byte = (uint8) twbr;
+	TWSR_REG.Bits.TWPS0_Bit = prescaler & 0x01;
+	TWSR_REG.Bits.TWPS1_Bit = (prescaler >> 1) & 0x01;
 
 	/* Insert the required address in TWAR salve address register */
 	TWAR_REG.Byte = ((Config_Ptr->address) << 1);
 
 	/* Enable TWI */
 	TWCR_REG.Bits.TWEN_Bit = 1;
+	return TRUE;
+}
+
+/*
+ * Description : Function to get the SCL frequency in Hz generated by the current
+ * bit_rate and Prescaler, it is not higher than the required one.
+ */
+TWI_BitRate_Type TWI_getBitRate(void)
+{
+	uint8 prescaler = (TWSR_REG.Bits.TWPS1_Bit << 1) | TWSR_REG.Bits.TWPS0_Bit;
+	return F_CPU / (16UL + (2UL * TWBR_REG.Byte * (1UL << (2 * prescaler))));
 }
 
 /*
@@ -90,6 +258,10 @@ void TWI_stop(void)
 	 * TWINT  = 1 Clear the TWINT flag before reading the data
 	 ***********************************************************************/
 	TWCR_REG.Byte = 0x94;
+
+	/* Wait for TWSTO flag cleared in TWCR Register (stop bit is send successfully) */
+	while (TWCR_REG.Bits.TWSTO_Bit == 1)
+		;
 }
 
 /*
@@ -169,3 +341,104 @@ uint8 TWI_getStatus(void)
 	status = (TWSR_REG.Byte) & 0xF8;
 	return status;
 }
+
+/*
+ * Description : Function to add a transaction to the queue of the interrupt driven engine,
+ * the transaction starts at once if the engine is idle.
+ * Return FALSE if the transaction is already in the queue.
+ * The blocking functions above must not be used while the engine is busy.
+ */
+uint8 TWI_submitTransaction(TWI_TransactionType *a_transaction)
+{
+	uint8 interruptState;
+
+	if (a_transaction->status == TWI_TRANSACTION_PENDING)
+	{
+		return FALSE;
+	}
+	a_transaction->status = TWI_TRANSACTION_PENDING;
+	a_transaction->next = NULL_PTR;
+
+	/* The queue is shared with the TWI ISR */
+	interruptState = SREG_REG.Bits.I_Bit;
+	SREG_REG.Bits.I_Bit = 0;
+
+	if (g_queueTail == NULL_PTR)
+	{
+		g_queueHead = a_transaction;
+	}
+	else
+	{
+		g_queueTail->next = a_transaction;
+	}
+	g_queueTail = a_transaction;
+
+	if (g_busy == FALSE)
+	{
+		/* the engine is idle, wait for the stop of the previous transaction then start */
+		g_busy = TRUE;
+		g_retries = 0;
+		TWI_beginTransaction();
+		while (TWCR_REG.Bits.TWSTO_Bit == 1)
+			;
+		TWCR_REG.Byte = TWI_TWCR_START;
+	}
+
+	SREG_REG.Bits.I_Bit = interruptState;
+	return TRUE;
+}
+
+/*
+ * Description : Function to check if the interrupt driven engine has no transactions.
+ */
+uint8 TWI_isIdle(void)
+{
+	return (g_busy == FALSE) ? TRUE : FALSE;
+}
+
+/*
+ * Description : Prepare the first transaction of the queue to start from its beginning.
+ */
+static void TWI_beginTransaction(void)
+{
+	TWI_TransactionType *transaction = g_queueHead;
+	g_index = 0;
+	/* a transaction without bytes to write starts by its read part */
+	g_reading = ((transaction->commandLength == 0)
+			&& (transaction->writeLength == 0)
+			&& (transaction->readLength > 0)) ? TRUE : FALSE;
+}
+
+/*
+ * Description : Complete the first transaction of the queue and start
+ * the next one or send the stop condition.
+ */
+static void TWI_completeTransaction(TWI_TransactionStatusType status)
+{
+	TWI_TransactionType *transaction = g_queueHead;
+
+	g_queueHead = transaction->next;
+	if (g_queueHead == NULL_PTR)
+	{
+		g_queueTail = NULL_PTR;
+	}
+	transaction->status = status;
+
+	/* the call back can submit a new transaction, it is queued as the engine is busy */
+	if (transaction->callBack != NULL_PTR)
+	{
+		transaction->callBack(transaction);
+	}
+
+	if (g_queueHead != NULL_PTR)
+	{
+		g_retries = 0;
+		TWI_beginTransaction();
+		TWCR_REG.Byte = TWI_TWCR_STOP_START;
+	}
+	else
+	{
+		g_busy = FALSE;
+		TWCR_REG.Byte = TWI_TWCR_STOP;
+	}
+}
@@ -19,6 +19,9 @@
  *******************************************************************************/
 typedef uint8 TWI_Address_Type;
 
+/* SCL frequency in Hz */
+typedef uint32 TWI_BitRate_Type;
+
 typedef enum
 {
 	TWI_PRESCALER_1, TWI_PRESCALER_4, TWI_PRESCALER_16, TWI_PRESCALER_64
@@ -27,9 +30,38 @@ typedef enum
 typedef struct
 {
 	TWI_Address_Type address;
-	TWI_Prescaler_Type Prescaler;
+	TWI_BitRate_Type bitRate;
 } TWI_ConfigType;
 
+typedef enum
+{
+	TWI_TRANSACTION_IDLE,
+	TWI_TRANSACTION_PENDING,
+	TWI_TRANSACTION_DONE,
+	TWI_TRANSACTION_FAILED
+} TWI_TransactionStatusType;
+
+/*
+ * Descriptor of one master transaction run by the interrupt driven engine:
+ * START, SLA+W, the command bytes then the write bytes, then if there are
+ * bytes to read: REPEATED START, SLA+R and the read bytes, then STOP.
+ * The descriptor is owned by the caller and must stay valid until it completes.
+ */
+typedef struct TWI_Transaction
+{
+	uint8 slaveAddress; /* device address with R/W=0 in bit 0 */
+	uint8 command[2]; /* bytes sent first, like the memory address */
+	uint8 commandLength;
+	const uint8 *writeData;
+	uint16 writeLength;
+	uint8 *readData;
+	uint16 readLength;
+	/* called from the TWI ISR when the transaction completes, or NULL_PTR */
+	void (*callBack)(struct TWI_Transaction *a_transaction);
+	volatile TWI_TransactionStatusType status;
+	struct TWI_Transaction *next; /* used by the driver queue */
+} TWI_TransactionType;
+
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
@@ -38,13 +70,47 @@ typedef struct
 #define TWI_START        	0x08 /* start has been sent */
 #define TWI_REP_START   	0x10 /* repeated start */
 #define TWI_MT_SLA_W_ACK 	0x18 /* Master transmit ( slave address + Write request ) to slave + ACK received from slave. */
+#define TWI_MT_SLA_W_NACK 	0x20 /* Master transmit ( slave address + Write request ) to slave + NACK received from slave. */
 #define TWI_MT_SLA_R_ACK 	0x40 /* Master transmit ( slave address + Read request ) to slave + ACK received from slave. */
+#define TWI_MT_SLA_R_NACK 	0x48 /* Master transmit ( slave address + Read request ) to slave + NACK received from slave. */
 #define TWI_MT_DATA_ACK  	0x28 /* Master transmit data and ACK has been received from Slave. */
+#define TWI_MT_DATA_NACK  	0x30 /* Master transmit data and NACK has been received from Slave. */
+#define TWI_ARB_LOST  		0x38 /* Arbitration lost in slave address or data bytes. */
 #define TWI_MR_DATA_ACK   	0x50 /* Master received data and send ACK to slave. */
 #define TWI_MR_DATA_NACK  	0x58 /* Master received data but doesn't send ACK to slave. */
 
 #define MC_ADDRESS 			0x01
 
+/* Standard and fast mode SCL frequencies in Hz */
+#define TWI_STANDARD_MODE_BIT_RATE	100000UL
+#define TWI_FAST_MODE_BIT_RATE		400000UL
+
+/* Minimum TWBR value in master mode (ATmega32 datasheet, TWI bit rate generator) */
+#define TWI_MIN_TWBR				10
+
+/*
+ * SCL frequency = F_CPU / (16 + 2 * TWBR * prescaler), the TWBR value is
+ * rounded up so the SCL frequency is never higher than the required one.
+ * A bit rate is valid if its TWBR is at least TWI_MIN_TWBR without prescaler,
+ * so the highest SCL frequency is F_CPU / 36 (222 kHz at 8 MHz), and at most
+ * 255 with the prescaler 64.
+ * These macros can be used in #if to check a constant bit rate at compile time.
+ */
+#define TWI_TWBR_VALUE(bitRate, prescaler) \
+	(((F_CPU) - (16UL * (bitRate)) + (2UL * (prescaler) * (bitRate)) - 1) \
+			/ (2UL * (prescaler) * (bitRate)))
+
+#define TWI_BIT_RATE_IS_VALID(bitRate) \
+	(((16UL * (bitRate)) <= (F_CPU)) \
+			&& (TWI_TWBR_VALUE(bitRate, 1UL) >= TWI_MIN_TWBR) \
+			&& (TWI_TWBR_VALUE(bitRate, 64UL) <= 255))
+
+/*
+ * Maximum restarts of a transaction after NACK of the slave address or lost
+ * arbitration, a 24Cxx EEPROM NACKs its address during its write cycle (5ms max)
+ */
+#define TWI_MAX_RETRIES		200
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -52,11 +118,18 @@ typedef struct
 /*
  * Description : Function to initialize the TWI driver
  * 	1. Set the required address.
- * 	2. Set the required Prescaler.
- * 	3. Set the required bit_rate.
- * 	4. Enable TWI.
+ * 	2. Calculate the smallest Prescaler and the bit_rate for the required SCL frequency.
+ * 	3. Enable TWI.
+ * Return FALSE and keep TWI disabled if the SCL frequency can't be generated from F_CPU
+ * with TWBR from TWI_MIN_TWBR to 255.
+ */
+uint8 TWI_init(const TWI_ConfigType *Config_Ptr);
+
+/*
+ * Description : Function to get the SCL frequency in Hz generated by the current
+ * bit_rate and Prescaler, it is not higher than the required one.
  */
-void TWI_init(const TWI_ConfigType *Config_Ptr);
+TWI_BitRate_Type TWI_getBitRate(void);
 
 /*
  * Description : Function to send start bit to the frame.
@@ -88,4 +161,17 @@ uint8 TWI_readByteWithNACK(void);
  */
 uint8 TWI_getStatus(void);
 
+/*
+ * Description : Function to add a transaction to the queue of the interrupt driven engine,
+ * the transaction starts at once if the engine is idle.
+ * Return FALSE if the transaction is already in the queue.
+ * The blocking functions above must not be used while the engine is busy.
+ */
+uint8 TWI_submitTransaction(TWI_TransactionType *a_transaction);
+
+/*
+ * Description : Function to check if the interrupt driven engine has no transactions.
+ */
+uint8 TWI_isIdle(void);
+
 #endif /* TWI_H_ */
@@ -0,0 +1,97 @@
+/*
+ ============================================================================
+ Name        : timer1_service.h
+ Author      : Ahmed Ali
+ Module Name : TIMER1
+ Layer       : MCAL
+ Date        : 18 Oct 2026
+ Description : Header file for the software timers service on top of TIMER1
+ ============================================================================
+ */
+
+#ifndef TIMER1_SERVICE_H_
+#define TIMER1_SERVICE_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Maximum number of software timers, its value should be less than 255 */
+#define TIMER1_SERVICE_MAX_TIMERS		8
+
+/* Returned by Timer1_createTimer when all the software timers are used */
+#define TIMER1_SERVICE_INVALID_ID		0xFF
+
+/*
+ * TIMER1 runs in CTC mode with prescaler 8, so it counts every 1 us at 8 MHz
+ * and gives one compare match (one tick) each 1 ms.
+ */
+#define TIMER1_SERVICE_TICK_COMPARE		((uint16) ((F_CPU / 8UL / 1000UL) - 1))
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	TIMER1_ONE_SHOT, TIMER1_PERIODIC
+} TIMER1_TimerModeType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start TIMER1 as a free running 1 ms tick and stop all the software timers.
+ */
+void Timer1_serviceInit(void);
+
+/*
+ * Description :
+ * Reserve one software timer with the required mode.
+ * The call back function (or NULL_PTR) is executed from the TIMER1 ISR at each expiry.
+ * Function output: the timer id, or TIMER1_SERVICE_INVALID_ID if no timer is free.
+ */
+uint8 Timer1_createTimer(TIMER1_TimerModeType mode, void (*a_ptr)(void));
+
+/*
+ * Description :
+ * Start (or restart) the software timer to expire after the required milliseconds,
+ * periodic timers are started again with the same period at each expiry.
+ */
+void Timer1_startTimer(uint8 id, uint16 a_ms);
+
+/*
+ * Description :
+ * Stop the software timer without executing its call back function.
+ */
+void Timer1_stopTimer(uint8 id);
+
+/*
+ * Description :
+ * Return the milliseconds remaining until the software timer expires, zero if stopped.
+ */
+uint16 Timer1_getRemainingTime(uint8 id);
+
+/*
+ * Description :
+ * Return TRUE once if the software timer expired since the last call, then clear the flag.
+ */
+uint8 Timer1_isTimerExpired(uint8 id);
+
+/*
+ * Description :
+ * Return the number of milliseconds passed since Timer1_serviceInit.
+ */
+uint32 Timer1_getTicks(void);
+
+/*
+ * Description :
+ * Return the number of TIMER1 counts (1 us each at 8 MHz) passed since Timer1_serviceInit.
+ */
+uint32 Timer1_getMicros(void);
+
+#endif /* TIMER1_SERVICE_H_ */
@@ -11,6 +11,78 @@
 
 #include "uart.h"
 #include "uart_private.h"
+#include "../../SERVICE/PROF/prof.h"
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define UART_RX_BUFFER_MASK		(UART_RX_BUFFER_SIZE - 1)
+#define UART_TX_BUFFER_MASK		(UART_TX_BUFFER_SIZE - 1)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/*
+ * Receive ring buffer, the head is written by the RX Complete ISR only
+ * and the tail is written by the application only.
+ */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+/*
+ * Transmit ring buffer, the head is written by the application only
+ * and the tail is written by the Data Register Empty ISR only.
+ */
+static volatile uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+static volatile uint8 g_txHead = 0;
+static volatile uint8 g_txTail = 0;
+
+/* Number of received bytes lost because the receive ring buffer was full */
+static volatile uint16 g_rxDropped = 0;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(USART_RXC_vect)
+{
+	/* Reading UDR clears the RXC flag, so read it even if there is no room for it */
+	uint8 data = UDR_REG;
+	uint8 next = (g_rxHead + 1) & UART_RX_BUFFER_MASK;
+
+	if (next != g_rxTail)
+	{
+		g_rxBuffer[g_rxHead] = data;
+		g_rxHead = next;
+	}
+	else
+	{
+		g_rxDropped++;
+	}
+}
+
+ISR(USART_UDRE_vect)
+{
+	if (g_txHead != g_txTail)
+	{
+		/* Move the next queued byte to the Tx buffer (UDR) */
+		UDR_REG = g_txBuffer[g_txTail];
+		g_txTail = (g_txTail + 1) & UART_TX_BUFFER_MASK;
+	}
+	else
+	{
+		/* Nothing left to send, stop the Data Register Empty interrupt */
+		UCSRB_REG.Bits.UDRIE_Bit = 0;
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
 
 /*
  * Description :
@@ -18,6 +90,7 @@
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
  * 2. Enable the UART.
  * 3. Setup the UART baud rate.
+ * 4. Enable the RX Complete interrupt which fills the receive ring buffer.
  */
 void UART_init(const UART_ConfigType *Config_Ptr)
 {
@@ -26,9 +99,10 @@ void UART_init(const UART_ConfigType *Config_Ptr)
 	UCSRA_REG.Bits.U2X_Bit = 1;
 
 	/************************** UCSRB Description **************************
-	 * RXCIE = 0 Disable USART RX Complete Interrupt Enable
+	 * RXCIE = 1 Enable USART RX Complete Interrupt Enable
 	 * TXCIE = 0 Disable USART Tx Complete Interrupt Enable
 	 * UDRIE = 0 Disable USART Data Register Empty Interrupt Enable
+	 *           (enabled by UART_write while there are bytes to send)
 	 * RXEN  = 1 Receiver Enable
 	 * RXEN  = 1 Transmitter Enable
 	 * UCSZ2 = 0 For 8-bit data mode
@@ -36,6 +110,7 @@ void UART_init(const UART_ConfigType *Config_Ptr)
 	 ***********************************************************************/
 	UCSRB_REG.Bits.TXEN_Bit = 1;
 	UCSRB_REG.Bits.RXEN_Bit = 1;
+	UCSRB_REG.Bits.RXCIE_Bit = 1;
 
 	/************************** UCSRC Description **************************
 	 * URSEL   = 1 The URSEL must be one when writing the UCSRC
@@ -73,43 +148,112 @@ void UART_init(const UART_ConfigType *Config_Ptr)
 	UBRRL_REG = ubrr_value;
 }
 
+/*
+ * Description :
+ * Queue up to length bytes in the transmit ring buffer without blocking.
+ * The bytes are sent in the background by the UDRE interrupt.
+ * Function output: number of bytes queued, less than length if the buffer is full.
+ */
+uint8 UART_write(const uint8 *data, uint8 length)
+{
+	uint8 count = 0;
+	uint8 next;
+
+	PROF_BEGIN(PROF_UART_WRITE);
+	while (count < length)
+	{
+		next = (g_txHead + 1) & UART_TX_BUFFER_MASK;
+		if (next == g_txTail)
+		{
+			/* The transmit ring buffer is full */
+			break;
+		}
+		g_txBuffer[g_txHead] = data[count];
+		g_txHead = next;
+		count++;
+	}
+
+	if (count != 0)
+	{
+		/* Start (or keep) the UDRE interrupt draining the transmit ring buffer */
+		UCSRB_REG.Bits.UDRIE_Bit = 1;
+	}
+	PROF_END(PROF_UART_WRITE);
+	return count;
+}
+
+/*
+ * Description :
+ * Copy up to length received bytes from the receive ring buffer without blocking.
+ * Function output: number of bytes copied, zero if nothing is received yet.
+ */
+uint8 UART_read(uint8 *data, uint8 length)
+{
+	uint8 count = 0;
+
+	PROF_BEGIN(PROF_UART_READ);
+	while ((count < length) && (g_rxTail != g_rxHead))
+	{
+		data[count] = g_rxBuffer[g_rxTail];
+		g_rxTail = (g_rxTail + 1) & UART_RX_BUFFER_MASK;
+		count++;
+	}
+	PROF_END(PROF_UART_READ);
+	return count;
+}
+
+/*
+ * Description :
+ * Return the number of received bytes waiting in the receive ring buffer.
+ */
+uint8 UART_available(void)
+{
+	return (g_rxHead - g_rxTail) & UART_RX_BUFFER_MASK;
+}
+
+/*
+ * Description :
+ * Return the number of received bytes dropped because the receive ring buffer was full.
+ */
+uint16 UART_getDroppedBytes(void)
+{
+	uint16 dropped;
+	uint8 interruptState = UCSRB_REG.Bits.RXCIE_Bit;
+
+	/* The 16-bit counter is updated by the RX Complete ISR, read it atomically */
+	UCSRB_REG.Bits.RXCIE_Bit = 0;
+	dropped = g_rxDropped;
+	UCSRB_REG.Bits.RXCIE_Bit = interruptState;
+	return dropped;
+}
+
 /*
  * Description :
  * Functional responsible for send byte to another UART device.
+ * Wait only if the transmit ring buffer is full.
  */
 void UART_sendByte(const uint8 data)
 {
-	/*
-	 * UDRE flag is set when the Tx buffer (UDR) is empty and ready for
-	 * transmitting a new byte so wait until this flag is set to one
-	 */
-	while (UCSRA_REG.Bits.UDRE_Bit == 0)
+	/* Wait until there is a free place in the transmit ring buffer */
+	while (UART_write(&data, 1) == 0)
 	{
 	}
-
-	/*
-	 * Put the required data in the UDR register and it also clear the UDRE flag as
-	 * the UDR register is not empty now
-	 */
-	UDR_REG = data;
 }
 
 /*
  * Description :
  * Functional responsible for receive byte from another UART device.
+ * Wait until a byte is available in the receive ring buffer.
  */
 uint8 UART_recieveByte(void)
 {
-	/* RXC flag is set when the UART receive data so wait until this flag is set to one */
-	while (UCSRA_REG.Bits.RXC_Bit == 0)
+	uint8 data;
+
+	/* Wait until the RX Complete ISR puts a byte in the receive ring buffer */
+	while (UART_read(&data, 1) == 0)
 	{
 	}
-
-	/*
-	 * Read the received data from the Rx buffer (UDR)
-	 * The RXC flag will be cleared after read the data
-	 */
-	return UDR_REG;
+	return data;
 }
 
 /*
@@ -14,6 +14,26 @@
 
 #include "../../LIB/std_types.h"
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Size of the receive and transmit ring buffers, its value should be a power of 2 */
+#define UART_RX_BUFFER_SIZE		32
+#define UART_TX_BUFFER_SIZE		32
+
+#if ((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) != 0) || (UART_RX_BUFFER_SIZE > 128)
+
+#error "UART RX buffer size should be a power of 2 and not more than 128"
+
+#endif
+
+#if ((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) != 0) || (UART_TX_BUFFER_SIZE > 128)
+
+#error "UART TX buffer size should be a power of 2 and not more than 128"
+
+#endif
+
 /*******************************************************************************
  *                         Types Declaration                                   *
  *******************************************************************************/
@@ -73,18 +93,48 @@ typedef struct
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
  * 2. Enable the UART.
  * 3. Setup the UART baud rate.
+ * 4. Enable the RX Complete interrupt which fills the receive ring buffer.
  */
 void UART_init(const UART_ConfigType *Config_Ptr);
 
+/*
+ * Description :
+ * Queue up to length bytes in the transmit ring buffer without blocking.
+ * The bytes are sent in the background by the UDRE interrupt.
+ * Function output: number of bytes queued, less than length if the buffer is full.
+ */
+uint8 UART_write(const uint8 *data, uint8 length);
+
+/*
+ * Description :
+ * Copy up to length received bytes from the receive ring buffer without blocking.
+ * Function output: number of bytes copied, zero if nothing is received yet.
+ */
+uint8 UART_read(uint8 *data, uint8 length);
+
+/*
+ * Description :
+ * Return the number of received bytes waiting in the receive ring buffer.
+ */
+uint8 UART_available(void);
+
+/*
+ * Description :
+ * Return the number of received bytes dropped because the receive ring buffer was full.
+ */
+uint16 UART_getDroppedBytes(void);
+
 /*
  * Description :
  * Functional responsible for send byte to another UART device.
+ * Wait only if the transmit ring buffer is full.
  */
 void UART_sendByte(const uint8 data);
 
 /*
  * Description :
  * Functional responsible for receive byte from another UART device.
+ * Wait until a byte is available in the receive ring buffer.
  */
 uint8 UART_recieveByte(void);
 
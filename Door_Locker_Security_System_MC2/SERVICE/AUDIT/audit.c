@@ -0,0 +1,392 @@
+/*
+ ============================================================================
+ Name        : audit.c
+ Author      : Ahmed Ali
+ Module Name : AUDIT
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the audit event log kept in the external EEPROM
+ ============================================================================
+ */
+
+#include "audit.h"
+#include "../../MCAL/TIMER1/timer1_service.h" /* to use the uptime of TIMER1 */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define AUDIT_RING_MASK				(AUDIT_RING_SIZE - 1)
+
+/* Byte offsets inside the event */
+#define AUDIT_TYPE_INDEX			0
+#define AUDIT_COUNTER_INDEX			1
+#define AUDIT_TIMESTAMP_INDEX		3
+#define AUDIT_CHECKSUM_INDEX		(AUDIT_EVENT_SIZE - 1)
+
+/* Seed of the event checksum, so a zeroed event is never taken as valid */
+#define AUDIT_CHECKSUM_SEED			0x5A
+
+#define AUDIT_PAGE_ADDRESS(page) \
+	((uint16) ((AUDIT_EEPROM_FIRST_PAGE + (page)) * EEPROM_PAGE_SIZE))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for calculating the checksum of the event.
+ */
+static uint8 AUDIT_checksum(const uint8 event[]);
+
+/*
+ * Function responsible for checking the type and the checksum of the event.
+ */
+static uint8 AUDIT_isEventValid(const uint8 event[]);
+
+/*
+ * Function responsible for ending the flush, it is called from the TWI ISR.
+ */
+static void AUDIT_pageWritten(uint8 result);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/*
+ * RAM ring of the events waiting for the flush, the head is written by AUDIT_log
+ * only and the tail is written by the end of the flush only.
+ */
+static uint8 g_ring[AUDIT_RING_SIZE][AUDIT_EVENT_SIZE];
+static uint8 g_ringHead = 0;
+static volatile uint8 g_ringTail = 0;
+
+/* Number of events dropped because the ring was full */
+static uint16 g_dropped = 0;
+
+/* Counter of the next event and the next page of the log */
+static uint16 g_nextCounter = 0;
+static volatile uint8 g_headPage = 0;
+
+/*
+ * TRUE after a complete scan. Until then the next page is not known, so the
+ * events wait in the RAM ring and no page is written over the newest events.
+ */
+static uint8 g_ready = FALSE;
+
+/* The page being written, it must not change until the write is completed */
+static uint8 g_flushPage[EEPROM_PAGE_SIZE];
+static uint8 g_flushCount;
+static volatile uint8 g_flushBusy = FALSE;
+
+/* Position of the running dump */
+static uint8 g_dumping = FALSE;
+static uint8 g_dumpPage;
+static uint8 g_dumpSlot;
+static uint8 g_dumpRing;
+static uint8 g_dumpBuffer[EEPROM_PAGE_SIZE];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Scan the pages of the log once to find its next page and its next counter.
+ * The TWI driver must be initialized before it.
+ * Return ERROR if a page can't be read, the events are kept in the RAM ring
+ * until a next scan is completed.
+ */
+uint8 AUDIT_init(void)
+{
+	uint8 page[EEPROM_PAGE_SIZE];
+	uint8 i, slot, found = FALSE;
+	uint8 headPage = 0;
+	uint16 counter, newest = 0;
+	uint8 *event;
+
+	g_ready = FALSE;
+	for (i = 0; i < AUDIT_EEPROM_NUM_PAGES; i++)
+	{
+		if (EEPROM_readBlock(AUDIT_PAGE_ADDRESS(i), page, EEPROM_PAGE_SIZE) == ERROR)
+		{
+			return ERROR;
+		}
+		for (slot = 0; slot < AUDIT_EVENTS_PER_PAGE; slot++)
+		{
+			if (AUDIT_isEventValid(&page[slot * AUDIT_EVENT_SIZE]) == FALSE)
+			{
+				continue;
+			}
+			counter = ((uint16) page[slot * AUDIT_EVENT_SIZE + AUDIT_COUNTER_INDEX] << 8)
+					| page[slot * AUDIT_EVENT_SIZE + AUDIT_COUNTER_INDEX + 1];
+			/* the counter wraps around, so the newer event is ahead by less than half */
+			if ((found == FALSE) || ((sint16) (counter - newest) > 0))
+			{
+				found = TRUE;
+				newest = counter;
+				/* the log continues after the page of the newest event */
+				headPage = (i + 1) % AUDIT_EEPROM_NUM_PAGES;
+			}
+		}
+	}
+
+	/* the scan is complete, the events logged before it are numbered after the newest one */
+	g_headPage = headPage;
+	g_nextCounter = (found == TRUE) ? (newest + 1) : 0;
+	for (i = g_ringTail; i != g_ringHead; i = (i + 1) & AUDIT_RING_MASK)
+	{
+		event = g_ring[i];
+		event[AUDIT_COUNTER_INDEX] = (uint8) (g_nextCounter >> 8);
+		event[AUDIT_COUNTER_INDEX + 1] = (uint8) g_nextCounter;
+		event[AUDIT_CHECKSUM_INDEX] = AUDIT_checksum(event);
+		g_nextCounter++;
+	}
+	g_ready = TRUE;
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Return TRUE if the scan of the log is completed.
+ */
+uint8 AUDIT_isReady(void)
+{
+	return g_ready;
+}
+
+/*
+ * Description :
+ * Add an event of the required type to the RAM ring without any EEPROM access.
+ * The event is dropped and counted if the ring is full.
+ * The TIMER1 service must be initialized before it.
+ */
+void AUDIT_log(uint8 type)
+{
+	uint8 next = (g_ringHead + 1) & AUDIT_RING_MASK;
+	uint32 timestamp;
+	uint8 *event;
+
+	if (type == AUDIT_EMPTY_TYPE)
+	{
+		return;
+	}
+	if (next == g_ringTail)
+	{
+		g_dropped++;
+		return;
+	}
+
+	timestamp = Timer1_getTicks();
+	event = g_ring[g_ringHead];
+	event[AUDIT_TYPE_INDEX] = type;
+	event[AUDIT_COUNTER_INDEX] = (uint8) (g_nextCounter >> 8);
+	event[AUDIT_COUNTER_INDEX + 1] = (uint8) g_nextCounter;
+	event[AUDIT_TIMESTAMP_INDEX] = (uint8) (timestamp >> 24);
+	event[AUDIT_TIMESTAMP_INDEX + 1] = (uint8) (timestamp >> 16);
+	event[AUDIT_TIMESTAMP_INDEX + 2] = (uint8) (timestamp >> 8);
+	event[AUDIT_TIMESTAMP_INDEX + 3] = (uint8) timestamp;
+	event[AUDIT_CHECKSUM_INDEX] = AUDIT_checksum(event);
+	g_nextCounter++;
+	g_ringHead = next;
+}
+
+/*
+ * Description :
+ * Start the page write of the waiting events when the flush policy requires it,
+ * it should be called periodically from the main loop.
+ */
+void AUDIT_poll(void)
+{
+	uint8 pending, i, tail;
+#if (AUDIT_FLUSH_POLICY == AUDIT_FLUSH_ON_TIME)
+	const uint8 *oldest;
+	uint32 timestamp;
+#endif
+
+	if ((g_ready == FALSE) || (g_flushBusy == TRUE) || (g_dumping == TRUE))
+	{
+		return;
+	}
+	tail = g_ringTail;
+	pending = (g_ringHead - tail) & AUDIT_RING_MASK;
+	if (pending == 0)
+	{
+		return;
+	}
+
+#if (AUDIT_FLUSH_POLICY == AUDIT_FLUSH_ON_SIZE)
+	if (pending < AUDIT_FLUSH_SIZE_THRESHOLD)
+	{
+		return;
+	}
+#else
+	if (pending < AUDIT_EVENTS_PER_PAGE)
+	{
+		oldest = g_ring[tail];
+		timestamp = ((uint32) oldest[AUDIT_TIMESTAMP_INDEX] << 24)
+				| ((uint32) oldest[AUDIT_TIMESTAMP_INDEX + 1] << 16)
+				| ((uint32) oldest[AUDIT_TIMESTAMP_INDEX + 2] << 8)
+				| oldest[AUDIT_TIMESTAMP_INDEX + 3];
+		if ((Timer1_getTicks() - timestamp) < AUDIT_FLUSH_PERIOD_MS)
+		{
+			return;
+		}
+	}
+#endif
+
+	/* one page holds a batch of events, the rest of the page stays empty */
+	g_flushCount = (pending < AUDIT_EVENTS_PER_PAGE) ? pending : AUDIT_EVENTS_PER_PAGE;
+	for (i = 0; i < EEPROM_PAGE_SIZE; i++)
+	{
+		g_flushPage[i] = (i < (g_flushCount * AUDIT_EVENT_SIZE)) ?
+				g_ring[(tail + (i / AUDIT_EVENT_SIZE)) & AUDIT_RING_MASK][i % AUDIT_EVENT_SIZE] :
+				AUDIT_EMPTY_TYPE;
+	}
+
+	/* the page is written in one write cycle, it is tried again later if the EEPROM is busy */
+	g_flushBusy = TRUE;
+	if (EEPROM_writeBlockAsync(AUDIT_PAGE_ADDRESS(g_headPage), g_flushPage,
+			EEPROM_PAGE_SIZE, AUDIT_pageWritten) == ERROR)
+	{
+		g_flushBusy = FALSE;
+	}
+}
+
+/*
+ * Description :
+ * Start reading the whole log from its oldest event, the flushes are held
+ * until the end of the dump so no event is read twice or missed.
+ */
+void AUDIT_dumpStart(void)
+{
+	/* wait for the running flush, it takes one write cycle at most */
+	while (g_flushBusy == TRUE)
+	{
+	}
+	g_dumping = TRUE;
+	g_dumpPage = 0;
+	g_dumpSlot = AUDIT_EVENTS_PER_PAGE;
+	g_dumpRing = g_ringTail;
+}
+
+/*
+ * Description :
+ * Copy the next event of the dump, the events in the EEPROM then the events
+ * still in the RAM ring.
+ * Return FALSE at the end of the dump.
+ */
+uint8 AUDIT_dumpNext(uint8 event[])
+{
+	uint8 i, valid;
+
+	if (g_dumping == FALSE)
+	{
+		return FALSE;
+	}
+
+	/* the oldest page is the next page of the log */
+	while (g_dumpPage < AUDIT_EEPROM_NUM_PAGES)
+	{
+		if (g_dumpSlot == AUDIT_EVENTS_PER_PAGE)
+		{
+			if (EEPROM_readBlock(
+					AUDIT_PAGE_ADDRESS((g_headPage + g_dumpPage) % AUDIT_EEPROM_NUM_PAGES),
+					g_dumpBuffer, EEPROM_PAGE_SIZE) == ERROR)
+			{
+				/* a page which can't be read is skipped */
+				for (i = 0; i < AUDIT_EVENTS_PER_PAGE; i++)
+				{
+					g_dumpBuffer[i * AUDIT_EVENT_SIZE + AUDIT_TYPE_INDEX] = AUDIT_EMPTY_TYPE;
+				}
+			}
+			g_dumpSlot = 0;
+		}
+		for (i = 0; i < AUDIT_EVENT_SIZE; i++)
+		{
+			event[i] = g_dumpBuffer[g_dumpSlot * AUDIT_EVENT_SIZE + i];
+		}
+		valid = AUDIT_isEventValid(event);
+		g_dumpSlot++;
+		if (g_dumpSlot == AUDIT_EVENTS_PER_PAGE)
+		{
+			g_dumpPage++;
+		}
+		if (valid == TRUE)
+		{
+			return TRUE;
+		}
+	}
+
+	/* then the events which are not flushed yet */
+	if (g_dumpRing != g_ringHead)
+	{
+		for (i = 0; i < AUDIT_EVENT_SIZE; i++)
+		{
+			event[i] = g_ring[g_dumpRing][i];
+		}
+		g_dumpRing = (g_dumpRing + 1) & AUDIT_RING_MASK;
+		return TRUE;
+	}
+
+	g_dumping = FALSE;
+	return FALSE;
+}
+
+/*
+ * Description :
+ * End the dump before its last event, the held flushes start again.
+ */
+void AUDIT_dumpStop(void)
+{
+	g_dumping = FALSE;
+}
+
+/*
+ * Description :
+ * Return the number of events dropped because the RAM ring was full.
+ */
+uint16 AUDIT_getDroppedEvents(void)
+{
+	return g_dropped;
+}
+
+/*
+ * Description :
+ * Calculate the checksum of the event, without its checksum byte.
+ */
+static uint8 AUDIT_checksum(const uint8 event[])
+{
+	uint8 i, checksum = AUDIT_CHECKSUM_SEED;
+	for (i = 0; i < AUDIT_CHECKSUM_INDEX; i++)
+	{
+		checksum = (uint8) ((checksum << 1) | (checksum >> 7)) ^ event[i];
+	}
+	return checksum;
+}
+
+/*
+ * Description :
+ * Check the type and the checksum of the event.
+ */
+static uint8 AUDIT_isEventValid(const uint8 event[])
+{
+	return ((event[AUDIT_TYPE_INDEX] != AUDIT_EMPTY_TYPE)
+			&& (event[AUDIT_CHECKSUM_INDEX] == AUDIT_checksum(event))) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * End the flush, it is called from the TWI ISR.
+ */
+static void AUDIT_pageWritten(uint8 result)
+{
+	if (result == SUCCESS)
+	{
+		/* the events are in the EEPROM now, free them from the ring */
+		g_ringTail = (g_ringTail + g_flushCount) & AUDIT_RING_MASK;
+		g_headPage = (g_headPage + 1) % AUDIT_EEPROM_NUM_PAGES;
+	}
+	/* on failure the events stay in the ring and the same page is written again */
+	g_flushBusy = FALSE;
+}
@@ -0,0 +1,130 @@
+/*
+ ============================================================================
+ Name        : audit.h
+ Author      : Ahmed Ali
+ Module Name : AUDIT
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the audit event log kept in the external EEPROM
+ ============================================================================
+ */
+
+#ifndef AUDIT_H_
+#define AUDIT_H_
+
+#include "../../LIB/std_types.h"
+#include "../../HAL/EXTERNAL_EEPROM/external_eeprom.h" /* to use the EEPROM page size */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Event format, in RAM and in the external EEPROM:
+ * | TYPE | COUNTER (2 bytes) | TIMESTAMP (4 bytes) | CHECKSUM |
+ * The counter numbers the events, the timestamp is the uptime in milliseconds.
+ * An event of type AUDIT_EMPTY_TYPE (erased EEPROM) is not an event.
+ */
+#define AUDIT_EVENT_SIZE			8
+#define AUDIT_EMPTY_TYPE			0xFF
+#define AUDIT_EVENTS_PER_PAGE		(EEPROM_PAGE_SIZE / AUDIT_EVENT_SIZE)
+
+/* The circular region of the log, the last pages of the EEPROM */
+#define AUDIT_EEPROM_FIRST_PAGE		80
+#define AUDIT_EEPROM_NUM_PAGES		48
+
+#if ((AUDIT_EEPROM_FIRST_PAGE + AUDIT_EEPROM_NUM_PAGES) > (EEPROM_SIZE / EEPROM_PAGE_SIZE))
+#error "The audit log doesn't fit in the EEPROM"
+#endif
+
+/* Number of events the RAM ring holds until they are flushed, its value should be a power of 2 */
+#define AUDIT_RING_SIZE				16
+
+#if ((AUDIT_RING_SIZE & (AUDIT_RING_SIZE - 1)) != 0)
+#error "Audit ring size should be a power of 2"
+#endif
+
+/*
+ * Flush policy:
+ * AUDIT_FLUSH_ON_SIZE: a page is written when AUDIT_FLUSH_SIZE_THRESHOLD events are waiting.
+ * AUDIT_FLUSH_ON_TIME: a full page is written at once, a part of a page is written
+ *                      when its oldest event waited AUDIT_FLUSH_PERIOD_MS.
+ */
+#define AUDIT_FLUSH_ON_SIZE			0
+#define AUDIT_FLUSH_ON_TIME			1
+
+/* they can also be given by the build, the host benchmark builds both policies */
+#ifndef AUDIT_FLUSH_POLICY
+#define AUDIT_FLUSH_POLICY			AUDIT_FLUSH_ON_TIME
+#endif
+#ifndef AUDIT_FLUSH_SIZE_THRESHOLD
+#define AUDIT_FLUSH_SIZE_THRESHOLD	AUDIT_EVENTS_PER_PAGE
+#endif
+#define AUDIT_FLUSH_PERIOD_MS		5000
+
+#if (AUDIT_FLUSH_SIZE_THRESHOLD == 0) || (AUDIT_FLUSH_SIZE_THRESHOLD > AUDIT_EVENTS_PER_PAGE)
+#error "Audit flush size threshold should be from 1 to the events of one page"
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Scan the pages of the log once to find its next page and its next counter.
+ * The TWI driver must be initialized before it.
+ * Return ERROR if a page can't be read, the events are kept in the RAM ring
+ * until a next scan is completed.
+ */
+uint8 AUDIT_init(void);
+
+/*
+ * Description :
+ * Return TRUE if the scan of the log is completed.
+ */
+uint8 AUDIT_isReady(void);
+
+/*
+ * Description :
+ * Add an event of the required type to the RAM ring without any EEPROM access.
+ * The event is dropped and counted if the ring is full.
+ * The TIMER1 service must be initialized before it.
+ */
+void AUDIT_log(uint8 type);
+
+/*
+ * Description :
+ * Start the page write of the waiting events when the flush policy requires it,
+ * it should be called periodically from the main loop.
+ */
+void AUDIT_poll(void);
+
+/*
+ * Description :
+ * Start reading the whole log from its oldest event, the flushes are held
+ * until the end of the dump so no event is read twice or missed.
+ */
+void AUDIT_dumpStart(void);
+
+/*
+ * Description :
+ * Copy the next event of the dump, the events in the EEPROM then the events
+ * still in the RAM ring.
+ * Return FALSE at the end of the dump.
+ */
+uint8 AUDIT_dumpNext(uint8 event[]);
+
+/*
+ * Description :
+ * End the dump before its last event, the held flushes start again.
+ */
+void AUDIT_dumpStop(void);
+
+/*
+ * Description :
+ * Return the number of events dropped because the RAM ring was full.
+ */
+uint16 AUDIT_getDroppedEvents(void);
+
+#endif /* AUDIT_H_ */
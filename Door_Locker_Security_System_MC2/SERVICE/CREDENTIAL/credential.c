@@ -0,0 +1,462 @@
+/*
+ ============================================================================
+ Name        : credential.c
+ Author      : Ahmed Ali
+ Module Name : CREDENTIAL
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the table of the salted user password hashes
+ ============================================================================
+ */
+
+#include "credential.h"
+#include "../../MCAL/TIMER1/timer1_service.h" /* to use the time as a source of the salts */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Byte offsets inside the record */
+#define CREDENTIAL_TAG_INDEX			0
+#define CREDENTIAL_SALT_INDEX			(CREDENTIAL_TAG_INDEX + CREDENTIAL_TAG_LENGTH)
+#define CREDENTIAL_VERIFIER_INDEX		(CREDENTIAL_SALT_INDEX + CREDENTIAL_SALT_LENGTH)
+
+#define CREDENTIAL_IS_USED(slot)		((g_used[(slot) / 8] & (1 << ((slot) % 8))) != 0)
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for calculating the tag of the password.
+ */
+static uint16 CREDENTIAL_tag(const uint8 password[]);
+
+/*
+ * Function responsible for calculating the verifier of the salt and the password.
+ */
+static void CREDENTIAL_verifier(const uint8 salt[], const uint8 password[],
+		uint8 verifier[]);
+
+/*
+ * Function responsible for finding the lowest used slot of the tag.
+ */
+static uint8 CREDENTIAL_find(uint16 tag);
+
+/*
+ * Function responsible for reading the record of the slot and comparing its verifier.
+ */
+static uint8 CREDENTIAL_verify(uint8 slot, const uint8 password[], uint8 *difference);
+
+/*
+ * Function responsible for checking that the tag finds the password for the slot.
+ */
+static uint8 CREDENTIAL_isTagFree(uint8 slot, uint16 tag, const uint8 password[]);
+
+/*
+ * Function responsible for writing the record being written to the record store.
+ */
+static uint8 CREDENTIAL_writeRecord(uint8 slot, uint8 length,
+		void (*a_ptr)(uint8 result));
+
+/*
+ * Function responsible for ending the write, it is called from the TWI ISR.
+ */
+static void CREDENTIAL_recordWritten(uint8 result);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const uint8 g_hashKey[HASH_KEY_LENGTH] = CREDENTIAL_HASH_KEY;
+static const uint8 g_tagKey[HASH_KEY_LENGTH] = CREDENTIAL_TAG_KEY;
+
+/* RAM copy of the tags of the slots and the bit map of the used slots */
+static uint16 g_tag[CREDENTIAL_MAX_USERS];
+static uint8 g_used[(CREDENTIAL_MAX_USERS + 7) / 8];
+
+/* TRUE if the RAM copy is the same as the EEPROM table */
+static uint8 g_cacheValid = FALSE;
+
+/* Number of the made salts, so two salts differ even at the same time */
+static uint32 g_saltCount = 0;
+
+/*
+ * The record being written, its length and its slot, they must not change
+ * until the write is completed, and the call back of the write
+ */
+static uint8 g_writeRecord[CREDENTIAL_RECORD_LENGTH];
+static uint8 g_writeLength;
+static uint8 g_writeSlot;
+static volatile uint8 g_saving = FALSE;
+static void (*g_savedCallBack)(uint8 result) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the tag of each used slot from the EEPROM record store to RAM.
+ * The record store must be scanned before it.
+ * Return TRUE if any user has a password.
+ */
+uint8 CREDENTIAL_init(void)
+{
+	uint8 record[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 slot, length, found = FALSE;
+
+	g_cacheValid = FALSE;
+	if (EEPROM_storeIsReady() == FALSE)
+	{
+		return FALSE;
+	}
+	for (slot = 0; slot < CREDENTIAL_MAX_USERS; slot++)
+	{
+		g_used[slot / 8] &= ~(1 << (slot % 8));
+		g_tag[slot] = 0;
+		/* a slot without a record was never used */
+		if (EEPROM_storeHasRecord(CREDENTIAL_STORE_KEY(slot)) == FALSE)
+		{
+			continue;
+		}
+		if (EEPROM_storeRead(CREDENTIAL_STORE_KEY(slot), record, &length) == ERROR)
+		{
+			return FALSE;
+		}
+		/* the record of a revoked slot has no payload */
+		if (length == CREDENTIAL_RECORD_LENGTH)
+		{
+			g_tag[slot] = ((uint16) record[CREDENTIAL_TAG_INDEX] << 8)
+					| record[CREDENTIAL_TAG_INDEX + 1];
+			g_used[slot / 8] |= (1 << (slot % 8));
+			found = TRUE;
+		}
+	}
+	g_cacheValid = TRUE;
+	return found;
+}
+
+/*
+ * Description :
+ * Find the user of the password and check it with its verifier. The work is
+ * the same for any password and any number of users: one 32-bit hash of the
+ * password for its tag, one pass over the RAM tags of all the slots, one record
+ * read from the EEPROM and one 32-bit hash of the salt and the password.
+ * If more than one user has the password, the lowest slot is taken.
+ * The slot is CREDENTIAL_NO_SLOT if no user has the password.
+ * Return TRUE if the password is correct, or CREDENTIAL_UNAVAILABLE if the
+ * table can't be read from the EEPROM.
+ */
+uint8 CREDENTIAL_check(const uint8 password[], uint8 *slot)
+{
+	uint8 found, difference;
+
+	*slot = CREDENTIAL_NO_SLOT;
+	if ((g_cacheValid == FALSE) && (g_saving == FALSE))
+	{
+		/* the table was not read or the last write failed, load it again */
+		(void) CREDENTIAL_init();
+	}
+	if (g_cacheValid == FALSE)
+	{
+		return CREDENTIAL_UNAVAILABLE;
+	}
+
+	found = CREDENTIAL_find(CREDENTIAL_tag(password));
+
+	/* a record is read and hashed even if no slot has the tag */
+	if (CREDENTIAL_verify((found != CREDENTIAL_NO_SLOT) ? found : CREDENTIAL_ADMIN_SLOT,
+			password, &difference) == ERROR)
+	{
+		/* the password of a found slot is not known wrong, any other one is */
+		return (found != CREDENTIAL_NO_SLOT) ? CREDENTIAL_UNAVAILABLE : FALSE;
+	}
+	if ((found == CREDENTIAL_NO_SLOT) || (difference != 0))
+	{
+		return FALSE;
+	}
+	*slot = found;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Tell if the slot has no password, the EEPROM table is loaded again if the
+ * last write failed.
+ * Return TRUE if the slot is free, FALSE if it is used or the table can't be read.
+ */
+uint8 CREDENTIAL_isSlotFree(uint8 slot)
+{
+	if ((g_cacheValid == FALSE) && (g_saving == FALSE))
+	{
+		(void) CREDENTIAL_init();
+	}
+	if (g_cacheValid == FALSE)
+	{
+		return FALSE;
+	}
+	return ((slot < CREDENTIAL_MAX_USERS) && (CREDENTIAL_IS_USED(slot) == FALSE)) ?
+			TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Set the password of the slot with a new salt and write its record to the EEPROM,
+ * the RAM tag is updated and the call back is called from the TWI ISR with
+ * SUCCESS or ERROR when the write cycle is completed.
+ * Two users may have the same password, it is never refused for that.
+ * Return ERROR if the slot is not valid, the table can't be read or another
+ * user has a different password with the same tag (about one password in a
+ * thousand with all the slots used), or CREDENTIAL_BUSY if the previous write
+ * is not completed yet.
+ */
+uint8 CREDENTIAL_save(uint8 slot, const uint8 password[],
+		void (*a_ptr)(uint8 result))
+{
+	uint8 saltSource[9];
+	uint8 salt[HASH_OUTPUT_32_BITS];
+	uint8 i;
+	uint16 tag;
+	uint32 time;
+
+	if (g_saving == TRUE)
+	{
+		return CREDENTIAL_BUSY;
+	}
+	if ((slot >= CREDENTIAL_MAX_USERS) || (g_cacheValid == FALSE))
+	{
+		return ERROR;
+	}
+	tag = CREDENTIAL_tag(password);
+	if (CREDENTIAL_isTagFree(slot, tag, password) == FALSE)
+	{
+		return ERROR;
+	}
+
+	/*
+	 * the salt is the keyed hash of the time in microseconds, which follows the
+	 * key presses of the user, the number of the made salts and the slot
+	 */
+	time = Timer1_getMicros();
+	saltSource[0] = (uint8) time;
+	saltSource[1] = (uint8) (time >> 8);
+	saltSource[2] = (uint8) (time >> 16);
+	saltSource[3] = (uint8) (time >> 24);
+	saltSource[4] = (uint8) g_saltCount;
+	saltSource[5] = (uint8) (g_saltCount >> 8);
+	saltSource[6] = (uint8) (g_saltCount >> 16);
+	saltSource[7] = (uint8) (g_saltCount >> 24);
+	saltSource[8] = slot;
+	g_saltCount++;
+	HASH_halfSipHash(g_hashKey, saltSource, sizeof(saltSource), salt,
+			HASH_OUTPUT_32_BITS);
+
+	g_writeRecord[CREDENTIAL_TAG_INDEX] = (uint8) (tag >> 8);
+	g_writeRecord[CREDENTIAL_TAG_INDEX + 1] = (uint8) tag;
+	for (i = 0; i < CREDENTIAL_SALT_LENGTH; i++)
+	{
+		g_writeRecord[CREDENTIAL_SALT_INDEX + i] = salt[i];
+	}
+	CREDENTIAL_verifier(&g_writeRecord[CREDENTIAL_SALT_INDEX], password,
+			&g_writeRecord[CREDENTIAL_VERIFIER_INDEX]);
+	return CREDENTIAL_writeRecord(slot, CREDENTIAL_RECORD_LENGTH, a_ptr);
+}
+
+/*
+ * Description :
+ * Free the slot and write its record to the EEPROM, the RAM tag is updated
+ * and the call back is called from the TWI ISR with SUCCESS or ERROR when the
+ * write cycle is completed.
+ * Return ERROR if the slot is not used or it is the admin slot,
+ * or CREDENTIAL_BUSY if the previous write is not completed yet.
+ */
+uint8 CREDENTIAL_revoke(uint8 slot, void (*a_ptr)(uint8 result))
+{
+	if (g_saving == TRUE)
+	{
+		return CREDENTIAL_BUSY;
+	}
+	if ((slot >= CREDENTIAL_MAX_USERS) || (slot == CREDENTIAL_ADMIN_SLOT)
+			|| (g_cacheValid == FALSE) || (CREDENTIAL_IS_USED(slot) == FALSE))
+	{
+		return ERROR;
+	}
+	return CREDENTIAL_writeRecord(slot, 0, a_ptr);
+}
+
+/*
+ * Description :
+ * Calculate the tag of the password, 16 bits of its keyed hash.
+ */
+static uint16 CREDENTIAL_tag(const uint8 password[])
+{
+	uint8 hash[HASH_OUTPUT_32_BITS];
+
+	HASH_halfSipHash(g_tagKey, password, CREDENTIAL_PASSWORD_LENGTH, hash,
+			HASH_OUTPUT_32_BITS);
+	return ((uint16) hash[0] << 8) | hash[1];
+}
+
+/*
+ * Description :
+ * Calculate the verifier, the keyed hash of the salt followed by the password.
+ */
+static void CREDENTIAL_verifier(const uint8 salt[], const uint8 password[],
+		uint8 verifier[])
+{
+	uint8 i;
+	uint8 message[CREDENTIAL_SALT_LENGTH + CREDENTIAL_PASSWORD_LENGTH];
+
+	for (i = 0; i < CREDENTIAL_SALT_LENGTH; i++)
+	{
+		message[i] = salt[i];
+	}
+	for (i = 0; i < CREDENTIAL_PASSWORD_LENGTH; i++)
+	{
+		message[CREDENTIAL_SALT_LENGTH + i] = password[i];
+	}
+	HASH_halfSipHash(g_hashKey, message, sizeof(message), verifier,
+			CREDENTIAL_VERIFIER_LENGTH);
+}
+
+/*
+ * Description :
+ * Find the lowest used slot of the tag, all the slots are visited and the
+ * match is selected without a branch, so the time doesn't depend on the slot
+ * or on the number of the users.
+ */
+static uint8 CREDENTIAL_find(uint16 tag)
+{
+	uint8 slot, mask, found = CREDENTIAL_NO_SLOT;
+
+	/* the slots are visited from the highest, so the lowest match is kept */
+	for (slot = CREDENTIAL_MAX_USERS; slot > 0; slot--)
+	{
+		/* mask is 0xFF for the used slot of the tag, otherwise 0x00 */
+		mask = (uint8) -(uint8) ((g_tag[slot - 1] == tag) & CREDENTIAL_IS_USED(slot - 1));
+		found = (found & ~mask) | ((slot - 1) & mask);
+	}
+	return found;
+}
+
+/*
+ * Description :
+ * Read the record of the slot and compare the verifier of the password with
+ * it in all its bytes, the difference is zero if the password is the one of
+ * the slot. Return ERROR if the record can't be read.
+ */
+static uint8 CREDENTIAL_verify(uint8 slot, const uint8 password[], uint8 *difference)
+{
+	uint8 record[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 verifier[CREDENTIAL_VERIFIER_LENGTH];
+	uint8 i, length = 0;
+
+	if (EEPROM_storeRead(CREDENTIAL_STORE_KEY(slot), record, &length) == ERROR)
+	{
+		/* a slot without a record in the scanned store is read as a free slot */
+		if ((EEPROM_storeIsReady() == FALSE)
+				|| (EEPROM_storeHasRecord(CREDENTIAL_STORE_KEY(slot)) == TRUE))
+		{
+			return ERROR;
+		}
+		for (i = 0; i < CREDENTIAL_RECORD_LENGTH; i++)
+		{
+			record[i] = 0xFF;
+		}
+	}
+	CREDENTIAL_verifier(&record[CREDENTIAL_SALT_INDEX], password, verifier);
+
+	/* compare all the bytes, so the time doesn't depend on the first wrong byte */
+	*difference = (uint8) (length ^ CREDENTIAL_RECORD_LENGTH);
+	for (i = 0; i < CREDENTIAL_VERIFIER_LENGTH; i++)
+	{
+		*difference |= verifier[i] ^ record[CREDENTIAL_VERIFIER_INDEX + i];
+	}
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Check that the checks will find the password for the slot: each other
+ * used slot with the same tag must have the same password, the lowest slot
+ * of a shared password is found for all its users.
+ */
+static uint8 CREDENTIAL_isTagFree(uint8 slot, uint16 tag, const uint8 password[])
+{
+	uint8 other, difference;
+
+	for (other = 0; other < CREDENTIAL_MAX_USERS; other++)
+	{
+		if ((other == slot) || (CREDENTIAL_IS_USED(other) == FALSE)
+				|| (g_tag[other] != tag))
+		{
+			continue;
+		}
+		if ((CREDENTIAL_verify(other, password, &difference) == ERROR)
+				|| (difference != 0))
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Write the record being written to the record store, the old record of the
+ * slot stays valid until the new one is completed.
+ */
+static uint8 CREDENTIAL_writeRecord(uint8 slot, uint8 length,
+		void (*a_ptr)(uint8 result))
+{
+	g_saving = TRUE;
+	g_writeSlot = slot;
+	g_writeLength = length;
+	g_savedCallBack = a_ptr;
+	if (EEPROM_storeWriteAsync(CREDENTIAL_STORE_KEY(slot), g_writeRecord, length,
+			CREDENTIAL_recordWritten) == ERROR)
+	{
+		/* the store is busy with the write of another record */
+		g_saving = FALSE;
+		return CREDENTIAL_BUSY;
+	}
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * End the write, it is called from the TWI ISR. The written record becomes the
+ * current record of the slot in RAM, so the checks find it from now on.
+ */
+static void CREDENTIAL_recordWritten(uint8 result)
+{
+	uint8 slot = g_writeSlot;
+
+	if (result == SUCCESS)
+	{
+		if (g_writeLength == CREDENTIAL_RECORD_LENGTH)
+		{
+			g_tag[slot] = ((uint16) g_writeRecord[CREDENTIAL_TAG_INDEX] << 8)
+					| g_writeRecord[CREDENTIAL_TAG_INDEX + 1];
+			g_used[slot / 8] |= (1 << (slot % 8));
+		}
+		else
+		{
+			g_used[slot / 8] &= ~(1 << (slot % 8));
+		}
+	}
+	else
+	{
+		/*
+		 * the old record is still valid, but the EEPROM state is not known,
+		 * load it again on the next check
+		 */
+		g_cacheValid = FALSE;
+	}
+	g_saving = FALSE;
+	if (g_savedCallBack != NULL_PTR)
+	{
+		g_savedCallBack(result);
+	}
+}
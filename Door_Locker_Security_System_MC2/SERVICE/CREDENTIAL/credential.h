@@ -0,0 +1,132 @@
+/*
+ ============================================================================
+ Name        : credential.h
+ Author      : Ahmed Ali
+ Module Name : CREDENTIAL
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the table of the salted user password hashes
+ ============================================================================
+ */
+
+#ifndef CREDENTIAL_H_
+#define CREDENTIAL_H_
+
+#include "../../LIB/std_types.h"
+#include "../../HAL/EXTERNAL_EEPROM/eeprom_store.h" /* to keep the user records in the record store */
+#include "../HASH/hash.h" /* to use the keyed hash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CREDENTIAL_PASSWORD_LENGTH		5
+
+/* Returned with ERROR and SUCCESS when the previous write is not completed yet */
+#define CREDENTIAL_BUSY					2
+
+/*
+ * Returned with TRUE and FALSE when the table can't be read from the EEPROM,
+ * the password is not checked so it is neither correct nor wrong
+ */
+#define CREDENTIAL_UNAVAILABLE			2
+
+/* Number of the user slots, the slot of the admin can't be revoked */
+#define CREDENTIAL_MAX_USERS			64
+#define CREDENTIAL_ADMIN_SLOT			0
+
+/* Returned as the slot when no user has the password */
+#define CREDENTIAL_NO_SLOT				0xFF
+
+/*
+ * The record of each user slot is a record of the EEPROM record store, so its
+ * writes are spread over the pages of the store and the old record stays valid
+ * until the new one is completed:
+ * | TAG (2 bytes) | SALT (2 bytes) | VERIFIER (4 bytes) |
+ * The tag is 16 bits of the keyed hash of the password without a salt, it finds
+ * the slot of a password. The verifier is the keyed hash of the salt and the
+ * password, the salt is made for each saved password. The hashes are
+ * HalfSipHash-2-4 with two different keys. A free slot has a record without
+ * payload or no record.
+ */
+#define CREDENTIAL_TAG_LENGTH			2
+#define CREDENTIAL_SALT_LENGTH			2
+#define CREDENTIAL_VERIFIER_LENGTH		HASH_OUTPUT_32_BITS
+#define CREDENTIAL_RECORD_LENGTH \
+	(CREDENTIAL_TAG_LENGTH + CREDENTIAL_SALT_LENGTH + CREDENTIAL_VERIFIER_LENGTH)
+
+/* The store key of the record of the slot */
+#define CREDENTIAL_STORE_KEY(slot)		(EEPROM_STORE_SERVICE_KEYS + (slot))
+
+#if (CREDENTIAL_RECORD_LENGTH > EEPROM_STORE_MAX_PAYLOAD)
+#error "A user record doesn't fit in a record of the store"
+#endif
+
+#if (CREDENTIAL_STORE_KEY(CREDENTIAL_MAX_USERS) > EEPROM_STORE_MAX_KEYS)
+#error "The record store has no key for each user slot"
+#endif
+
+/* Keys of the password hashes, they should be changed for each product */
+#define CREDENTIAL_HASH_KEY \
+	{ 0x3C, 0x91, 0x5E, 0xD2, 0x07, 0xA8, 0x6B, 0xF4 }
+#define CREDENTIAL_TAG_KEY \
+	{ 0xB5, 0x2E, 0x74, 0x0F, 0xC9, 0x63, 0x1A, 0x8D }
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the tag of each used slot from the EEPROM record store to RAM.
+ * The record store must be scanned before it.
+ * Return TRUE if any user has a password.
+ */
+uint8 CREDENTIAL_init(void);
+
+/*
+ * Description :
+ * Find the user of the password and check it with its verifier. The work is
+ * the same for any password and any number of users: one 32-bit hash of the
+ * password for its tag, one pass over the RAM tags of all the slots, one record
+ * read from the EEPROM and one 32-bit hash of the salt and the password.
+ * If more than one user has the password, the lowest slot is taken.
+ * The slot is CREDENTIAL_NO_SLOT if no user has the password.
+ * Return TRUE if the password is correct, or CREDENTIAL_UNAVAILABLE if the
+ * table can't be read from the EEPROM.
+ */
+uint8 CREDENTIAL_check(const uint8 password[], uint8 *slot);
+
+/*
+ * Description :
+ * Tell if the slot has no password, the EEPROM table is loaded again if the
+ * last write failed.
+ * Return TRUE if the slot is free, FALSE if it is used or the table can't be read.
+ */
+uint8 CREDENTIAL_isSlotFree(uint8 slot);
+
+/*
+ * Description :
+ * Set the password of the slot with a new salt and write its record to the EEPROM,
+ * the RAM tag is updated and the call back is called from the TWI ISR with
+ * SUCCESS or ERROR when the write cycle is completed.
+ * Two users may have the same password, it is never refused for that.
+ * Return ERROR if the slot is not valid, the table can't be read or another
+ * user has a different password with the same tag (about one password in a
+ * thousand with all the slots used), or CREDENTIAL_BUSY if the previous write
+ * is not completed yet.
+ */
+uint8 CREDENTIAL_save(uint8 slot, const uint8 password[],
+		void (*a_ptr)(uint8 result));
+
+/*
+ * Description :
+ * Free the slot and write its record to the EEPROM, the RAM tag is updated
+ * and the call back is called from the TWI ISR with SUCCESS or ERROR when the
+ * write cycle is completed.
+ * Return ERROR if the slot is not used or it is the admin slot,
+ * or CREDENTIAL_BUSY if the previous write is not completed yet.
+ */
+uint8 CREDENTIAL_revoke(uint8 slot, void (*a_ptr)(uint8 result));
+
+#endif /* CREDENTIAL_H_ */
@@ -0,0 +1,169 @@
+/*
+ ============================================================================
+ Name        : frame.c
+ Author      : Ahmed Ali
+ Module Name : FRAME
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the framed UART link between the two ECUs
+ ============================================================================
+ */
+
+#include "frame.h"
+#include "../../MCAL/UART/uart.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	WAIT_START, WAIT_TYPE, WAIT_LENGTH, WAIT_PAYLOAD, WAIT_CRC
+} FRAME_ParserStateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* State of the receive parser, kept between calls as bytes arrive one by one */
+static FRAME_ParserStateType g_parserState = WAIT_START;
+static uint8 g_parserIndex = 0;
+static uint8 g_parserCrc = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Update the CRC-8 (polynomial 0x07) with one byte.
+ */
+static uint8 FRAME_crc8Update(uint8 crc, uint8 data);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Send one frame with the required type and payload through UART.
+ */
+void FRAME_send(uint8 type, const uint8 *payload, uint8 length)
+{
+	uint8 i;
+	uint8 crc = 0;
+
+	UART_sendByte(FRAME_START_BYTE);
+	UART_sendByte(type);
+	crc = FRAME_crc8Update(crc, type);
+	UART_sendByte(length);
+	crc = FRAME_crc8Update(crc, length);
+	for (i = 0; i < length; i++)
+	{
+		UART_sendByte(payload[i]);
+		crc = FRAME_crc8Update(crc, payload[i]);
+	}
+	UART_sendByte(crc);
+}
+
+/*
+ * Description :
+ * Feed one received byte to the frame parser.
+ * Function output: FRAME_RECEIVED when a valid frame is completed in frame,
+ *                  FRAME_CORRUPTED when a frame failed its CRC or length check,
+ *                  otherwise FRAME_INCOMPLETE.
+ */
+FRAME_StatusType FRAME_parseByte(uint8 byte, FRAME_Type *frame)
+{
+	FRAME_StatusType status = FRAME_INCOMPLETE;
+
+	switch (g_parserState)
+	{
+	case WAIT_START:
+		/* Skip any noise between frames */
+		if (byte == FRAME_START_BYTE)
+		{
+			g_parserCrc = 0;
+			g_parserState = WAIT_TYPE;
+		}
+		break;
+	case WAIT_TYPE:
+		frame->type = byte;
+		g_parserCrc = FRAME_crc8Update(g_parserCrc, byte);
+		g_parserState = WAIT_LENGTH;
+		break;
+	case WAIT_LENGTH:
+		if (byte > FRAME_MAX_PAYLOAD)
+		{
+			status = FRAME_CORRUPTED;
+			g_parserState = WAIT_START;
+		}
+		else
+		{
+			frame->length = byte;
+			g_parserCrc = FRAME_crc8Update(g_parserCrc, byte);
+			g_parserIndex = 0;
+			g_parserState = (byte == 0) ? WAIT_CRC : WAIT_PAYLOAD;
+		}
+		break;
+	case WAIT_PAYLOAD:
+		frame->payload[g_parserIndex] = byte;
+		g_parserCrc = FRAME_crc8Update(g_parserCrc, byte);
+		g_parserIndex++;
+		if (g_parserIndex == frame->length)
+		{
+			g_parserState = WAIT_CRC;
+		}
+		break;
+	case WAIT_CRC:
+		status = (byte == g_parserCrc) ? FRAME_RECEIVED : FRAME_CORRUPTED;
+		g_parserState = WAIT_START;
+		break;
+	}
+	return status;
+}
+
+/*
+ * Description :
+ * Consume the bytes already received by UART without blocking.
+ * A corrupted frame is answered by a NACK frame so the sender repeats it.
+ * Function output: FRAME_RECEIVED when a valid frame is completed in frame.
+ */
+FRAME_StatusType FRAME_poll(FRAME_Type *frame)
+{
+	uint8 byte;
+	FRAME_StatusType status = FRAME_INCOMPLETE;
+
+	while ((status != FRAME_RECEIVED) && (UART_read(&byte, 1) != 0))
+	{
+		status = FRAME_parseByte(byte, frame);
+		if (status == FRAME_CORRUPTED)
+		{
+			FRAME_send(FRAME_NACK, NULL_PTR, 0);
+		}
+	}
+	return status;
+}
+
+/*
+ * Description :
+ * Update the CRC-8 (polynomial 0x07) with one byte.
+ */
+static uint8 FRAME_crc8Update(uint8 crc, uint8 data)
+{
+	uint8 bit;
+
+	crc ^= data;
+	for (bit = 0; bit < 8; bit++)
+	{
+		if (crc & 0x80)
+		{
+			crc = (uint8) ((crc << 1) ^ 0x07);
+		}
+		else
+		{
+			crc <<= 1;
+		}
+	}
+	return crc;
+}
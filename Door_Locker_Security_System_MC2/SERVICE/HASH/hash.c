@@ -0,0 +1,156 @@
+/*
+ ============================================================================
+ Name        : hash.c
+ Author      : Ahmed Ali
+ Module Name : HASH
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the HalfSipHash-2-4 keyed hash
+ ============================================================================
+ */
+
+#include "hash.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define HASH_C_ROUNDS			2
+#define HASH_D_ROUNDS			4
+
+#define HASH_ROTATE_LEFT(x, b)	((uint32) (((x) << (b)) | ((x) >> (32 - (b)))))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for running the rounds on the state.
+ */
+static void HASH_rounds(uint32 v[], uint8 rounds);
+
+/*
+ * Function responsible for reading a little endian word.
+ */
+static uint32 HASH_readWord(const uint8 *bytes);
+
+/*
+ * Function responsible for writing a little endian word.
+ */
+static void HASH_writeWord(uint8 *bytes, uint32 word);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Calculate the HalfSipHash-2-4 of the data with the key, the output length
+ * should be HASH_OUTPUT_32_BITS or HASH_OUTPUT_64_BITS.
+ */
+void HASH_halfSipHash(const uint8 key[], const uint8 *data, uint8 length,
+		uint8 *output, uint8 outputLength)
+{
+	uint32 v[4];
+	uint32 k0 = HASH_readWord(key);
+	uint32 k1 = HASH_readWord(key + 4);
+	uint32 m;
+	uint8 left = length & 3;
+	const uint8 *end = data + length - left;
+
+	v[0] = k0;
+	v[1] = k1;
+	v[2] = 0x6C796765UL ^ k0;
+	v[3] = 0x74656462UL ^ k1;
+	if (outputLength == HASH_OUTPUT_64_BITS)
+	{
+		v[1] ^= 0xEE;
+	}
+
+	/* the full words of the data */
+	for (; data != end; data += 4)
+	{
+		m = HASH_readWord(data);
+		v[3] ^= m;
+		HASH_rounds(v, HASH_C_ROUNDS);
+		v[0] ^= m;
+	}
+
+	/* the last block holds the left bytes and the length */
+	m = (uint32) length << 24;
+	switch (left)
+	{
+	case 3:
+		m |= (uint32) data[2] << 16;
+		/* no break */
+	case 2:
+		m |= (uint32) data[1] << 8;
+		/* no break */
+	case 1:
+		m |= data[0];
+		break;
+	default:
+		break;
+	}
+	v[3] ^= m;
+	HASH_rounds(v, HASH_C_ROUNDS);
+	v[0] ^= m;
+
+	/* finalization */
+	v[2] ^= (outputLength == HASH_OUTPUT_64_BITS) ? 0xEE : 0xFF;
+	HASH_rounds(v, HASH_D_ROUNDS);
+	HASH_writeWord(output, v[1] ^ v[3]);
+	if (outputLength == HASH_OUTPUT_64_BITS)
+	{
+		v[1] ^= 0xDD;
+		HASH_rounds(v, HASH_D_ROUNDS);
+		HASH_writeWord(output + 4, v[1] ^ v[3]);
+	}
+}
+
+/*
+ * Description :
+ * Run the rounds on the state.
+ */
+static void HASH_rounds(uint32 v[], uint8 rounds)
+{
+	while (rounds--)
+	{
+		v[0] += v[1];
+		v[1] = HASH_ROTATE_LEFT(v[1], 5);
+		v[1] ^= v[0];
+		v[0] = HASH_ROTATE_LEFT(v[0], 16);
+		v[2] += v[3];
+		v[3] = HASH_ROTATE_LEFT(v[3], 8);
+		v[3] ^= v[2];
+		v[0] += v[3];
+		v[3] = HASH_ROTATE_LEFT(v[3], 7);
+		v[3] ^= v[0];
+		v[2] += v[1];
+		v[1] = HASH_ROTATE_LEFT(v[1], 13);
+		v[1] ^= v[2];
+		v[2] = HASH_ROTATE_LEFT(v[2], 16);
+	}
+}
+
+/*
+ * Description :
+ * Read a little endian word.
+ */
+static uint32 HASH_readWord(const uint8 *bytes)
+{
+	return (uint32) bytes[0] | ((uint32) bytes[1] << 8)
+			| ((uint32) bytes[2] << 16) | ((uint32) bytes[3] << 24);
+}
+
+/*
+ * Description :
+ * Write a little endian word.
+ */
+static void HASH_writeWord(uint8 *bytes, uint32 word)
+{
+	bytes[0] = (uint8) word;
+	bytes[1] = (uint8) (word >> 8);
+	bytes[2] = (uint8) (word >> 16);
+	bytes[3] = (uint8) (word >> 24);
+}
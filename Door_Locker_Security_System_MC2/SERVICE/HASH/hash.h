@@ -0,0 +1,43 @@
+/*
+ ============================================================================
+ Name        : hash.h
+ Author      : Ahmed Ali
+ Module Name : HASH
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the HalfSipHash-2-4 keyed hash
+ ============================================================================
+ */
+
+#ifndef HASH_H_
+#define HASH_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * HalfSipHash works on 32-bit words, so each round is few 8-bit additions and
+ * XORs and its rotations by 8 and 16 are byte moves on the AVR.
+ * A message of n bytes takes 2 rounds for each 4 bytes, 2 rounds for the last
+ * block and 4 rounds for each 4 bytes of the output.
+ */
+#define HASH_KEY_LENGTH			8
+#define HASH_OUTPUT_32_BITS		4
+#define HASH_OUTPUT_64_BITS		8
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Calculate the HalfSipHash-2-4 of the data with the key, the output length
+ * should be HASH_OUTPUT_32_BITS or HASH_OUTPUT_64_BITS.
+ */
+void HASH_halfSipHash(const uint8 key[], const uint8 *data, uint8 length,
+		uint8 *output, uint8 outputLength);
+
+#endif /* HASH_H_ */
@@ -0,0 +1,320 @@
+/*
+ ============================================================================
+ Name        : lockout.c
+ Author      : Ahmed Ali
+ Module Name : LOCKOUT
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the persistent lockout after the wrong passwords
+ ============================================================================
+ */
+
+#include "lockout.h"
+#include "../../MCAL/TIMER1/timer1_service.h" /* to use the uptime of TIMER1 */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Byte offsets inside the record */
+#define LOCKOUT_TRIES_INDEX				0
+#define LOCKOUT_LEVEL_INDEX				1
+#define LOCKOUT_RUNNING_INDEX			2
+#define LOCKOUT_RECORD_LENGTH			3
+
+#define LOCKOUT_ONE_SECOND_IN_MS		1000UL
+
+/* The record is loaded again at this period while it can't be read */
+#define LOCKOUT_LOAD_RETRY_PERIOD_MS	1000UL
+
+/*
+ * Longest wait for the running write of the record store before the write of
+ * a wrong password, one page write cycle with its ACK polling
+ */
+#define LOCKOUT_SAVE_WAIT_MS			20UL
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for starting a lockout of the level.
+ */
+static uint16 LOCKOUT_start(uint8 level);
+
+/*
+ * Function responsible for loading the record from the EEPROM record store.
+ */
+static void LOCKOUT_load(void);
+
+/*
+ * Function responsible for starting the write of the record to the EEPROM record store.
+ */
+static uint8 LOCKOUT_save(void);
+
+/*
+ * Function responsible for ending the save of the record, it is called from the TWI ISR.
+ */
+static void LOCKOUT_recordSaved(uint8 result);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Wrong passwords since the last lockout or correct password */
+static uint8 g_tries = 0;
+
+/* Level of the next lockout, the lockout of level n lasts LOCKOUT_BASE_PERIOD * 2^n */
+static uint8 g_level = 0;
+
+/* Level of the running lockout plus one, or zero if no lockout is running */
+static uint8 g_running = 0;
+
+/* TIMER1 milliseconds at the end of the running lockout */
+static uint32 g_lockoutEnd;
+
+/* TRUE if the record changed after it was saved */
+static uint8 g_dirty = FALSE;
+
+/*
+ * TRUE after the record is loaded or the store is known to have none, until
+ * then the wrong passwords before the reset are not known
+ */
+static uint8 g_known = FALSE;
+
+/* TIMER1 milliseconds of the last load */
+static uint32 g_loadTime;
+
+/* The record being saved, it must not change until the write is completed */
+static uint8 g_record[LOCKOUT_RECORD_LENGTH];
+static volatile uint8 g_saving = FALSE;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the lockout record from the EEPROM record store and start the lockout
+ * again if it was running. The TIMER1 service must be initialized before it.
+ * If the store is not scanned or the record can't be read, the state is not
+ * known and LOCKOUT_poll loads the record again later.
+ */
+void LOCKOUT_init(void)
+{
+	g_known = FALSE;
+	g_tries = 0;
+	g_level = 0;
+	g_running = 0;
+	g_dirty = FALSE;
+	LOCKOUT_load();
+}
+
+/*
+ * Description :
+ * Return TRUE if the wrong passwords before the reset are known, the
+ * passwords must not be checked until then.
+ */
+uint8 LOCKOUT_isKnown(void)
+{
+	return g_known;
+}
+
+/*
+ * Description :
+ * Return the remaining seconds of the running lockout, rounded up, or zero if
+ * the passwords can be checked. It doesn't access the EEPROM.
+ */
+uint16 LOCKOUT_getRemainingTime(void)
+{
+	sint32 remaining;
+
+	if (g_running == 0)
+	{
+		return 0;
+	}
+	/* the difference is right when the milliseconds wrap around */
+	remaining = (sint32) (g_lockoutEnd - Timer1_getTicks());
+	if (remaining <= 0)
+	{
+		return 0;
+	}
+	return (uint16) ((remaining + LOCKOUT_ONE_SECOND_IN_MS - 1) / LOCKOUT_ONE_SECOND_IN_MS);
+}
+
+/*
+ * Description :
+ * Count a wrong password, the lockout starts when the wrong passwords reach
+ * LOCKOUT_MAX_TRIES. The write of the record starts before the return, so
+ * a reset after the reply to the wrong password doesn't clear it.
+ * Return the seconds of the started lockout, or zero if no lockout is started.
+ */
+uint16 LOCKOUT_recordFailure(void)
+{
+	uint16 period = 0;
+	uint32 start;
+
+	g_tries++;
+	if (g_tries >= LOCKOUT_MAX_TRIES)
+	{
+		g_tries = 0;
+		period = LOCKOUT_start(g_level);
+		/* the next lockout is twice this one */
+		if (g_level < LOCKOUT_MAX_LEVEL)
+		{
+			g_level++;
+		}
+	}
+	g_dirty = TRUE;
+
+	/*
+	 * wait for a running write of the store, it ends in one write cycle,
+	 * if it doesn't end in time the record is saved by LOCKOUT_poll
+	 */
+	start = Timer1_getTicks();
+	while ((LOCKOUT_save() == ERROR)
+			&& ((Timer1_getTicks() - start) < LOCKOUT_SAVE_WAIT_MS))
+	{
+	}
+	return period;
+}
+
+/*
+ * Description :
+ * Clear the wrong passwords and the lockout level after a correct password.
+ */
+void LOCKOUT_recordSuccess(void)
+{
+	/* the record is saved only if it changes, so the correct passwords don't wear the EEPROM */
+	if ((g_tries != 0) || (g_level != 0))
+	{
+		g_tries = 0;
+		g_level = 0;
+		g_dirty = TRUE;
+	}
+}
+
+/*
+ * Description :
+ * Save the changed lockout record to the EEPROM and end the lockout when its
+ * time passes, it should be called periodically from the main loop.
+ * It loads the record again while its state is not known.
+ */
+void LOCKOUT_poll(void)
+{
+	if (g_known == FALSE)
+	{
+		if ((Timer1_getTicks() - g_loadTime) >= LOCKOUT_LOAD_RETRY_PERIOD_MS)
+		{
+			LOCKOUT_load();
+		}
+		return;
+	}
+
+	if ((g_running != 0) && (LOCKOUT_getRemainingTime() == 0))
+	{
+		g_running = 0;
+		g_dirty = TRUE;
+	}
+
+	if (g_dirty == TRUE)
+	{
+		/* it is tried again later if the EEPROM is busy */
+		LOCKOUT_save();
+	}
+}
+
+/*
+ * Description :
+ * Load the record from the EEPROM record store, a store without the record
+ * is a first start without wrong passwords.
+ */
+static void LOCKOUT_load(void)
+{
+	uint8 record[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 length;
+
+	g_loadTime = Timer1_getTicks();
+	if (EEPROM_storeIsReady() == FALSE)
+	{
+		return;
+	}
+	if (EEPROM_storeHasRecord(LOCKOUT_STORE_KEY) == FALSE)
+	{
+		g_known = TRUE;
+		return;
+	}
+	if (EEPROM_storeRead(LOCKOUT_STORE_KEY, record, &length) == ERROR)
+	{
+		return;
+	}
+	g_known = TRUE;
+	if (length != LOCKOUT_RECORD_LENGTH)
+	{
+		return;
+	}
+	g_tries = record[LOCKOUT_TRIES_INDEX];
+	g_level = record[LOCKOUT_LEVEL_INDEX];
+	if (g_level > LOCKOUT_MAX_LEVEL)
+	{
+		g_level = LOCKOUT_MAX_LEVEL;
+	}
+	/* the time of the lockout before the reset is not known, so it starts again */
+	if (record[LOCKOUT_RUNNING_INDEX] != 0)
+	{
+		LOCKOUT_start(record[LOCKOUT_RUNNING_INDEX] - 1);
+	}
+}
+
+/*
+ * Description :
+ * Start the write of the record to the EEPROM record store.
+ * Return ERROR if the previous write of the record or another write of the
+ * store is not completed yet.
+ */
+static uint8 LOCKOUT_save(void)
+{
+	if (g_saving == TRUE)
+	{
+		return ERROR;
+	}
+	g_record[LOCKOUT_TRIES_INDEX] = g_tries;
+	g_record[LOCKOUT_LEVEL_INDEX] = g_level;
+	g_record[LOCKOUT_RUNNING_INDEX] = g_running;
+
+	g_saving = TRUE;
+	if (EEPROM_storeWriteAsync(LOCKOUT_STORE_KEY, g_record,
+			LOCKOUT_RECORD_LENGTH, LOCKOUT_recordSaved) == ERROR)
+	{
+		g_saving = FALSE;
+		return ERROR;
+	}
+	g_dirty = FALSE;
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Start a lockout of the level.
+ */
+static uint16 LOCKOUT_start(uint8 level)
+{
+	uint16 period = (uint16) LOCKOUT_BASE_PERIOD << level;
+
+	g_running = level + 1;
+	g_lockoutEnd = Timer1_getTicks() + (period * LOCKOUT_ONE_SECOND_IN_MS);
+	return period;
+}
+
+/*
+ * Description :
+ * End the save of the record, it is called from the TWI ISR.
+ */
+static void LOCKOUT_recordSaved(uint8 result)
+{
+	if (result == ERROR)
+	{
+		g_dirty = TRUE;
+	}
+	g_saving = FALSE;
+}
@@ -0,0 +1,98 @@
+/*
+ ============================================================================
+ Name        : lockout.h
+ Author      : Ahmed Ali
+ Module Name : LOCKOUT
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the persistent lockout after the wrong passwords
+ ============================================================================
+ */
+
+#ifndef LOCKOUT_H_
+#define LOCKOUT_H_
+
+#include "../../LIB/std_types.h"
+#include "../../HAL/EXTERNAL_EEPROM/eeprom_store.h" /* to keep the counters in EEPROM */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Number of the wrong passwords which start a lockout */
+#define LOCKOUT_MAX_TRIES				3
+
+/*
+ * The first lockout lasts LOCKOUT_BASE_PERIOD seconds and each next lockout
+ * without a correct password between them lasts twice the previous one,
+ * up to LOCKOUT_BASE_PERIOD * 2^LOCKOUT_MAX_LEVEL seconds.
+ */
+#define LOCKOUT_BASE_PERIOD				60
+#define LOCKOUT_MAX_LEVEL				6
+
+#if ((LOCKOUT_BASE_PERIOD << LOCKOUT_MAX_LEVEL) > 65535)
+#error "The longest lockout doesn't fit in 16 bits"
+#endif
+
+/*
+ * Key of the lockout record in the EEPROM record store:
+ * | WRONG TRIES | LEVEL | LOCKED |
+ * A reset during a lockout starts the lockout again.
+ */
+#define LOCKOUT_STORE_KEY				1
+
+#if (LOCKOUT_STORE_KEY >= EEPROM_STORE_SERVICE_KEYS)
+#error "LOCKOUT_STORE_KEY is not a service key of the record store"
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the lockout record from the EEPROM record store and start the lockout
+ * again if it was running. The TIMER1 service must be initialized before it.
+ * If the store is not scanned or the record can't be read, the state is not
+ * known and LOCKOUT_poll loads the record again later.
+ */
+void LOCKOUT_init(void);
+
+/*
+ * Description :
+ * Return TRUE if the wrong passwords before the reset are known, the
+ * passwords must not be checked until then.
+ */
+uint8 LOCKOUT_isKnown(void);
+
+/*
+ * Description :
+ * Return the remaining seconds of the running lockout, rounded up, or zero if
+ * the passwords can be checked. It doesn't access the EEPROM.
+ */
+uint16 LOCKOUT_getRemainingTime(void);
+
+/*
+ * Description :
+ * Count a wrong password, the lockout starts when the wrong passwords reach
+ * LOCKOUT_MAX_TRIES. The write of the record starts before the return, so
+ * a reset after the reply to the wrong password doesn't clear it.
+ * Return the seconds of the started lockout, or zero if no lockout is started.
+ */
+uint16 LOCKOUT_recordFailure(void);
+
+/*
+ * Description :
+ * Clear the wrong passwords and the lockout level after a correct password.
+ */
+void LOCKOUT_recordSuccess(void);
+
+/*
+ * Description :
+ * Save the changed lockout record to the EEPROM and end the lockout when its
+ * time passes, it should be called periodically from the main loop.
+ * It loads the record again while its state is not known.
+ */
+void LOCKOUT_poll(void);
+
+#endif /* LOCKOUT_H_ */
@@ -0,0 +1,89 @@
+/*
+ ============================================================================
+ Name        : prof.h
+ Author      : Ahmed Ali
+ Module Name : PROF
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the execution time probes of the hot paths
+ ============================================================================
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Set to 1 to build the probes in, with 0 PROF_BEGIN and PROF_END are
+ * empty and the module adds no code and no RAM.
+ */
+#define PROF_ENABLE					0
+
+/*
+ * Diagnostic request of the probe table, sent by the admin menu of HMI ECU.
+ * It is answered by one probe frame per probe in the order of their ids then
+ * an ACK frame with the number of probes, zero when they are not built in:
+ * | COUNT (2 bytes) | MIN (2 bytes) | MAX (2 bytes) | AVERAGE (2 bytes) |
+ * The times are in microseconds (TIMER1 counts, 8 CPU cycles each at 8 MHz),
+ * the count stops at 0xFFFF. The table is cleared after it is sent.
+ */
+#define PROF_QUERY					0x50
+#define PROF_PROBE_FRAME			0x52
+#define PROF_PROBE_FRAME_SIZE		8
+
+/* Ids of the probes */
+#define PROF_EEPROM_WRITE			0 /* a block write from its start to its last write cycle */
+#define PROF_TWI_ISR				1 /* one step of the TWI engine */
+#define PROF_UART_WRITE				2
+#define PROF_UART_READ				3
+#define PROF_NUM_PROBES				4
+
+#if (PROF_ENABLE == 1)
+
+/* Start the measure of the probe */
+#define PROF_BEGIN(id)				PROF_begin(id)
+/* End the measure of the probe and add it to the probe table */
+#define PROF_END(id)				PROF_end(id)
+
+#else
+
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if (PROF_ENABLE == 1)
+
+/*
+ * Description :
+ * Take the start time of the probe, it may be called from an ISR.
+ * The TIMER1 service must be initialized before it.
+ */
+void PROF_begin(uint8 id);
+
+/*
+ * Description :
+ * Add the time since PROF_begin of the probe to its minimum, maximum,
+ * total and count, it may be called from an ISR.
+ */
+void PROF_end(uint8 id);
+
+/*
+ * Description :
+ * Send the probe frames of the table through the frame link then clear it,
+ * the caller closes the table by its ACK frame.
+ */
+void PROF_sendTable(void);
+
+#endif
+
+#endif /* PROF_H_ */
@@ -0,0 +1,172 @@
+/*
+ ============================================================================
+ Name        : scheduler.c
+ Author      : Ahmed Ali
+ Module Name : SCHEDULER
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Source file for the run-to-completion event scheduler
+ ============================================================================
+ */
+
+#include "scheduler.h"
+#include "../../MCAL/TIMER1/timer1_service.h"
+#include "../../MCAL/GPIO/gpio_private.h" /* to use the declaration of SREG register */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SCHEDULER_QUEUE_MASK		(SCHEDULER_QUEUE_SIZE - 1)
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	SCHEDULER_EventType events[SCHEDULER_QUEUE_SIZE];
+	uint8 head;
+	uint8 tail;
+} SCHEDULER_QueueType;
+
+typedef struct
+{
+	void (*handler)(const SCHEDULER_EventType *event);
+	SCHEDULER_PriorityType priority;
+} SCHEDULER_TaskType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static SCHEDULER_TaskType g_tasks[SCHEDULER_MAX_TASKS];
+static uint8 g_numberOfTasks = 0;
+
+/* One queue for each priority, the events of the same priority keep their order */
+static volatile SCHEDULER_QueueType g_queues[SCHEDULER_NUM_PRIORITIES];
+
+static uint16 g_maxLatency = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Add a task with the required priority, its handler runs to completion for each event.
+ * Function output: the task id, or SCHEDULER_INVALID_TASK if no task is free.
+ */
+uint8 SCHEDULER_addTask(SCHEDULER_PriorityType priority,
+		void (*a_handler)(const SCHEDULER_EventType *event))
+{
+	if ((g_numberOfTasks >= SCHEDULER_MAX_TASKS)
+			|| (priority >= SCHEDULER_NUM_PRIORITIES))
+	{
+		return SCHEDULER_INVALID_TASK;
+	}
+	g_tasks[g_numberOfTasks].handler = a_handler;
+	g_tasks[g_numberOfTasks].priority = priority;
+	g_numberOfTasks++;
+	return g_numberOfTasks - 1;
+}
+
+/*
+ * Description :
+ * Post an event to the task, it can be called from the ISRs.
+ * Function output: TRUE if the event is queued, FALSE if the queue of the task priority is full.
+ */
+uint8 SCHEDULER_post(uint8 task, uint8 signal, uint8 param)
+{
+	volatile SCHEDULER_QueueType *queue;
+	uint8 next;
+	uint8 result = FALSE;
+	uint8 interruptState;
+
+	if (task >= g_numberOfTasks)
+	{
+		return FALSE;
+	}
+	queue = &g_queues[g_tasks[task].priority];
+
+	/* The queues are shared between the application and the ISRs */
+	interruptState = SREG_REG.Bits.I_Bit;
+	SREG_REG.Bits.I_Bit = 0;
+
+	next = (queue->head + 1) & SCHEDULER_QUEUE_MASK;
+	if (next != queue->tail)
+	{
+		queue->events[queue->head].task = task;
+		queue->events[queue->head].signal = signal;
+		queue->events[queue->head].param = param;
+		queue->events[queue->head].postTime = Timer1_getMicros();
+		queue->head = next;
+		result = TRUE;
+	}
+
+	SREG_REG.Bits.I_Bit = interruptState;
+	return result;
+}
+
+/*
+ * Description :
+ * Dispatch the oldest event of the highest priority to its task handler.
+ * Function output: TRUE if an event is dispatched, FALSE if all the queues are empty.
+ */
+uint8 SCHEDULER_dispatch(void)
+{
+	volatile SCHEDULER_QueueType *queue;
+	SCHEDULER_EventType event;
+	uint32 latency;
+	uint8 priority;
+	uint8 interruptState;
+
+	for (priority = 0; priority < SCHEDULER_NUM_PRIORITIES; priority++)
+	{
+		queue = &g_queues[priority];
+		if (queue->tail == queue->head)
+		{
+			continue;
+		}
+
+		/* take a copy of the event, so its place is free while the handler runs */
+		interruptState = SREG_REG.Bits.I_Bit;
+		SREG_REG.Bits.I_Bit = 0;
+		event = queue->events[queue->tail];
+		queue->tail = (queue->tail + 1) & SCHEDULER_QUEUE_MASK;
+		SREG_REG.Bits.I_Bit = interruptState;
+
+		latency = Timer1_getMicros() - event.postTime;
+		if (latency > 0xFFFF)
+		{
+			latency = 0xFFFF;
+		}
+		if (latency > g_maxLatency)
+		{
+			g_maxLatency = (uint16) latency;
+		}
+
+		g_tasks[event.task].handler(&event);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Return the worst time (in TIMER1 counts, 1 us each at 8 MHz) between posting
+ * an event and starting its handler since the last reset of the measurement.
+ */
+uint16 SCHEDULER_getMaxLatency(void)
+{
+	return g_maxLatency;
+}
+
+/*
+ * Description :
+ * Restart the measurement of the worst dispatch latency.
+ */
+void SCHEDULER_resetMaxLatency(void)
+{
+	g_maxLatency = 0;
+}
@@ -0,0 +1,98 @@
+/*
+ ============================================================================
+ Name        : scheduler.h
+ Author      : Ahmed Ali
+ Module Name : SCHEDULER
+ Layer       : SERVICE
+ Date        : 18 Oct 2026
+ Description : Header file for the run-to-completion event scheduler
+ ============================================================================
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "../../LIB/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Maximum number of tasks */
+#define SCHEDULER_MAX_TASKS			6
+
+/*
+ * Number of events each priority queue holds, its value should be a power of 2.
+ * It is above the worst number of waiting events of each priority of the ECU
+ * (see its tasks in main), and a post to a full queue returns FALSE so its
+ * caller keeps the event and posts it again.
+ */
+#define SCHEDULER_QUEUE_SIZE		8
+
+#if ((SCHEDULER_QUEUE_SIZE & (SCHEDULER_QUEUE_SIZE - 1)) != 0)
+
+#error "Scheduler queue size should be a power of 2"
+
+#endif
+
+/* Returned by SCHEDULER_addTask when all the tasks are used */
+#define SCHEDULER_INVALID_TASK		0xFF
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	SCHEDULER_PRIORITY_HIGH, SCHEDULER_PRIORITY_MEDIUM, SCHEDULER_PRIORITY_LOW,
+	SCHEDULER_NUM_PRIORITIES
+} SCHEDULER_PriorityType;
+
+typedef struct
+{
+	uint8 task;
+	uint8 signal;
+	uint8 param;
+	uint32 postTime; /* TIMER1 counts when the event is posted */
+} SCHEDULER_EventType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Add a task with the required priority, its handler runs to completion for each event.
+ * Function output: the task id, or SCHEDULER_INVALID_TASK if no task is free.
+ */
+uint8 SCHEDULER_addTask(SCHEDULER_PriorityType priority,
+		void (*a_handler)(const SCHEDULER_EventType *event));
+
+/*
+ * Description :
+ * Post an event to the task, it can be called from the ISRs.
+ * Function output: TRUE if the event is queued, FALSE if the queue of the task priority is full.
+ */
+uint8 SCHEDULER_post(uint8 task, uint8 signal, uint8 param);
+
+/*
+ * Description :
+ * Dispatch the oldest event of the highest priority to its task handler.
+ * Function output: TRUE if an event is dispatched, FALSE if all the queues are empty.
+ */
+uint8 SCHEDULER_dispatch(void);
+
+/*
+ * Description :
+ * Return the worst time (in TIMER1 counts, 1 us each at 8 MHz) between posting
+ * an event and starting its handler since the last reset of the measurement.
+ */
+uint16 SCHEDULER_getMaxLatency(void);
+
+/*
+ * Description :
+ * Restart the measurement of the worst dispatch latency.
+ */
+void SCHEDULER_resetMaxLatency(void);
+
+#endif /* SCHEDULER_H_ */
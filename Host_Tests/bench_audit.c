@@ -0,0 +1,175 @@
+/*
+ ============================================================================
+ Name        : bench_audit.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the audit events per second which the flushes keep up with
+ ============================================================================
+ */
+
+/*
+ * The benchmark is built for two flush policies of audit.h: bench_audit_page
+ * with the policy of the Control ECU, a page of AUDIT_EVENTS_PER_PAGE events
+ * a write cycle, and bench_audit_event with AUDIT_FLUSH_ON_SIZE and a
+ * threshold of one event, a flush as soon as an event waits. A flush takes all
+ * the waiting events up to a page, so the second one also fills the pages when
+ * the events come faster than the write cycles.
+ *
+ * The events are logged at a fixed rate for RUN_MS on the virtual clock, and
+ * AUDIT_poll is called each POLL_US like the main loop of the Control ECU.
+ * The flushes go over the TWI driver to the model of the 24C16 of
+ * shim/host_twi_eeprom.h. A rate is sustained when no event is dropped from
+ * the RAM ring, the highest one is found by bisection.
+ */
+
+#include "shim/host_blocks.h"
+#include "shim/host_twi_eeprom.h"
+#include "SERVICE/AUDIT/audit.h"
+#include "MCAL/TIMER1/timer1_service.h"
+#include "MCAL/I2C/twi.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BIT_RATE			200000UL
+
+#define CYCLES_PER_MS		(F_CPU / 1000UL)
+
+/* The time of the events of one rate, and the period of the main loop */
+#define RUN_MS				10000UL
+#define POLL_US				100
+
+/*
+ * The polls after the events, the last events are flushed so the next rate
+ * starts with an empty ring and no write on the bus
+ */
+#define DRAIN_MS			(AUDIT_FLUSH_PERIOD_MS + 100UL)
+
+#define EVENT_TYPE			0x21
+
+/* The range of the bisection in events per second */
+#define MAX_RATE			1000
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const uint16 g_rates[] = { 50, 100, 200, 400 };
+
+#define NUM_RATES		(sizeof(g_rates) / sizeof(g_rates[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The uptime of the TIMER1 service on the virtual clock, the timestamps of the events.
+ */
+uint32 Timer1_getTicks(void)
+{
+	return (uint32) (g_hostCycles / CYCLES_PER_MS);
+}
+
+/*
+ * Description :
+ * The devices of the benchmark, stepped on the virtual clock.
+ */
+static void stepDevices(void)
+{
+	HOST_twiEepromStep(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Start an erased 24C16 and scan its empty log.
+ */
+static void makeLog(void)
+{
+	TWI_ConfigType config = { MC_ADDRESS, BIT_RATE };
+
+	HOST_twiEepromReset(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	g_hostDevices = stepDevices;
+	/* the clock jumps to the end of each action on the bus between the polls */
+	g_hostNextEvent = HOST_twiEepromNextEvent;
+	host_SREG.Bits.I_Bit = 1;
+	TWI_init(&config);
+	(void) AUDIT_init();
+}
+
+/*
+ * Description :
+ * Log the events at the rate for RUN_MS with the polls of the main loop.
+ * Return the number of the dropped events, the write cycles are added to the pointer.
+ */
+static uint32 runRate(uint16 rate, uint32 *a_writeCycles)
+{
+	uint64 period = F_CPU / rate;
+	uint64 end, nextEvent;
+	uint32 dropped, writeCycles;
+
+	makeLog();
+	dropped = AUDIT_getDroppedEvents();
+	writeCycles = g_hostTwiEepromStats.writeCycles;
+	nextEvent = g_hostCycles;
+	end = g_hostCycles + (RUN_MS * CYCLES_PER_MS);
+	while (g_hostCycles < end)
+	{
+		while (g_hostCycles >= nextEvent)
+		{
+			AUDIT_log(EVENT_TYPE);
+			nextEvent += period;
+		}
+		AUDIT_poll();
+		HOST_run(POLL_US * (F_CPU / 1000000UL));
+	}
+	dropped = (uint16) (AUDIT_getDroppedEvents() - dropped);
+	end = g_hostCycles + (DRAIN_MS * CYCLES_PER_MS);
+	while (g_hostCycles < end)
+	{
+		AUDIT_poll();
+		HOST_run(POLL_US * (F_CPU / 1000000UL));
+	}
+	*a_writeCycles = g_hostTwiEepromStats.writeCycles - writeCycles;
+	return dropped;
+}
+
+int main(void)
+{
+	uint32 dropped, writeCycles, logged;
+	uint16 low = 1, high = MAX_RATE, rate;
+	uint8 i;
+
+	printf("audit events at %lu kHz for %lu s, a poll each %u us, %s\n", BIT_RATE / 1000,
+			RUN_MS / 1000, POLL_US, (AUDIT_FLUSH_SIZE_THRESHOLD == 1) ?
+					"a flush of each waiting event" : "a flush of each full page");
+	printf("%10s %8s %8s %13s %16s\n", "events/s", "logged", "dropped", "write cycles",
+			"events / cycle");
+	for (i = 0; i < NUM_RATES; i++)
+	{
+		dropped = runRate(g_rates[i], &writeCycles);
+		logged = (uint32) ((RUN_MS * g_rates[i]) / 1000);
+		printf("%10u %8lu %8lu %13lu %16.2f\n", g_rates[i], (unsigned long) logged,
+				(unsigned long) dropped, (unsigned long) writeCycles,
+				(writeCycles != 0) ? (double) (logged - dropped) / writeCycles : 0.0);
+	}
+
+	/* the highest rate without a dropped event */
+	while (low < high)
+	{
+		rate = (uint16) ((low + high + 1) / 2);
+		if (runRate(rate, &writeCycles) == 0)
+		{
+			low = rate;
+		}
+		else
+		{
+			high = (uint16) (rate - 1);
+		}
+	}
+	printf("sustained: %u events/s\n", low);
+	return 0;
+}
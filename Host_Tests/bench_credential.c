@@ -0,0 +1,327 @@
+/*
+ ============================================================================
+ Name        : bench_credential.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the password check time versus the number of the users
+ ============================================================================
+ */
+
+/*
+ * The checks of CREDENTIAL_check are timed with its RAM tags, and without
+ * them: CREDENTIAL_init is called before each check, the load of the tags of
+ * all the slots from the record store which the check does when they are not
+ * valid, the way of a check which reads the table from the EEPROM.
+ *
+ * The cost of HASH_halfSipHash is timed for messages of whole 4-byte blocks,
+ * and a check is split into its parts: the hash of the tag, the record read
+ * and the hash of the verifier, the rest is the pass over the tags and the
+ * compare.
+ */
+
+#include "shim/host_blocks.h"
+#include "shim/host_twi_eeprom.h"
+#include "SERVICE/CREDENTIAL/credential.h"
+#include "MCAL/TIMER1/timer1_service.h"
+#include "MCAL/I2C/twi.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BIT_RATE			200000UL
+
+/* Passwords of each kind checked for each table size */
+#define CHECKS				32
+
+/* The longest message of the hash costs in 4-byte blocks */
+#define HASH_MAX_BLOCKS		6
+#define HASH_BLOCK_LENGTH	4
+
+/* The time of a kind of checks */
+typedef struct
+{
+	uint32 maxUs;
+	uint32 totalUs;
+	uint32 count;
+} MeasureType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The numbers of the used slots */
+static const uint8 g_sizes[] = { 1, 8, 16, 32, 64 };
+
+#define NUM_SIZES		(sizeof(g_sizes) / sizeof(g_sizes[0]))
+
+static const uint8 g_hashKey[HASH_KEY_LENGTH] = CREDENTIAL_HASH_KEY;
+
+static volatile uint8 g_saved;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The uptime of the TIMER1 service on the virtual clock, the source of the salts.
+ */
+uint32 Timer1_getMicros(void)
+{
+	return (uint32) (g_hostCycles / HOST_CYCLES_PER_US);
+}
+
+/*
+ * Description :
+ * The devices of the benchmark, stepped on the virtual clock.
+ */
+static void stepDevices(void)
+{
+	HOST_twiEepromStep(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Call back of the saves.
+ */
+static void passwordSaved(uint8 result)
+{
+	(void) result;
+	g_saved = TRUE;
+}
+
+/*
+ * Description :
+ * Make the password digits of the number, 5 digits with the leading zeros.
+ */
+static void makePassword(uint8 password[], uint32 number)
+{
+	sint8 i;
+
+	for (i = CREDENTIAL_PASSWORD_LENGTH - 1; i >= 0; i--)
+	{
+		password[i] = (uint8) (number % 10);
+		number /= 10;
+	}
+}
+
+/*
+ * Description :
+ * The password of each slot in the benchmark.
+ */
+static uint32 slotPassword(uint8 slot)
+{
+	return (slot * 1111UL) + 7;
+}
+
+/*
+ * Description :
+ * Start an erased 24C16 with the required number of the used slots.
+ */
+static void makeTable(uint8 users)
+{
+	TWI_ConfigType config = { MC_ADDRESS, BIT_RATE };
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+
+	HOST_twiEepromReset(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	g_hostDevices = stepDevices;
+	host_SREG.Bits.I_Bit = 1;
+	TWI_init(&config);
+	(void) EEPROM_storeInit();
+	(void) CREDENTIAL_init();
+	for (slot = 0; slot < users; slot++)
+	{
+		makePassword(password, slotPassword(slot));
+		g_saved = FALSE;
+		while (CREDENTIAL_save(slot, password, passwordSaved) == CREDENTIAL_BUSY)
+		{
+			HOST_run(HOST_CYCLES_PER_BLOCK);
+		}
+		while (g_saved == FALSE)
+		{
+			HOST_run(HOST_CYCLES_PER_BLOCK);
+		}
+	}
+	/* the reset, the tags are loaded from the store */
+	(void) EEPROM_storeInit();
+	(void) CREDENTIAL_init();
+}
+
+/*
+ * Description :
+ * Check the password of the number and add its time to the measure, without
+ * the RAM cache the tags are loaded from the EEPROM before the check.
+ */
+static void measureCheck(uint32 number, uint8 expected, uint8 cached, MeasureType *a_measure)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+	uint64 start;
+	uint32 timeUs;
+
+	makePassword(password, number);
+	start = g_hostCycles;
+	if (cached == FALSE)
+	{
+		(void) CREDENTIAL_init();
+	}
+	if (CREDENTIAL_check(password, &slot) != expected)
+	{
+		printf("check of %05lu is not %u\n", (unsigned long) number, expected);
+	}
+	timeUs = (uint32) ((g_hostCycles - start) / HOST_CYCLES_PER_US);
+	if (timeUs > a_measure->maxUs)
+	{
+		a_measure->maxUs = timeUs;
+	}
+	a_measure->totalUs += timeUs;
+	a_measure->count++;
+}
+
+/*
+ * Description :
+ * The time of a check which hashes the salt and the password of every slot,
+ * the check of the A/B records kept in RAM: one 64-bit verifier for each slot.
+ */
+static uint32 scanAllSlotsUs(uint8 slots)
+{
+	uint8 message[4 + CREDENTIAL_PASSWORD_LENGTH] = { 0 };
+	uint8 verifier[HASH_OUTPUT_64_BITS];
+	uint64 start = g_hostCycles;
+	uint8 slot;
+
+	for (slot = 0; slot < slots; slot++)
+	{
+		HASH_halfSipHash(g_hashKey, message, sizeof(message), verifier,
+				HASH_OUTPUT_64_BITS);
+	}
+	return (uint32) ((g_hostCycles - start) / HOST_CYCLES_PER_US);
+}
+
+/*
+ * Description :
+ * Return the cycles of one hash of a message of the length.
+ */
+static uint32 hashCycles(uint8 length, uint8 outputLength)
+{
+	uint8 message[HASH_MAX_BLOCKS * HASH_BLOCK_LENGTH] = { 0 };
+	uint8 output[HASH_OUTPUT_64_BITS];
+	uint64 start = g_hostCycles;
+
+	HASH_halfSipHash(g_hashKey, message, length, output, outputLength);
+	return (uint32) (g_hostCycles - start);
+}
+
+/*
+ * Description :
+ * Print the cycles of the hash for each number of the blocks of the message,
+ * and the cost of one more block.
+ */
+static void printHashCosts(void)
+{
+	uint8 blocks;
+
+	printf("HASH_halfSipHash on the virtual clock, a message of whole 4-byte blocks\n");
+	printf("%7s %7s | %9s %9s\n", "blocks", "bytes", "32 bits", "64 bits");
+	for (blocks = 0; blocks <= HASH_MAX_BLOCKS; blocks++)
+	{
+		printf("%7u %7u | %9lu %9lu\n", blocks, blocks * HASH_BLOCK_LENGTH,
+				(unsigned long) hashCycles(blocks * HASH_BLOCK_LENGTH, HASH_OUTPUT_32_BITS),
+				(unsigned long) hashCycles(blocks * HASH_BLOCK_LENGTH, HASH_OUTPUT_64_BITS));
+	}
+	printf("each more block: %lu cycles, %.1f us\n",
+			(unsigned long) ((hashCycles(HASH_MAX_BLOCKS * HASH_BLOCK_LENGTH, HASH_OUTPUT_32_BITS)
+					- hashCycles(0, HASH_OUTPUT_32_BITS)) / HASH_MAX_BLOCKS),
+			(double) (hashCycles(HASH_MAX_BLOCKS * HASH_BLOCK_LENGTH, HASH_OUTPUT_32_BITS)
+					- hashCycles(0, HASH_OUTPUT_32_BITS)) / HASH_MAX_BLOCKS / HOST_CYCLES_PER_US);
+}
+
+/*
+ * Description :
+ * Print the parts of the check of the correct password of the slot.
+ */
+static void printCheckParts(uint8 slot)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 record[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 length, found;
+	uint64 start = g_hostCycles;
+	uint32 checkCycles, tagCycles, readCycles, verifierCycles;
+
+	makePassword(password, slotPassword(slot));
+	(void) CREDENTIAL_check(password, &found);
+	checkCycles = (uint32) (g_hostCycles - start);
+	tagCycles = hashCycles(CREDENTIAL_PASSWORD_LENGTH, HASH_OUTPUT_32_BITS);
+	verifierCycles = hashCycles(CREDENTIAL_SALT_LENGTH + CREDENTIAL_PASSWORD_LENGTH,
+			CREDENTIAL_VERIFIER_LENGTH);
+	start = g_hostCycles;
+	(void) EEPROM_storeRead(CREDENTIAL_STORE_KEY(slot), record, &length);
+	readCycles = (uint32) (g_hostCycles - start);
+
+	printf("parts of a check, %u users\n", CREDENTIAL_MAX_USERS);
+	printf("%-28s %9.1f us\n", "hash of the tag", (double) tagCycles / HOST_CYCLES_PER_US);
+	printf("%-28s %9.1f us\n", "record read", (double) readCycles / HOST_CYCLES_PER_US);
+	printf("%-28s %9.1f us\n", "hash of the verifier",
+			(double) verifierCycles / HOST_CYCLES_PER_US);
+	printf("%-28s %9.1f us\n", "pass over the tags, compare",
+			(double) (checkCycles - tagCycles - readCycles - verifierCycles) / HOST_CYCLES_PER_US);
+	printf("%-28s %9.1f us\n", "check", (double) checkCycles / HOST_CYCLES_PER_US);
+}
+
+int main(void)
+{
+	MeasureType correct, wrong, uncached;
+	uint8 i, n;
+	uint32 minMax = 0xFFFFFFFF, maxMax = 0;
+
+	printf("password check at %lu kHz, clock of %u cycles a block, %u checks of each kind\n",
+			BIT_RATE / 1000, HOST_CYCLES_PER_BLOCK, CHECKS);
+	printf("%6s | %19s | %19s | %21s | %19s\n", "", "correct password",
+			"wrong password", "hash of every slot", "no RAM cache");
+	printf("%6s | %9s %9s | %9s %9s | %9s %11s | %9s %9s\n", "users", "max us",
+			"mean us", "max us", "mean us", "us", "/ tag check", "max us", "mean us");
+	for (i = 0; i < NUM_SIZES; i++)
+	{
+		makeTable(g_sizes[i]);
+		correct.maxUs = correct.totalUs = correct.count = 0;
+		wrong.maxUs = wrong.totalUs = wrong.count = 0;
+		uncached.maxUs = uncached.totalUs = uncached.count = 0;
+		for (n = 0; n < CHECKS; n++)
+		{
+			measureCheck(slotPassword(n % g_sizes[i]), TRUE, TRUE, &correct);
+			/* the numbers between the passwords of the slots are wrong */
+			measureCheck(slotPassword(n) + 500, FALSE, TRUE, &wrong);
+			measureCheck(slotPassword(n % g_sizes[i]), TRUE, FALSE, &uncached);
+		}
+		printf("%6u | %9lu %9lu | %9lu %9lu | %9lu %10.1fx | %9lu %9lu\n", g_sizes[i],
+				(unsigned long) correct.maxUs,
+				(unsigned long) (correct.totalUs / correct.count),
+				(unsigned long) wrong.maxUs,
+				(unsigned long) (wrong.totalUs / wrong.count),
+				(unsigned long) scanAllSlotsUs(g_sizes[i]),
+				(double) scanAllSlotsUs(g_sizes[i]) / correct.maxUs,
+				(unsigned long) uncached.maxUs,
+				(unsigned long) (uncached.totalUs / uncached.count));
+		if (correct.maxUs < minMax)
+		{
+			minMax = correct.maxUs;
+		}
+		if (correct.maxUs > maxMax)
+		{
+			maxMax = correct.maxUs;
+		}
+		if (wrong.maxUs > maxMax)
+		{
+			maxMax = wrong.maxUs;
+		}
+	}
+	printf("spread of the worst check over the table sizes: %lu us\n",
+			(unsigned long) (maxMax - minMax));
+	printHashCosts();
+	printCheckParts(0);
+	return 0;
+}
@@ -0,0 +1,247 @@
+/*
+ ============================================================================
+ Name        : bench_external_eeprom.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the 24C16 block writes and reads on the virtual clock
+ ============================================================================
+ */
+
+#include "shim/host_blocks.h"
+#include "shim/host_twi_eeprom.h"
+#include "HAL/EXTERNAL_EEPROM/external_eeprom.h"
+#include "MCAL/I2C/twi.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BIT_RATE		200000UL
+
+/* The fixed delay after each byte of the byte by byte writes */
+#define BYTE_DELAY_US	10000UL
+
+/* The time of a write or a read and its bus counters */
+typedef struct
+{
+	uint32 timeUs;
+	uint32 starts;
+	uint32 addressNacks;
+	uint32 writeCycles;
+	uint32 isrCycles;
+} MeasureType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_data[256];
+
+/* The block sizes, the first one is the 5 digits password */
+static const uint16 g_sizes[] = { 5, 16, 17, 64, 256 };
+
+#define NUM_SIZES		(sizeof(g_sizes) / sizeof(g_sizes[0]))
+
+static volatile uint8 g_asyncDone;
+
+static uint8 g_readData[256];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The devices of the benchmark, stepped on the virtual clock.
+ */
+static void stepDevices(void)
+{
+	HOST_twiEepromStep(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Call back of the asynchronous write.
+ */
+static void asyncWritten(uint8 result)
+{
+	(void) result;
+	g_asyncDone = TRUE;
+}
+
+/*
+ * Description :
+ * Start a measure on an idle bus and an erased 24C16.
+ */
+static uint64 beginMeasure(void)
+{
+	TWI_ConfigType config = { MC_ADDRESS, BIT_RATE };
+
+	HOST_twiEepromReset(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	g_hostDevices = stepDevices;
+	host_SREG.Bits.I_Bit = 1;
+	TWI_init(&config);
+	return g_hostCycles;
+}
+
+/*
+ * Description :
+ * End a measure started at the time.
+ */
+static void endMeasure(uint64 start, MeasureType *a_measure)
+{
+	a_measure->timeUs = (uint32) ((g_hostCycles - start) / HOST_CYCLES_PER_US);
+	a_measure->starts = g_hostTwiEepromStats.starts;
+	a_measure->addressNacks = g_hostTwiEepromStats.addressNacks;
+	a_measure->writeCycles = g_hostTwiEepromStats.writeCycles;
+	a_measure->isrCycles = g_hostTwiEepromStats.isrBlocks * HOST_CYCLES_PER_BLOCK;
+}
+
+/*
+ * Description :
+ * The write of the first version: one transaction for each byte, then a
+ * fixed delay for its write cycle.
+ */
+static void writeByteByByte(uint16 length, MeasureType *a_measure)
+{
+	TWI_TransactionType write;
+	uint64 start = beginMeasure();
+	uint16 i;
+
+	for (i = 0; i < length; i++)
+	{
+		write.slaveAddress = 0xA0;
+		write.command[0] = (uint8) i;
+		write.commandLength = 1;
+		write.writeData = &g_data[i];
+		write.writeLength = 1;
+		write.readLength = 0;
+		write.callBack = NULL_PTR;
+		write.status = TWI_TRANSACTION_IDLE;
+		TWI_submitTransaction(&write);
+		while (TWI_isIdle() == FALSE)
+		{
+			HOST_run(HOST_CYCLES_PER_BLOCK);
+		}
+		HOST_run(BYTE_DELAY_US * HOST_CYCLES_PER_US);
+	}
+	endMeasure(start, a_measure);
+}
+
+/*
+ * Description :
+ * The page writes with ACK polling of EEPROM_writeBlock.
+ */
+static void writePages(uint16 length, MeasureType *a_measure)
+{
+	uint64 start = beginMeasure();
+
+	EEPROM_writeBlock(0, g_data, length);
+	endMeasure(start, a_measure);
+}
+
+/*
+ * Description :
+ * The same page writes with EEPROM_writeBlockAsync, the CPU is free out of
+ * the ISR until the call back.
+ */
+static void writePagesAsync(uint16 length, MeasureType *a_measure)
+{
+	uint64 start = beginMeasure();
+
+	g_asyncDone = FALSE;
+	EEPROM_writeBlockAsync(0, g_data, length, asyncWritten);
+	while (g_asyncDone == FALSE)
+	{
+		HOST_run(HOST_CYCLES_PER_BLOCK);
+	}
+	endMeasure(start, a_measure);
+}
+
+/*
+ * Description :
+ * The reads of the first version: one transaction with the memory address
+ * and a REPEATED START for each byte.
+ */
+static void readByteByByte(uint16 length, MeasureType *a_measure)
+{
+	uint64 start = beginMeasure();
+	uint16 i;
+
+	for (i = 0; i < length; i++)
+	{
+		EEPROM_readByte(i, &g_readData[i]);
+	}
+	endMeasure(start, a_measure);
+}
+
+/*
+ * Description :
+ * The sequential read of EEPROM_readBlock.
+ */
+static void readSequential(uint16 length, MeasureType *a_measure)
+{
+	uint64 start = beginMeasure();
+
+	EEPROM_readBlock(0, g_readData, length);
+	endMeasure(start, a_measure);
+}
+
+int main(void)
+{
+	MeasureType before, after, async;
+	uint16 i;
+
+	for (i = 0; i < sizeof(g_data); i++)
+	{
+		g_data[i] = (uint8) i;
+	}
+
+	printf("24C16 block write at %lu kHz, write cycle %u us, clock of %u cycles a block\n",
+			BIT_RATE / 1000, HOST_TWI_EEPROM_WRITE_CYCLE_US,
+			HOST_CYCLES_PER_BLOCK);
+	printf("%6s | %28s | %34s | %8s | %7s\n", "", "byte by byte + 10 ms delay",
+			"page writes + ACK polling", "speedup", "ISR CPU");
+	printf("%6s | %9s %8s %9s | %9s %8s %7s %7s | %8s | %7s\n", "bytes", "ms",
+			"STARTs", "cycles", "ms", "STARTs", "NACKs", "cycles", "", "");
+	for (i = 0; i < NUM_SIZES; i++)
+	{
+		writeByteByByte(g_sizes[i], &before);
+		writePages(g_sizes[i], &after);
+		writePagesAsync(g_sizes[i], &async);
+		printf("%6u | %9.2f %8lu %9lu | %9.2f %8lu %7lu %7lu | %7.1fx | %6.2f%%\n",
+				g_sizes[i], before.timeUs / 1000.0,
+				(unsigned long) before.starts,
+				(unsigned long) before.writeCycles, after.timeUs / 1000.0,
+				(unsigned long) after.starts,
+				(unsigned long) after.addressNacks,
+				(unsigned long) after.writeCycles,
+				(double) before.timeUs / after.timeUs,
+				100.0 * async.isrCycles / (async.timeUs * HOST_CYCLES_PER_US));
+	}
+	printf("bytes/s of the page writes: %lu (256 bytes)\n",
+			(unsigned long) (256000000ULL / after.timeUs));
+
+	printf("\n24C16 block read at %lu kHz\n", BIT_RATE / 1000);
+	printf("%6s | %18s | %18s | %8s | %7s\n", "", "byte by byte",
+			"sequential read", "speedup", "ISR CPU");
+	printf("%6s | %9s %8s | %9s %8s | %8s | %7s\n", "bytes", "ms", "STARTs",
+			"ms", "STARTs", "", "");
+	for (i = 0; i < NUM_SIZES; i++)
+	{
+		readByteByByte(g_sizes[i], &before);
+		readSequential(g_sizes[i], &after);
+		printf("%6u | %9.2f %8lu | %9.2f %8lu | %7.1fx | %6.2f%%\n",
+				g_sizes[i], before.timeUs / 1000.0,
+				(unsigned long) before.starts, after.timeUs / 1000.0,
+				(unsigned long) after.starts,
+				(double) before.timeUs / after.timeUs,
+				100.0 * after.isrCycles / (after.timeUs * HOST_CYCLES_PER_US));
+	}
+	printf("bytes/s of the sequential read: %lu (256 bytes)\n",
+			(unsigned long) (256000000ULL / after.timeUs));
+	return 0;
+}
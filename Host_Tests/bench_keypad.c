@@ -0,0 +1,218 @@
+/*
+ ============================================================================
+ Name        : bench_keypad.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the GPIO accesses and the cycles of one keypad scan
+ ============================================================================
+ */
+
+/*
+ * keypad.c runs on the virtual clock of host_blocks.h and calls the GPIO API
+ * of this file through gpio_fast.h, a model of the key matrix. Each access
+ * counts the cycles of its instruction of the release build, where the inline
+ * API of gpio_fast.h gives one IN for the read of the column port and one SBI
+ * or CBI for a pin, so the cycles are a simulation and not a measure on target.
+ *
+ * The last column is the scan before the inline API, from its source: one
+ * GPIO_readPin call for each column, two GPIO_setupPinDirection calls and one
+ * GPIO_writePin call of the runtime API.
+ */
+
+#include "shim/host_blocks.h"
+#include "HAL/KEYPAD/keypad.h"
+#include "MCAL/GPIO/gpio.h"
+#include "MCAL/TIMER1/timer1_service.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The cycles of the instructions of the inline API */
+#define PORT_READ_CYCLES			1 /* IN */
+#define PIN_WRITE_CYCLES			2 /* SBI, CBI */
+
+/* The runtime API calls of a scan before the inline API */
+#define RUNTIME_CALLS_PER_SCAN		(KEYPAD_NUM_COLS + 3)
+
+/* The scans of each case, a number of whole rounds of the rows */
+#define ROUNDS						8
+#define SCANS						(ROUNDS * KEYPAD_NUM_ROWS)
+
+typedef enum
+{
+	CASE_NO_KEY, CASE_PRESS, CASE_KEY_HELD, NUM_CASES
+} CaseType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const char *const g_names[NUM_CASES] =
+{
+	"no key",
+	"a press and a release",
+	"a key held"
+};
+
+/* The driven row, or KEYPAD_NUM_ROWS for none, and the pressed key, or 0xFF */
+static uint8 g_drivenRow = KEYPAD_NUM_ROWS;
+static uint8 g_pressedRow = 0xFF;
+static uint8 g_pressedCol;
+
+static uint32 g_accesses;
+static uint32 g_events;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+	g_hostCycles += PIN_WRITE_CYCLES;
+	g_accesses++;
+	if ((port_num == KEYPAD_ROW_PORT_ID) && (pin_num >= KEYPAD_FIRST_ROW_PIN_ID))
+	{
+		if (direction == PIN_OUTPUT)
+		{
+			g_drivenRow = pin_num - KEYPAD_FIRST_ROW_PIN_ID;
+		}
+		else if (g_drivenRow == (pin_num - KEYPAD_FIRST_ROW_PIN_ID))
+		{
+			g_drivenRow = KEYPAD_NUM_ROWS;
+		}
+	}
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+	(void) port_num;
+	(void) pin_num;
+	(void) value;
+	g_hostCycles += PIN_WRITE_CYCLES;
+	g_accesses++;
+}
+
+/*
+ * Description :
+ * The columns are pulled up, the column of the pressed key is low while its
+ * row is driven.
+ */
+uint8 GPIO_readPort(uint8 port_num)
+{
+	uint8 value = 0xFF;
+
+	g_hostCycles += PORT_READ_CYCLES;
+	g_accesses++;
+	if ((port_num == KEYPAD_COL_PORT_ID) && (g_pressedRow == g_drivenRow))
+	{
+		value &= (uint8) ~(1 << (KEYPAD_FIRST_COL_PIN_ID + g_pressedCol));
+	}
+	return value;
+}
+
+/*
+ * Description :
+ * The scans are called by the benchmark, the periodic timer of KEYPAD_init is not used.
+ */
+uint8 Timer1_createTimer(TIMER1_TimerModeType mode, void (*a_ptr)(void))
+{
+	(void) mode;
+	(void) a_ptr;
+	return 0;
+}
+
+void Timer1_startTimer(uint8 id, uint16 a_ms)
+{
+	(void) id;
+	(void) a_ms;
+}
+
+/*
+ * Description :
+ * Set the pressed key of the scan of the case, the key of the last row is
+ * released at the half of a press and a release.
+ */
+static void setKey(CaseType kase, uint16 scan)
+{
+	if ((kase == CASE_NO_KEY) || ((kase == CASE_PRESS) && (scan >= (SCANS / 2))))
+	{
+		g_pressedRow = 0xFF;
+	}
+	else
+	{
+		g_pressedRow = KEYPAD_NUM_ROWS - 1;
+		g_pressedCol = KEYPAD_NUM_COLS - 1;
+	}
+}
+
+/*
+ * Description :
+ * Run the scans of the case and return the worst cycles of one scan, the
+ * accesses of all the scans are given by the pointer. The held key is
+ * pressed and debounced before the measured scans.
+ */
+static uint32 runCase(CaseType kase, uint32 *a_accesses)
+{
+	KEYPAD_EventType event;
+	uint32 worst = 0, cycles;
+	uint64 start;
+	uint16 scan;
+
+	if (kase == CASE_KEY_HELD)
+	{
+		for (scan = 0; scan < SCANS; scan++)
+		{
+			setKey(kase, scan);
+			KEYPAD_scan();
+		}
+	}
+	g_accesses = 0;
+	for (scan = 0; scan < SCANS; scan++)
+	{
+		setKey(kase, scan);
+		start = g_hostCycles;
+		KEYPAD_scan();
+		cycles = (uint32) (g_hostCycles - start);
+		if (cycles > worst)
+		{
+			worst = cycles;
+		}
+	}
+	g_events = 0;
+	while (KEYPAD_getEvent(&event) == TRUE)
+	{
+		g_events++;
+	}
+	*a_accesses = g_accesses;
+	return worst;
+}
+
+int main(void)
+{
+	uint32 worst, accesses, failed = 0;
+	uint8 kase;
+
+	KEYPAD_init();
+	printf("KEYPAD_scan, %u cycles a block, %u cycles a port read and %u a pin write\n",
+			HOST_CYCLES_PER_BLOCK, PORT_READ_CYCLES, PIN_WRITE_CYCLES);
+	printf("%-22s %9s %8s %13s %9s | %14s\n", "", "accesses", "/ scan", "worst cycles",
+			"worst us", "runtime calls");
+	for (kase = 0; kase < NUM_CASES; kase++)
+	{
+		worst = runCase(kase, &accesses);
+		printf("%-22s %9lu %8.1f %13lu %9.2f | %14u\n", g_names[kase], (unsigned long) accesses,
+				(double) accesses / SCANS, (unsigned long) worst,
+				(double) worst / HOST_CYCLES_PER_US,
+				RUNTIME_CALLS_PER_SCAN);
+		/* the model of the matrix is checked by the events of the press and the release */
+		if ((kase == CASE_PRESS) && (g_events != 2))
+		{
+			printf("FAIL: %lu key events of a press and a release\n", (unsigned long) g_events);
+			failed++;
+		}
+	}
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+ ============================================================================
+ Name        : bench_lcd.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the GPIO accesses and the time of each LCD operation
+ ============================================================================
+ */
+
+/*
+ * The benchmark is built for each LCD_WAIT_MODE of lcd.h, bench_lcd_timing
+ * and bench_lcd_busy_flag. lcd.c runs on the virtual clock against the model
+ * of the HD44780 of shim/host_lcd_bus.h, which checks that no byte is written
+ * while the LCD is busy and that the screen has the text.
+ *
+ * The last columns are the driver before the execution time waits, from its
+ * source: each byte was 13 pin writes with seven _delay_ms(1) between them.
+ */
+
+#include "shim/host_blocks.h"
+#include "shim/host_lcd_bus.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Each byte of the delay driver */
+#define DELAY_DRIVER_PIN_WRITES		13
+#define DELAY_DRIVER_US				7000
+
+typedef enum
+{
+	OP_INIT,
+	OP_CHARACTER,
+	OP_MOVE_CURSOR,
+	OP_CLEAR_SCREEN,
+	OP_ROW_STRING,
+	OP_FULL_SCREEN,
+	NUM_OPS
+} OpType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const char *const g_names[NUM_OPS] =
+{
+	"LCD_init",
+	"LCD_displayCharacter",
+	"LCD_moveCursor",
+	"LCD_clearScreen",
+	"LCD_displayString 16",
+	"clear + 2 rows of 16"
+};
+
+static const char g_row0[] = "plz re-enter the";
+static const char g_row1[] = "same pass:      ";
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Run one operation of the LCD driver.
+ */
+static void runOp(OpType op)
+{
+	switch (op)
+	{
+	case OP_INIT:
+		LCD_init();
+		break;
+	case OP_CHARACTER:
+		LCD_displayCharacter('*');
+		break;
+	case OP_MOVE_CURSOR:
+		LCD_moveCursor(1, 0);
+		break;
+	case OP_CLEAR_SCREEN:
+		LCD_clearScreen();
+		break;
+	case OP_ROW_STRING:
+		LCD_displayString(g_row0);
+		break;
+	default:
+		LCD_clearScreen();
+		LCD_displayString(g_row0);
+		LCD_moveCursor(1, 0);
+		LCD_displayString(g_row1);
+		break;
+	}
+}
+
+int main(void)
+{
+	HOST_LcdBusStatsType before;
+	uint64 start, cycles;
+	uint32 bytes, failed = 0;
+	uint8 op;
+
+	HOST_lcdBusReset();
+	printf("LCD operations with %s, %u cycles a block, %u cycles a pin access\n",
+			(LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG) ? "the busy flag" : "the execution time waits",
+			HOST_CYCLES_PER_BLOCK, HOST_LCD_BUS_CYCLES_PER_ACCESS);
+	printf("%-22s %6s %6s %6s %6s %6s %9s | %13s %9s\n", "", "bytes", "writes", "dirs",
+			"reads", "busy", "us", "delay writes", "us");
+	for (op = 0; op < NUM_OPS; op++)
+	{
+		/* the row string is measured without its cursor move */
+		if (op == OP_ROW_STRING)
+		{
+			LCD_moveCursor(0, 0);
+		}
+		before = g_hostLcdBusStats;
+		start = g_hostCycles;
+		runOp(op);
+		cycles = g_hostCycles - start;
+		bytes = (g_hostLcdBusStats.instructions - before.instructions)
+				+ (g_hostLcdBusStats.characters - before.characters);
+		printf("%-22s %6lu %6lu %6lu %6lu %6lu %9.1f", g_names[op], (unsigned long) bytes,
+				(unsigned long) (g_hostLcdBusStats.pinWrites - before.pinWrites),
+				(unsigned long) (g_hostLcdBusStats.directionWrites - before.directionWrites),
+				(unsigned long) (g_hostLcdBusStats.pinReads - before.pinReads),
+				(unsigned long) (g_hostLcdBusStats.busyReads - before.busyReads),
+				(double) cycles / HOST_CYCLES_PER_US);
+		if (op == OP_INIT)
+		{
+			printf(" | %13s %9s\n", "-", "-");
+		}
+		else
+		{
+			printf(" | %13lu %9lu\n", (unsigned long) (bytes * DELAY_DRIVER_PIN_WRITES),
+					(unsigned long) (bytes * DELAY_DRIVER_US));
+		}
+	}
+
+	if (g_hostLcdBusStats.lostBytes != 0)
+	{
+		printf("FAIL: %lu bytes written while the LCD was busy\n",
+				(unsigned long) g_hostLcdBusStats.lostBytes);
+		failed++;
+	}
+	if ((strcmp(HOST_lcdBusRow(0), g_row0) != 0) || (strcmp(HOST_lcdBusRow(1), g_row1) != 0))
+	{
+		printf("FAIL: the screen is [%s][%s]\n", HOST_lcdBusRow(0), HOST_lcdBusRow(1));
+		failed++;
+	}
+	return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/*
+ ============================================================================
+ Name        : bench_lcd_screens.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the LCD bus transactions of the HMI screen transitions
+ ============================================================================
+ */
+
+/*
+ * The screens of HMI_ECU.c from the power on to a door cycle, a wrong
+ * password, the lockout and the admin menu are drawn in two ways on the model
+ * of the HD44780 of shim/host_lcd_bus.h:
+ *   direct    LCD_clearScreen, then the rows with LCD_displayString, the way of
+ *             HMI_ECU.c before the frame buffer
+ *   buffered  the frame buffer calls of HMI_ECU.c, then LCD_flush with
+ *             LCD_FLUSH_MAX_BYTES until the screen is up to date, one call a tick
+ * A bus transaction is one instruction or character. The screen of both ways
+ * is checked to be the same after each transition.
+ */
+
+#include "shim/host_blocks.h"
+#include "shim/host_lcd_bus.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The flush of one tick of HMI_ECU.c */
+#define LCD_FLUSH_MAX_BYTES			8
+
+typedef enum
+{
+	SCREEN_TEXT, /* a new screen of two rows */
+	SCREEN_ECHO, /* one '*' of a password digit at the cursor */
+	SCREEN_COUNTDOWN /* the seconds at the end of the second row */
+} ScreenKindType;
+
+typedef struct
+{
+	ScreenKindType kind;
+	const char *row0;
+	const char *row1; /* the seconds of a countdown */
+} ScreenType;
+
+/* The cost of one screen */
+typedef struct
+{
+	uint32 bytes;
+	uint64 cycles;
+	uint32 flushes; /* LCD_flush calls of the buffered way */
+} CostType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const ScreenType g_screens[] =
+{
+	{ SCREEN_TEXT, "  Final Project ", "Edges Diploma 79" },
+	{ SCREEN_TEXT, "     Made By    ", "    Ahmed Ali   " },
+	{ SCREEN_TEXT, "plz enter pass:", "" },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_TEXT, "plz re-enter the", "same pass: " },
+	{ SCREEN_ECHO, NULL_PTR, NULL_PTR },
+	{ SCREEN_TEXT, "+ : Open Door", "- : Change Pass" },
+	{ SCREEN_TEXT, "plz enter pass:", "" },
+	{ SCREEN_TEXT, "    Door is     ", "   Unlocking" },
+	{ SCREEN_COUNTDOWN, NULL_PTR, "15s" },
+	{ SCREEN_COUNTDOWN, NULL_PTR, "14s" },
+	{ SCREEN_COUNTDOWN, NULL_PTR, " 9s" },
+	{ SCREEN_TEXT, "    Door is     ", "  Open" },
+	{ SCREEN_TEXT, "    Door is     ", "    locking" },
+	{ SCREEN_TEXT, "+ : Open Door", "- : Change Pass" },
+	{ SCREEN_TEXT, "plz enter pass:", "" },
+	{ SCREEN_TEXT, "Wrong Password", "" },
+	{ SCREEN_TEXT, "plz enter pass:", "" },
+	{ SCREEN_TEXT, "   LOCKED OUT   ", " Wait" },
+	{ SCREEN_COUNTDOWN, NULL_PTR, "60s" },
+	{ SCREEN_TEXT, "+ : Open Door", "- : Change Pass" },
+	{ SCREEN_TEXT, "1:Add  2:Revoke", "3:Diag 4:Probes" }
+};
+
+#define NUM_SCREENS		(sizeof(g_screens) / sizeof(g_screens[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Draw the screen with the direct calls of the driver.
+ */
+static void drawDirect(const ScreenType *a_screen)
+{
+	if (a_screen->kind == SCREEN_ECHO)
+	{
+		LCD_displayCharacter('*');
+	}
+	else if (a_screen->kind == SCREEN_COUNTDOWN)
+	{
+		LCD_displayStringRowColumn(1, LCD_COLS - strlen(a_screen->row1), a_screen->row1);
+	}
+	else
+	{
+		LCD_clearScreen();
+		LCD_displayString(a_screen->row0);
+		LCD_moveCursor(1, 0);
+		LCD_displayString(a_screen->row1);
+	}
+}
+
+/*
+ * Description :
+ * Draw the screen in the frame buffer, the echo goes to the buffer cursor.
+ */
+static void drawBuffer(const ScreenType *a_screen)
+{
+	if (a_screen->kind == SCREEN_ECHO)
+	{
+		LCD_bufferDisplayCharacter('*');
+	}
+	else if (a_screen->kind == SCREEN_COUNTDOWN)
+	{
+		LCD_bufferDisplayStringRowColumn(1, LCD_COLS - strlen(a_screen->row1), a_screen->row1);
+	}
+	else
+	{
+		LCD_bufferClear();
+		LCD_bufferDisplayString(a_screen->row0);
+		LCD_bufferMoveCursor(1, 0);
+		LCD_bufferDisplayString(a_screen->row1);
+	}
+}
+
+/*
+ * Description :
+ * Power on the LCD, then draw all the screens in one way and take the cost
+ * and the text of each one. The buffered way is flushed like the ticks of
+ * HMI_ECU.c until the screen is up to date.
+ */
+static void drawAll(uint8 buffered, CostType costs[], char texts[][2][LCD_COLS + 1])
+{
+	uint32 bytes;
+	uint64 cycles;
+	uint8 i;
+
+	HOST_lcdBusReset();
+	LCD_init();
+	for (i = 0; i < NUM_SCREENS; i++)
+	{
+		bytes = g_hostLcdBusStats.instructions + g_hostLcdBusStats.characters;
+		cycles = g_hostCycles;
+		costs[i].flushes = 0;
+		if (buffered == TRUE)
+		{
+			drawBuffer(&g_screens[i]);
+			do
+			{
+				costs[i].flushes++;
+			} while (LCD_flush(LCD_FLUSH_MAX_BYTES) == FALSE);
+		}
+		else
+		{
+			drawDirect(&g_screens[i]);
+		}
+		costs[i].bytes = (g_hostLcdBusStats.instructions + g_hostLcdBusStats.characters) - bytes;
+		costs[i].cycles = g_hostCycles - cycles;
+		strcpy(texts[i][0], HOST_lcdBusRow(0));
+		strcpy(texts[i][1], HOST_lcdBusRow(1));
+	}
+}
+
+int main(void)
+{
+	static CostType direct[NUM_SCREENS], buffered[NUM_SCREENS];
+	static char directTexts[NUM_SCREENS][2][LCD_COLS + 1];
+	static char bufferedTexts[NUM_SCREENS][2][LCD_COLS + 1];
+	uint32 directBytes = 0, bufferedBytes = 0, failed = 0;
+	uint64 directCycles = 0, bufferedCycles = 0;
+	uint8 i;
+
+	drawAll(FALSE, direct, directTexts);
+	drawAll(TRUE, buffered, bufferedTexts);
+
+	printf("LCD bus transactions of the HMI screens, %u cycles a block, flush of %u bytes a tick\n",
+			HOST_CYCLES_PER_BLOCK, LCD_FLUSH_MAX_BYTES);
+	printf("%-18s | %7s %9s | %7s %6s %9s\n", "screen", "direct", "us", "buffer", "ticks", "us");
+	for (i = 0; i < NUM_SCREENS; i++)
+	{
+		printf("%-18s | %7lu %9.1f | %7lu %6lu %9.1f",
+				(g_screens[i].kind == SCREEN_ECHO) ? "*" :
+				(g_screens[i].kind == SCREEN_COUNTDOWN) ? g_screens[i].row1 : g_screens[i].row0,
+				(unsigned long) direct[i].bytes, (double) direct[i].cycles / HOST_CYCLES_PER_US,
+				(unsigned long) buffered[i].bytes, (unsigned long) buffered[i].flushes,
+				(double) buffered[i].cycles / HOST_CYCLES_PER_US);
+		if ((strcmp(directTexts[i][0], bufferedTexts[i][0]) != 0)
+				|| (strcmp(directTexts[i][1], bufferedTexts[i][1]) != 0))
+		{
+			printf("  FAIL: [%s][%s]", bufferedTexts[i][0], bufferedTexts[i][1]);
+			failed++;
+		}
+		printf("\n");
+		directBytes += direct[i].bytes;
+		directCycles += direct[i].cycles;
+		bufferedBytes += buffered[i].bytes;
+		bufferedCycles += buffered[i].cycles;
+	}
+	printf("%-18s | %7lu %9.1f | %7lu %6s %9.1f\n", "total", (unsigned long) directBytes,
+			(double) directCycles / HOST_CYCLES_PER_US, (unsigned long) bufferedBytes, "",
+			(double) bufferedCycles / HOST_CYCLES_PER_US);
+	if (g_hostLcdBusStats.lostBytes != 0)
+	{
+		printf("FAIL: %lu bytes written while the LCD was busy\n",
+				(unsigned long) g_hostLcdBusStats.lostBytes);
+		failed++;
+	}
+	return (failed == 0) ? 0 : 1;
+}
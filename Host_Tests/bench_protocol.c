@@ -0,0 +1,265 @@
+/*
+ ============================================================================
+ Name        : bench_protocol.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the bytes and the turnarounds on the line of each request
+ ============================================================================
+ */
+
+/*
+ * The operations of the user run in the simulation of both ECUs (see
+ * shim/host_sim.h) and the line is watched between the enter key and the
+ * screen of the reply: the bytes of each direction, the turnarounds (a byte
+ * in the other direction than the last one) and the time from the start of
+ * the first byte to the end of the last one.
+ *
+ * The before columns are the protocol of one byte per digit which the frames
+ * replaced, counted from its source: the action and mode bytes, then each
+ * digit answered by START_COMMNUCATION, then the reply byte, and after a
+ * wrong password the BUZZER_ON or BUZZER_OFF byte of HMI ECU. Its line time
+ * is the least one, its bytes back to back and the 10 ms wait after each digit
+ * of the create for the EEPROM write.
+ */
+
+#include "shim/host_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SEED						1
+
+#define CYCLES_PER_MS				(F_CPU / 1000UL)
+
+/* A byte on the line at 9600 baud with U2X, 10 bits of 8 * (UBRR + 1) cycles */
+#define BYTE_CYCLES					(10UL * 8UL * 104UL)
+
+/* The line is checked at this period, less than one byte */
+#define STEP_CYCLES					200
+
+#define KEY_HOLD_MS					80
+#define KEY_GAP_MS					120
+
+/* The longest wait of a screen, and the quiet line after it */
+#define SCREEN_WAIT_MS				2000
+#define QUIET_MS					20
+
+#define PASSWORD_DIGITS				5
+
+/* The wait of the create before the frames after each digit */
+#define BEFORE_EEPROM_WAIT_MS		10
+
+typedef enum
+{
+	OP_PASSWORD_STATE, OP_CREATE, OP_CHECK_WRONG, OP_CHECK_CORRECT, NUM_OPS
+} OpType;
+
+/* The line during one operation, and the protocol before the frames */
+typedef struct
+{
+	const char *name;
+	uint8 beforeHmiBytes;
+	uint8 beforeControlBytes;
+	uint8 beforeTurnarounds;
+	uint8 beforeWaitMs;
+	uint32 hmiBytes;
+	uint32 controlBytes;
+	uint32 turnarounds;
+	uint64 firstStart;
+	uint64 lastEnd;
+} LineType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static LineType g_ops[NUM_OPS] =
+{
+	{ "password state at boot", 0, 0, 0, 0 },
+	{ "create password", 6, 5, 9, PASSWORD_DIGITS * BEFORE_EEPROM_WAIT_MS },
+	{ "check, wrong password", 8, 6, 10, 0 },
+	{ "check, door opens", 7, 6, 9, 0 }
+};
+
+static const HOST_HmiBoardType *const g_hmi = &g_hostHmiBoard;
+
+/* The operation being watched, NUM_OPS for none */
+static OpType g_op = NUM_OPS;
+static uint32 g_lastHmiBytes;
+static uint32 g_lastControlBytes;
+/* The direction of the last byte, TRUE for HMI ECU to Control ECU */
+static uint8 g_lastFromHmi;
+static uint8 g_anyByte;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Take one byte of the line for the operation being watched.
+ */
+static void takeByte(uint8 fromHmi, uint64 end)
+{
+	LineType *op = &g_ops[g_op];
+
+	if (fromHmi == TRUE)
+	{
+		op->hmiBytes++;
+	}
+	else
+	{
+		op->controlBytes++;
+	}
+	if ((op->hmiBytes + op->controlBytes) == 1)
+	{
+		op->firstStart = end - BYTE_CYCLES;
+	}
+	else if ((g_anyByte == TRUE) && (fromHmi != g_lastFromHmi))
+	{
+		op->turnarounds++;
+	}
+	op->lastEnd = end;
+	g_lastFromHmi = fromHmi;
+	g_anyByte = TRUE;
+}
+
+/*
+ * Description :
+ * Run one step and take the new bytes of the line in the order of their ends,
+ * a step is shorter than a byte so there is at most one in each direction.
+ */
+static void step(void)
+{
+	uint8 newHmi, newControl;
+
+	HOST_simRun(STEP_CYCLES);
+	newHmi = (g_hostSimStats.hmiToControlBytes != g_lastHmiBytes) ? TRUE : FALSE;
+	newControl = (g_hostSimStats.controlToHmiBytes != g_lastControlBytes) ? TRUE : FALSE;
+	g_lastHmiBytes = g_hostSimStats.hmiToControlBytes;
+	g_lastControlBytes = g_hostSimStats.controlToHmiBytes;
+	if (g_op == NUM_OPS)
+	{
+		return;
+	}
+	if (newHmi && newControl && (g_hostSimStats.controlToHmiEnd < g_hostSimStats.hmiToControlEnd))
+	{
+		takeByte(FALSE, g_hostSimStats.controlToHmiEnd);
+		newControl = FALSE;
+	}
+	if (newHmi)
+	{
+		takeByte(TRUE, g_hostSimStats.hmiToControlEnd);
+	}
+	if (newControl)
+	{
+		takeByte(FALSE, g_hostSimStats.controlToHmiEnd);
+	}
+}
+
+/*
+ * Description :
+ * Run until the row of the LCD has the text, then until the line is quiet.
+ * Return TRUE if the text is shown.
+ */
+static uint8 waitLcd(uint8 row, const char *text)
+{
+	uint64 end = HOST_simNow() + (SCREEN_WAIT_MS * CYCLES_PER_MS);
+
+	while (strstr(g_hmi->lcd->text[row], text) == NULL_PTR)
+	{
+		if (HOST_simNow() >= end)
+		{
+			printf("FAIL: no \"%s\", the screen is [%s][%s]\n", text, g_hmi->lcd->text[0],
+					g_hmi->lcd->text[1]);
+			return FALSE;
+		}
+		step();
+	}
+	end = HOST_simNow() + (QUIET_MS * CYCLES_PER_MS);
+	while (HOST_simNow() < end)
+	{
+		step();
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Press and release the key, and run until it is released.
+ */
+static void typeKey(uint8 key)
+{
+	uint64 time = HOST_simNow() + (KEY_GAP_MS * CYCLES_PER_MS);
+
+	HOST_simSchedule(time, g_hmi->setKey, key);
+	HOST_simSchedule(time + (KEY_HOLD_MS * CYCLES_PER_MS), g_hmi->setKey, HOST_NO_KEY);
+	while (HOST_simNow() <= (time + (KEY_HOLD_MS * CYCLES_PER_MS)))
+	{
+		step();
+	}
+}
+
+/*
+ * Description :
+ * Type the digits of the password, then watch the line from its enter key
+ * for the operation until the screen of the reply.
+ */
+static uint8 enterPassword(const char *digits, OpType op, uint8 row, const char *text)
+{
+	uint8 i;
+
+	for (i = 0; i < PASSWORD_DIGITS; i++)
+	{
+		typeKey((uint8) (digits[i] - '0'));
+	}
+	g_op = op;
+	g_anyByte = FALSE;
+	typeKey('#');
+	i = waitLcd(row, text);
+	g_op = NUM_OPS;
+	return i;
+}
+
+int main(void)
+{
+	uint8 completed, op;
+
+	HOST_simInit(SEED);
+	g_op = OP_PASSWORD_STATE;
+	g_anyByte = FALSE;
+	completed = waitLcd(0, "plz enter pass:");
+	g_op = NUM_OPS;
+	completed = completed && enterPassword("12345", NUM_OPS, 0, "plz re-enter the")
+			&& enterPassword("12345", OP_CREATE, 0, "+ : Open Door");
+	if (completed)
+	{
+		typeKey('+');
+		completed = waitLcd(0, "plz enter pass:")
+				&& enterPassword("54321", OP_CHECK_WRONG, 0, "Wrong Password")
+				&& waitLcd(0, "plz enter pass:")
+				&& enterPassword("12345", OP_CHECK_CORRECT, 1, "Unlocking");
+	}
+
+	printf("line of each request at 9600 baud, %.2f ms a byte, before = one byte a digit\n",
+			(double) BYTE_CYCLES / CYCLES_PER_MS);
+	printf("%-24s | %-34s | %-34s\n", "", "before", "frames");
+	printf("%-24s | %7s %7s %7s %10s | %7s %7s %7s %10s\n", "", "HMI", "Control", "turns",
+			"line ms >=", "HMI", "Control", "turns", "line ms");
+	for (op = 0; op < NUM_OPS; op++)
+	{
+		printf("%-24s | %7u %7u %7u %10.2f | %7lu %7lu %7lu %10.2f\n", g_ops[op].name,
+				g_ops[op].beforeHmiBytes, g_ops[op].beforeControlBytes,
+				g_ops[op].beforeTurnarounds,
+				((double) (g_ops[op].beforeHmiBytes + g_ops[op].beforeControlBytes) * BYTE_CYCLES
+						/ CYCLES_PER_MS) + g_ops[op].beforeWaitMs,
+				(unsigned long) g_ops[op].hmiBytes,
+				(unsigned long) g_ops[op].controlBytes, (unsigned long) g_ops[op].turnarounds,
+				(double) (g_ops[op].lastEnd - g_ops[op].firstStart) / CYCLES_PER_MS);
+	}
+	return (completed == TRUE) ? 0 : 1;
+}
@@ -0,0 +1,532 @@
+/*
+ ============================================================================
+ Name        : bench_stages.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host benchmark of the stages from a key press to the motor against a baseline
+ ============================================================================
+ */
+
+/*
+ * Usage: bench_stages [--update]
+ *
+ * A scripted user types on the keypad of the HMI ECU in the simulation of
+ * both ECUs (see shim/host_sim.h): the creation of the admin password, then
+ * the correct password which opens the door. Each seed of BENCH_SEEDS runs
+ * in its own process. The stages are times on the virtual clock which are
+ * seen on the pins of the boards and on the line:
+ *   key scan       the press of a key to the scan with its last debounce sample
+ *   LCD echo       that scan of a digit to the write of its '*'
+ *   UART framing   that scan of the enter key to the end of the request frame
+ *   EEPROM verify  the end of the request to the start of the reply, the
+ *                  password check of Control ECU with its 24C16 reads
+ *   motor start    the start of the reply to the motor turning
+ * The last three are taken for the password which opens the door.
+ *
+ * The 50th, 90th and 99th percentiles of each stage are checked against
+ * BASELINE_FILE, the program fails if one of them is longer than its baseline
+ * by more than BASELINE_TOLERANCE_PERCENT. --update writes the new baseline.
+ */
+
+#include "shim/host_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BASELINE_FILE				"bench_stages.baseline"
+#define BASELINE_TOLERANCE_PERCENT	5
+
+#define FIRST_SEED					1
+#define BENCH_SEEDS					16
+
+#define CYCLES_PER_MS				(F_CPU / 1000UL)
+#define CYCLES_PER_US				(F_CPU / 1000000UL)
+
+/* A byte on the line at 9600 baud with U2X, 10 bits of 8 * (UBRR + 1) cycles */
+#define BYTE_CYCLES					(10UL * 8UL * 104UL)
+
+/* The pins and the line are checked at this period, less than one LCD write */
+#define STEP_CYCLES					200
+
+/* The times of a key typed by the user, the random part is added to the minimum */
+#define KEY_HOLD_MIN_MS				60
+#define KEY_HOLD_RANDOM_MS			60
+#define KEY_GAP_MIN_MS				60
+#define KEY_GAP_RANDOM_MS			140
+
+/* The longest wait of a screen */
+#define SCREEN_WAIT_MS				2000
+
+/* The digits and the enter key of a password */
+#define PASSWORD_KEYS				6
+
+/* The samples of one stage in one run */
+#define MAX_SAMPLES					32
+
+#define NUM_PERCENTILES				3
+
+typedef enum
+{
+	STAGE_KEY_SCAN,
+	STAGE_LCD_ECHO,
+	STAGE_UART_FRAMING,
+	STAGE_EEPROM_VERIFY,
+	STAGE_MOTOR_START,
+	NUM_STAGES
+} StageType;
+
+/* The samples of one run in microseconds, sent by its process */
+typedef struct
+{
+	uint8 completed;
+	uint8 count[NUM_STAGES];
+	uint32 us[NUM_STAGES][MAX_SAMPLES];
+} ResultType;
+
+/* The state of the key being typed */
+typedef struct
+{
+	uint8 key;
+	uint64 sampledPress; /* the press whose key scan is taken */
+	uint8 echoed; /* the echo of the digit is taken */
+} TypingType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The names of the stages in the output and in the baseline file */
+static const char *const g_names[NUM_STAGES] =
+{
+	"key_scan",
+	"lcd_echo",
+	"uart_framing",
+	"eeprom_verify",
+	"motor_start"
+};
+
+static const uint8 g_percentiles[NUM_PERCENTILES] = { 50, 90, 99 };
+
+static const HOST_HmiBoardType *const g_hmi = &g_hostHmiBoard;
+static const HOST_ControlBoardType *const g_control = &g_hostControlBoard;
+
+static ResultType g_result;
+static TypingType g_typing;
+
+/* All the samples of each stage */
+static uint32 g_samples[NUM_STAGES][BENCH_SEEDS * MAX_SAMPLES];
+static uint32 g_sampleCount[NUM_STAGES];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Keep one sample of the stage in microseconds.
+ */
+static void addSample(StageType stage, uint64 cycles)
+{
+	if (g_result.count[stage] < MAX_SAMPLES)
+	{
+		g_result.us[stage][g_result.count[stage]] = (uint32) (cycles / CYCLES_PER_US);
+		g_result.count[stage]++;
+	}
+}
+
+/*
+ * Description :
+ * The action of the queue which presses a key, it is also kept as the key being typed.
+ */
+static void pressAction(uint8 key)
+{
+	g_typing.key = key;
+	g_typing.echoed = FALSE;
+	g_hmi->setKey(key);
+}
+
+/*
+ * Description :
+ * Run one step and take the key scan and the echo of the key being typed.
+ */
+static void step(void)
+{
+	const HOST_KeypadType *keypad = g_hmi->keypad;
+
+	HOST_simRun(STEP_CYCLES);
+	if ((keypad->detected == 0) || (keypad->pressed == 0))
+	{
+		return;
+	}
+	if (keypad->pressed != g_typing.sampledPress)
+	{
+		g_typing.sampledPress = keypad->pressed;
+		addSample(STAGE_KEY_SCAN, keypad->detected - keypad->pressed);
+	}
+	/* the digits are echoed, the other keys change the screen */
+	if ((g_typing.key <= 9) && (g_typing.echoed == FALSE)
+			&& (g_hmi->lcd->lastWrite > keypad->detected))
+	{
+		g_typing.echoed = TRUE;
+		addSample(STAGE_LCD_ECHO, g_hmi->lcd->lastWrite - keypad->detected);
+	}
+}
+
+/*
+ * Description :
+ * Put the press and the release of the key in the queue after a random gap.
+ * Return the time of the release.
+ */
+static uint64 scheduleKey(uint64 time, uint8 key)
+{
+	time += (KEY_GAP_MIN_MS + HOST_simRandom(KEY_GAP_RANDOM_MS)) * CYCLES_PER_MS;
+	HOST_simSchedule(time, pressAction, key);
+	time += (KEY_HOLD_MIN_MS + HOST_simRandom(KEY_HOLD_RANDOM_MS)) * CYCLES_PER_MS;
+	HOST_simSchedule(time, g_hmi->setKey, HOST_NO_KEY);
+	return time;
+}
+
+/*
+ * Description :
+ * Put the digits of the password in the queue, it is entered by the user
+ * later by enterKey. Return the time of the release of the last digit.
+ */
+static uint64 typeDigits(const char *digits)
+{
+	uint64 time = HOST_simNow();
+	uint8 i;
+
+	for (i = 0; i < (PASSWORD_KEYS - 1); i++)
+	{
+		time = scheduleKey(time, (uint8) (digits[i] - '0'));
+	}
+	return time;
+}
+
+/*
+ * Description :
+ * Run until the time, then press the enter key and run until it is detected.
+ * Return FALSE if it is not detected.
+ */
+static uint8 enterKey(uint64 time)
+{
+	uint64 end = scheduleKey(time, '#');
+
+	while ((g_typing.key != '#') || (g_hmi->keypad->detected == 0))
+	{
+		if (HOST_simNow() >= end)
+		{
+			return FALSE;
+		}
+		step();
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Run until the row of the LCD has the text or the time ends.
+ * Return TRUE if the text is shown.
+ */
+static uint8 waitLcd(uint8 row, const char *text, uint32 ms)
+{
+	uint64 end = HOST_simNow() + ((uint64) ms * CYCLES_PER_MS);
+
+	while (strstr(g_hmi->lcd->text[row], text) == NULL_PTR)
+	{
+		if (HOST_simNow() >= end)
+		{
+			return FALSE;
+		}
+		step();
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Type the password, then run until the row of the LCD has the text.
+ */
+static uint8 typeAndWait(const char *digits, uint8 row, const char *text)
+{
+	return enterKey(typeDigits(digits)) && waitLcd(row, text, SCREEN_WAIT_MS);
+}
+
+/*
+ * Description :
+ * Open the door with the correct password and take the stages of its request.
+ */
+static uint8 unlockDoor(void)
+{
+	uint64 detected, requestEnd, replyStart;
+	uint32 replyBytes;
+
+	scheduleKey(HOST_simNow(), '+');
+	if ((waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == FALSE)
+			|| (enterKey(typeDigits("12345")) == FALSE))
+	{
+		return FALSE;
+	}
+	detected = g_hmi->keypad->detected;
+	/* the first byte of Control ECU after the enter key is the start of the reply */
+	replyBytes = g_hostSimStats.controlToHmiBytes;
+	while (g_hostSimStats.controlToHmiBytes == replyBytes)
+	{
+		if (HOST_simNow() >= (detected + (SCREEN_WAIT_MS * CYCLES_PER_MS)))
+		{
+			return FALSE;
+		}
+		step();
+	}
+	requestEnd = g_hostSimStats.hmiToControlEnd;
+	replyStart = g_hostSimStats.controlToHmiEnd - BYTE_CYCLES;
+	while (g_control->motor->direction != HOST_MOTOR_CLOCK_WISE)
+	{
+		if (HOST_simNow() >= (detected + (SCREEN_WAIT_MS * CYCLES_PER_MS)))
+		{
+			return FALSE;
+		}
+		step();
+	}
+	if ((requestEnd <= detected) || (replyStart < requestEnd)
+			|| (g_control->motor->lastChange < replyStart))
+	{
+		return FALSE;
+	}
+	addSample(STAGE_UART_FRAMING, requestEnd - detected);
+	addSample(STAGE_EEPROM_VERIFY, replyStart - requestEnd);
+	addSample(STAGE_MOTOR_START, g_control->motor->lastChange - replyStart);
+	return waitLcd(1, "Unlocking", SCREEN_WAIT_MS);
+}
+
+/*
+ * Description :
+ * Run the scenario with the seed in a new process and take its samples.
+ * Return FALSE if the process failed.
+ */
+static uint8 runSeed(uint32 seed, ResultType *a_result)
+{
+	int pipeFds[2];
+	int status;
+	pid_t pid;
+
+	if (pipe(pipeFds) != 0)
+	{
+		return FALSE;
+	}
+	pid = fork();
+	if (pid == 0)
+	{
+		close(pipeFds[0]);
+		memset(&g_result, 0, sizeof(g_result));
+		memset(&g_typing, 0, sizeof(g_typing));
+		g_typing.key = HOST_NO_KEY;
+		HOST_simInit(seed);
+		g_result.completed = waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS)
+				&& typeAndWait("12345", 0, "plz re-enter the")
+				&& typeAndWait("12345", 0, "+ : Open Door") && unlockDoor();
+		if (write(pipeFds[1], &g_result, sizeof(g_result)) != sizeof(g_result))
+		{
+			_exit(1);
+		}
+		_exit(0);
+	}
+	close(pipeFds[1]);
+	memset(a_result, 0, sizeof(*a_result));
+	if ((pid < 0) || (read(pipeFds[0], a_result, sizeof(*a_result)) != sizeof(*a_result)))
+	{
+		a_result->completed = FALSE;
+	}
+	close(pipeFds[0]);
+	if (pid > 0)
+	{
+		waitpid(pid, &status, 0);
+	}
+	return a_result->completed;
+}
+
+static int compareSamples(const void *a, const void *b)
+{
+	uint32 x = *(const uint32*) a;
+	uint32 y = *(const uint32*) b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Description :
+ * Return the percentile of the sorted samples by the nearest rank.
+ */
+static uint32 percentile(const uint32 samples[], uint32 count, uint8 percent)
+{
+	uint32 rank = ((count * percent) + 99) / 100;
+
+	return samples[(rank != 0) ? (rank - 1) : 0];
+}
+
+/*
+ * Description :
+ * Read the percentiles of each stage from the baseline file.
+ * Return FALSE if the file is missing or a stage is not in it.
+ */
+static uint8 readBaseline(uint32 baseline[NUM_STAGES][NUM_PERCENTILES])
+{
+	FILE *file = fopen(BASELINE_FILE, "r");
+	char line[128], name[32];
+	unsigned long us[NUM_PERCENTILES];
+	uint8 found[NUM_STAGES] = { 0 };
+	uint8 stage, i;
+
+	if (file == NULL)
+	{
+		return FALSE;
+	}
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		if ((line[0] == '#')
+				|| (sscanf(line, "%31s %lu %lu %lu", name, &us[0], &us[1], &us[2]) != 4))
+		{
+			continue;
+		}
+		for (stage = 0; stage < NUM_STAGES; stage++)
+		{
+			if (strcmp(name, g_names[stage]) == 0)
+			{
+				for (i = 0; i < NUM_PERCENTILES; i++)
+				{
+					baseline[stage][i] = (uint32) us[i];
+				}
+				found[stage] = TRUE;
+			}
+		}
+	}
+	fclose(file);
+	for (stage = 0; stage < NUM_STAGES; stage++)
+	{
+		if (found[stage] == FALSE)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Write the percentiles of each stage as the new baseline file.
+ * Return FALSE if the file can't be written.
+ */
+static uint8 writeBaseline(uint32 measured[NUM_STAGES][NUM_PERCENTILES])
+{
+	FILE *file = fopen(BASELINE_FILE, "w");
+	uint8 stage;
+
+	if (file == NULL)
+	{
+		return FALSE;
+	}
+	fprintf(file, "# bench_stages: microseconds of the p50, p90 and p99 of each stage,\n");
+	fprintf(file, "# seeds %u to %u, written by bench_stages --update\n",
+			FIRST_SEED, FIRST_SEED + BENCH_SEEDS - 1);
+	for (stage = 0; stage < NUM_STAGES; stage++)
+	{
+		fprintf(file, "%s %lu %lu %lu\n", g_names[stage], (unsigned long) measured[stage][0],
+				(unsigned long) measured[stage][1], (unsigned long) measured[stage][2]);
+	}
+	return (fclose(file) == 0) ? TRUE : FALSE;
+}
+
+int main(int argc, char *argv[])
+{
+	uint8 update = ((argc > 1) && (strcmp(argv[1], "--update") == 0)) ? TRUE : FALSE;
+	uint32 measured[NUM_STAGES][NUM_PERCENTILES];
+	uint32 baseline[NUM_STAGES][NUM_PERCENTILES];
+	uint8 haveBaseline = FALSE;
+	ResultType result;
+	uint32 seed, failed = 0, regressed = 0;
+	uint8 stage, i;
+
+	for (seed = FIRST_SEED; seed < (FIRST_SEED + BENCH_SEEDS); seed++)
+	{
+		if (runSeed(seed, &result) == FALSE)
+		{
+			printf("seed %lu: the door is not opened\n", (unsigned long) seed);
+			failed++;
+			continue;
+		}
+		for (stage = 0; stage < NUM_STAGES; stage++)
+		{
+			for (i = 0; i < result.count[stage]; i++)
+			{
+				g_samples[stage][g_sampleCount[stage]++] = result.us[stage][i];
+			}
+		}
+	}
+	if (failed != 0)
+	{
+		return 1;
+	}
+
+	if (update == FALSE)
+	{
+		haveBaseline = readBaseline(baseline);
+		if (haveBaseline == FALSE)
+		{
+			printf("no baseline in %s, run bench_stages --update\n", BASELINE_FILE);
+		}
+	}
+	printf("stages of %u runs from the seed %u, microseconds on the virtual clock\n",
+			BENCH_SEEDS, FIRST_SEED);
+	printf("%-14s %8s %9s %9s %9s   %s\n", "stage", "samples", "p50", "p90", "p99",
+			"baseline p50/p90/p99");
+	for (stage = 0; stage < NUM_STAGES; stage++)
+	{
+		qsort(g_samples[stage], g_sampleCount[stage], sizeof(uint32), compareSamples);
+		for (i = 0; i < NUM_PERCENTILES; i++)
+		{
+			measured[stage][i] = (g_sampleCount[stage] != 0) ?
+					percentile(g_samples[stage], g_sampleCount[stage], g_percentiles[i]) : 0;
+		}
+		printf("%-14s %8lu %9lu %9lu %9lu", g_names[stage],
+				(unsigned long) g_sampleCount[stage], (unsigned long) measured[stage][0],
+				(unsigned long) measured[stage][1], (unsigned long) measured[stage][2]);
+		if (haveBaseline == TRUE)
+		{
+			printf("   %lu/%lu/%lu", (unsigned long) baseline[stage][0],
+					(unsigned long) baseline[stage][1], (unsigned long) baseline[stage][2]);
+			for (i = 0; i < NUM_PERCENTILES; i++)
+			{
+				if ((uint64) measured[stage][i] * 100
+						> (uint64) baseline[stage][i] * (100 + BASELINE_TOLERANCE_PERCENT))
+				{
+					printf(" p%u REGRESSED", g_percentiles[i]);
+					regressed++;
+				}
+			}
+		}
+		printf("\n");
+		if (g_sampleCount[stage] == 0)
+		{
+			failed++;
+		}
+	}
+
+	if (update == TRUE)
+	{
+		if (writeBaseline(measured) == FALSE)
+		{
+			printf("can't write %s\n", BASELINE_FILE);
+			return 1;
+		}
+		printf("baseline written to %s\n", BASELINE_FILE);
+	}
+	return ((failed == 0) && (regressed == 0) && ((haveBaseline == TRUE) || (update == TRUE))) ?
+			0 : 1;
+}
@@ -0,0 +1,20 @@
+/*
+ ============================================================================
+ File Name   : interrupt.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host replacement of the avr-libc interrupt header
+ ============================================================================
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+/* An ISR is a normal function which the test calls as the interrupt */
+#define ISR(vector)		void vector(void); void vector(void)
+
+#define sei()
+#define cli()
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,18 @@
+/*
+ ============================================================================
+ File Name   : pgmspace.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host replacement of the avr-libc program memory header
+ ============================================================================
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+/* The host has one address space, the tables stay in RAM */
+#define PROGMEM
+#define pgm_read_byte(address)	(*(const unsigned char *) (address))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
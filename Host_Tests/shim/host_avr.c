@@ -0,0 +1,382 @@
+/*
+ ============================================================================
+ File Name   : host_avr.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Model of the TIMER1 and the UART of the ATmega32 behind their registers
+ ============================================================================
+ */
+
+#include "host_avr.h"
+#include "host_registers.h"
+#include "host_blocks.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The bytes started by the transmitter and not taken yet, must be power of 2 */
+#define TX_QUEUE_SIZE		4
+/* The bytes given to the RX pin and not received yet, must be power of 2 */
+#define RX_QUEUE_SIZE		16
+
+/* Bytes of the receive FIFO of the AVR, UDR and the one behind it */
+#define RX_FIFO_BYTES		2
+
+typedef struct
+{
+	uint8 data;
+	uint64 end;
+} ByteType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The TIMER1 prescaler of each CS12:0 value, 0 for no clock (the external clock isn't modeled) */
+static const uint16 g_prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+/* The time of TCNT1 = 0, the count is taken from it */
+static uint8 g_timerRunning;
+static uint64 g_timerBase;
+/* The last value of TCNT1 written by the model, another value is a write of the driver */
+static uint16 g_timerCount;
+
+/* The buffer of UDR, the shift register and the end of its frame */
+static uint8 g_txBufferFull;
+static uint8 g_txBuffer;
+static uint8 g_txShifting;
+static uint64 g_txEnd;
+
+static ByteType g_txQueue[TX_QUEUE_SIZE];
+static uint8 g_txHead;
+static uint8 g_txTail;
+
+static ByteType g_rxQueue[RX_QUEUE_SIZE];
+static uint8 g_rxHead;
+static uint8 g_rxTail;
+/* The received bytes in the FIFO, the first one is in UDR with RXC */
+static uint8 g_rxFifo[RX_FIFO_BYTES];
+static uint8 g_rxFifoBytes;
+
+static uint32 g_rxOverruns;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* The ISRs of the drivers */
+void TIMER1_COMPA_vect(void);
+void TIMER1_OVF_vect(void);
+void USART_RXC_vect(void);
+void USART_UDRE_vect(void);
+
+/*
+ * Function responsible for counting TIMER1 to the time and setting its flags.
+ */
+static void stepTimer(uint64 now);
+
+/*
+ * Function responsible for the transmitter and the receiver at the time.
+ */
+static void stepUart(uint64 now);
+
+/*
+ * Function responsible for the AVR cycles of one UART frame.
+ */
+static uint64 frameCycles(void);
+
+/*
+ * Function responsible for calling the ISR with the I-bit cleared.
+ */
+static void callIsr(void (*isr)(void));
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Put the TIMER1 and UART registers at their reset values and empty the UART.
+ */
+void HOST_avrReset(void)
+{
+	host_TCCR1A.Byte = 0;
+	host_TCCR1B.Byte = 0;
+	host_TCNT1 = 0;
+	host_OCR1A = 0;
+	host_TIMSK.Byte = 0;
+	host_TIFR.Byte = 0;
+	g_timerRunning = FALSE;
+	g_timerCount = 0;
+
+	host_UCSRA.Byte = 0;
+	host_UCSRA.Bits.UDRE_Bit = 1;
+	host_UCSRB.Byte = 0;
+	host_UCSRC.Byte = 0x86;
+	host_UDR = HOST_UDR_EMPTY;
+	host_UBRRL = 0;
+	host_UBRRH = 0;
+	g_txBufferFull = FALSE;
+	g_txShifting = FALSE;
+	g_txHead = 0;
+	g_txTail = 0;
+	g_rxHead = 0;
+	g_rxTail = 0;
+	g_rxFifoBytes = 0;
+	g_rxOverruns = 0;
+}
+
+/*
+ * Description :
+ * Step TIMER1 and the UART to the time in AVR cycles, then take their
+ * interrupts which are enabled while the I-bit is set.
+ */
+void HOST_avrStep(uint64 now)
+{
+	stepTimer(now);
+	stepUart(now);
+	if (host_SREG.Bits.I_Bit == 0)
+	{
+		return;
+	}
+	/* the interrupts in the order of their vectors on the ATmega32 */
+	if (host_TIFR.Bits.OCF1A_Bit && host_TIMSK.Bits.OCIE1A_Bit)
+	{
+		host_TIFR.Bits.OCF1A_Bit = 0;
+		callIsr(TIMER1_COMPA_vect);
+	}
+	if (host_TIFR.Bits.TOV1_Bit && host_TIMSK.Bits.TOIE1_Bit)
+	{
+		host_TIFR.Bits.TOV1_Bit = 0;
+		callIsr(TIMER1_OVF_vect);
+	}
+	if (host_UCSRA.Bits.RXC_Bit && host_UCSRB.Bits.RXCIE_Bit)
+	{
+		callIsr(USART_RXC_vect);
+		/* the ISR read UDR, the next byte of the FIFO comes in it */
+		g_rxFifo[0] = g_rxFifo[1];
+		g_rxFifoBytes--;
+		host_UCSRA.Bits.RXC_Bit = 0;
+		host_UDR = HOST_UDR_EMPTY;
+		stepUart(now);
+	}
+	if (host_UCSRA.Bits.UDRE_Bit && host_UCSRB.Bits.UDRIE_Bit)
+	{
+		callIsr(USART_UDRE_vect);
+		/* the byte written by the ISR moves to the shift register at once if it is free */
+		stepUart(now);
+	}
+}
+
+/*
+ * Description :
+ * Return the time of the next TIMER1 flag or UART frame end, or HOST_NO_EVENT.
+ * The model must be stepped to the time before, so TCNT1 and UDR are taken.
+ */
+uint64 HOST_avrNextEvent(void)
+{
+	uint16 prescaler = g_prescalers[host_TCCR1B.Byte & 0x07];
+	uint64 next = HOST_NO_EVENT;
+
+	if ((g_timerRunning == TRUE) && (prescaler != 0))
+	{
+		/* the counter is cleared after OCR1A in CTC mode and after 0xFFFF in normal mode */
+		next = g_timerBase + (host_TCCR1B.Bits.WGM12_Bit ?
+				(((uint64) host_OCR1A + 1) * prescaler) : (0x10000ULL * prescaler));
+	}
+	if ((g_txShifting == TRUE) && (g_txEnd < next))
+	{
+		next = g_txEnd;
+	}
+	if ((g_rxTail != g_rxHead) && (g_rxQueue[g_rxTail].end < next))
+	{
+		next = g_rxQueue[g_rxTail].end;
+	}
+	return next;
+}
+
+/*
+ * Description :
+ * Take the next byte which the transmitter moved to its shift register and
+ * the time when its stop bit ends.
+ * Return FALSE if no byte is started since the last call.
+ */
+uint8 HOST_avrUartTake(uint8 *a_data, uint64 *a_end)
+{
+	if (g_txTail == g_txHead)
+	{
+		return FALSE;
+	}
+	*a_data = g_txQueue[g_txTail].data;
+	*a_end = g_txQueue[g_txTail].end;
+	g_txTail = (g_txTail + 1) & (TX_QUEUE_SIZE - 1);
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Give a byte to the RX pin, it is received at the end time of its frame.
+ * The bytes must be given in the order of their end times.
+ */
+void HOST_avrUartGive(uint8 data, uint64 end)
+{
+	uint8 next = (g_rxHead + 1) & (RX_QUEUE_SIZE - 1);
+
+	if (next == g_rxTail)
+	{
+		/* the line is faster than the simulation takes the bytes, it can't happen at 9600 baud */
+		g_rxOverruns++;
+		return;
+	}
+	g_rxQueue[g_rxHead].data = data;
+	g_rxQueue[g_rxHead].end = end;
+	g_rxHead = next;
+}
+
+/*
+ * Description :
+ * Return the number of the received bytes lost by a data overrun.
+ */
+uint32 HOST_avrUartOverruns(void)
+{
+	return g_rxOverruns;
+}
+
+/*
+ * Description :
+ * Count TIMER1 to the time and set its flags.
+ */
+static void stepTimer(uint64 now)
+{
+	uint16 prescaler = g_prescalers[host_TCCR1B.Byte & 0x07];
+	uint64 period;
+
+	if (prescaler == 0)
+	{
+		g_timerRunning = FALSE;
+		return;
+	}
+	if ((g_timerRunning == FALSE) || (host_TCNT1 != g_timerCount))
+	{
+		/* the clock is started or TCNT1 is written, count from its value */
+		g_timerRunning = TRUE;
+		g_timerBase = now - ((uint64) host_TCNT1 * prescaler);
+	}
+	if (host_TCCR1B.Bits.WGM12_Bit)
+	{
+		/* CTC mode, the counter is cleared after it matches OCR1A */
+		period = ((uint64) host_OCR1A + 1) * prescaler;
+		while ((now - g_timerBase) >= period)
+		{
+			g_timerBase += period;
+			host_TIFR.Bits.OCF1A_Bit = 1;
+		}
+	}
+	else
+	{
+		period = 0x10000ULL * prescaler;
+		while ((now - g_timerBase) >= period)
+		{
+			g_timerBase += period;
+			host_TIFR.Bits.TOV1_Bit = 1;
+		}
+	}
+	g_timerCount = (uint16) ((now - g_timerBase) / prescaler);
+	host_TCNT1 = g_timerCount;
+}
+
+/*
+ * Description :
+ * Run the transmitter and the receiver to the time.
+ */
+static void stepUart(uint64 now)
+{
+	uint8 next;
+
+	/* a write of the driver to UDR clears the high byte of host_UDR */
+	if ((host_UDR & 0xFF00) == 0)
+	{
+		g_txBuffer = (uint8) host_UDR;
+		g_txBufferFull = TRUE;
+		host_UDR = (g_rxFifoBytes != 0) ?
+				(HOST_UDR_RECEIVED | g_rxFifo[0]) : HOST_UDR_EMPTY;
+	}
+	if ((g_txShifting == TRUE) && (now >= g_txEnd))
+	{
+		g_txShifting = FALSE;
+		host_UCSRA.Bits.TXC_Bit = 1;
+	}
+	if ((g_txShifting == FALSE) && (g_txBufferFull == TRUE)
+			&& host_UCSRB.Bits.TXEN_Bit)
+	{
+		g_txShifting = TRUE;
+		g_txBufferFull = FALSE;
+		g_txEnd = now + frameCycles();
+		next = (g_txHead + 1) & (TX_QUEUE_SIZE - 1);
+		if (next != g_txTail)
+		{
+			g_txQueue[g_txHead].data = g_txBuffer;
+			g_txQueue[g_txHead].end = g_txEnd;
+			g_txHead = next;
+		}
+	}
+	host_UCSRA.Bits.UDRE_Bit = (g_txBufferFull == FALSE) ? 1 : 0;
+
+	/* the bytes whose frames ended are received in the FIFO */
+	while ((g_rxTail != g_rxHead) && (g_rxQueue[g_rxTail].end <= now))
+	{
+		if (host_UCSRB.Bits.RXEN_Bit == 0)
+		{
+			/* the receiver is off, the byte is not seen */
+		}
+		else if (g_rxFifoBytes < RX_FIFO_BYTES)
+		{
+			g_rxFifo[g_rxFifoBytes] = g_rxQueue[g_rxTail].data;
+			g_rxFifoBytes++;
+		}
+		else
+		{
+			g_rxOverruns++;
+			host_UCSRA.Bits.DOR_Bit = 1;
+		}
+		g_rxTail = (g_rxTail + 1) & (RX_QUEUE_SIZE - 1);
+	}
+	if (g_rxFifoBytes != 0)
+	{
+		host_UCSRA.Bits.RXC_Bit = 1;
+		host_UDR = HOST_UDR_RECEIVED | g_rxFifo[0];
+	}
+}
+
+/*
+ * Description :
+ * Return the AVR cycles of one UART frame at the baud rate of UBRR and U2X.
+ */
+static uint64 frameCycles(void)
+{
+	uint16 ubrr = (uint16) (((host_UBRRH & 0x0F) << 8) | host_UBRRL);
+	uint8 bits = 1 + 8 + 1;
+
+	if (host_UCSRC.Bits.UPM1_Bit)
+	{
+		bits++; /* the parity bit */
+	}
+	if (host_UCSRC.Bits.USBS_Bit)
+	{
+		bits++; /* the second stop bit */
+	}
+	return (uint64) bits * (host_UCSRA.Bits.U2X_Bit ? 8 : 16) * (ubrr + 1);
+}
+
+/*
+ * Description :
+ * Call the ISR with the I-bit cleared like the AVR does, RETI sets it again.
+ */
+static void callIsr(void (*isr)(void))
+{
+	host_SREG.Bits.I_Bit = 0;
+	isr();
+	host_SREG.Bits.I_Bit = 1;
+}
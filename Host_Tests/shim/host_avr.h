@@ -0,0 +1,90 @@
+/*
+ ============================================================================
+ File Name   : host_avr.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Model of the TIMER1 and the UART of the ATmega32 behind their registers
+ ============================================================================
+ */
+
+/*
+ * The model is built in the object of each ECU of the simulation with its
+ * registers, see host_ecu.h.
+ *
+ * TIMER1 counts the AVR cycles of the virtual clock through its prescaler up
+ * to OCR1A in CTC mode or up to 0xFFFF in normal mode, then sets OCF1A or
+ * TOV1. A write of the driver to TCNT1 starts the count again from its value.
+ *
+ * The UART has the buffer of UDR and the shift register of the transmitter:
+ * a byte written to UDR moves to the shift register when it is free, then it
+ * is on the TX pin for one frame (start bit, 8 data bits, the parity bit and
+ * the stop bits) at the baud rate of UBRR and U2X. A received byte is put in
+ * UDR at the end of its frame, the receive FIFO of the AVR holds two bytes,
+ * a third one is lost (data overrun).
+ *
+ * The interrupts run with the I-bit cleared like on the AVR, the RXC flag is
+ * cleared when the RX Complete ISR returns since it reads UDR.
+ *
+ * The model changes by itself at three events: the compare match or the
+ * overflow of TIMER1, the end of the frame which is sent and the end of the
+ * next frame on the RX pin. An idle wait of the ECU jumps to the next one.
+ */
+#ifndef HOST_AVR_H_
+#define HOST_AVR_H_
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * A received byte is put in host_UDR with this bit, so it is not taken as a
+ * byte written by the driver (a write clears the high byte, see host_registers.h)
+ */
+#define HOST_UDR_RECEIVED			0x200
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Put the TIMER1 and UART registers at their reset values and empty the UART.
+ */
+void HOST_avrReset(void);
+
+/*
+ * Description :
+ * Step TIMER1 and the UART to the time in AVR cycles, then take their
+ * interrupts which are enabled while the I-bit is set.
+ */
+void HOST_avrStep(uint64 now);
+
+/*
+ * Description :
+ * Return the time of the next TIMER1 flag or UART frame end, or HOST_NO_EVENT.
+ */
+uint64 HOST_avrNextEvent(void);
+
+/*
+ * Description :
+ * Take the next byte which the transmitter moved to its shift register and
+ * the time when its stop bit ends.
+ * Return FALSE if no byte is started since the last call.
+ */
+uint8 HOST_avrUartTake(uint8 *a_data, uint64 *a_end);
+
+/*
+ * Description :
+ * Give a byte to the RX pin, it is received at the end time of its frame.
+ * The bytes must be given in the order of their end times.
+ */
+void HOST_avrUartGive(uint8 data, uint64 end);
+
+/*
+ * Description :
+ * Return the number of the received bytes lost by a data overrun.
+ */
+uint32 HOST_avrUartOverruns(void);
+
+#endif /* HOST_AVR_H_ */
@@ -0,0 +1,82 @@
+/*
+ ============================================================================
+ File Name   : host_blocks.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Count of the basic blocks run by the instrumented sources
+ ============================================================================
+ */
+
+#include "host_blocks.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+volatile uint32 g_hostBlocks = 0;
+volatile uint64 g_hostCycles = 0;
+void (*volatile g_hostDevices)(void) = NULL_PTR;
+void (*volatile g_hostYield)(void) = NULL_PTR;
+uint64 (*volatile g_hostNextEvent)(void) = NULL_PTR;
+
+/* TRUE while the devices are stepped, the blocks of their ISRs don't step them again */
+static uint8 g_inDevices = FALSE;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Called by the compiler at the start of each basic block of the instrumented
+ * sources, it must not be instrumented itself.
+ */
+__attribute__((no_sanitize_coverage)) void __sanitizer_cov_trace_pc(void)
+{
+	g_hostBlocks++;
+	g_hostCycles += HOST_CYCLES_PER_BLOCK;
+	if (g_inDevices == FALSE)
+	{
+		if (g_hostDevices != NULL_PTR)
+		{
+			g_inDevices = TRUE;
+			g_hostDevices();
+			g_inDevices = FALSE;
+		}
+		if (g_hostYield != NULL_PTR)
+		{
+			g_hostYield();
+		}
+	}
+}
+
+/*
+ * Description :
+ * Let the clock run for the required cycles with idle blocks, like a main
+ * loop which has nothing to do, the devices are stepped and the ISRs run.
+ * With g_hostNextEvent the clock jumps from one event to the next one.
+ */
+void HOST_run(uint32 cycles)
+{
+	uint64 end = g_hostCycles + cycles;
+	uint64 next;
+
+	while (g_hostCycles < end)
+	{
+		__sanitizer_cov_trace_pc();
+		if (g_hostNextEvent != NULL_PTR)
+		{
+			/* the devices are stepped to the clock, the next block runs at the event */
+			next = g_hostNextEvent();
+			if (next > end)
+			{
+				next = end;
+			}
+			if (next > (g_hostCycles + HOST_CYCLES_PER_BLOCK))
+			{
+				g_hostCycles = next - HOST_CYCLES_PER_BLOCK;
+			}
+		}
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ ============================================================================
+ File Name   : host_blocks.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Count of the basic blocks run by the instrumented sources
+ ============================================================================
+ */
+
+#ifndef HOST_BLOCKS_H_
+#define HOST_BLOCKS_H_
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * The sources built with -fsanitize-coverage=trace-pc call
+ * __sanitizer_cov_trace_pc at the start of each of their basic blocks, the
+ * shim counts the calls. The count is the cost of a code path on the host, it
+ * doesn't depend on the speed or the load of the host, so a test can check
+ * how the cost grows with its input.
+ *
+ * The count also runs a virtual clock of AVR cycles, HOST_CYCLES_PER_BLOCK
+ * for each block. It is an estimate: a block of the -Os build has about four
+ * instructions of one or two cycles. The device models of a test are stepped
+ * on this clock, so a busy wait of a driver gives time to the device it waits for.
+ */
+#define HOST_CYCLES_PER_BLOCK		6
+
+/* Virtual clock cycles in one microsecond */
+#define HOST_CYCLES_PER_US			(F_CPU / 1000000UL)
+
+/* The time of no event, see g_hostNextEvent */
+#define HOST_NO_EVENT				0xFFFFFFFFFFFFFFFFULL
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+extern volatile uint32 g_hostBlocks;
+
+/* The virtual clock in AVR cycles */
+extern volatile uint64 g_hostCycles;
+
+/*
+ * Called after each block with the clock, it steps the device models of the
+ * test and takes their interrupts, or NULL_PTR. It is not called again from
+ * the blocks of the ISRs which it calls.
+ */
+extern void (*volatile g_hostDevices)(void);
+
+/*
+ * Called after the devices out of the blocks of the ISRs, or NULL_PTR. The
+ * simulation of the two ECUs switches to the other ECU from it, see host_sim.h.
+ */
+extern void (*volatile g_hostYield)(void);
+
+/*
+ * Returns the time of the next event of the device models, when they change
+ * by themselves, or HOST_NO_EVENT, or it is NULL_PTR. HOST_run jumps to the
+ * next event since nothing happens in an idle wait before it.
+ */
+extern uint64 (*volatile g_hostNextEvent)(void);
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Let the clock run for the required cycles with idle blocks, like a main
+ * loop which has nothing to do, the devices are stepped and the ISRs run.
+ * With g_hostNextEvent the clock jumps from one event to the next one.
+ */
+void HOST_run(uint32 cycles);
+
+#endif /* HOST_BLOCKS_H_ */
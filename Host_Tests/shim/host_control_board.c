@@ -0,0 +1,171 @@
+/*
+ ============================================================================
+ File Name   : host_control_board.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The board of the Control ECU in the simulation, the motor, the buzzer and the 24C16
+ ============================================================================
+ */
+
+/*
+ * It is built in the object of the Control ECU, see host_ecu.h.
+ *
+ * The motor driver takes the direction from the two pins of motor.h while
+ * they are outputs and the speed from OCR0. The buzzer is on while its pin is
+ * an output and high. The 24C16 is the model of host_twi_eeprom.h.
+ */
+
+#include "host_ecu.h"
+#include "host_avr.h"
+#include "host_registers.h"
+#include "host_twi_eeprom.h"
+#include "HAL/MOTOR/motor.h"
+#include "HAL/BUZZER/buzzer.h"
+#include "MCAL/GPIO/gpio.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if (MOTOR_PORT_ID != PORTB_ID)
+#error "The motor model takes its pins from PORTB"
+#endif
+
+#if (BUZZER_PORT_ID != PORTC_ID)
+#error "The buzzer model takes its pin from PORTC"
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static HOST_MotorType g_motor;
+static HOST_BuzzerType g_buzzer;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* The main function of the Control ECU */
+int main(void);
+
+static int boardMain(void);
+static void boardStep(uint64 now);
+static uint64 boardNextEvent(void);
+
+/*
+ * Function responsible for the direction and the speed of the motor.
+ */
+static void stepMotor(uint64 now);
+
+/*
+ * Function responsible for the state of the buzzer.
+ */
+static void stepBuzzer(uint64 now);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+const HOST_ControlBoardType g_hostControlBoard =
+{
+	{ boardMain, boardStep, HOST_avrUartTake, HOST_avrUartGive, HOST_avrUartOverruns,
+			boardNextEvent },
+	&g_motor,
+	&g_buzzer,
+	g_hostTwiEeprom
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The power on of the board, then the main function of the ECU.
+ */
+static int boardMain(void)
+{
+	HOST_avrReset();
+	HOST_twiEepromReset(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	host_SREG.Byte = 0;
+	host_PORTB.Byte = 0;
+	host_DDRB.Byte = 0;
+	host_PORTC.Byte = 0;
+	host_DDRC.Byte = 0;
+	host_TCCR0 = 0;
+	host_OCR0 = 0;
+	memset(&g_motor, 0, sizeof(g_motor));
+	memset(&g_buzzer, 0, sizeof(g_buzzer));
+	return main();
+}
+
+/*
+ * Description :
+ * Step the devices of the board and the peripherals to the time.
+ */
+static void boardStep(uint64 now)
+{
+	stepMotor(now);
+	stepBuzzer(now);
+	HOST_twiEepromStep(now);
+	HOST_avrStep(now);
+}
+
+/*
+ * Description :
+ * Return the next event of the peripherals or the 24C16, or HOST_NO_EVENT.
+ */
+static uint64 boardNextEvent(void)
+{
+	uint64 next = HOST_avrNextEvent();
+	uint64 twi = HOST_twiEepromNextEvent();
+
+	return (twi < next) ? twi : next;
+}
+
+/*
+ * Description :
+ * Take the direction from IN1 and IN2 and the speed from OCR0.
+ */
+static void stepMotor(uint64 now)
+{
+	uint8 outputs = host_DDRB.Byte & host_PORTB.Byte;
+	uint8 in1 = (outputs >> MOTOR_IN1_PIN_ID) & 1;
+	uint8 in2 = (outputs >> MOTOR_IN2_PIN_ID) & 1;
+	HOST_MotorDirectionType direction = HOST_MOTOR_STOP;
+
+	/* both pins high is the brake of the H-bridge */
+	if (in1 && !in2)
+	{
+		direction = HOST_MOTOR_CLOCK_WISE;
+	}
+	else if (!in1 && in2)
+	{
+		direction = HOST_MOTOR_ANTI_CLOCK_WISE;
+	}
+	if (direction != g_motor.direction)
+	{
+		g_motor.direction = direction;
+		g_motor.changes++;
+		g_motor.lastChange = now;
+	}
+	g_motor.duty = host_OCR0;
+}
+
+/*
+ * Description :
+ * The buzzer is on while its pin is an output and high.
+ */
+static void stepBuzzer(uint64 now)
+{
+	uint8 on = ((host_DDRC.Byte & host_PORTC.Byte) >> BUZZER_PIN_ID) & 1;
+
+	if (on != g_buzzer.on)
+	{
+		g_buzzer.on = on;
+		g_buzzer.lastChange = now;
+	}
+}
@@ -0,0 +1,131 @@
+/*
+ ============================================================================
+ File Name   : host_ecu.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The ECUs of the simulation as they are seen by the simulator
+ ============================================================================
+ */
+
+/*
+ * Each ECU is built on the host from its sources as they are, with its own
+ * copy of the register shim, of the peripherals model (host_avr.h) and of its
+ * board: the devices on its pins. The objects of one ECU are linked in one
+ * object by ld -r, then all their symbols are made local except its board, so
+ * the two ECUs have their own registers and drivers in one program:
+ *   g_hostHmiBoard      HMI_ECU.c with the keypad and the LCD
+ *   g_hostControlBoard  Control_ECU.c with the motor, the buzzer and the 24C16
+ * The simulator (host_sim.h) runs the main function of each ECU and connects
+ * their UARTs. The times are in AVR cycles of the virtual clock of each ECU.
+ */
+#ifndef HOST_ECU_H_
+#define HOST_ECU_H_
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The LCD of the HMI ECU, the board checks it against lcd.h */
+#define HOST_LCD_ROWS				2
+#define HOST_LCD_COLS				16
+
+/* The key which is held on the keypad when no key is pressed */
+#define HOST_NO_KEY					0xFF
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* The part of the board which is the same in both ECUs */
+typedef struct
+{
+	/* The main function of the ECU, it never returns */
+	int (*main)(void);
+	/*
+	 * Step the peripherals and the devices of the board to the time, then
+	 * take the interrupts which are enabled, called after each block of the ECU
+	 */
+	void (*step)(uint64 now);
+	/*
+	 * Take the next byte which the UART started to send and the time when
+	 * its stop bit ends, return FALSE if no byte is started
+	 */
+	uint8 (*uartTake)(uint8 *a_data, uint64 *a_end);
+	/* Give a byte to the RX pin of the UART, it is received at the time */
+	void (*uartGive)(uint8 data, uint64 end);
+	/* Number of the bytes lost by the UART receiver (data overrun) */
+	uint32 (*uartOverruns)(void);
+	/*
+	 * The time of the next event of the board, when its peripherals change by
+	 * themselves, or HOST_NO_EVENT, the idle waits of the ECU jump to it
+	 */
+	uint64 (*nextEvent)(void);
+} HOST_EcuType;
+
+/* The HD44780 of the HMI ECU as seen on its pins */
+typedef struct
+{
+	char text[HOST_LCD_ROWS][HOST_LCD_COLS + 1]; /* the visible cells */
+	uint32 instructions; /* instructions and characters written */
+	uint64 lastWrite; /* the time of the last character written */
+} HOST_LcdType;
+
+/* The keypad of the HMI ECU as seen on its pins */
+typedef struct
+{
+	uint64 pressed; /* the time of the press of the held key */
+	/*
+	 * The time of the scan which took the last debounce sample of the held
+	 * key (KEYPAD_DEBOUNCE_SAMPLES scans of its row), zero until then
+	 */
+	uint64 detected;
+} HOST_KeypadType;
+
+typedef struct
+{
+	HOST_EcuType ecu;
+	/* Hold the key on the keypad, HOST_NO_KEY releases it */
+	void (*setKey)(uint8 key);
+	const HOST_KeypadType *keypad;
+	const HOST_LcdType *lcd;
+} HOST_HmiBoardType;
+
+typedef enum
+{
+	HOST_MOTOR_STOP, HOST_MOTOR_CLOCK_WISE, HOST_MOTOR_ANTI_CLOCK_WISE
+} HOST_MotorDirectionType;
+
+/* The motor of the Control ECU, from its two direction pins and OCR0 */
+typedef struct
+{
+	HOST_MotorDirectionType direction;
+	uint8 duty; /* OCR0, 255 for the full speed */
+	uint32 changes; /* changes of the direction */
+	uint64 lastChange; /* the time of the last change of the direction */
+} HOST_MotorType;
+
+/* The buzzer of the Control ECU */
+typedef struct
+{
+	uint8 on;
+	uint64 lastChange;
+} HOST_BuzzerType;
+
+typedef struct
+{
+	HOST_EcuType ecu;
+	const HOST_MotorType *motor;
+	const HOST_BuzzerType *buzzer;
+	/* The memory of the 24C16 on the TWI bus, erased at the power on of the board */
+	uint8 *eeprom;
+} HOST_ControlBoardType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+extern const HOST_HmiBoardType g_hostHmiBoard;
+extern const HOST_ControlBoardType g_hostControlBoard;
+
+#endif /* HOST_ECU_H_ */
@@ -0,0 +1,130 @@
+/*
+ ============================================================================
+ File Name   : host_eeprom.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : RAM model of the external EEPROM with power cut injection
+ ============================================================================
+ */
+
+#include "host_eeprom.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+uint8 g_hostEeprom[EEPROM_SIZE];
+uint32 g_hostEepromPageWrites[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+
+static sint16 g_cutBytes = HOST_EEPROM_NO_CUT;
+static HOST_EepromCutType g_cut = HOST_EEPROM_KEEP_OLD;
+static uint8 g_failReads = FALSE;
+
+/* Number of the reads before the one which fails once, or HOST_EEPROM_NO_FAULT */
+static sint16 g_readsBeforeFault = HOST_EEPROM_NO_FAULT;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Erase the memory to 0xFF, clear the write counts and the faults.
+ */
+void HOST_eepromReset(void)
+{
+	memset(g_hostEeprom, 0xFF, sizeof(g_hostEeprom));
+	memset(g_hostEepromPageWrites, 0, sizeof(g_hostEepromPageWrites));
+	g_cutBytes = HOST_EEPROM_NO_CUT;
+	g_failReads = FALSE;
+	g_readsBeforeFault = HOST_EEPROM_NO_FAULT;
+}
+
+/*
+ * Description :
+ * Cut the power of the next block write after the required number of bytes,
+ * the write ends with ERROR like a write which got no ACK after the reset.
+ */
+void HOST_eepromCutNextWrite(sint16 bytes, HOST_EepromCutType cut)
+{
+	g_cutBytes = bytes;
+	g_cut = cut;
+}
+
+/*
+ * Description :
+ * Make the reads fail with ERROR, like a missing EEPROM.
+ */
+void HOST_eepromFailReads(uint8 fail)
+{
+	g_failReads = fail;
+}
+
+/*
+ * Description :
+ * Make one read fail with ERROR after the required number of good reads,
+ * like a bus error in the middle of a scan.
+ */
+void HOST_eepromFailOneRead(sint16 goodReads)
+{
+	g_readsBeforeFault = goodReads;
+}
+
+/*
+ * Description :
+ * The blocking read of the driver, from the RAM memory.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *u8data, uint16 u16length)
+{
+	if ((g_failReads == TRUE) || ((u16addr + u16length) > EEPROM_SIZE))
+	{
+		return ERROR;
+	}
+	if (g_readsBeforeFault != HOST_EEPROM_NO_FAULT)
+	{
+		if (g_readsBeforeFault == 0)
+		{
+			g_readsBeforeFault = HOST_EEPROM_NO_FAULT;
+			return ERROR;
+		}
+		g_readsBeforeFault--;
+	}
+	memcpy(u8data, &g_hostEeprom[u16addr], u16length);
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * The write of the driver, the write cycle is completed at once and the call
+ * back is called before the return, as the TWI ISR would call it later.
+ */
+uint8 EEPROM_writeBlockAsync(uint16 u16addr, const uint8 *u8data,
+		uint16 u16length, void (*a_ptr)(uint8 result))
+{
+	uint8 result = SUCCESS;
+	uint16 written = u16length;
+
+	if ((u16addr + u16length) > EEPROM_SIZE)
+	{
+		return ERROR;
+	}
+	g_hostEepromPageWrites[u16addr / EEPROM_PAGE_SIZE]++;
+	if ((g_cutBytes != HOST_EEPROM_NO_CUT) && (g_cutBytes < u16length))
+	{
+		written = (uint16) g_cutBytes;
+		if (g_cut == HOST_EEPROM_ERASED)
+		{
+			memset(&g_hostEeprom[u16addr + written], 0xFF, u16length - written);
+		}
+		result = ERROR;
+	}
+	g_cutBytes = HOST_EEPROM_NO_CUT;
+	memcpy(&g_hostEeprom[u16addr], u8data, written);
+	if (a_ptr != NULL_PTR)
+	{
+		a_ptr(result);
+	}
+	return SUCCESS;
+}
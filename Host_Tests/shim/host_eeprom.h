@@ -0,0 +1,75 @@
+/*
+ ============================================================================
+ File Name   : host_eeprom.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : RAM model of the external EEPROM with power cut injection
+ ============================================================================
+ */
+
+#ifndef HOST_EEPROM_H_
+#define HOST_EEPROM_H_
+
+#include "HAL/EXTERNAL_EEPROM/external_eeprom.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* No power cut on the next write */
+#define HOST_EEPROM_NO_CUT				(-1)
+
+/* No failed read */
+#define HOST_EEPROM_NO_FAULT			(-1)
+
+/*
+ * What is left in the bytes of the page after the cut: their old values,
+ * or the erased value 0xFF of a page which was cleared before its write.
+ */
+typedef enum
+{
+	HOST_EEPROM_KEEP_OLD, HOST_EEPROM_ERASED
+} HOST_EepromCutType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The memory of the EEPROM */
+extern uint8 g_hostEeprom[EEPROM_SIZE];
+
+/* Number of the block writes of each page */
+extern uint32 g_hostEepromPageWrites[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Erase the memory to 0xFF, clear the write counts and the faults.
+ */
+void HOST_eepromReset(void);
+
+/*
+ * Description :
+ * Cut the power of the next block write after the required number of bytes,
+ * the write ends with ERROR like a write which got no ACK after the reset.
+ */
+void HOST_eepromCutNextWrite(sint16 bytes, HOST_EepromCutType cut);
+
+/*
+ * Description :
+ * Make the reads fail with ERROR, like a missing EEPROM.
+ */
+void HOST_eepromFailReads(uint8 fail);
+
+/*
+ * Description :
+ * Make one read fail with ERROR after the required number of good reads,
+ * like a bus error in the middle of a scan.
+ */
+void HOST_eepromFailOneRead(sint16 goodReads);
+
+#endif /* HOST_EEPROM_H_ */
@@ -0,0 +1,348 @@
+/*
+ ============================================================================
+ File Name   : host_hmi_board.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The board of the HMI ECU in the simulation, the keypad and the LCD
+ ============================================================================
+ */
+
+/*
+ * It is built in the object of the HMI ECU, see host_ecu.h.
+ *
+ * The keypad has pull-up resistors on its column pins, a held key pulls its
+ * column pin low while the driver drives its row pin low. The model also
+ * takes the time when the driver has the debounce samples of the held key.
+ *
+ * The LCD is an HD44780 on the pins of lcd.h in 4-bit mode. It takes the data
+ * pins which are seen while E is high at the falling edge of E, so the model
+ * needs the waits of the driver to be on the virtual clock (HOST_DELAY_CLOCK)
+ * to see E high. It starts in 8-bit mode where one nibble is one instruction,
+ * like after the power on, and the function set with DL = 0 puts it in 4-bit
+ * mode where two nibbles are one byte, the high one first.
+ */
+
+#include "host_ecu.h"
+#include "host_avr.h"
+#include "host_registers.h"
+#include "HAL/LCD/lcd.h"
+#include "HAL/KEYPAD/keypad.h"
+#include "MCAL/GPIO/gpio.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if ((LCD_DATA_BITS_MODE != 4) || (LCD_WAIT_MODE != LCD_WAIT_TIMING))
+#error "The LCD model has the 4-bit mode with the timed waits only"
+#endif
+
+#if ((LCD_ROWS != HOST_LCD_ROWS) || (LCD_COLS != HOST_LCD_COLS))
+#error "The LCD model has another size than lcd.h"
+#endif
+
+#if ((LCD_RS_PORT_ID != PORTA_ID) || (LCD_E_PORT_ID != PORTA_ID) \
+		|| (LCD_DATA_PORT_ID != PORTA_ID))
+#error "The LCD model takes its pins from PORTA"
+#endif
+
+#if ((KEYPAD_ROW_PORT_ID != PORTB_ID) || (KEYPAD_COL_PORT_ID != PORTD_ID))
+#error "The keypad model takes its rows from PORTB and its columns from PORTD"
+#endif
+
+/* The HD44780 instructions which change the screen, the other ones are ignored */
+#define LCD_FUNCTION_SET_MASK		0xE0
+#define LCD_FUNCTION_SET			0x20
+#define LCD_FUNCTION_SET_DL			0x10
+#define LCD_ADDRESS_MASK			0x7F
+
+/* The DDRAM of the two lines, 40 cells each */
+#define LCD_DDRAM_SIZE				0x80
+#define LCD_LINE_LENGTH				40
+#define LCD_SECOND_LINE				0x40
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The keys of keypad.c in the places of their buttons */
+static const uint8 g_keypad[KEYPAD_NUM_ROWS][KEYPAD_NUM_COLS] =
+{
+	{ 1, 2, 3, '^' },
+	{ 4, 5, 6, '^' },
+	{ 7, 8, 9, '^' },
+	{ '-', 0, '+', '#' }
+};
+
+/* The button of the held key, or HOST_NO_KEY */
+static uint8 g_keyRow = HOST_NO_KEY;
+static uint8 g_keyCol;
+/* TRUE until the first step after the press, which takes its time */
+static uint8 g_keyNew = FALSE;
+/* The row of the held key was driven at the last step, and its scans since the press */
+static uint8 g_keyRowDriven;
+static uint8 g_keySamples;
+
+static HOST_KeypadType g_keypadState;
+
+static HOST_LcdType g_lcd;
+
+static uint8 g_ddram[LCD_DDRAM_SIZE];
+static uint8 g_address;
+static uint8 g_eightBits;
+/* The high nibble of a byte in 4-bit mode while the low one is not written */
+static uint8 g_highNibble;
+static uint8 g_haveHighNibble;
+/* E at the last step, and RS and the data pins while E was high */
+static uint8 g_enable;
+static uint8 g_rs;
+static uint8 g_nibble;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* The main function of the HMI ECU */
+int main(void);
+
+static int boardMain(void);
+static void boardStep(uint64 now);
+static void setKey(uint8 key);
+
+/*
+ * Function responsible for the column pins of the held key and its scans.
+ */
+static void stepKeypad(uint64 now);
+
+/*
+ * Function responsible for the LCD pins at the time.
+ */
+static void stepLcd(uint64 now);
+
+/*
+ * Function responsible for one byte of the LCD, an instruction or a character.
+ */
+static void lcdByte(uint8 byte, uint8 rs, uint64 now);
+
+/*
+ * Function responsible for copying the visible cells of the DDRAM to the text.
+ */
+static void lcdUpdateText(void);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+const HOST_HmiBoardType g_hostHmiBoard =
+{
+	{ boardMain, boardStep, HOST_avrUartTake, HOST_avrUartGive, HOST_avrUartOverruns,
+			HOST_avrNextEvent },
+	setKey,
+	&g_keypadState,
+	&g_lcd
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The power on of the board, then the main function of the ECU.
+ */
+static int boardMain(void)
+{
+	HOST_avrReset();
+	host_SREG.Byte = 0;
+	host_PORTA.Byte = 0;
+	host_DDRA.Byte = 0;
+	host_PORTB.Byte = 0;
+	host_DDRB.Byte = 0;
+	host_PORTD.Byte = 0;
+	host_DDRD.Byte = 0;
+	host_PINB.Byte = 0xFF;
+	host_PIND.Byte = 0xFF;
+	memset(g_ddram, ' ', sizeof(g_ddram));
+	g_address = 0;
+	g_eightBits = TRUE;
+	g_haveHighNibble = FALSE;
+	g_enable = LOGIC_LOW;
+	memset(&g_lcd, 0, sizeof(g_lcd));
+	memset(&g_keypadState, 0, sizeof(g_keypadState));
+	lcdUpdateText();
+	return main();
+}
+
+/*
+ * Description :
+ * Step the devices of the board and the peripherals to the time.
+ */
+static void boardStep(uint64 now)
+{
+	stepKeypad(now);
+	stepLcd(now);
+	HOST_avrStep(now);
+}
+
+/*
+ * Description :
+ * Hold the key on the keypad, HOST_NO_KEY releases it.
+ */
+static void setKey(uint8 key)
+{
+	uint8 row, col;
+
+	g_keyRow = HOST_NO_KEY;
+	/* the press takes its time at the next step of the board */
+	g_keyNew = (key != HOST_NO_KEY) ? TRUE : FALSE;
+	g_keypadState.detected = 0;
+	for (row = 0; row < KEYPAD_NUM_ROWS; row++)
+	{
+		for (col = 0; col < KEYPAD_NUM_COLS; col++)
+		{
+			if ((g_keyRow == HOST_NO_KEY) && (g_keypad[row][col] == key))
+			{
+				g_keyRow = row;
+				g_keyCol = col;
+			}
+		}
+	}
+}
+
+/*
+ * Description :
+ * Pull the column pin of the held key low while its row pin is driven low.
+ * The driver reads the columns of a row before it drives the next one, so
+ * the end of the drive of the row of the held key is one sample of it.
+ */
+static void stepKeypad(uint64 now)
+{
+	uint8 rowPin, colMask, driven = FALSE;
+	uint8 cols = 0xFF;
+
+	if (g_keyNew == TRUE)
+	{
+		g_keyNew = FALSE;
+		g_keypadState.pressed = now;
+		g_keypadState.detected = 0;
+		g_keySamples = 0;
+	}
+	if (g_keyRow != HOST_NO_KEY)
+	{
+		rowPin = KEYPAD_FIRST_ROW_PIN_ID + g_keyRow;
+		if (((host_DDRB.Byte >> rowPin) & 1) && !((host_PORTB.Byte >> rowPin) & 1))
+		{
+			driven = TRUE;
+			cols &= (uint8) ~(1 << (KEYPAD_FIRST_COL_PIN_ID + g_keyCol));
+		}
+		else if ((g_keyRowDriven == TRUE) && (g_keySamples < KEYPAD_DEBOUNCE_SAMPLES))
+		{
+			g_keySamples++;
+			if (g_keySamples == KEYPAD_DEBOUNCE_SAMPLES)
+			{
+				g_keypadState.detected = now;
+			}
+		}
+	}
+	g_keyRowDriven = driven;
+	colMask = (uint8) (((1 << KEYPAD_NUM_COLS) - 1) << KEYPAD_FIRST_COL_PIN_ID);
+	host_PIND.Byte = (host_PIND.Byte & (uint8) ~colMask) | (cols & colMask);
+}
+
+/*
+ * Description :
+ * Keep the pins while E is high and take them at its falling edge.
+ */
+static void stepLcd(uint64 now)
+{
+	uint8 port = host_PORTA.Byte;
+	uint8 enable = (port >> LCD_E_PIN_ID) & 1;
+
+	if (enable == LOGIC_HIGH)
+	{
+		g_rs = (port >> LCD_RS_PIN_ID) & 1;
+		g_nibble = (port >> LCD_DB4_PIN_ID) & 0x0F;
+	}
+	else if (g_enable == LOGIC_HIGH)
+	{
+		if (g_eightBits == TRUE)
+		{
+			/* DB3 --> DB0 are not connected, they are read as zeros */
+			lcdByte((uint8) (g_nibble << 4), g_rs, now);
+		}
+		else if (g_haveHighNibble == FALSE)
+		{
+			g_highNibble = g_nibble;
+			g_haveHighNibble = TRUE;
+		}
+		else
+		{
+			g_haveHighNibble = FALSE;
+			lcdByte((uint8) ((g_highNibble << 4) | g_nibble), g_rs, now);
+		}
+	}
+	g_enable = enable;
+}
+
+/*
+ * Description :
+ * Run one instruction (RS = 0) or write one character (RS = 1).
+ */
+static void lcdByte(uint8 byte, uint8 rs, uint64 now)
+{
+	g_lcd.instructions++;
+	if (rs == LOGIC_HIGH)
+	{
+		g_ddram[g_address] = byte;
+		/* the address counter goes from the end of a line to the start of the other one */
+		g_address++;
+		if (g_address == LCD_LINE_LENGTH)
+		{
+			g_address = LCD_SECOND_LINE;
+		}
+		else if (g_address == (LCD_SECOND_LINE + LCD_LINE_LENGTH))
+		{
+			g_address = 0;
+		}
+		g_lcd.lastWrite = now;
+		lcdUpdateText();
+	}
+	else if (byte & LCD_SET_CURSOR_LOCATION)
+	{
+		g_address = byte & LCD_ADDRESS_MASK;
+	}
+	else if ((byte & LCD_FUNCTION_SET_MASK) == LCD_FUNCTION_SET)
+	{
+		g_eightBits = (byte & LCD_FUNCTION_SET_DL) ? TRUE : FALSE;
+	}
+	else if (byte == LCD_CLEAR_COMMAND)
+	{
+		memset(g_ddram, ' ', sizeof(g_ddram));
+		g_address = 0;
+		g_lcd.lastWrite = now;
+		lcdUpdateText();
+	}
+	else if ((byte & (uint8) ~1) == LCD_GO_TO_HOME)
+	{
+		g_address = 0;
+	}
+}
+
+/*
+ * Description :
+ * Copy the visible cells of the two lines to the text.
+ */
+static void lcdUpdateText(void)
+{
+	uint8 col;
+
+	for (col = 0; col < HOST_LCD_COLS; col++)
+	{
+		g_lcd.text[0][col] = (char) g_ddram[col];
+		g_lcd.text[1][col] = (char) g_ddram[LCD_SECOND_LINE + col];
+	}
+	g_lcd.text[0][HOST_LCD_COLS] = '\0';
+	g_lcd.text[1][HOST_LCD_COLS] = '\0';
+}
@@ -0,0 +1,226 @@
+/*
+ ============================================================================
+ File Name   : host_lcd_bus.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The GPIO API of the LCD driver with a model of the HD44780 on its pins
+ ============================================================================
+ */
+
+#include "host_lcd_bus.h"
+#include "host_blocks.h"
+#include "MCAL/GPIO/gpio.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#if (LCD_DATA_BITS_MODE != 4)
+#error "The model takes the 4-bit interface of lcd.h"
+#endif
+
+/* The DDRAM of the HD44780, the rows start at 0x00 and 0x40 */
+#define BUS_DDRAM_SIZE			0x80
+
+/* The LCD takes no instruction for 15 ms after the power on */
+#define BUS_POWER_ON_US			15000
+
+#if (LCD_WAIT_MODE == LCD_WAIT_BUSY_FLAG)
+#define BUS_READ_MODE()			((g_values[LCD_RW_PORT_ID] >> LCD_RW_PIN_ID) & 1)
+#else
+/* RW is tied to the ground when the busy flag is not read */
+#define BUS_READ_MODE()			0
+#endif
+
+#define BUS_PIN(port, pin)		((g_values[port] >> (pin)) & 1)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+HOST_LcdBusStatsType g_hostLcdBusStats;
+
+static uint8 g_values[NUM_OF_PORTS];
+static uint8 g_directions[NUM_OF_PORTS];
+
+static uint8 g_fourBits;
+static uint8 g_highNibble;
+static uint8 g_haveHighNibble;
+static uint8 g_address;
+static uint64 g_busyUntil;
+static char g_ddram[BUS_DDRAM_SIZE];
+static char g_row[LCD_COLS + 1];
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for the nibble on DB4 --> DB7 at the falling edge of E.
+ */
+static void busLatch(void);
+
+/*
+ * Function responsible for one instruction or character.
+ */
+static void busExecute(uint8 byte, uint8 rs);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The power on of the LCD, in the 8-bit interface with a blank screen, and
+ * zero the counters.
+ */
+void HOST_lcdBusReset(void)
+{
+	memset(&g_hostLcdBusStats, 0, sizeof(g_hostLcdBusStats));
+	memset(g_values, 0, sizeof(g_values));
+	memset(g_directions, 0, sizeof(g_directions));
+	memset(g_ddram, ' ', sizeof(g_ddram));
+	g_fourBits = FALSE;
+	g_haveHighNibble = FALSE;
+	g_address = 0;
+	g_busyUntil = g_hostCycles + (BUS_POWER_ON_US * HOST_CYCLES_PER_US);
+}
+
+/*
+ * Description :
+ * Return the visible text of the row, LCD_COLS characters.
+ */
+const char* HOST_lcdBusRow(uint8 row)
+{
+	uint8 start = ((row & 1) ? 0x40 : 0x00) + ((row & 2) ? LCD_COLS : 0);
+
+	memcpy(g_row, &g_ddram[start], LCD_COLS);
+	g_row[LCD_COLS] = '\0';
+	return g_row;
+}
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+	g_hostCycles += HOST_LCD_BUS_CYCLES_PER_ACCESS;
+	g_hostLcdBusStats.directionWrites++;
+	if (direction == PIN_OUTPUT)
+	{
+		g_directions[port_num] |= (uint8) (1 << pin_num);
+	}
+	else
+	{
+		g_directions[port_num] &= (uint8) ~(1 << pin_num);
+	}
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+	uint8 fallingE = ((port_num == LCD_E_PORT_ID) && (pin_num == LCD_E_PIN_ID)
+			&& (value == LOGIC_LOW) && BUS_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID));
+
+	g_hostCycles += HOST_LCD_BUS_CYCLES_PER_ACCESS;
+	g_hostLcdBusStats.pinWrites++;
+	if (value == LOGIC_HIGH)
+	{
+		g_values[port_num] |= (uint8) (1 << pin_num);
+	}
+	else
+	{
+		g_values[port_num] &= (uint8) ~(1 << pin_num);
+	}
+	if (fallingE && !BUS_READ_MODE())
+	{
+		busLatch();
+	}
+}
+
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num)
+{
+	g_hostCycles += HOST_LCD_BUS_CYCLES_PER_ACCESS;
+	g_hostLcdBusStats.pinReads++;
+	/* the LCD drives DB7 with the busy flag while E and RW are high */
+	if ((port_num == LCD_DATA_PORT_ID) && (pin_num == LCD_DB7_PIN_ID)
+			&& BUS_READ_MODE() && BUS_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID)
+			&& !((g_directions[port_num] >> pin_num) & 1))
+	{
+		if (g_hostCycles < g_busyUntil)
+		{
+			g_hostLcdBusStats.busyReads++;
+			return LOGIC_HIGH;
+		}
+		return LOGIC_LOW;
+	}
+	return BUS_PIN(port_num, pin_num);
+}
+
+/*
+ * Description :
+ * Take the nibble on DB4 --> DB7, one instruction of the 8-bit interface of
+ * the init sequence or the half of a byte of the 4-bit interface.
+ */
+static void busLatch(void)
+{
+	uint8 nibble = (uint8) ((BUS_PIN(LCD_DATA_PORT_ID, LCD_DB4_PIN_ID) << 0)
+			| (BUS_PIN(LCD_DATA_PORT_ID, LCD_DB5_PIN_ID) << 1)
+			| (BUS_PIN(LCD_DATA_PORT_ID, LCD_DB6_PIN_ID) << 2)
+			| (BUS_PIN(LCD_DATA_PORT_ID, LCD_DB7_PIN_ID) << 3));
+	uint8 rs = BUS_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID);
+
+	if ((g_haveHighNibble == FALSE) && (g_hostCycles < g_busyUntil))
+	{
+		g_hostLcdBusStats.lostBytes++;
+	}
+	if (g_fourBits == FALSE)
+	{
+		/* a function set of the 8-bit interface, DB0 --> DB3 are not connected */
+		g_hostLcdBusStats.instructions++;
+		g_busyUntil = g_hostCycles + ((g_hostLcdBusStats.instructions == 1) ?
+				HOST_LCD_BUS_INIT_EXECUTION_US : HOST_LCD_BUS_EXECUTION_US) * HOST_CYCLES_PER_US;
+		g_fourBits = (nibble == 0x2) ? TRUE : FALSE;
+		return;
+	}
+	if (g_haveHighNibble == FALSE)
+	{
+		g_highNibble = nibble;
+		g_haveHighNibble = TRUE;
+		return;
+	}
+	g_haveHighNibble = FALSE;
+	busExecute((uint8) ((g_highNibble << 4) | nibble), rs);
+}
+
+/*
+ * Description :
+ * Execute the instruction or write the character at the address counter.
+ */
+static void busExecute(uint8 byte, uint8 rs)
+{
+	uint32 executionUs = HOST_LCD_BUS_EXECUTION_US;
+
+	if (rs == LOGIC_HIGH)
+	{
+		g_hostLcdBusStats.characters++;
+		g_ddram[g_address] = (char) byte;
+		g_address = (g_address + 1) & (BUS_DDRAM_SIZE - 1);
+	}
+	else
+	{
+		g_hostLcdBusStats.instructions++;
+		if (byte & LCD_SET_CURSOR_LOCATION)
+		{
+			g_address = byte & (BUS_DDRAM_SIZE - 1);
+		}
+		else if ((byte == LCD_CLEAR_COMMAND) || (byte == LCD_GO_TO_HOME))
+		{
+			if (byte == LCD_CLEAR_COMMAND)
+			{
+				memset(g_ddram, ' ', sizeof(g_ddram));
+			}
+			g_address = 0;
+			executionUs = HOST_LCD_BUS_CLEAR_EXECUTION_US;
+		}
+	}
+	g_busyUntil = g_hostCycles + (executionUs * HOST_CYCLES_PER_US);
+}
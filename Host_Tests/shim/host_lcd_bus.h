@@ -0,0 +1,75 @@
+/*
+ ============================================================================
+ File Name   : host_lcd_bus.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The GPIO API of the LCD driver with a model of the HD44780 on its pins
+ ============================================================================
+ */
+
+/*
+ * The shim gives GPIO_setupPinDirection, GPIO_writePin and GPIO_readPin to
+ * lcd.c, which calls them through gpio_fast.h in a build without optimization.
+ * Each call is one SBI, CBI or SBIC instruction of the release build, so it
+ * counts HOST_LCD_BUS_CYCLES_PER_ACCESS on the virtual clock of host_blocks.h.
+ *
+ * The HD44780 latches a nibble on the falling edge of E while RW is low: the
+ * four nibbles of the 8-bit interface of the init sequence one by one, then the
+ * instructions and the characters in two nibbles. Each one makes it busy for
+ * its execution time of the data sheet, a byte written while it is busy is
+ * counted as lost. While E and RW are high DB7 is the busy flag.
+ */
+#ifndef HOST_LCD_BUS_H_
+#define HOST_LCD_BUS_H_
+
+#include "HAL/LCD/lcd.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* One SBI, CBI or SBIC instruction of the release build */
+#define HOST_LCD_BUS_CYCLES_PER_ACCESS		2
+
+/* Execution times of the data sheet at 270 kHz in microseconds */
+#define HOST_LCD_BUS_EXECUTION_US			37
+#define HOST_LCD_BUS_CLEAR_EXECUTION_US		1520
+#define HOST_LCD_BUS_INIT_EXECUTION_US		4100
+
+/* Counters of the bus since the reset */
+typedef struct
+{
+	uint32 pinWrites; /* GPIO_writePin calls */
+	uint32 directionWrites; /* GPIO_setupPinDirection calls */
+	uint32 pinReads; /* GPIO_readPin calls */
+	uint32 instructions; /* instructions and nibbles of the init sequence */
+	uint32 characters;
+	uint32 busyReads; /* busy flag reads which found the LCD busy */
+	uint32 lostBytes; /* nibbles and bytes written while the LCD was busy */
+} HOST_LcdBusStatsType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+extern HOST_LcdBusStatsType g_hostLcdBusStats;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The power on of the LCD, in the 8-bit interface with a blank screen, and
+ * zero the counters.
+ */
+void HOST_lcdBusReset(void);
+
+/*
+ * Description :
+ * Return the visible text of the row, LCD_COLS characters.
+ */
+const char* HOST_lcdBusRow(uint8 row);
+
+#endif /* HOST_LCD_BUS_H_ */
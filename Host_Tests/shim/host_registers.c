@@ -0,0 +1,47 @@
+/*
+ ============================================================================
+ File Name   : host_registers.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : The RAM variables of the register shim
+ ============================================================================
+ */
+
+#include "host_registers.h"
+
+volatile SREG_Type host_SREG;
+
+volatile GPIO_PORTA_Type host_PORTA, host_DDRA, host_PINA;
+volatile GPIO_PORTB_Type host_PORTB, host_DDRB, host_PINB;
+volatile GPIO_PORTC_Type host_PORTC, host_DDRC, host_PINC;
+volatile GPIO_PORTD_Type host_PORTD, host_DDRD, host_PIND;
+
+volatile UART_UCSRA_Type host_UCSRA;
+volatile UART_UCSRB_Type host_UCSRB;
+volatile UART_UCSRC_Type host_UCSRC;
+volatile uint16 host_UDR = HOST_UDR_EMPTY;
+volatile uint8 host_UBRRL;
+volatile uint8 host_UBRRH;
+
+/* This file is built without HOST_TIMER0_REGISTERS, TIMSK and TIFR have their TIMER1 types */
+volatile Timer1_TCCR1A_Type host_TCCR1A;
+volatile Timer1_TCCR1B_Type host_TCCR1B;
+volatile uint16 host_TCNT1;
+volatile uint16 host_OCR1A;
+volatile uint16 host_OCR1B;
+volatile uint16 host_ICR1;
+volatile Timers_TIMSK_Type host_TIMSK;
+volatile Timers_TIFR_Type host_TIFR;
+
+volatile uint8 host_TCCR0;
+volatile uint8 host_TCNT0;
+volatile uint8 host_OCR0;
+
+#ifdef HOST_TWI_REGISTERS
+volatile TWI_TWBR_Type host_TWBR;
+volatile TWI_TWSR_Type host_TWSR;
+volatile TWI_TWAR_Type host_TWAR;
+volatile TWI_TWDR_Type host_TWDR;
+volatile TWI_TWCR_Type host_TWCR;
+#endif
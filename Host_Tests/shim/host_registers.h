@@ -0,0 +1,198 @@
+/*
+ ============================================================================
+ File Name   : host_registers.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Register shim, the AVR registers of the drivers as RAM variables
+ ============================================================================
+ */
+
+/*
+ * It is included by the Makefile before any source and after host_types.h,
+ * with the ECU directory in the include path. The private headers of the
+ * drivers are included here first, then their registers at fixed addresses are
+ * replaced by variables which the test can set and check. The sources include
+ * the same headers again, their include guards keep the replaced registers.
+ */
+#ifndef HOST_REGISTERS_H_
+#define HOST_REGISTERS_H_
+
+#include "MCAL/GPIO/gpio_private.h"
+#include "MCAL/UART/uart_private.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * UDR is one address for two registers on the AVR, a write goes to the
+ * transmitter and a read comes from the receiver. host_UDR is 16 bits: the
+ * test puts HOST_UDR_EMPTY in it, a write of the driver clears the high byte,
+ * so the test knows that a byte was sent even if it has the value of the last one.
+ */
+#define HOST_UDR_EMPTY				0x100
+
+/*******************************************************************************
+ *                         Registers of all the ECUs                           *
+ *******************************************************************************/
+
+/* The status register, the critical sections save and clear its I-bit */
+#undef SREG_REG
+#define SREG_REG	host_SREG
+extern volatile SREG_Type host_SREG;
+
+/* The GPIO ports, the PIN registers are written by the test only */
+#undef PORTA_REG
+#undef DDRA_REG
+#undef PINA_REG
+#undef PORTB_REG
+#undef DDRB_REG
+#undef PINB_REG
+#undef PORTC_REG
+#undef DDRC_REG
+#undef PINC_REG
+#undef PORTD_REG
+#undef DDRD_REG
+#undef PIND_REG
+#define PORTA_REG	host_PORTA
+#define DDRA_REG	host_DDRA
+#define PINA_REG	host_PINA
+#define PORTB_REG	host_PORTB
+#define DDRB_REG	host_DDRB
+#define PINB_REG	host_PINB
+#define PORTC_REG	host_PORTC
+#define DDRC_REG	host_DDRC
+#define PINC_REG	host_PINC
+#define PORTD_REG	host_PORTD
+#define DDRD_REG	host_DDRD
+#define PIND_REG	host_PIND
+extern volatile GPIO_PORTA_Type host_PORTA, host_DDRA, host_PINA;
+extern volatile GPIO_PORTB_Type host_PORTB, host_DDRB, host_PINB;
+extern volatile GPIO_PORTC_Type host_PORTC, host_DDRC, host_PINC;
+extern volatile GPIO_PORTD_Type host_PORTD, host_DDRD, host_PIND;
+
+/* The UART, UCSRC and UBRRH share one address on the AVR but not here */
+#undef UCSRA_REG
+#undef UCSRB_REG
+#undef UCSRC_REG
+#undef UDR_REG
+#undef UBRRL_REG
+#undef UBRRH_REG
+#define UCSRA_REG	host_UCSRA
+#define UCSRB_REG	host_UCSRB
+#define UCSRC_REG	host_UCSRC
+#define UDR_REG		host_UDR
+#define UBRRL_REG	host_UBRRL
+#define UBRRH_REG	host_UBRRH
+extern volatile UART_UCSRA_Type host_UCSRA;
+extern volatile UART_UCSRB_Type host_UCSRB;
+extern volatile UART_UCSRC_Type host_UCSRC;
+extern volatile uint16 host_UDR;
+extern volatile uint8 host_UBRRL;
+extern volatile uint8 host_UBRRH;
+
+/*
+ * The timers, timer0_private.h and timer1_private.h have one include guard and
+ * both declare the TIMSK and TIFR types, so a source can see only one of them.
+ * The source of the TIMER0 driver is built with HOST_TIMER0_REGISTERS, the
+ * other ones get the TIMER1 registers. TIMSK and TIFR are the same variables
+ * in both cases.
+ */
+#ifdef HOST_TIMER0_REGISTERS
+
+#include "MCAL/TIMER0_PWM/timer0_private.h"
+
+#undef TCCR0_REG
+#undef TCNT0_REG
+#undef OCR0_REG
+#undef TIMSK_REG
+#undef TIFR_REG
+#define TCCR0_REG	(*(volatile Timer0_TCCR0_Type *) &host_TCCR0)
+#define TCNT0_REG	host_TCNT0
+#define OCR0_REG	host_OCR0
+#define TIMSK_REG	(*(volatile Timers_TIMSK_Type *) &host_TIMSK)
+#define TIFR_REG	(*(volatile Timers_TIFR_Type *) &host_TIFR)
+extern volatile uint8 host_TIMSK;
+extern volatile uint8 host_TIFR;
+
+#else
+
+#include "MCAL/TIMER1/timer1_private.h"
+
+#undef TCCR1A_REG
+#undef TCCR1B_REG
+#undef TCNT1H_REG
+#undef TCNT1L_REG
+#undef TCNT1_REG
+#undef OCR1AH_REG
+#undef OCR1AL_REG
+#undef OCR1A_REG
+#undef OCR1BH_REG
+#undef OCR1BL_REG
+#undef OCR1B_REG
+#undef ICR1H_REG
+#undef ICR1L_REG
+#undef ICR1_REG
+#undef TIMSK_REG
+#undef TIFR_REG
+#define TCCR1A_REG	host_TCCR1A
+#define TCCR1B_REG	host_TCCR1B
+#define TCNT1_REG	host_TCNT1
+#define TCNT1H_REG	(((volatile uint8 *) &host_TCNT1)[1])
+#define TCNT1L_REG	(((volatile uint8 *) &host_TCNT1)[0])
+#define OCR1A_REG	host_OCR1A
+#define OCR1AH_REG	(((volatile uint8 *) &host_OCR1A)[1])
+#define OCR1AL_REG	(((volatile uint8 *) &host_OCR1A)[0])
+#define OCR1B_REG	host_OCR1B
+#define OCR1BH_REG	(((volatile uint8 *) &host_OCR1B)[1])
+#define OCR1BL_REG	(((volatile uint8 *) &host_OCR1B)[0])
+#define ICR1_REG	host_ICR1
+#define ICR1H_REG	(((volatile uint8 *) &host_ICR1)[1])
+#define ICR1L_REG	(((volatile uint8 *) &host_ICR1)[0])
+#define TIMSK_REG	host_TIMSK
+#define TIFR_REG	host_TIFR
+extern volatile Timer1_TCCR1A_Type host_TCCR1A;
+extern volatile Timer1_TCCR1B_Type host_TCCR1B;
+extern volatile uint16 host_TCNT1;
+extern volatile uint16 host_OCR1A;
+extern volatile uint16 host_OCR1B;
+extern volatile uint16 host_ICR1;
+extern volatile Timers_TIMSK_Type host_TIMSK;
+extern volatile Timers_TIFR_Type host_TIFR;
+
+#endif /* HOST_TIMER0_REGISTERS */
+
+/* The TIMER0 registers are bytes in both cases, so the device models can read them */
+extern volatile uint8 host_TCCR0;
+extern volatile uint8 host_TCNT0;
+extern volatile uint8 host_OCR0;
+
+/*******************************************************************************
+ *                       Registers of the Control ECU                          *
+ *******************************************************************************/
+
+/* The TWI registers, only the Control ECU has the TWI driver */
+#ifdef HOST_TWI_REGISTERS
+
+#include "MCAL/I2C/twi_private.h"
+
+#undef TWBR_REG
+#undef TWSR_REG
+#undef TWAR_REG
+#undef TWDR_REG
+#undef TWCR_REG
+#define TWBR_REG	host_TWBR
+#define TWSR_REG	host_TWSR
+#define TWAR_REG	host_TWAR
+#define TWDR_REG	host_TWDR
+#define TWCR_REG	host_TWCR
+extern volatile TWI_TWBR_Type host_TWBR;
+extern volatile TWI_TWSR_Type host_TWSR;
+extern volatile TWI_TWAR_Type host_TWAR;
+extern volatile TWI_TWDR_Type host_TWDR;
+extern volatile TWI_TWCR_Type host_TWCR;
+
+#endif /* HOST_TWI_REGISTERS */
+
+#endif /* HOST_REGISTERS_H_ */
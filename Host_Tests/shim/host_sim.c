@@ -0,0 +1,311 @@
+/*
+ ============================================================================
+ File Name   : host_sim.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Simulation of the two ECUs connected by their UARTs
+ ============================================================================
+ */
+
+#include "host_sim.h"
+#include "host_blocks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_ECUS				2
+#define SIM_HMI					0
+#define SIM_CONTROL				1
+
+/* The stack of each ECU, the host frames are larger than the AVR ones */
+#define SIM_STACK_SIZE			(256UL * 1024UL)
+
+/* The latest power on of the Control ECU after the HMI ECU, one millisecond */
+#define SIM_MAX_POWER_ON_DELAY	(F_CPU / 1000UL)
+
+typedef struct
+{
+	const HOST_EcuType *ecu;
+	ucontext_t context;
+	uint64 cycles; /* the clock of the ECU while the other one runs */
+} SimEcuType;
+
+typedef struct
+{
+	uint64 time;
+	HOST_SimActionType action;
+	uint8 arg;
+} SimEventType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+HOST_SimStatsType g_hostSimStats;
+
+static SimEcuType g_ecus[SIM_ECUS];
+static ucontext_t g_simulator;
+static uint8 g_current;
+static uint64 g_now;
+static uint64 g_turnEnd;
+
+/* The queue of the events of the scenario in the order of their times */
+static SimEventType g_events[HOST_SIM_MAX_EVENTS];
+static uint8 g_eventCount;
+
+/* The state of the xorshift random numbers, never zero */
+static uint32 g_random;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for stepping the board of the running ECU.
+ */
+static void simDevices(void);
+
+/*
+ * Function responsible for switching back to the simulator at the end of the turn.
+ */
+static void simYield(void);
+
+/*
+ * Function responsible for the next event of the running ECU in its turn.
+ */
+static uint64 simNextEvent(void);
+
+/*
+ * Function responsible for calling the actions of the queue whose time came.
+ */
+static void simFireEvents(void);
+
+/*
+ * Function responsible for running the main function of the ECU on its stack.
+ */
+static void simStart(void);
+
+/*
+ * Function responsible for giving the bytes sent by one ECU to the other one.
+ */
+static uint32 simLine(const HOST_EcuType *a_from, const HOST_EcuType *a_to, uint64 *a_end);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Power on both boards, the HMI ECU at the time 0 and the Control ECU up to
+ * one millisecond later, and seed the random numbers.
+ */
+void HOST_simInit(uint32 seed)
+{
+	uint8 i;
+
+	g_random = (seed != 0) ? seed : 1;
+
+	g_ecus[SIM_HMI].ecu = &g_hostHmiBoard.ecu;
+	g_ecus[SIM_CONTROL].ecu = &g_hostControlBoard.ecu;
+	for (i = 0; i < SIM_ECUS; i++)
+	{
+		getcontext(&g_ecus[i].context);
+		g_ecus[i].context.uc_stack.ss_sp = malloc(SIM_STACK_SIZE);
+		g_ecus[i].context.uc_stack.ss_size = SIM_STACK_SIZE;
+		g_ecus[i].context.uc_link = NULL_PTR;
+		if (g_ecus[i].context.uc_stack.ss_sp == NULL_PTR)
+		{
+			fprintf(stderr, "no memory for the stack of the ECU %u\n", i);
+			exit(1);
+		}
+		makecontext(&g_ecus[i].context, simStart, 0);
+	}
+	g_ecus[SIM_HMI].cycles = 0;
+	g_ecus[SIM_CONTROL].cycles = HOST_simRandom(SIM_MAX_POWER_ON_DELAY);
+	g_now = 0;
+	g_eventCount = 0;
+	g_hostSimStats.hmiToControlBytes = 0;
+	g_hostSimStats.controlToHmiBytes = 0;
+	g_hostSimStats.hmiToControlEnd = 0;
+	g_hostSimStats.controlToHmiEnd = 0;
+	g_hostDevices = simDevices;
+	g_hostYield = simYield;
+	g_hostNextEvent = simNextEvent;
+}
+
+/*
+ * Description :
+ * Run both ECUs for the required AVR cycles.
+ */
+void HOST_simRun(uint64 cycles)
+{
+	uint64 end = g_now + cycles;
+
+	while (g_now < end)
+	{
+		simFireEvents();
+		g_turnEnd = g_now + HOST_SIM_QUANTUM_CYCLES;
+		if (g_turnEnd > end)
+		{
+			g_turnEnd = end;
+		}
+		if ((g_eventCount != 0) && (g_events[0].time < g_turnEnd))
+		{
+			g_turnEnd = g_events[0].time;
+		}
+		for (g_current = 0; g_current < SIM_ECUS; g_current++)
+		{
+			if (g_ecus[g_current].cycles < g_turnEnd)
+			{
+				g_hostCycles = g_ecus[g_current].cycles;
+				swapcontext(&g_simulator, &g_ecus[g_current].context);
+				g_ecus[g_current].cycles = g_hostCycles;
+			}
+		}
+		g_hostSimStats.hmiToControlBytes += simLine(g_ecus[SIM_HMI].ecu,
+				g_ecus[SIM_CONTROL].ecu, &g_hostSimStats.hmiToControlEnd);
+		g_hostSimStats.controlToHmiBytes += simLine(g_ecus[SIM_CONTROL].ecu,
+				g_ecus[SIM_HMI].ecu, &g_hostSimStats.controlToHmiEnd);
+		g_now = g_turnEnd;
+	}
+	simFireEvents();
+}
+
+/*
+ * Description :
+ * Return the time of the simulation in AVR cycles, the end of the last turn.
+ */
+uint64 HOST_simNow(void)
+{
+	return g_now;
+}
+
+/*
+ * Description :
+ * Put the action in the queue, it is called at the time between two turns,
+ * the actions of the same time are called in their order.
+ * Return FALSE if the queue is full.
+ */
+uint8 HOST_simSchedule(uint64 time, HOST_SimActionType action, uint8 arg)
+{
+	uint8 i;
+
+	if (g_eventCount == HOST_SIM_MAX_EVENTS)
+	{
+		return FALSE;
+	}
+	/* the later events move one place to keep the queue in order */
+	for (i = g_eventCount; (i != 0) && (g_events[i - 1].time > time); i--)
+	{
+		g_events[i] = g_events[i - 1];
+	}
+	g_events[i].time = time;
+	g_events[i].action = action;
+	g_events[i].arg = arg;
+	g_eventCount++;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Return a random number from 0 to range - 1 from the seed of the simulation.
+ */
+uint32 HOST_simRandom(uint32 range)
+{
+	/* xorshift32 */
+	g_random ^= g_random << 13;
+	g_random ^= g_random >> 17;
+	g_random ^= g_random << 5;
+	return (range != 0) ? (g_random % range) : 0;
+}
+
+/*
+ * Description :
+ * Step the board of the running ECU to its clock.
+ */
+static void simDevices(void)
+{
+	g_ecus[g_current].ecu->step(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Switch back to the simulator when the clock of the running ECU reaches the
+ * end of the turn.
+ */
+static void simYield(void)
+{
+	if (g_hostCycles >= g_turnEnd)
+	{
+		swapcontext(&g_ecus[g_current].context, &g_simulator);
+	}
+}
+
+/*
+ * Description :
+ * Return the next event of the board of the running ECU, or the end of its
+ * turn if it comes first.
+ */
+static uint64 simNextEvent(void)
+{
+	uint64 next = g_ecus[g_current].ecu->nextEvent();
+
+	return (next < g_turnEnd) ? next : g_turnEnd;
+}
+
+/*
+ * Description :
+ * Call the actions of the queue whose time came, an action can put new ones.
+ */
+static void simFireEvents(void)
+{
+	SimEventType event;
+	uint8 i;
+
+	while ((g_eventCount != 0) && (g_events[0].time <= g_now))
+	{
+		event = g_events[0];
+		g_eventCount--;
+		for (i = 0; i < g_eventCount; i++)
+		{
+			g_events[i] = g_events[i + 1];
+		}
+		event.action(event.arg);
+	}
+}
+
+/*
+ * Description :
+ * Run the main function of the ECU on its stack, it never returns.
+ */
+static void simStart(void)
+{
+	g_ecus[g_current].ecu->main();
+	fprintf(stderr, "the main function of the ECU %u returned\n", g_current);
+	exit(1);
+}
+
+/*
+ * Description :
+ * Give the bytes which one ECU started to send to the other one and take the
+ * end of the last one. Return the number of the bytes.
+ */
+static uint32 simLine(const HOST_EcuType *a_from, const HOST_EcuType *a_to, uint64 *a_end)
+{
+	uint8 data;
+	uint64 end;
+	uint32 bytes = 0;
+
+	while (a_from->uartTake(&data, &end) == TRUE)
+	{
+		a_to->uartGive(data, end);
+		*a_end = end;
+		bytes++;
+	}
+	return bytes;
+}
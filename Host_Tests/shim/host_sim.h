@@ -0,0 +1,103 @@
+/*
+ ============================================================================
+ File Name   : host_sim.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Simulation of the two ECUs connected by their UARTs
+ ============================================================================
+ */
+
+/*
+ * Each ECU runs its main function on its own stack and its own virtual clock,
+ * the clock of host_blocks.h is saved and loaded when the simulator switches
+ * between them. The simulator runs the ECUs in turns of HOST_SIM_QUANTUM_CYCLES:
+ * an ECU runs until its clock reaches the end of the turn, then the other one.
+ * After each turn the bytes which the UART of each ECU started to send are
+ * given to the RX pin of the other one at the end time of their frames. A
+ * frame is longer than a turn, so a byte always arrives in the future of the
+ * receiver and the order of the events on the line is kept.
+ *
+ * Time moves from one event to the next one: a turn also ends at the next
+ * event of the queue, the events of the scenario like the keys of the user,
+ * and an idle wait of an ECU (_delay_ms, _delay_us) jumps to the next event of
+ * its board: the TIMER1 compare match, the end of a UART frame or of a TWI
+ * action. The random numbers of the scenario and the power on of the Control
+ * ECU up to one millisecond after the HMI ECU come from the seed, so a run is
+ * the same for the same seed and the phase of the two TIMER1 ticks changes
+ * with it.
+ *
+ * One simulation runs in a process, it starts with the power on of both boards.
+ */
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include "host_ecu.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Cycles of one turn, less than the 8320 cycles of a frame at 9600 baud and 8 MHz */
+#define HOST_SIM_QUANTUM_CYCLES		1000
+
+/* Events which can wait in the queue */
+#define HOST_SIM_MAX_EVENTS			32
+
+/* An event of the scenario, called with its argument at its time */
+typedef void (*HOST_SimActionType)(uint8 arg);
+
+/* Counters of the line since the power on */
+typedef struct
+{
+	uint32 hmiToControlBytes;
+	uint32 controlToHmiBytes;
+	/* the end of the stop bit of the last byte of each direction */
+	uint64 hmiToControlEnd;
+	uint64 controlToHmiEnd;
+} HOST_SimStatsType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+extern HOST_SimStatsType g_hostSimStats;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Power on both boards, the HMI ECU at the time 0 and the Control ECU up to
+ * one millisecond later, and seed the random numbers.
+ */
+void HOST_simInit(uint32 seed);
+
+/*
+ * Description :
+ * Run both ECUs for the required AVR cycles.
+ */
+void HOST_simRun(uint64 cycles);
+
+/*
+ * Description :
+ * Return the time of the simulation in AVR cycles, the end of the last turn.
+ */
+uint64 HOST_simNow(void);
+
+/*
+ * Description :
+ * Put the action in the queue, it is called at the time between two turns,
+ * the actions of the same time are called in their order.
+ * Return FALSE if the queue is full.
+ */
+uint8 HOST_simSchedule(uint64 time, HOST_SimActionType action, uint8 arg);
+
+/*
+ * Description :
+ * Return a random number from 0 to range - 1 from the seed of the simulation.
+ */
+uint32 HOST_simRandom(uint32 range);
+
+#endif /* HOST_SIM_H_ */
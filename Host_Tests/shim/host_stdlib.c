@@ -0,0 +1,53 @@
+/*
+ ============================================================================
+ File Name   : host_stdlib.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host addition to the C library, the avr-libc itoa
+ ============================================================================
+ */
+
+#include <stdlib.h>
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Convert the value to a string in the radix like avr-libc, the value is
+ * taken as the 16-bit int of the AVR.
+ */
+char *itoa(int value, char *string, int radix)
+{
+	sint16 avrValue = (sint16) value;
+	uint16 magnitude;
+	char digits[17];
+	uint8 length = 0;
+	uint8 i = 0;
+
+	/* avr-libc writes the sign for the radix 10 only */
+	if ((avrValue < 0) && (radix == 10))
+	{
+		string[i++] = '-';
+		magnitude = (uint16) -avrValue;
+	}
+	else
+	{
+		magnitude = (uint16) avrValue;
+	}
+	do
+	{
+		digits[length] = "0123456789abcdefghijklmnopqrstuvwxyz"[magnitude % radix];
+		length++;
+		magnitude /= radix;
+	} while (magnitude != 0);
+	while (length != 0)
+	{
+		length--;
+		string[i++] = digits[length];
+	}
+	string[i] = '\0';
+	return string;
+}
@@ -0,0 +1,35 @@
+/*
+ ============================================================================
+ File Name   : host_test.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Check macro and result of the host tests
+ ============================================================================
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+
+/* Number of the failed checks of the test program */
+extern int g_hostTestFailures;
+
+/* Print the failed condition with its line and count it, the test goes on */
+#define HOST_CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			g_hostTestFailures++; \
+		} \
+	} while (0)
+
+/* Print the result of the test program and return its exit status */
+#define HOST_TEST_END() \
+	((g_hostTestFailures == 0) ? (printf("PASS\n"), 0) \
+			: (printf("FAIL, %d failed checks\n", g_hostTestFailures), 1))
+
+#endif /* HOST_TEST_H_ */
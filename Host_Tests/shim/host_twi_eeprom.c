@@ -0,0 +1,371 @@
+/*
+ ============================================================================
+ File Name   : host_twi_eeprom.c
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Model of the TWI bus and a 24C16 EEPROM behind the TWI registers
+ ============================================================================
+ */
+
+#include "host_twi_eeprom.h"
+#include "host_blocks.h"
+#include "MCAL/I2C/twi.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* TWCR bits */
+#define TWCR_TWIE		0x01
+#define TWCR_TWEN		0x04
+#define TWCR_TWWC		0x08
+#define TWCR_TWSTO		0x10
+#define TWCR_TWSTA		0x20
+#define TWCR_TWEA		0x40
+#define TWCR_TWINT		0x80
+
+/* SCL periods of a byte with its ACK bit */
+#define BYTE_PERIODS	9
+
+/* Device address of the 24C16 without the A10 A9 A8 R/W bits */
+#define DEVICE_ADDRESS	0xA0
+#define DEVICE_MASK		0xF0
+
+#define PAGE_MASK		(EEPROM_PAGE_SIZE - 1)
+
+/* The state of the bus after the last action */
+typedef enum
+{
+	BUS_FREE, /* no START or after STOP */
+	BUS_ADDRESS, /* after START, the next byte is the address */
+	BUS_WORD_ADDRESS, /* after SLA+W ACK, the next byte is the memory address */
+	BUS_WRITE_DATA, /* after the memory address, the next bytes are loaded in the page */
+	BUS_READ, /* after SLA+R ACK, the next bytes are read */
+	BUS_NOT_ADDRESSED /* after an address NACK, the 24C16 ignores the bytes */
+} BusStateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+uint8 g_hostTwiEeprom[EEPROM_SIZE];
+uint32 g_hostTwiEepromPageWrites[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+HOST_TwiEepromStatsType g_hostTwiEepromStats;
+
+static BusStateType g_bus = BUS_FREE;
+
+/* The address counter of the 24C16 */
+static uint16 g_address = 0;
+
+/* The page being loaded, its first address and the offsets written in it */
+static uint8 g_page[EEPROM_PAGE_SIZE];
+static uint16 g_pageBase = 0;
+static uint16 g_loadedMask = 0;
+static uint8 g_loadedBytes = 0;
+
+/* End of the write cycle, the 24C16 NACKs its address before it */
+static uint64 g_writeEnd = 0;
+static uint64 g_writeCycleCycles = 0;
+
+/* The running action, its end and the status and flags at its end */
+static uint8 g_actionRunning = FALSE;
+static uint64 g_actionEnd = 0;
+static uint8 g_actionStatus = 0;
+static uint8 g_actionSetsInterrupt = FALSE;
+
+/* The faults */
+static uint8 g_removed = FALSE;
+static uint8 g_arbitrationsToLose = 0;
+static uint8 g_nackNextData = FALSE;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* The TWI ISR of the driver */
+void TWI_vect(void);
+
+/*
+ * Function responsible for the STOP condition, it starts the write cycle of a loaded page.
+ */
+static void stopCondition(uint64 now);
+
+/*
+ * Function responsible for one byte after the START and return its TWSR status.
+ */
+static uint8 transferByte(uint8 control, uint64 now);
+
+/*
+ * Function responsible for taking a new action written by the driver in TWCR.
+ */
+static void takeAction(uint64 now);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Erase the memory to 0xFF, free the bus, reset the TWI registers, clear the
+ * counters and the faults, and set the write cycle time in microseconds.
+ */
+void HOST_twiEepromReset(uint32 writeCycleUs)
+{
+	memset(g_hostTwiEeprom, 0xFF, sizeof(g_hostTwiEeprom));
+	memset(g_hostTwiEepromPageWrites, 0, sizeof(g_hostTwiEepromPageWrites));
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	g_bus = BUS_FREE;
+	g_address = 0;
+	g_loadedMask = 0;
+	g_loadedBytes = 0;
+	g_writeEnd = 0;
+	g_writeCycleCycles = (uint64) writeCycleUs * (F_CPU / 1000000UL);
+	g_actionRunning = FALSE;
+	g_removed = FALSE;
+	g_arbitrationsToLose = 0;
+	g_nackNextData = FALSE;
+	/* the TWI registers of the power on reset */
+	host_TWCR.Byte = 0;
+	host_TWSR.Byte = 0xF8;
+	host_TWDR.Byte = 0xFF;
+}
+
+/*
+ * Description :
+ * Step the bus and the 24C16 to the time in AVR cycles, then take the TWI
+ * interrupt if TWINT is set by the model, TWIE is set and the I-bit is set.
+ * The ISR runs with the I-bit cleared like on the AVR.
+ */
+void HOST_twiEepromStep(uint64 now)
+{
+	uint8 control;
+	uint32 blocks;
+
+	if ((g_actionRunning == TRUE) && (now >= g_actionEnd))
+	{
+		g_actionRunning = FALSE;
+		host_TWSR.Byte = (host_TWSR.Byte & 0x07) | g_actionStatus;
+		/* the hardware clears TWSTO when the STOP is sent */
+		control = host_TWCR.Byte & (uint8) ~TWCR_TWSTO;
+		if (g_actionSetsInterrupt == TRUE)
+		{
+			control |= TWCR_TWINT;
+		}
+		host_TWCR.Byte = control;
+	}
+
+	if (g_actionRunning == FALSE)
+	{
+		takeAction(now);
+	}
+
+	control = host_TWCR.Byte;
+	if (((control & (TWCR_TWINT | TWCR_TWWC | TWCR_TWIE | TWCR_TWEN))
+			== (TWCR_TWINT | TWCR_TWWC | TWCR_TWIE | TWCR_TWEN))
+			&& (host_SREG.Bits.I_Bit == 1))
+	{
+		g_hostTwiEepromStats.interrupts++;
+		host_SREG.Bits.I_Bit = 0;
+		blocks = g_hostBlocks;
+		TWI_vect();
+		g_hostTwiEepromStats.isrBlocks += g_hostBlocks - blocks;
+		host_SREG.Bits.I_Bit = 1;
+	}
+}
+
+/*
+ * Description :
+ * Return the end time of the running action on the bus, or HOST_NO_EVENT.
+ */
+uint64 HOST_twiEepromNextEvent(void)
+{
+	return (g_actionRunning == TRUE) ? g_actionEnd : HOST_NO_EVENT;
+}
+
+/*
+ * Description :
+ * Make the 24C16 NACK its address or not, like an EEPROM which is not connected.
+ */
+void HOST_twiEepromRemove(uint8 removed)
+{
+	g_removed = removed;
+}
+
+/*
+ * Description :
+ * Lose the arbitration to another master in the address byte of the next
+ * transactions, the bus is released like the TWI hardware does.
+ */
+void HOST_twiEepromLoseArbitration(uint8 times)
+{
+	g_arbitrationsToLose = times;
+}
+
+/*
+ * Description :
+ * NACK the next data byte which is written to the 24C16.
+ */
+void HOST_twiEepromNackNextData(void)
+{
+	g_nackNextData = TRUE;
+}
+
+/*
+ * Description :
+ * Return TRUE if the 24C16 is in its write cycle at the time.
+ */
+uint8 HOST_twiEepromIsWriting(uint64 now)
+{
+	return (now < g_writeEnd) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Take a new action written by the driver in TWCR: a whole byte with TWINT = 1
+ * and TWWC = 0, TWINT reads zero until the action ends.
+ */
+static void takeAction(uint64 now)
+{
+	uint8 control = host_TWCR.Byte;
+	uint8 prescaler = host_TWSR.Byte & 0x03;
+	uint32 period = 16UL + (2UL * host_TWBR.Byte * (1UL << (2 * prescaler)));
+	uint32 duration = 0;
+
+	if ((control & (TWCR_TWINT | TWCR_TWWC | TWCR_TWEN))
+			!= (TWCR_TWINT | TWCR_TWEN))
+	{
+		return;
+	}
+	host_TWCR.Byte = (control & (uint8) ~TWCR_TWINT) | TWCR_TWWC;
+	g_actionSetsInterrupt = FALSE;
+
+	if (control & TWCR_TWSTO)
+	{
+		duration += period;
+		stopCondition(now + duration);
+	}
+	if (control & TWCR_TWSTA)
+	{
+		duration += period;
+		g_hostTwiEepromStats.starts++;
+		g_actionStatus = (g_bus == BUS_FREE) ? TWI_START : TWI_REP_START;
+		g_actionSetsInterrupt = TRUE;
+		/* a REPEATED START after the memory address is a random read, the load is dropped */
+		g_loadedBytes = 0;
+		g_loadedMask = 0;
+		g_bus = BUS_ADDRESS;
+	}
+	else if ((control & TWCR_TWSTO) == 0)
+	{
+		duration += BYTE_PERIODS * period;
+		g_actionStatus = transferByte(control, now + duration);
+		g_actionSetsInterrupt = TRUE;
+	}
+
+	g_actionRunning = TRUE;
+	g_actionEnd = now + duration;
+}
+
+/*
+ * Description :
+ * The STOP condition, it starts the write cycle of a loaded page. The page is
+ * programmed at once, the 24C16 can't be read before the end of its cycle.
+ */
+static void stopCondition(uint64 now)
+{
+	uint8 offset;
+
+	if ((g_bus == BUS_WRITE_DATA) && (g_loadedBytes > 0))
+	{
+		for (offset = 0; offset < EEPROM_PAGE_SIZE; offset++)
+		{
+			if (g_loadedMask & (1U << offset))
+			{
+				g_hostTwiEeprom[g_pageBase + offset] = g_page[offset];
+			}
+		}
+		g_hostTwiEepromStats.writeCycles++;
+		g_hostTwiEepromPageWrites[g_pageBase / EEPROM_PAGE_SIZE]++;
+		g_writeEnd = now + g_writeCycleCycles;
+	}
+	g_loadedBytes = 0;
+	g_loadedMask = 0;
+	g_bus = BUS_FREE;
+}
+
+/*
+ * Description :
+ * One byte after the START: the address, the memory address, a byte loaded in
+ * the page or a byte read. Return the TWSR status at its end.
+ */
+static uint8 transferByte(uint8 control, uint64 now)
+{
+	uint8 data = host_TWDR.Byte;
+
+	switch (g_bus)
+	{
+	case BUS_ADDRESS:
+		if (g_arbitrationsToLose > 0)
+		{
+			/* the other master wins, the hardware releases the bus */
+			g_arbitrationsToLose--;
+			g_hostTwiEepromStats.arbitrationsLost++;
+			g_bus = BUS_FREE;
+			return TWI_ARB_LOST;
+		}
+		if (((data & DEVICE_MASK) != DEVICE_ADDRESS) || (g_removed == TRUE)
+				|| (now < g_writeEnd))
+		{
+			g_hostTwiEepromStats.addressNacks++;
+			g_bus = BUS_NOT_ADDRESSED;
+			return (data & 0x01) ? TWI_MT_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+		}
+		if (data & 0x01)
+		{
+			g_bus = BUS_READ;
+			return TWI_MT_SLA_R_ACK;
+		}
+		/* A10 A9 A8 of the address are bits 3 to 1 of the device address */
+		g_address = (uint16) (data & 0x0E) << 7;
+		g_bus = BUS_WORD_ADDRESS;
+		return TWI_MT_SLA_W_ACK;
+
+	case BUS_WORD_ADDRESS:
+		g_hostTwiEepromStats.bytes++;
+		g_address = (g_address & 0x0700) | data;
+		g_pageBase = g_address & (uint16) ~PAGE_MASK;
+		g_bus = BUS_WRITE_DATA;
+		return TWI_MT_DATA_ACK;
+
+	case BUS_WRITE_DATA:
+		g_hostTwiEepromStats.bytes++;
+		if (g_nackNextData == TRUE)
+		{
+			g_nackNextData = FALSE;
+			return TWI_MT_DATA_NACK;
+		}
+		g_page[g_address & PAGE_MASK] = data;
+		g_loadedMask |= 1U << (g_address & PAGE_MASK);
+		g_loadedBytes++;
+		if (g_loadedBytes == EEPROM_PAGE_SIZE + 1)
+		{
+			g_hostTwiEepromStats.pageWraps++;
+		}
+		/* the address counter rolls over inside the page */
+		g_address = g_pageBase | ((g_address + 1) & PAGE_MASK);
+		return TWI_MT_DATA_ACK;
+
+	case BUS_READ:
+		g_hostTwiEepromStats.bytes++;
+		host_TWDR.Byte = g_hostTwiEeprom[g_address];
+		/* the address counter rolls over at the end of the memory */
+		g_address = (g_address + 1) & (EEPROM_SIZE - 1);
+		return (control & TWCR_TWEA) ? TWI_MR_DATA_ACK : TWI_MR_DATA_NACK;
+
+	default:
+		/* nobody answers the byte */
+		return TWI_MT_DATA_NACK;
+	}
+}
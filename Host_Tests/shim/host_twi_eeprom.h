@@ -0,0 +1,111 @@
+/*
+ ============================================================================
+ File Name   : host_twi_eeprom.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Model of the TWI bus and a 24C16 EEPROM behind the TWI registers
+ ============================================================================
+ */
+
+#ifndef HOST_TWI_EEPROM_H_
+#define HOST_TWI_EEPROM_H_
+
+#include "HAL/EXTERNAL_EEPROM/external_eeprom.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * The model watches TWCR like the TWI hardware. The driver writes TWCR as a
+ * whole byte with TWINT = 1 to start an action, the model runs it for its bus
+ * time then sets TWINT and the status in TWSR. The model also sets TWWC when
+ * it takes an action and keeps it set with TWINT, so a TWINT = 1 written by
+ * the driver (TWWC = 0) is told from the flag set by the model.
+ *
+ * The bus times are counted in SCL periods of TWBR and the prescaler: one for
+ * START or STOP and nine for a byte with its ACK. The 24C16 answers at
+ * 1010 A10 A9 A8 R/W, loads up to one page of 16 bytes and programs it after
+ * the STOP in its write cycle, it NACKs its address until the cycle ends.
+ */
+
+/* Write cycle of the 24C16 in microseconds (5 ms maximum in the data sheet) */
+#define HOST_TWI_EEPROM_WRITE_CYCLE_US		5000
+
+/* Counters of the bus since the reset */
+typedef struct
+{
+	uint32 starts; /* START and REPEATED START conditions */
+	uint32 addressNacks; /* addresses NACKed by the 24C16 (ACK polling) */
+	uint32 bytes; /* bytes sent or received after the address */
+	uint32 writeCycles; /* page programs */
+	uint32 pageWraps; /* page loads of more than one page, the start of the page was overwritten */
+	uint32 arbitrationsLost;
+	uint32 interrupts; /* TWI_vect calls */
+	uint32 isrBlocks; /* basic blocks run in TWI_vect, see host_blocks.h */
+} HOST_TwiEepromStatsType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* The memory of the 24C16 */
+extern uint8 g_hostTwiEeprom[EEPROM_SIZE];
+
+/* Number of the write cycles of each page */
+extern uint32 g_hostTwiEepromPageWrites[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+
+extern HOST_TwiEepromStatsType g_hostTwiEepromStats;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Erase the memory to 0xFF, free the bus, reset the TWI registers, clear the
+ * counters and the faults, and set the write cycle time in microseconds.
+ */
+void HOST_twiEepromReset(uint32 writeCycleUs);
+
+/*
+ * Description :
+ * Step the bus and the 24C16 to the time in AVR cycles, then take the TWI
+ * interrupt if TWINT is set by the model, TWIE is set and the I-bit is set.
+ * The ISR runs with the I-bit cleared like on the AVR.
+ */
+void HOST_twiEepromStep(uint64 now);
+
+/*
+ * Description :
+ * Return the end time of the running action on the bus, or HOST_NO_EVENT.
+ */
+uint64 HOST_twiEepromNextEvent(void);
+
+/*
+ * Description :
+ * Make the 24C16 NACK its address or not, like an EEPROM which is not connected.
+ */
+void HOST_twiEepromRemove(uint8 removed);
+
+/*
+ * Description :
+ * Lose the arbitration to another master in the address byte of the next
+ * transactions, the bus is released like the TWI hardware does.
+ */
+void HOST_twiEepromLoseArbitration(uint8 times);
+
+/*
+ * Description :
+ * NACK the next data byte which is written to the 24C16.
+ */
+void HOST_twiEepromNackNextData(void);
+
+/*
+ * Description :
+ * Return TRUE if the 24C16 is in its write cycle at the time.
+ */
+uint8 HOST_twiEepromIsWriting(uint64 now);
+
+#endif /* HOST_TWI_EEPROM_H_ */
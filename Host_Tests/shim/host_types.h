@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ File Name   : host_types.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Standard types of the ECUs with their AVR sizes on the host
+ ============================================================================
+ */
+
+/*
+ * It is included before any source by the Makefile, it takes the include guard
+ * of LIB/std_types.h so the same names are used with the sizes they have on the
+ * AVR (long is 64 bits on the host, but uint32 must stay 32 bits).
+ */
+#ifndef STD_TYPES_H_
+#define STD_TYPES_H_
+
+#include <stdint.h>
+
+/* Boolean Data Type */
+typedef unsigned char boolean;
+
+/* Boolean Values */
+#ifndef FALSE
+#define FALSE       (0u)
+#endif
+#ifndef TRUE
+#define TRUE        (1u)
+#endif
+
+#define LOGIC_HIGH        (1u)
+#define LOGIC_LOW         (0u)
+
+#define NULL_PTR    ((void*)0)
+
+typedef uint8_t uint8;
+typedef int8_t sint8;
+typedef uint16_t uint16;
+typedef int16_t sint16;
+typedef uint32_t uint32;
+typedef int32_t sint32;
+typedef uint64_t uint64;
+typedef int64_t sint64;
+typedef float float32;
+typedef double float64;
+
+#endif /* STD_TYPES_H_ */
@@ -0,0 +1,23 @@
+/*
+ ============================================================================
+ File Name   : stdlib.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host addition to the C library header, the avr-libc itoa
+ ============================================================================
+ */
+
+#ifndef HOST_STDLIB_H_
+#define HOST_STDLIB_H_
+
+#include_next <stdlib.h>
+
+/*
+ * Description :
+ * Convert the value to a string in the radix like avr-libc, the value is
+ * taken as the 16-bit int of the AVR.
+ */
+char *itoa(int value, char *string, int radix);
+
+#endif /* HOST_STDLIB_H_ */
@@ -0,0 +1,47 @@
+/*
+ ============================================================================
+ File Name   : delay.h
+ Author      : Ahmed Ali
+ Module      : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host replacement of the avr-libc busy wait header
+ ============================================================================
+ */
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#ifdef HOST_DELAY_CLOCK
+
+/*
+ * The ECUs of the simulation wait on the virtual clock, the devices are
+ * stepped and the ISRs run during the wait like on the AVR.
+ */
+#include "host_blocks.h"
+
+static inline void _delay_ms(double ms)
+{
+	HOST_run((uint32) (ms * (F_CPU / 1000UL)));
+}
+
+static inline void _delay_us(double us)
+{
+	HOST_run((uint32) (us * HOST_CYCLES_PER_US));
+}
+
+#else
+
+/* The tests don't wait, the time is given by their stubs of the TIMER1 service */
+static inline void _delay_ms(double ms)
+{
+	(void) ms;
+}
+
+static inline void _delay_us(double us)
+{
+	(void) us;
+}
+
+#endif /* HOST_DELAY_CLOCK */
+
+#endif /* HOST_UTIL_DELAY_H_ */
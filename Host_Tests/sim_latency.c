@@ -0,0 +1,473 @@
+/*
+ ============================================================================
+ Name        : sim_latency.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Latency of the keypad to the LCD and the motor in the simulation of both ECUs
+ ============================================================================
+ */
+
+/*
+ * Usage: sim_latency [first seed] [runs]
+ *
+ * Each run is one seed, the unlock and the lockout scenarios run in their own
+ * process since a simulation starts with the power on of both boards. The
+ * keys are typed with random hold and gap times from the seed, and the
+ * Control ECU powers on at a random phase of the HMI ECU (see host_sim.h).
+ * The latencies are from the press of the key on the virtual clock:
+ *   key -> LCD echo         a digit of a password to the write of its '*'
+ *   unlock # -> motor       the enter key of the correct password to the motor turning
+ *   unlock # -> LCD         the enter key to the "Door is Unlocking" screen
+ *   lockout # -> buzzer     the enter key of the third wrong password to the buzzer
+ *   lockout # -> LCD        the enter key to the "LOCKED OUT" screen
+ * After the door cycle the unlock scenario also reads the worst event dispatch
+ * latency of the scheduler of Control ECU since its power on, from the
+ * diagnostics of the admin menu (GET_DISPATCH_LATENCY, TIMER1 microseconds):
+ *   worst dispatch          one sample a run, in the same table
+ * The program fails if a scenario doesn't reach its screen.
+ */
+
+#include "shim/host_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define DEFAULT_SEED				1
+#define DEFAULT_RUNS				8
+
+#define CYCLES_PER_MS				(F_CPU / 1000UL)
+#define CYCLES_PER_US				(F_CPU / 1000000UL)
+
+/* The LCD and the motor are checked at this period, less than one LCD write */
+#define STEP_CYCLES					200
+
+/* The times of a key typed by the user, the random part is added to the minimum */
+#define KEY_HOLD_MIN_MS				60
+#define KEY_HOLD_RANDOM_MS			60
+#define KEY_GAP_MIN_MS				60
+#define KEY_GAP_RANDOM_MS			140
+
+/* The time for the rest of a screen to be written after its first text */
+#define SCREEN_SETTLE_MS			50
+
+/* The longest wait of a screen */
+#define SCREEN_WAIT_MS				2000
+
+/* The longest wait of the door unlocking, holding and locking */
+#define DOOR_CYCLE_WAIT_MS			40000
+
+/* The digits and the enter key of a password */
+#define PASSWORD_KEYS				6
+
+/* The samples of one metric in one run */
+#define MAX_SAMPLES					32
+
+typedef enum
+{
+	LATENCY_KEY_ECHO,
+	LATENCY_UNLOCK_MOTOR,
+	LATENCY_UNLOCK_LCD,
+	LATENCY_LOCKOUT_BUZZER,
+	LATENCY_LOCKOUT_LCD,
+	LATENCY_WORST_DISPATCH,
+	NUM_LATENCIES
+} LatencyType;
+
+typedef enum
+{
+	SCENARIO_UNLOCK, SCENARIO_LOCKOUT, NUM_SCENARIOS
+} ScenarioType;
+
+/* The samples of one scenario in microseconds, sent by its process */
+typedef struct
+{
+	uint8 completed;
+	uint8 count[NUM_LATENCIES];
+	uint32 us[NUM_LATENCIES][MAX_SAMPLES];
+} ResultType;
+
+/* The password being typed and the press times of its keys */
+typedef struct
+{
+	uint8 keys[PASSWORD_KEYS];
+	uint64 press[PASSWORD_KEYS];
+	uint8 echoed; /* the keys before it are echoed or they are not digits */
+} TypingType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const char *const g_names[NUM_LATENCIES] =
+{
+	"key -> LCD echo",
+	"unlock # -> motor",
+	"unlock # -> LCD",
+	"lockout # -> buzzer",
+	"lockout # -> LCD",
+	"worst dispatch"
+};
+
+static const HOST_HmiBoardType *const g_hmi = &g_hostHmiBoard;
+static const HOST_ControlBoardType *const g_control = &g_hostControlBoard;
+
+static ResultType g_result;
+static TypingType g_typing;
+
+/* The release time of the last key in the queue, a new key is pressed after it */
+static uint64 g_keysEnd;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Keep one sample of the metric in microseconds.
+ */
+static void addSample(LatencyType latency, uint64 cycles)
+{
+	if (g_result.count[latency] < MAX_SAMPLES)
+	{
+		g_result.us[latency][g_result.count[latency]] = (uint32) (cycles / CYCLES_PER_US);
+		g_result.count[latency]++;
+	}
+}
+
+/*
+ * Description :
+ * Run one step and take the echo of the typed digit if it is written.
+ */
+static void step(void)
+{
+	uint8 *next = &g_typing.echoed;
+
+	HOST_simRun(STEP_CYCLES);
+	/* the enter key is not echoed */
+	while ((*next < PASSWORD_KEYS) && (g_typing.keys[*next] > 9))
+	{
+		(*next)++;
+	}
+	if ((*next < PASSWORD_KEYS) && (HOST_simNow() >= g_typing.press[*next])
+			&& (g_hmi->lcd->lastWrite > g_typing.press[*next]))
+	{
+		addSample(LATENCY_KEY_ECHO, g_hmi->lcd->lastWrite - g_typing.press[*next]);
+		(*next)++;
+	}
+}
+
+/*
+ * Description :
+ * Put the keys of the password in the queue of the simulation with random
+ * times, like a user types them. Return the press time of the enter key.
+ */
+static uint64 typePassword(const char *digits)
+{
+	uint64 time = (g_keysEnd > HOST_simNow()) ? g_keysEnd : HOST_simNow();
+	uint8 i;
+
+	for (i = 0; i < PASSWORD_KEYS; i++)
+	{
+		g_typing.keys[i] = (i < (PASSWORD_KEYS - 1)) ? (uint8) (digits[i] - '0') : '#';
+		time += (KEY_GAP_MIN_MS + HOST_simRandom(KEY_GAP_RANDOM_MS)) * CYCLES_PER_MS;
+		g_typing.press[i] = time;
+		HOST_simSchedule(time, g_hmi->setKey, g_typing.keys[i]);
+		time += (KEY_HOLD_MIN_MS + HOST_simRandom(KEY_HOLD_RANDOM_MS)) * CYCLES_PER_MS;
+		HOST_simSchedule(time, g_hmi->setKey, HOST_NO_KEY);
+	}
+	g_keysEnd = time;
+	g_typing.echoed = 0;
+	return g_typing.press[PASSWORD_KEYS - 1];
+}
+
+/*
+ * Description :
+ * Press and release one key which is not a password.
+ */
+static void pressKey(uint8 key)
+{
+	uint64 time = (g_keysEnd > HOST_simNow()) ? g_keysEnd : HOST_simNow();
+
+	time += KEY_GAP_MIN_MS * CYCLES_PER_MS;
+	HOST_simSchedule(time, g_hmi->setKey, key);
+	g_keysEnd = time + (KEY_HOLD_MIN_MS * CYCLES_PER_MS);
+	HOST_simSchedule(g_keysEnd, g_hmi->setKey, HOST_NO_KEY);
+}
+
+/*
+ * Description :
+ * Run for the time.
+ */
+static void runFor(uint32 ms)
+{
+	uint64 end = HOST_simNow() + ((uint64) ms * CYCLES_PER_MS);
+
+	while (HOST_simNow() < end)
+	{
+		step();
+	}
+}
+
+/*
+ * Description :
+ * Run until the row of the LCD has the text or the time ends.
+ * Return TRUE if the text is shown.
+ */
+static uint8 waitLcd(uint8 row, const char *text, uint32 ms)
+{
+	uint64 end = HOST_simNow() + ((uint64) ms * CYCLES_PER_MS);
+
+	while (strstr(g_hmi->lcd->text[row], text) == NULL_PTR)
+	{
+		if (HOST_simNow() >= end)
+		{
+			return FALSE;
+		}
+		step();
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Run until the password is typed, then until the row of the LCD has the text.
+ */
+static uint8 typeAndWait(const char *digits, uint8 row, const char *text)
+{
+	uint64 end = typePassword(digits);
+
+	while (HOST_simNow() <= end)
+	{
+		step();
+	}
+	return waitLcd(row, text, SCREEN_WAIT_MS);
+}
+
+/*
+ * Description :
+ * The boot and the creation of the admin password, up to the main menu.
+ */
+static uint8 createPassword(void)
+{
+	return waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS)
+			&& typeAndWait("12345", 0, "plz re-enter the")
+			&& typeAndWait("12345", 0, "+ : Open Door");
+}
+
+/*
+ * Description :
+ * Wait for the end of the door cycle, then read the worst dispatch latency of
+ * Control ECU from the first diagnostics screen of the admin menu.
+ */
+static uint8 readDispatchLatency(void)
+{
+	const char *value;
+
+	if (waitLcd(0, "+ : Open Door", DOOR_CYCLE_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	pressKey('#');
+	if ((waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == FALSE)
+			|| (typeAndWait("12345", 0, "1:Add  2:Revoke") == FALSE))
+	{
+		return FALSE;
+	}
+	pressKey(3);
+	if (waitLcd(1, "Dispatch us ", SCREEN_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	runFor(SCREEN_SETTLE_MS);
+	value = strstr(g_hmi->lcd->text[1], "Dispatch us ") + strlen("Dispatch us ");
+	addSample(LATENCY_WORST_DISPATCH, strtoul(value, NULL, 10) * CYCLES_PER_US);
+	return TRUE;
+}
+
+/*
+ * Description :
+ * The correct password opens the door.
+ */
+static uint8 unlockScenario(void)
+{
+	uint64 enter;
+
+	pressKey('+');
+	if (waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	enter = typePassword("12345");
+	while (g_control->motor->direction != HOST_MOTOR_CLOCK_WISE)
+	{
+		if (HOST_simNow() >= (enter + (SCREEN_WAIT_MS * CYCLES_PER_MS)))
+		{
+			return FALSE;
+		}
+		step();
+	}
+	addSample(LATENCY_UNLOCK_MOTOR, g_control->motor->lastChange - enter);
+	if (waitLcd(1, "Unlocking", SCREEN_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	addSample(LATENCY_UNLOCK_LCD, HOST_simNow() - enter);
+	return readDispatchLatency();
+}
+
+/*
+ * Description :
+ * Three wrong passwords start the lockout. They are different since the same
+ * request in REQUEST_REPEAT_PERIOD_MS of Control_ECU.c is a retry of HMI ECU.
+ */
+static uint8 lockoutScenario(void)
+{
+	static const char *const wrongPasswords[] = { "54321", "54322" };
+	uint64 enter;
+	uint8 i;
+
+	pressKey('+');
+	for (i = 0; i < 2; i++)
+	{
+		if ((waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == FALSE)
+				|| (typeAndWait(wrongPasswords[i], 0, "Wrong Password") == FALSE))
+		{
+			return FALSE;
+		}
+	}
+	if (waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	enter = typePassword("54323");
+	while (g_control->buzzer->on == FALSE)
+	{
+		if (HOST_simNow() >= (enter + (SCREEN_WAIT_MS * CYCLES_PER_MS)))
+		{
+			return FALSE;
+		}
+		step();
+	}
+	addSample(LATENCY_LOCKOUT_BUZZER, g_control->buzzer->lastChange - enter);
+	if (waitLcd(0, "LOCKED OUT", SCREEN_WAIT_MS) == FALSE)
+	{
+		return FALSE;
+	}
+	addSample(LATENCY_LOCKOUT_LCD, HOST_simNow() - enter);
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Run the scenario with the seed in a new process and take its samples.
+ * Return FALSE if the process failed.
+ */
+static uint8 runScenario(ScenarioType scenario, uint32 seed, ResultType *a_result)
+{
+	int pipeFds[2];
+	int status;
+	pid_t pid;
+
+	if (pipe(pipeFds) != 0)
+	{
+		return FALSE;
+	}
+	pid = fork();
+	if (pid == 0)
+	{
+		close(pipeFds[0]);
+		memset(&g_result, 0, sizeof(g_result));
+		g_typing.echoed = PASSWORD_KEYS;
+		g_keysEnd = 0;
+		HOST_simInit(seed);
+		g_result.completed = createPassword() && ((scenario == SCENARIO_UNLOCK) ?
+				unlockScenario() : lockoutScenario());
+		if (write(pipeFds[1], &g_result, sizeof(g_result)) != sizeof(g_result))
+		{
+			_exit(1);
+		}
+		_exit(0);
+	}
+	close(pipeFds[1]);
+	memset(a_result, 0, sizeof(*a_result));
+	if ((pid < 0) || (read(pipeFds[0], a_result, sizeof(*a_result)) != sizeof(*a_result)))
+	{
+		a_result->completed = FALSE;
+	}
+	close(pipeFds[0]);
+	if (pid > 0)
+	{
+		waitpid(pid, &status, 0);
+	}
+	return a_result->completed;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32 seed = (argc > 1) ? (uint32) strtoul(argv[1], NULL, 0) : DEFAULT_SEED;
+	uint32 runs = (argc > 2) ? (uint32) strtoul(argv[2], NULL, 0) : DEFAULT_RUNS;
+	uint32 min[NUM_LATENCIES], max[NUM_LATENCIES], samples[NUM_LATENCIES];
+	uint64 sum[NUM_LATENCIES];
+	ResultType result;
+	uint32 run, failed = 0;
+	uint8 scenario, latency, i;
+
+	for (latency = 0; latency < NUM_LATENCIES; latency++)
+	{
+		min[latency] = 0xFFFFFFFF;
+		max[latency] = 0;
+		sum[latency] = 0;
+		samples[latency] = 0;
+	}
+	for (run = 0; run < runs; run++)
+	{
+		for (scenario = 0; scenario < NUM_SCENARIOS; scenario++)
+		{
+			if (runScenario(scenario, seed + run, &result) == FALSE)
+			{
+				printf("seed %lu: the %s scenario failed\n", (unsigned long) (seed + run),
+						(scenario == SCENARIO_UNLOCK) ? "unlock" : "lockout");
+				failed++;
+			}
+			for (latency = 0; latency < NUM_LATENCIES; latency++)
+			{
+				for (i = 0; i < result.count[latency]; i++)
+				{
+					if (result.us[latency][i] < min[latency])
+					{
+						min[latency] = result.us[latency][i];
+					}
+					if (result.us[latency][i] > max[latency])
+					{
+						max[latency] = result.us[latency][i];
+					}
+					sum[latency] += result.us[latency][i];
+					samples[latency]++;
+				}
+			}
+		}
+	}
+
+	printf("%lu runs from the seed %lu, milliseconds from the key press\n",
+			(unsigned long) runs, (unsigned long) seed);
+	printf("%-22s %8s %9s %9s %9s\n", "", "samples", "min", "avg", "max");
+	for (latency = 0; latency < NUM_LATENCIES; latency++)
+	{
+		if (samples[latency] == 0)
+		{
+			printf("%-22s %8u %9s %9s %9s\n", g_names[latency], 0, "-", "-", "-");
+			continue;
+		}
+		printf("%-22s %8lu %9.3f %9.3f %9.3f\n", g_names[latency],
+				(unsigned long) samples[latency], min[latency] / 1000.0,
+				(double) sum[latency] / samples[latency] / 1000.0, max[latency] / 1000.0);
+	}
+	return (failed == 0) ? 0 : 1;
+}
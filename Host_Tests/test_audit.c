@@ -0,0 +1,173 @@
+/*
+ ============================================================================
+ Name        : test_audit.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the audit event log flushes and its scan
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_eeprom.h"
+#include "SERVICE/AUDIT/audit.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define EVENT_TYPE			0x21
+
+/* Byte offsets inside the event, as in audit.c */
+#define COUNTER_INDEX		1
+#define CHECKSUM_INDEX		(AUDIT_EVENT_SIZE - 1)
+
+#define PAGE_ADDRESS(page) \
+	((uint16) ((AUDIT_EEPROM_FIRST_PAGE + (page)) * EEPROM_PAGE_SIZE))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The uptime of the TIMER1 stub in milliseconds */
+static uint32 g_ticks = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The uptime of the TIMER1 service, driven by the test.
+ */
+uint32 Timer1_getTicks(void)
+{
+	return g_ticks;
+}
+
+/*
+ * Description :
+ * The checksum of the event in audit.c, to write the events of an older log.
+ */
+static uint8 checksum(const uint8 event[])
+{
+	uint8 i, sum = 0x5A;
+	for (i = 0; i < CHECKSUM_INDEX; i++)
+	{
+		sum = (uint8) ((sum << 1) | (sum >> 7)) ^ event[i];
+	}
+	return sum;
+}
+
+/*
+ * Description :
+ * The counter of the event in the slot of the page of the log, or -1 if the
+ * slot has no valid event.
+ */
+static sint32 counterAt(uint8 page, uint8 slot)
+{
+	const uint8 *event = &g_hostEeprom[PAGE_ADDRESS(page) + slot * AUDIT_EVENT_SIZE];
+
+	if ((event[0] == AUDIT_EMPTY_TYPE) || (event[CHECKSUM_INDEX] != checksum(event)))
+	{
+		return -1;
+	}
+	return ((sint32) event[COUNTER_INDEX] << 8) | event[COUNTER_INDEX + 1];
+}
+
+/*
+ * Description :
+ * Poll the log until no more pages are written at this time.
+ */
+static void flush(void)
+{
+	uint8 i;
+	for (i = 0; i < AUDIT_RING_SIZE; i++)
+	{
+		AUDIT_poll();
+	}
+}
+
+/*
+ * Description :
+ * The full pages are written at once, a part of a page after its oldest event
+ * waited AUDIT_FLUSH_PERIOD_MS, and a scan continues the log after them.
+ */
+static void testFlushAndScan(void)
+{
+	uint8 i;
+
+	HOST_eepromReset();
+	HOST_CHECK(AUDIT_init() == SUCCESS);
+	HOST_CHECK(AUDIT_isReady() == TRUE);
+	for (i = 0; i < 5; i++)
+	{
+		AUDIT_log(EVENT_TYPE);
+	}
+	flush();
+	HOST_CHECK((counterAt(0, 0) == 0) && (counterAt(1, 1) == 3));
+	HOST_CHECK(counterAt(2, 0) == -1);
+
+	g_ticks += AUDIT_FLUSH_PERIOD_MS;
+	flush();
+	HOST_CHECK((counterAt(2, 0) == 4) && (counterAt(2, 1) == -1));
+
+	/* the reset */
+	HOST_CHECK(AUDIT_init() == SUCCESS);
+	AUDIT_log(EVENT_TYPE);
+	g_ticks += AUDIT_FLUSH_PERIOD_MS;
+	flush();
+	HOST_CHECK(counterAt(3, 0) == 5);
+}
+
+/*
+ * Description :
+ * A scan cut in its middle writes no page, so the newest events in the
+ * EEPROM are not overwritten. The events logged meanwhile wait in the RAM
+ * ring, and the next complete scan numbers them after the newest event and
+ * writes them after its page.
+ */
+static void testScanCut(void)
+{
+	uint8 *event = &g_hostEeprom[PAGE_ADDRESS(10)];
+	uint32 pageWrites[EEPROM_SIZE / EEPROM_PAGE_SIZE];
+
+	/* a newer event of the log before the reset */
+	memset(event, 0, AUDIT_EVENT_SIZE);
+	event[0] = EVENT_TYPE;
+	event[COUNTER_INDEX] = 0x01;
+	event[COUNTER_INDEX + 1] = 0x2C;
+	event[CHECKSUM_INDEX] = checksum(event);
+
+	HOST_eepromFailOneRead(AUDIT_EEPROM_NUM_PAGES / 2);
+	HOST_CHECK(AUDIT_init() == ERROR);
+	HOST_CHECK(AUDIT_isReady() == FALSE);
+
+	AUDIT_log(EVENT_TYPE);
+	AUDIT_log(EVENT_TYPE);
+	AUDIT_log(EVENT_TYPE);
+	memcpy(pageWrites, g_hostEepromPageWrites, sizeof(pageWrites));
+	g_ticks += AUDIT_FLUSH_PERIOD_MS;
+	flush();
+	HOST_CHECK(memcmp(pageWrites, g_hostEepromPageWrites, sizeof(pageWrites)) == 0);
+
+	HOST_CHECK(AUDIT_init() == SUCCESS);
+	HOST_CHECK(AUDIT_isReady() == TRUE);
+	flush();
+	HOST_CHECK(counterAt(10, 0) == 300);
+	HOST_CHECK((counterAt(11, 0) == 301) && (counterAt(11, 1) == 302));
+	g_ticks += AUDIT_FLUSH_PERIOD_MS;
+	flush();
+	HOST_CHECK((counterAt(12, 0) == 303) && (counterAt(12, 1) == -1));
+	HOST_CHECK(counterAt(3, 0) == 5);
+}
+
+int main(void)
+{
+	testFlushAndScan();
+	testScanCut();
+	return HOST_TEST_END();
+}
@@ -0,0 +1,350 @@
+/*
+ ============================================================================
+ Name        : test_credential.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the credential table in the record store with power cuts
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_eeprom.h"
+#include "SERVICE/CREDENTIAL/credential.h"
+#include "MCAL/TIMER1/timer1_service.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define REWRITE_SAVES			600
+#define REVOKED_SLOT			5
+#define CUT_SLOT				2
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+static uint8 g_lastResult;
+
+static const uint8 g_tagKey[HASH_KEY_LENGTH] = CREDENTIAL_TAG_KEY;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The TIMER1 service of the test, the source of the salts.
+ */
+uint32 Timer1_getMicros(void)
+{
+	static uint32 micros = 0;
+
+	micros += 1234;
+	return micros;
+}
+
+/*
+ * Description :
+ * The call back of the writes, it keeps the result.
+ */
+static void writeDone(uint8 result)
+{
+	g_lastResult = result;
+}
+
+/*
+ * Description :
+ * Make the password digits of the number, 5 digits with the leading zeros.
+ */
+static void makePassword(uint8 password[], uint32 number)
+{
+	sint8 i;
+
+	for (i = CREDENTIAL_PASSWORD_LENGTH - 1; i >= 0; i--)
+	{
+		password[i] = (uint8) (number % 10);
+		number /= 10;
+	}
+}
+
+/*
+ * Description :
+ * The password of each slot in the tests.
+ */
+static uint32 slotPassword(uint8 slot)
+{
+	return (slot * 1111UL) + 7;
+}
+
+/*
+ * Description :
+ * Check that the password is the one of the slot.
+ */
+static void checkSlotPassword(uint32 number, uint8 expectedSlot)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot = CREDENTIAL_NO_SLOT;
+
+	makePassword(password, number);
+	HOST_CHECK(CREDENTIAL_check(password, &slot) == TRUE);
+	HOST_CHECK(slot == expectedSlot);
+}
+
+/*
+ * Description :
+ * The reset of the Control ECU, the store is scanned then the tags are loaded.
+ */
+static uint8 reset(void)
+{
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	return CREDENTIAL_init();
+}
+
+/*
+ * Description :
+ * The tag of the password in credential.c.
+ */
+static uint16 tagOf(uint32 number)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 hash[HASH_OUTPUT_32_BITS];
+
+	makePassword(password, number);
+	HASH_halfSipHash(g_tagKey, password, CREDENTIAL_PASSWORD_LENGTH, hash,
+			HASH_OUTPUT_32_BITS);
+	return ((uint16) hash[0] << 8) | hash[1];
+}
+
+/*
+ * Description :
+ * Each slot keeps its password, in RAM and after a reset.
+ */
+static void testSaveAndCheck(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+
+	HOST_eepromReset();
+	HOST_CHECK(reset() == FALSE);
+	HOST_CHECK(CREDENTIAL_isSlotFree(CREDENTIAL_ADMIN_SLOT) == TRUE);
+
+	for (slot = 0; slot < CREDENTIAL_MAX_USERS; slot++)
+	{
+		makePassword(password, slotPassword(slot));
+		HOST_CHECK(CREDENTIAL_save(slot, password, writeDone) == SUCCESS);
+		HOST_CHECK(g_lastResult == SUCCESS);
+	}
+	HOST_CHECK(CREDENTIAL_save(CREDENTIAL_MAX_USERS, password, writeDone) == ERROR);
+	HOST_CHECK(CREDENTIAL_isSlotFree(CREDENTIAL_ADMIN_SLOT) == FALSE);
+	for (slot = 0; slot < CREDENTIAL_MAX_USERS; slot++)
+	{
+		checkSlotPassword(slotPassword(slot), slot);
+	}
+
+	HOST_CHECK(reset() == TRUE);
+	for (slot = 0; slot < CREDENTIAL_MAX_USERS; slot++)
+	{
+		checkSlotPassword(slotPassword(slot), slot);
+	}
+}
+
+/*
+ * Description :
+ * Two users may share a password, the lowest slot is found.
+ */
+static void testSharedPassword(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+
+	makePassword(password, slotPassword(1));
+	HOST_CHECK(CREDENTIAL_save(4, password, writeDone) == SUCCESS);
+	checkSlotPassword(slotPassword(1), 1);
+	makePassword(password, slotPassword(4));
+	HOST_CHECK(CREDENTIAL_save(4, password, writeDone) == SUCCESS);
+	checkSlotPassword(slotPassword(4), 4);
+}
+
+/*
+ * Description :
+ * A different password with the tag of another user is refused, so the
+ * check of each user still finds its slot.
+ */
+static void testTagCollision(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint32 number;
+	uint8 slot, found = FALSE;
+
+	for (number = 0; (number < 100000) && (found == FALSE); number++)
+	{
+		for (slot = 1; slot < CREDENTIAL_MAX_USERS; slot++)
+		{
+			if ((number != slotPassword(slot))
+					&& (tagOf(number) == tagOf(slotPassword(slot))))
+			{
+				found = TRUE;
+				break;
+			}
+		}
+	}
+	HOST_CHECK(found == TRUE);
+	number--;
+
+	/* the slot itself may change its password to one with the same tag */
+	makePassword(password, number);
+	HOST_CHECK(CREDENTIAL_save((slot == 1) ? 2 : 1, password, writeDone) == ERROR);
+	HOST_CHECK(CREDENTIAL_save(slot, password, writeDone) == SUCCESS);
+	checkSlotPassword(number, slot);
+	makePassword(password, slotPassword(slot));
+	HOST_CHECK(CREDENTIAL_save(slot, password, writeDone) == SUCCESS);
+	checkSlotPassword(slotPassword(slot), slot);
+}
+
+/*
+ * Description :
+ * A slot is saved many times while all the slots are used, its record takes
+ * the pages of the store which hold no current record, and the newest one
+ * is taken after a reset.
+ */
+static void testRewrites(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint16 i;
+
+	for (i = 0; i < REWRITE_SAVES; i++)
+	{
+		makePassword(password, (i % 2) ? 12345 : 54321);
+		HOST_CHECK(CREDENTIAL_save(1, password, writeDone) == SUCCESS);
+		HOST_CHECK(g_lastResult == SUCCESS);
+	}
+	HOST_CHECK(reset() == TRUE);
+	checkSlotPassword(12345, 1);
+
+	makePassword(password, slotPassword(1));
+	HOST_CHECK(CREDENTIAL_save(1, password, writeDone) == SUCCESS);
+	HOST_CHECK(reset() == TRUE);
+	checkSlotPassword(slotPassword(1), 1);
+}
+
+/*
+ * Description :
+ * The power is cut after each byte of the page of the new record: after the
+ * reset the slot has its old password, or the new one if the whole page is written.
+ */
+static void testPowerCuts(HOST_EepromCutType cut)
+{
+	uint8 oldPassword[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 newPassword[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+	uint8 bytes;
+
+	makePassword(oldPassword, slotPassword(CUT_SLOT));
+	makePassword(newPassword, 99999);
+	for (bytes = 0; bytes <= EEPROM_PAGE_SIZE; bytes++)
+	{
+		HOST_eepromCutNextWrite(bytes, cut);
+		HOST_CHECK(CREDENTIAL_save(CUT_SLOT, newPassword, writeDone) == SUCCESS);
+		HOST_CHECK(g_lastResult
+				== ((bytes < EEPROM_PAGE_SIZE) ? ERROR : SUCCESS));
+
+		HOST_CHECK(reset() == TRUE);
+		if (bytes < EEPROM_PAGE_SIZE)
+		{
+			checkSlotPassword(slotPassword(CUT_SLOT), CUT_SLOT);
+			HOST_CHECK(CREDENTIAL_check(newPassword, &slot) == FALSE);
+		}
+		else
+		{
+			checkSlotPassword(99999, CUT_SLOT);
+			HOST_CHECK(CREDENTIAL_save(CUT_SLOT, oldPassword, writeDone) == SUCCESS);
+		}
+		checkSlotPassword(slotPassword(3), 3);
+	}
+}
+
+/*
+ * Description :
+ * A revoked user is refused in RAM and after a reset, the admin can't be revoked.
+ */
+static void testRevoke(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+
+	HOST_CHECK(CREDENTIAL_revoke(CREDENTIAL_ADMIN_SLOT, writeDone) == ERROR);
+	HOST_CHECK(CREDENTIAL_revoke(REVOKED_SLOT, writeDone) == SUCCESS);
+	HOST_CHECK(CREDENTIAL_revoke(REVOKED_SLOT, writeDone) == ERROR);
+	HOST_CHECK(CREDENTIAL_isSlotFree(REVOKED_SLOT) == TRUE);
+
+	makePassword(password, slotPassword(REVOKED_SLOT));
+	HOST_CHECK(CREDENTIAL_check(password, &slot) == FALSE);
+	HOST_CHECK(slot == CREDENTIAL_NO_SLOT);
+	HOST_CHECK(reset() == TRUE);
+	HOST_CHECK(CREDENTIAL_check(password, &slot) == FALSE);
+}
+
+/*
+ * Description :
+ * A check of a table which can't be read is CREDENTIAL_UNAVAILABLE, not a
+ * wrong password, and it works again when the EEPROM answers.
+ */
+static void testUnavailable(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+
+	HOST_eepromFailReads(TRUE);
+	CREDENTIAL_init();
+	makePassword(password, slotPassword(CREDENTIAL_ADMIN_SLOT));
+	HOST_CHECK(CREDENTIAL_check(password, &slot) == CREDENTIAL_UNAVAILABLE);
+	HOST_CHECK(CREDENTIAL_isSlotFree(CREDENTIAL_ADMIN_SLOT) == FALSE);
+	HOST_CHECK(CREDENTIAL_save(1, password, writeDone) == ERROR);
+
+	HOST_eepromFailReads(FALSE);
+	checkSlotPassword(slotPassword(CREDENTIAL_ADMIN_SLOT), CREDENTIAL_ADMIN_SLOT);
+}
+
+/*
+ * Description :
+ * No other password of the 100000 is taken for a user.
+ */
+static void testAllPasswords(void)
+{
+	uint8 password[CREDENTIAL_PASSWORD_LENGTH];
+	uint8 slot;
+	uint8 result;
+	uint32 number;
+	uint8 expected;
+
+	for (number = 0; number < 100000; number++)
+	{
+		makePassword(password, number);
+		result = CREDENTIAL_check(password, &slot);
+		expected = (number >= 7) && (((number - 7) % 1111) == 0)
+				&& (((number - 7) / 1111) < CREDENTIAL_MAX_USERS)
+				&& (((number - 7) / 1111) != REVOKED_SLOT);
+		HOST_CHECK(result == expected);
+		if ((result == TRUE) && (expected == TRUE))
+		{
+			HOST_CHECK(slot == (number - 7) / 1111);
+		}
+	}
+}
+
+int main(void)
+{
+	testSaveAndCheck();
+	testSharedPassword();
+	testTagCollision();
+	testRewrites();
+	testPowerCuts(HOST_EEPROM_KEEP_OLD);
+	testPowerCuts(HOST_EEPROM_ERASED);
+	testRevoke();
+	testUnavailable();
+	testAllPasswords();
+	return HOST_TEST_END();
+}
@@ -0,0 +1,264 @@
+/*
+ ============================================================================
+ Name        : test_eeprom_store.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the EEPROM record store with power cuts
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_eeprom.h"
+#include "HAL/EXTERNAL_EEPROM/eeprom_store.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define KEY_PASSWORD		0
+#define KEY_OTHER			3
+#define WEAR_WRITES			100000UL
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+static uint8 g_lastResult;
+static uint8 g_results;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The call back of the writes, it keeps the result.
+ */
+static void writeDone(uint8 result)
+{
+	g_lastResult = result;
+	g_results++;
+}
+
+/*
+ * Description :
+ * Check that the current record of the key has the required payload.
+ */
+static void checkRecord(uint8 key, const uint8 *expected, uint8 expectedLength)
+{
+	uint8 data[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 length = 0;
+
+	HOST_CHECK(EEPROM_storeRead(key, data, &length) == SUCCESS);
+	HOST_CHECK(length == expectedLength);
+	HOST_CHECK(memcmp(data, expected, expectedLength) == 0);
+}
+
+/*
+ * Description :
+ * An empty store has no records, written records are read back after a reset.
+ */
+static void testReadBack(void)
+{
+	uint8 data[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 length;
+	uint8 key;
+
+	HOST_eepromReset();
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	for (key = 0; key < EEPROM_STORE_MAX_KEYS; key++)
+	{
+		HOST_CHECK(EEPROM_storeRead(key, data, &length) == ERROR);
+	}
+	HOST_CHECK(EEPROM_storeRead(EEPROM_STORE_MAX_KEYS, data, &length) == ERROR);
+
+	g_results = 0;
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_OTHER, (const uint8 *) "abc", 3,
+			writeDone) == SUCCESS);
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, (const uint8 *) "12345", 5,
+			writeDone) == SUCCESS);
+	HOST_CHECK((g_results == 2) && (g_lastResult == SUCCESS));
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, data,
+			EEPROM_STORE_MAX_PAYLOAD + 1, writeDone) == ERROR);
+	checkRecord(KEY_OTHER, (const uint8 *) "abc", 3);
+	checkRecord(KEY_PASSWORD, (const uint8 *) "12345", 5);
+
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	checkRecord(KEY_OTHER, (const uint8 *) "abc", 3);
+	checkRecord(KEY_PASSWORD, (const uint8 *) "12345", 5);
+}
+
+/*
+ * Description :
+ * The writes of a key are spread over the pages of the store which don't hold
+ * a current record, and the store is correct after resets between them.
+ * The store is full like in the Control ECU: each user slot has a record
+ * which is not written again, so the writes of the key are spread over the
+ * pages left by the current records.
+ */
+static void testWearLeveling(void)
+{
+	uint8 value[5];
+	uint32 i;
+	uint32 minWrites = 0xFFFFFFFF, maxWrites = 0;
+	uint8 page, key;
+	uint8 coldPages = 0, hotPages = 0;
+
+	HOST_eepromReset();
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_OTHER, (const uint8 *) "abc", 3,
+			writeDone) == SUCCESS);
+	for (key = EEPROM_STORE_SERVICE_KEYS; key < EEPROM_STORE_MAX_KEYS; key++)
+	{
+		HOST_CHECK(EEPROM_storeWriteAsync(key, &key, 1, writeDone) == SUCCESS);
+	}
+
+	for (i = 0; i < WEAR_WRITES; i++)
+	{
+		memset(value, (uint8) i, sizeof(value));
+		HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, value, sizeof(value),
+				writeDone) == SUCCESS);
+		if ((i % 1000) == 0)
+		{
+			HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+		}
+	}
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	checkRecord(KEY_PASSWORD, value, sizeof(value));
+	checkRecord(KEY_OTHER, (const uint8 *) "abc", 3);
+	for (key = EEPROM_STORE_SERVICE_KEYS; key < EEPROM_STORE_MAX_KEYS; key++)
+	{
+		checkRecord(key, &key, 1);
+	}
+
+	printf("writes of each page after %lu writes of one key:", WEAR_WRITES);
+	for (page = 0; page < EEPROM_SIZE / EEPROM_PAGE_SIZE; page++)
+	{
+		if ((page < EEPROM_STORE_FIRST_PAGE)
+				|| (page >= EEPROM_STORE_FIRST_PAGE + EEPROM_STORE_NUM_PAGES))
+		{
+			HOST_CHECK(g_hostEepromPageWrites[page] == 0);
+			continue;
+		}
+		if (((page - EEPROM_STORE_FIRST_PAGE) % 10) == 0)
+		{
+			printf("\n  page %2u:", page);
+		}
+		printf(" %5lu", (unsigned long) g_hostEepromPageWrites[page]);
+		if (g_hostEepromPageWrites[page] == 1)
+		{
+			/* the pages of the records of the other keys are never written again */
+			coldPages++;
+		}
+		else
+		{
+			hotPages++;
+			if (g_hostEepromPageWrites[page] < minWrites)
+			{
+				minWrites = g_hostEepromPageWrites[page];
+			}
+			if (g_hostEepromPageWrites[page] > maxWrites)
+			{
+				maxWrites = g_hostEepromPageWrites[page];
+			}
+		}
+	}
+	printf("\n  %u pages of current records written once, %u pages take the writes:"
+			" %lu to %lu writes\n", coldPages, hotPages,
+			(unsigned long) minWrites, (unsigned long) maxWrites);
+	HOST_CHECK(coldPages == EEPROM_STORE_MAX_KEYS - EEPROM_STORE_SERVICE_KEYS + 1);
+	HOST_CHECK(hotPages == EEPROM_STORE_NUM_PAGES - coldPages);
+	HOST_CHECK((maxWrites - minWrites) <= 2);
+}
+
+/*
+ * Description :
+ * The power is cut after each byte of a page write: after the reset the key
+ * has its old record, or its new one if the whole page is written, the other
+ * keys are not touched and the next write works.
+ */
+static void testPowerCuts(HOST_EepromCutType cut)
+{
+	const uint8 oldValue[5] = { 1, 2, 3, 4, 5 };
+	const uint8 newValue[5] = { 9, 8, 7, 6, 5 };
+	uint8 bytes;
+
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, oldValue, sizeof(oldValue),
+			writeDone) == SUCCESS);
+	for (bytes = 0; bytes <= EEPROM_PAGE_SIZE; bytes++)
+	{
+		HOST_eepromCutNextWrite(bytes, cut);
+		HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, newValue,
+				sizeof(newValue), writeDone) == SUCCESS);
+		HOST_CHECK(g_lastResult == ((bytes < EEPROM_PAGE_SIZE) ? ERROR : SUCCESS));
+
+		/* the reset */
+		HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+		if (bytes < EEPROM_PAGE_SIZE)
+		{
+			checkRecord(KEY_PASSWORD, oldValue, sizeof(oldValue));
+		}
+		else
+		{
+			checkRecord(KEY_PASSWORD, newValue, sizeof(newValue));
+		}
+		checkRecord(KEY_OTHER, (const uint8 *) "abc", 3);
+
+		/* the log goes on after the cut record */
+		HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, oldValue,
+				sizeof(oldValue), writeDone) == SUCCESS);
+		HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+		checkRecord(KEY_PASSWORD, oldValue, sizeof(oldValue));
+	}
+}
+
+/*
+ * Description :
+ * A failed read of the scan is reported, and a scan cut in its middle leaves
+ * the store closed: no record is read from the half built index and no record
+ * is written with a sequence which may be lower than the records in the
+ * EEPROM. The next complete scan opens it again.
+ */
+static void testReadFailure(void)
+{
+	const uint8 value[5] = { 5, 4, 3, 2, 1 };
+	uint8 data[EEPROM_STORE_MAX_PAYLOAD];
+	uint8 length;
+
+	HOST_eepromFailReads(TRUE);
+	HOST_CHECK(EEPROM_storeInit() == ERROR);
+	HOST_eepromFailReads(FALSE);
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	HOST_CHECK(EEPROM_storeIsReady() == TRUE);
+
+	HOST_eepromFailOneRead(EEPROM_STORE_NUM_PAGES / 2);
+	HOST_CHECK(EEPROM_storeInit() == ERROR);
+	HOST_CHECK(EEPROM_storeIsReady() == FALSE);
+	HOST_CHECK(EEPROM_storeRead(KEY_OTHER, data, &length) == ERROR);
+	g_results = 0;
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, value, sizeof(value),
+			writeDone) == ERROR);
+	HOST_CHECK(g_results == 0);
+
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	checkRecord(KEY_OTHER, (const uint8 *) "abc", 3);
+	HOST_CHECK(EEPROM_storeWriteAsync(KEY_PASSWORD, value, sizeof(value),
+			writeDone) == SUCCESS);
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	checkRecord(KEY_PASSWORD, value, sizeof(value));
+}
+
+int main(void)
+{
+	testReadBack();
+	testWearLeveling();
+	testPowerCuts(HOST_EEPROM_KEEP_OLD);
+	testPowerCuts(HOST_EEPROM_ERASED);
+	testReadFailure();
+	return HOST_TEST_END();
+}
@@ -0,0 +1,304 @@
+/*
+ ============================================================================
+ Name        : test_external_eeprom.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the 24C16 block writes and reads over the TWI engine
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_blocks.h"
+#include "shim/host_twi_eeprom.h"
+#include "HAL/EXTERNAL_EEPROM/external_eeprom.h"
+#include "MCAL/I2C/twi.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BIT_RATE		200000UL
+
+/* A block write of an address and a length */
+typedef struct
+{
+	uint16 address;
+	uint16 length;
+} BlockType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The expected memory of the 24C16 */
+static uint8 g_reference[EEPROM_SIZE];
+
+static uint8 g_data[EEPROM_SIZE];
+
+/* The result of the asynchronous write, 0xFF before its call back */
+static volatile uint8 g_asyncResult;
+
+/* Aligned, unaligned, one page, across pages and across the 256 bytes blocks */
+static const BlockType g_blocks[] =
+{
+	{ 0x000, 1 }, { 0x010, 16 }, { 0x027, 9 }, { 0x035, 16 }, { 0x04F, 1 },
+	{ 0x050, 17 }, { 0x063, 45 }, { 0x0F8, 20 }, { 0x1F0, 48 },
+	{ 0x2A1, 200 }, { 0x7F0, 16 }
+};
+
+#define NUM_BLOCKS		(sizeof(g_blocks) / sizeof(g_blocks[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The devices of the test, stepped on the virtual clock.
+ */
+static void stepDevices(void)
+{
+	HOST_twiEepromStep(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Call back of the asynchronous write.
+ */
+static void asyncWritten(uint8 result)
+{
+	g_asyncResult = result;
+}
+
+/*
+ * Description :
+ * Number of the pages from the address to the end of the block.
+ */
+static uint16 pagesOf(uint16 address, uint16 length)
+{
+	return ((address + length - 1) / EEPROM_PAGE_SIZE)
+			- (address / EEPROM_PAGE_SIZE) + 1;
+}
+
+/*
+ * Description :
+ * Start from an erased 24C16 with a write cycle and a fresh engine at 200 kHz.
+ */
+static void resetDevices(uint32 writeCycleUs)
+{
+	TWI_ConfigType config = { MC_ADDRESS, BIT_RATE };
+
+	HOST_twiEepromReset(writeCycleUs);
+	memset(g_reference, 0xFF, sizeof(g_reference));
+	g_hostDevices = stepDevices;
+	host_SREG.Bits.I_Bit = 1;
+	HOST_CHECK(TWI_init(&config) == TRUE);
+}
+
+/*
+ * Description :
+ * Each block is split at the page boundaries: one write cycle for each page
+ * it touches, no page wrap in the 24C16, and the bytes around it are kept.
+ * The write returns after its last write cycle, its time is the cycles of its
+ * pages and the bus, the ACK polling waits no longer.
+ */
+static void testPageSplit(void)
+{
+	uint16 i, pages;
+	uint32 writeCycles;
+	uint64 start, time;
+
+	resetDevices(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	for (i = 0; i < EEPROM_SIZE; i++)
+	{
+		g_data[i] = (uint8) (i * 31 + 7);
+	}
+	for (i = 0; i < NUM_BLOCKS; i++)
+	{
+		writeCycles = g_hostTwiEepromStats.writeCycles;
+		pages = pagesOf(g_blocks[i].address, g_blocks[i].length);
+		start = g_hostCycles;
+		HOST_CHECK(EEPROM_writeBlock(g_blocks[i].address, g_data,
+				g_blocks[i].length) == SUCCESS);
+		time = (g_hostCycles - start) / HOST_CYCLES_PER_US;
+		memcpy(&g_reference[g_blocks[i].address], g_data, g_blocks[i].length);
+
+		HOST_CHECK(memcmp(g_hostTwiEeprom, g_reference, EEPROM_SIZE) == 0);
+		HOST_CHECK(g_hostTwiEepromStats.writeCycles - writeCycles == pages);
+		HOST_CHECK(HOST_twiEepromIsWriting(g_hostCycles) == FALSE);
+		HOST_CHECK(time >= (uint64) pages * HOST_TWI_EEPROM_WRITE_CYCLE_US);
+		/*
+		 * a full page is about 1 ms on the bus with its ISRs, and the ACK
+		 * polling sees the end of a write cycle less than one restart late
+		 */
+		HOST_CHECK(time < (uint64) pages * (HOST_TWI_EEPROM_WRITE_CYCLE_US + 1500));
+	}
+	HOST_CHECK(g_hostTwiEepromStats.pageWraps == 0);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks > 0);
+}
+
+/*
+ * Description :
+ * The 24C16 itself wraps a load of more than a page to the start of the page,
+ * which is why the driver splits the blocks: 20 bytes from the offset 4 of a
+ * page overwrite the offsets 4 to 15 then 0 to 7.
+ */
+static void testPageWrap(void)
+{
+	TWI_TransactionType write;
+	uint8 i;
+
+	resetDevices(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	write.slaveAddress = 0xA4;
+	write.command[0] = 0x04;
+	write.commandLength = 1;
+	write.writeData = g_data;
+	write.writeLength = 20;
+	write.readLength = 0;
+	write.callBack = NULL_PTR;
+	write.status = TWI_TRANSACTION_IDLE;
+	HOST_CHECK(TWI_submitTransaction(&write) == TRUE);
+	while (TWI_isIdle() == FALSE)
+	{
+		HOST_run(100);
+	}
+	HOST_run(100);
+	HOST_CHECK(write.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK(g_hostTwiEepromStats.pageWraps == 1);
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 1);
+	for (i = 0; i < 20; i++)
+	{
+		g_reference[0x200 + ((4 + i) % EEPROM_PAGE_SIZE)] = g_data[i];
+	}
+	HOST_CHECK(memcmp(g_hostTwiEeprom, g_reference, EEPROM_SIZE) == 0);
+	HOST_CHECK(g_hostTwiEeprom[0x210] == 0xFF);
+}
+
+/*
+ * Description :
+ * The asynchronous write returns at once, refuses a second block until its
+ * call back, and a read submitted in its write cycles waits with ACK polling.
+ */
+static void testAsyncWrite(void)
+{
+	uint8 readData[24];
+
+	resetDevices(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	g_asyncResult = 0xFF;
+	HOST_CHECK(EEPROM_writeBlockAsync(0x108, g_data, 24, asyncWritten) == SUCCESS);
+	HOST_CHECK(g_asyncResult == 0xFF);
+	HOST_CHECK(EEPROM_writeBlockAsync(0x300, g_data, 4, asyncWritten) == ERROR);
+	HOST_CHECK(EEPROM_writeBlock(0x300, g_data, 4) == ERROR);
+
+	/* the read is queued after the second page, both wait for the write cycles with ACK polling */
+	HOST_run(1000 * HOST_CYCLES_PER_US);
+	HOST_CHECK(EEPROM_readBlock(0x108, readData, 8) == SUCCESS);
+	HOST_CHECK(memcmp(readData, g_data, 8) == 0);
+
+	while (g_asyncResult == 0xFF)
+	{
+		HOST_run(1000);
+	}
+	HOST_CHECK(g_asyncResult == SUCCESS);
+	HOST_CHECK(EEPROM_readBlock(0x108, readData, 24) == SUCCESS);
+	HOST_CHECK(memcmp(readData, g_data, 24) == 0);
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 2);
+}
+
+/*
+ * Description :
+ * The restarts of TWI_MAX_RETRIES cover a write cycle of about 12 ms at
+ * 200 kHz, more than the 5 ms of the data sheet. A slower or missing 24C16
+ * and a NACKed data byte fail the write with ERROR, and the next write works.
+ */
+static void testWriteFailures(void)
+{
+	resetDevices(10000);
+	HOST_CHECK(EEPROM_writeBlock(0x040, g_data, 32) == SUCCESS);
+
+	resetDevices(20000);
+	HOST_CHECK(EEPROM_writeBlock(0x040, g_data, 32) == ERROR);
+	/* the first page is written, the second one isn't */
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 1);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks == TWI_MAX_RETRIES + 1);
+
+	resetDevices(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	HOST_twiEepromRemove(TRUE);
+	HOST_CHECK(EEPROM_writeBlock(0x040, g_data, 4) == ERROR);
+	HOST_twiEepromRemove(FALSE);
+	HOST_twiEepromNackNextData();
+	HOST_CHECK(EEPROM_writeBlock(0x040, g_data, 4) == ERROR);
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 0);
+	HOST_CHECK(EEPROM_writeBlock(0x040, g_data, 4) == SUCCESS);
+	HOST_CHECK(memcmp(&g_hostTwiEeprom[0x040], g_data, 4) == 0);
+}
+
+/*
+ * Description :
+ * A block read is one transaction: the memory address once, then the bytes
+ * with ACK and the last one with NACK. The address counter of the 24C16 goes
+ * on across the pages and the 256 bytes blocks and rolls over at the end of
+ * the memory. A single byte read gives its byte.
+ */
+static void testSequentialRead(void)
+{
+	static const BlockType reads[] =
+	{
+		{ 0x000, 1 }, { 0x005, 2 }, { 0x010, 16 }, { 0x01F, 17 },
+		{ 0x0F0, 32 }, { 0x155, 300 }, { 0x000, EEPROM_SIZE }
+	};
+	static uint8 readData[EEPROM_SIZE];
+	uint16 i;
+	uint8 byte = 0;
+
+	resetDevices(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	for (i = 0; i < EEPROM_SIZE; i++)
+	{
+		g_hostTwiEeprom[i] = (uint8) ((i >> 3) ^ (i * 13));
+	}
+	for (i = 0; i < sizeof(reads) / sizeof(reads[0]); i++)
+	{
+		memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+		memset(readData, 0, sizeof(readData));
+		HOST_CHECK(EEPROM_readBlock(reads[i].address, readData,
+				reads[i].length) == SUCCESS);
+		HOST_CHECK(memcmp(readData, &g_hostTwiEeprom[reads[i].address],
+				reads[i].length) == 0);
+		/* START and REPEATED START, the memory address and the bytes */
+		HOST_CHECK(g_hostTwiEepromStats.starts == 2);
+		HOST_CHECK(g_hostTwiEepromStats.bytes == reads[i].length + 1UL);
+		HOST_CHECK(g_hostTwiEepromStats.interrupts == reads[i].length + 5UL);
+	}
+
+	/* the end of the memory */
+	HOST_CHECK(EEPROM_readBlock(0x7F8, readData, 16) == SUCCESS);
+	HOST_CHECK(memcmp(readData, &g_hostTwiEeprom[0x7F8], 8) == 0);
+	HOST_CHECK(memcmp(&readData[8], g_hostTwiEeprom, 8) == 0);
+
+	/* nothing to read, nothing on the bus */
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	HOST_CHECK(EEPROM_readBlock(0x100, readData, 0) == SUCCESS);
+	HOST_CHECK(g_hostTwiEepromStats.starts == 0);
+
+	HOST_CHECK(EEPROM_readByte(0x3C5, &byte) == SUCCESS);
+	HOST_CHECK(byte == g_hostTwiEeprom[0x3C5]);
+
+	HOST_twiEepromRemove(TRUE);
+	HOST_CHECK(EEPROM_readBlock(0x100, readData, 4) == ERROR);
+	HOST_twiEepromRemove(FALSE);
+	HOST_CHECK(EEPROM_readBlock(0x100, readData, 4) == SUCCESS);
+}
+
+int main(void)
+{
+	testPageSplit();
+	testPageWrap();
+	testAsyncWrite();
+	testWriteFailures();
+	testSequentialRead();
+	return HOST_TEST_END();
+}
@@ -0,0 +1,251 @@
+/*
+ ============================================================================
+ Name        : test_frame.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the FRAME link, its CRC-8 and its parser
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "SERVICE/FRAME/frame.h"
+#include "MCAL/UART/uart.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define WIRE_SIZE		64
+
+typedef struct
+{
+	uint8 type;
+	uint8 length;
+	uint8 payload[FRAME_MAX_PAYLOAD];
+	uint8 crc; /* CRC-8 (polynomial 0x07, initial 0) of a reference calculator */
+} FrameVectorType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The bytes sent by FRAME and the bytes which UART_read gives to it */
+static uint8 g_txWire[WIRE_SIZE];
+static uint8 g_txLength = 0;
+static uint8 g_rxWire[WIRE_SIZE];
+static uint8 g_rxLength = 0;
+static uint8 g_rxIndex = 0;
+
+/* A check request, an ACK reply, a NACK and a lockout reply */
+static const FrameVectorType g_vectors[] =
+{
+	{ 0xDD, 6, { 0xFF, 1, 2, 3, 4, 5 }, 0x4C },
+	{ FRAME_ACK, 1, { 0xAA }, 0x37 },
+	{ FRAME_NACK, 0, { 0 }, 0x16 },
+	{ 0x68, 3, { 0x68, 0x3C, 0x00 }, 0x1E },
+};
+
+#define NUM_VECTORS		(sizeof(g_vectors) / sizeof(g_vectors[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The UART driver of the test, the sent bytes are kept in the TX wire.
+ */
+void UART_sendByte(const uint8 data)
+{
+	if (g_txLength < WIRE_SIZE)
+	{
+		g_txWire[g_txLength++] = data;
+	}
+}
+
+/*
+ * Description :
+ * The UART driver of the test, the received bytes are taken from the RX wire.
+ */
+uint8 UART_read(uint8 *data, uint8 length)
+{
+	uint8 count = 0;
+
+	while ((count < length) && (g_rxIndex < g_rxLength))
+	{
+		data[count++] = g_rxWire[g_rxIndex++];
+	}
+	return count;
+}
+
+/*
+ * Description :
+ * Feed the bytes to the parser and return the last status which is not
+ * FRAME_INCOMPLETE, or FRAME_INCOMPLETE if all of them are.
+ */
+static FRAME_StatusType parseBytes(const uint8 *bytes, uint8 length,
+		FRAME_Type *frame)
+{
+	FRAME_StatusType status = FRAME_INCOMPLETE;
+	FRAME_StatusType byteStatus;
+	uint8 i;
+
+	for (i = 0; i < length; i++)
+	{
+		byteStatus = FRAME_parseByte(bytes[i], frame);
+		if (byteStatus != FRAME_INCOMPLETE)
+		{
+			status = byteStatus;
+		}
+	}
+	return status;
+}
+
+/*
+ * Description :
+ * The sent frame is START, TYPE, LENGTH, PAYLOAD and the CRC-8 of the reference.
+ */
+static void testSendLayout(void)
+{
+	uint8 v, i;
+
+	for (v = 0; v < NUM_VECTORS; v++)
+	{
+		g_txLength = 0;
+		FRAME_send(g_vectors[v].type, g_vectors[v].payload, g_vectors[v].length);
+		HOST_CHECK(g_txLength == g_vectors[v].length + FRAME_OVERHEAD);
+		HOST_CHECK(g_txWire[0] == FRAME_START_BYTE);
+		HOST_CHECK(g_txWire[1] == g_vectors[v].type);
+		HOST_CHECK(g_txWire[2] == g_vectors[v].length);
+		for (i = 0; i < g_vectors[v].length; i++)
+		{
+			HOST_CHECK(g_txWire[3 + i] == g_vectors[v].payload[i]);
+		}
+		HOST_CHECK(g_txWire[g_txLength - 1] == g_vectors[v].crc);
+	}
+}
+
+/*
+ * Description :
+ * A sent frame is parsed back to the same type and payload, after noise too.
+ */
+static void testParseRoundTrip(void)
+{
+	const uint8 noise[] = { 0x00, 0x55, 0xFF };
+	FRAME_Type frame;
+	uint8 v;
+
+	for (v = 0; v < NUM_VECTORS; v++)
+	{
+		g_txLength = 0;
+		FRAME_send(g_vectors[v].type, g_vectors[v].payload, g_vectors[v].length);
+		HOST_CHECK(parseBytes(noise, sizeof(noise), &frame) == FRAME_INCOMPLETE);
+		memset(&frame, 0, sizeof(frame));
+		HOST_CHECK(parseBytes(g_txWire, g_txLength, &frame) == FRAME_RECEIVED);
+		HOST_CHECK(frame.type == g_vectors[v].type);
+		HOST_CHECK(frame.length == g_vectors[v].length);
+		HOST_CHECK(memcmp(frame.payload, g_vectors[v].payload,
+				g_vectors[v].length) == 0);
+	}
+}
+
+/*
+ * Description :
+ * Each single bit error of the frame is never received as a frame, and the
+ * parser finds the next frame after it.
+ */
+static void testSingleBitErrors(void)
+{
+	uint8 good[WIRE_SIZE];
+	uint8 bad[WIRE_SIZE];
+	uint8 goodLength;
+	uint8 byte, bit, copy;
+	uint8 received;
+	FRAME_Type frame;
+
+	g_txLength = 0;
+	FRAME_send(g_vectors[0].type, g_vectors[0].payload, g_vectors[0].length);
+	memcpy(good, g_txWire, g_txLength);
+	goodLength = g_txLength;
+
+	/* the start byte is not covered by the CRC, an error on it drops the frame */
+	for (byte = 1; byte < goodLength; byte++)
+	{
+		for (bit = 0; bit < 8; bit++)
+		{
+			memcpy(bad, good, goodLength);
+			bad[byte] ^= (uint8) (1 << bit);
+			HOST_CHECK(parseBytes(bad, goodLength, &frame) != FRAME_RECEIVED);
+
+			/* a longer length takes a part of the next frame, so two are sent */
+			received = 0;
+			for (copy = 0; copy < 2; copy++)
+			{
+				if (parseBytes(good, goodLength, &frame) == FRAME_RECEIVED)
+				{
+					received++;
+				}
+			}
+			HOST_CHECK(received >= 1);
+			HOST_CHECK(frame.type == g_vectors[0].type);
+		}
+	}
+}
+
+/*
+ * Description :
+ * A length above FRAME_MAX_PAYLOAD is corrupted at once.
+ */
+static void testLengthCheck(void)
+{
+	const uint8 bytes[] = { FRAME_START_BYTE, FRAME_ACK, FRAME_MAX_PAYLOAD + 1 };
+	FRAME_Type frame;
+
+	HOST_CHECK(parseBytes(bytes, sizeof(bytes), &frame) == FRAME_CORRUPTED);
+}
+
+/*
+ * Description :
+ * FRAME_poll answers a corrupted frame by a NACK, and stops after a received
+ * frame so the next one stays in UART.
+ */
+static void testPoll(void)
+{
+	FRAME_Type frame;
+	uint8 frameLength;
+
+	g_txLength = 0;
+	FRAME_send(g_vectors[1].type, g_vectors[1].payload, g_vectors[1].length);
+	frameLength = g_txLength;
+	memcpy(g_rxWire, g_txWire, frameLength);
+	g_rxWire[frameLength - 1] ^= 0x01;
+	memcpy(&g_rxWire[frameLength], g_txWire, frameLength);
+	memcpy(&g_rxWire[2 * frameLength], g_txWire, frameLength);
+	g_rxLength = 3 * frameLength;
+	g_rxIndex = 0;
+
+	g_txLength = 0;
+	HOST_CHECK(FRAME_poll(&frame) == FRAME_RECEIVED);
+	HOST_CHECK(frame.type == FRAME_ACK);
+	HOST_CHECK(g_rxIndex == 2 * frameLength);
+	HOST_CHECK(g_txLength == FRAME_OVERHEAD);
+	HOST_CHECK(g_txWire[1] == FRAME_NACK);
+	HOST_CHECK(g_txWire[3] == g_vectors[2].crc);
+
+	HOST_CHECK(FRAME_poll(&frame) == FRAME_RECEIVED);
+	HOST_CHECK(FRAME_poll(&frame) == FRAME_INCOMPLETE);
+}
+
+int main(void)
+{
+	testSendLayout();
+	testParseRoundTrip();
+	testSingleBitErrors();
+	testLengthCheck();
+	testPoll();
+	return HOST_TEST_END();
+}
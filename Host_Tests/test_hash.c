@@ -0,0 +1,76 @@
+/*
+ ============================================================================
+ Name        : test_hash.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of HalfSipHash-2-4 with the reference vectors
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "SERVICE/HASH/hash.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * The key is 00 01 .. 07 and the message of length n is 00 01 .. n-1, like the
+ * vectors of the HalfSipHash reference code (vectors_hsip32 and vectors_hsip64).
+ */
+typedef struct
+{
+	uint8 length;
+	uint8 output32[HASH_OUTPUT_32_BITS];
+	uint8 output64[HASH_OUTPUT_64_BITS];
+} HashVectorType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+static const HashVectorType g_vectors[] =
+{
+	{ 0, { 0xa9, 0x35, 0x9f, 0x5b }, { 0x21, 0x8d, 0x1f, 0x59, 0xb9, 0xb8, 0x3c, 0xc8 } },
+	{ 1, { 0x27, 0x47, 0x5a, 0xb8 }, { 0xbe, 0x55, 0x24, 0x12, 0xf8, 0x38, 0x73, 0x15 } },
+	{ 3, { 0x8a, 0xfe, 0xe7, 0x04 }, { 0xce, 0x0f, 0x1a, 0x45, 0xf7, 0x06, 0x06, 0x79 } },
+	{ 4, { 0x2a, 0x6e, 0x46, 0x89 }, { 0xd5, 0xe7, 0x8a, 0x17, 0x5b, 0xe5, 0x2e, 0xa1 } },
+	{ 5, { 0xc5, 0xfa, 0xb6, 0x69 }, { 0xcb, 0x9d, 0x7c, 0x3f, 0x2f, 0x3d, 0xb5, 0x80 } },
+	{ 8, { 0xd0, 0xb8, 0x84, 0x8f }, { 0xed, 0xfe, 0xe8, 0x20, 0xbc, 0xe4, 0x85, 0x8c } },
+	{ 13, { 0x77, 0xe6, 0x63, 0xff }, { 0x5a, 0x23, 0x52, 0xd7, 0x5a, 0x0c, 0x37, 0x44 } },
+	{ 63, { 0x59, 0xea, 0x4a, 0x74 }, { 0x2e, 0xa6, 0x3c, 0x71, 0xbf, 0x32, 0x60, 0x87 } },
+};
+
+#define NUM_VECTORS		(sizeof(g_vectors) / sizeof(g_vectors[0]))
+
+int main(void)
+{
+	uint8 key[HASH_KEY_LENGTH];
+	uint8 message[64];
+	uint8 output[HASH_OUTPUT_64_BITS];
+	uint8 i;
+
+	for (i = 0; i < HASH_KEY_LENGTH; i++)
+	{
+		key[i] = i;
+	}
+	for (i = 0; i < sizeof(message); i++)
+	{
+		message[i] = i;
+	}
+
+	for (i = 0; i < NUM_VECTORS; i++)
+	{
+		HASH_halfSipHash(key, message, g_vectors[i].length, output,
+				HASH_OUTPUT_32_BITS);
+		HOST_CHECK(memcmp(output, g_vectors[i].output32, HASH_OUTPUT_32_BITS) == 0);
+		HASH_halfSipHash(key, message, g_vectors[i].length, output,
+				HASH_OUTPUT_64_BITS);
+		HOST_CHECK(memcmp(output, g_vectors[i].output64, HASH_OUTPUT_64_BITS) == 0);
+	}
+	return HOST_TEST_END();
+}
@@ -0,0 +1,169 @@
+/*
+ ============================================================================
+ Name        : test_lockout.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the persistent lockout with resets and read faults
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_eeprom.h"
+#include "SERVICE/LOCKOUT/lockout.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define ONE_SECOND_MS		1000UL
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The uptime of the TIMER1 stub in milliseconds */
+static uint32 g_ticks = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The uptime of the TIMER1 service, driven by the test.
+ */
+uint32 Timer1_getTicks(void)
+{
+	return g_ticks;
+}
+
+/*
+ * Description :
+ * Number of the page writes of the record store.
+ */
+static uint32 storeWrites(void)
+{
+	uint32 writes = 0;
+	uint8 page;
+
+	for (page = 0; page < EEPROM_STORE_NUM_PAGES; page++)
+	{
+		writes += g_hostEepromPageWrites[EEPROM_STORE_FIRST_PAGE + page];
+	}
+	return writes;
+}
+
+/*
+ * Description :
+ * The reset of the Control ECU, the store is scanned again then the lockout
+ * record is loaded.
+ */
+static void reset(void)
+{
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	LOCKOUT_init();
+	HOST_CHECK(LOCKOUT_isKnown() == TRUE);
+}
+
+/*
+ * Description :
+ * A store without the record is a first start. Each wrong password is written
+ * before LOCKOUT_recordFailure returns, so a reset right after the reply
+ * keeps it, and the third one starts the lockout.
+ */
+static void testFailureSaved(void)
+{
+	uint32 writes;
+
+	HOST_eepromReset();
+	reset();
+	HOST_CHECK(LOCKOUT_getRemainingTime() == 0);
+
+	writes = storeWrites();
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(storeWrites() == writes + 1);
+	reset();
+
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(storeWrites() == writes + 2);
+	reset();
+
+	HOST_CHECK(LOCKOUT_recordFailure() == LOCKOUT_BASE_PERIOD);
+	HOST_CHECK(storeWrites() == writes + 3);
+	HOST_CHECK(LOCKOUT_getRemainingTime() == LOCKOUT_BASE_PERIOD);
+
+	/* a reset during the lockout starts it again */
+	g_ticks += 10 * ONE_SECOND_MS;
+	reset();
+	HOST_CHECK(LOCKOUT_getRemainingTime() == LOCKOUT_BASE_PERIOD);
+}
+
+/*
+ * Description :
+ * While the record can't be read the state is not known and nothing is
+ * written, LOCKOUT_poll loads it after the next complete scan of the store.
+ */
+static void testUnknownState(void)
+{
+	uint32 writes;
+
+	HOST_eepromFailOneRead(EEPROM_STORE_NUM_PAGES / 2);
+	HOST_CHECK(EEPROM_storeInit() == ERROR);
+	LOCKOUT_init();
+	HOST_CHECK(LOCKOUT_isKnown() == FALSE);
+	HOST_CHECK(LOCKOUT_getRemainingTime() == 0);
+
+	writes = storeWrites();
+	g_ticks += ONE_SECOND_MS;
+	LOCKOUT_poll();
+	HOST_CHECK(LOCKOUT_isKnown() == FALSE);
+	HOST_CHECK(storeWrites() == writes);
+
+	/* the scan of the main loop, the record is loaded at the next period */
+	HOST_CHECK(EEPROM_storeInit() == SUCCESS);
+	LOCKOUT_poll();
+	HOST_CHECK(LOCKOUT_isKnown() == FALSE);
+	g_ticks += ONE_SECOND_MS;
+	LOCKOUT_poll();
+	HOST_CHECK(LOCKOUT_isKnown() == TRUE);
+	HOST_CHECK(LOCKOUT_getRemainingTime() == LOCKOUT_BASE_PERIOD);
+	HOST_CHECK(storeWrites() == writes);
+}
+
+/*
+ * Description :
+ * The end of the lockout is saved, the next lockout is twice the first one
+ * until a correct password.
+ */
+static void testLockoutEnd(void)
+{
+	g_ticks += LOCKOUT_BASE_PERIOD * ONE_SECOND_MS;
+	LOCKOUT_poll();
+	HOST_CHECK(LOCKOUT_getRemainingTime() == 0);
+	reset();
+	HOST_CHECK(LOCKOUT_getRemainingTime() == 0);
+
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(LOCKOUT_recordFailure() == 2 * LOCKOUT_BASE_PERIOD);
+
+	g_ticks += 2 * LOCKOUT_BASE_PERIOD * ONE_SECOND_MS;
+	LOCKOUT_poll();
+	LOCKOUT_recordSuccess();
+	LOCKOUT_poll();
+	reset();
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(LOCKOUT_recordFailure() == 0);
+	HOST_CHECK(LOCKOUT_recordFailure() == LOCKOUT_BASE_PERIOD);
+}
+
+int main(void)
+{
+	testFailureSaved();
+	testUnknownState();
+	testLockoutEnd();
+	return HOST_TEST_END();
+}
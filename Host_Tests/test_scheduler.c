@@ -0,0 +1,221 @@
+/*
+ ============================================================================
+ Name        : test_scheduler.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the SCHEDULER queues and critical sections
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "SERVICE/SCHEDULER/scheduler.h"
+#include "MCAL/TIMER1/timer1_service.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define LOG_SIZE		32
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The time of the TIMER1 service and the I-bit seen by each read of it */
+static uint32 g_micros = 0;
+static uint8 g_interruptsSeenEnabled = FALSE;
+
+/* The events in the order of their handlers */
+static SCHEDULER_EventType g_log[LOG_SIZE];
+static uint8 g_logLength = 0;
+
+static uint8 g_highTask;
+static uint8 g_mediumTask;
+static uint8 g_lowTask;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The TIMER1 service of the test, it is read inside the critical section of post.
+ */
+uint32 Timer1_getMicros(void)
+{
+	if (host_SREG.Bits.I_Bit == 1)
+	{
+		g_interruptsSeenEnabled = TRUE;
+	}
+	return g_micros;
+}
+
+/*
+ * Description :
+ * The handler of all the tasks, it logs the event.
+ */
+static void logEvent(const SCHEDULER_EventType *event)
+{
+	if (g_logLength < LOG_SIZE)
+	{
+		g_log[g_logLength++] = *event;
+	}
+}
+
+/*
+ * Description :
+ * The medium task posts a high event for its param 0xAA while it runs.
+ */
+static void postingHandler(const SCHEDULER_EventType *event)
+{
+	logEvent(event);
+	if (event->param == 0xAA)
+	{
+		HOST_CHECK(SCHEDULER_post(g_highTask, 9, 0xBB) == TRUE);
+	}
+}
+
+/*
+ * Description :
+ * The highest priority is dispatched first, the events of one priority in
+ * their post order, and the interrupts are disabled inside post.
+ */
+static void testOrder(void)
+{
+	uint8 i;
+
+	host_SREG.Bits.I_Bit = 1;
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 1, 10) == TRUE);
+	HOST_CHECK(SCHEDULER_post(g_mediumTask, 2, 20) == TRUE);
+	HOST_CHECK(SCHEDULER_post(g_highTask, 3, 30) == TRUE);
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 4, 40) == TRUE);
+	HOST_CHECK(SCHEDULER_post(g_highTask, 5, 50) == TRUE);
+	HOST_CHECK(host_SREG.Bits.I_Bit == 1);
+	HOST_CHECK(g_interruptsSeenEnabled == FALSE);
+
+	g_logLength = 0;
+	while (SCHEDULER_dispatch() == TRUE)
+	{
+	}
+	HOST_CHECK(host_SREG.Bits.I_Bit == 1);
+	HOST_CHECK(g_logLength == 5);
+	{
+		const uint8 order[] = { 3, 5, 2, 1, 4 };
+		for (i = 0; i < 5; i++)
+		{
+			HOST_CHECK(g_log[i].signal == order[i]);
+		}
+	}
+	HOST_CHECK(g_log[0].task == g_highTask);
+	HOST_CHECK(g_log[2].task == g_mediumTask);
+	HOST_CHECK(g_log[2].param == 20);
+
+	/* a post with the interrupts disabled keeps them disabled */
+	host_SREG.Bits.I_Bit = 0;
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 6, 60) == TRUE);
+	HOST_CHECK(host_SREG.Bits.I_Bit == 0);
+	HOST_CHECK(SCHEDULER_dispatch() == TRUE);
+	HOST_CHECK(SCHEDULER_dispatch() == FALSE);
+}
+
+/*
+ * Description :
+ * A queue takes SCHEDULER_QUEUE_SIZE - 1 events, a post to a full queue returns
+ * FALSE and keeps the queued events, and the other priorities still take events.
+ */
+static void testFullQueue(void)
+{
+	uint8 i;
+
+	host_SREG.Bits.I_Bit = 1;
+	for (i = 0; i < SCHEDULER_QUEUE_SIZE - 1; i++)
+	{
+		HOST_CHECK(SCHEDULER_post(g_lowTask, 7, i) == TRUE);
+	}
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 7, 0xFF) == FALSE);
+	HOST_CHECK(host_SREG.Bits.I_Bit == 1);
+	HOST_CHECK(SCHEDULER_post(g_highTask, 8, 0) == TRUE);
+
+	g_logLength = 0;
+	while (SCHEDULER_dispatch() == TRUE)
+	{
+	}
+	HOST_CHECK(g_logLength == SCHEDULER_QUEUE_SIZE);
+	HOST_CHECK(g_log[0].signal == 8);
+	for (i = 0; i < SCHEDULER_QUEUE_SIZE - 1; i++)
+	{
+		HOST_CHECK(g_log[i + 1].param == i);
+	}
+
+	/* the queue is free again */
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 7, 0xFF) == TRUE);
+	HOST_CHECK(SCHEDULER_dispatch() == TRUE);
+}
+
+/*
+ * Description :
+ * A handler may post, a higher event posted by it is the next one dispatched.
+ */
+static void testPostFromHandler(void)
+{
+	g_logLength = 0;
+	HOST_CHECK(SCHEDULER_post(g_mediumTask, 2, 0xAA) == TRUE);
+	HOST_CHECK(SCHEDULER_post(g_mediumTask, 2, 0x01) == TRUE);
+	while (SCHEDULER_dispatch() == TRUE)
+	{
+	}
+	HOST_CHECK(g_logLength == 3);
+	HOST_CHECK(g_log[1].param == 0xBB);
+	HOST_CHECK(g_log[2].param == 0x01);
+}
+
+/*
+ * Description :
+ * The worst dispatch latency is the longest time between a post and its handler.
+ */
+static void testLatency(void)
+{
+	SCHEDULER_resetMaxLatency();
+	g_micros = 1000;
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 1, 0) == TRUE);
+	g_micros = 1250;
+	HOST_CHECK(SCHEDULER_dispatch() == TRUE);
+	HOST_CHECK(SCHEDULER_getMaxLatency() == 250);
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 1, 0) == TRUE);
+	g_micros = 1300;
+	HOST_CHECK(SCHEDULER_dispatch() == TRUE);
+	HOST_CHECK(SCHEDULER_getMaxLatency() == 250);
+	HOST_CHECK(SCHEDULER_post(g_lowTask, 1, 0) == TRUE);
+	g_micros = 200000;
+	HOST_CHECK(SCHEDULER_dispatch() == TRUE);
+	HOST_CHECK(SCHEDULER_getMaxLatency() == 0xFFFF);
+}
+
+int main(void)
+{
+	uint8 i;
+
+	g_highTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_HIGH, logEvent);
+	g_mediumTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_MEDIUM, postingHandler);
+	g_lowTask = SCHEDULER_addTask(SCHEDULER_PRIORITY_LOW, logEvent);
+	HOST_CHECK(SCHEDULER_addTask(SCHEDULER_NUM_PRIORITIES, logEvent)
+			== SCHEDULER_INVALID_TASK);
+	HOST_CHECK(SCHEDULER_post(SCHEDULER_MAX_TASKS, 1, 0) == FALSE);
+
+	testOrder();
+	testFullQueue();
+	testPostFromHandler();
+	testLatency();
+
+	/* the tasks run out */
+	for (i = 3; i < SCHEDULER_MAX_TASKS; i++)
+	{
+		HOST_CHECK(SCHEDULER_addTask(SCHEDULER_PRIORITY_LOW, logEvent) == i);
+	}
+	HOST_CHECK(SCHEDULER_addTask(SCHEDULER_PRIORITY_LOW, logEvent)
+			== SCHEDULER_INVALID_TASK);
+	return HOST_TEST_END();
+}
@@ -0,0 +1,189 @@
+/*
+ ============================================================================
+ Name        : test_system.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of both ECUs connected by their UARTs, from the keypad to the motor
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_sim.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CYCLES_PER_MS				(F_CPU / 1000UL)
+
+/* A key is held and released longer than the debounce of the 4 scanned rows */
+#define KEY_HOLD_MS					60
+#define KEY_RELEASE_MS				60
+
+/* The time of a screen which waits for the next state */
+#define SCREEN_WAIT_MS				1000
+
+/* The longest screen of the test, the unlocking and the locking of the door */
+#define DOOR_MOVE_MS				15000
+
+/* The simulation is the same in each run */
+#define TEST_SEED					1
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+static const HOST_HmiBoardType *const g_hmi = &g_hostHmiBoard;
+static const HOST_ControlBoardType *const g_control = &g_hostControlBoard;
+
+static const char *const g_wrongPasswords[] = { "54321", "54322", "54323" };
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Run both ECUs for the milliseconds.
+ */
+static void runMs(uint32 ms)
+{
+	HOST_simRun((uint64) ms * CYCLES_PER_MS);
+}
+
+/*
+ * Description :
+ * Press and release the key like a user.
+ */
+static void pressKey(uint8 key)
+{
+	g_hmi->setKey(key);
+	runMs(KEY_HOLD_MS);
+	g_hmi->setKey(HOST_NO_KEY);
+	runMs(KEY_RELEASE_MS);
+}
+
+/*
+ * Description :
+ * Type the five digits of the password and the enter key.
+ */
+static void typePassword(const char *digits)
+{
+	while (*digits != '\0')
+	{
+		pressKey((uint8) (*digits - '0'));
+		digits++;
+	}
+	pressKey('#');
+}
+
+/*
+ * Description :
+ * Return TRUE if the row of the LCD has the text.
+ */
+static uint8 lcdShows(uint8 row, const char *text)
+{
+	return (strstr(g_hmi->lcd->text[row], text) != NULL_PTR) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Run until the row of the LCD has the text or the time ends.
+ * Return TRUE if the text is shown.
+ */
+static uint8 waitLcd(uint8 row, const char *text, uint32 ms)
+{
+	while (ms != 0)
+	{
+		if (lcdShows(row, text) == TRUE)
+		{
+			return TRUE;
+		}
+		runMs(1);
+		ms--;
+	}
+	return lcdShows(row, text);
+}
+
+/*
+ * Description :
+ * The boot shows the splash screens, the Control ECU finds no password in its
+ * erased 24C16 and the HMI asks for a new one. It is created on both ECUs
+ * over the UART and the main menu is shown.
+ */
+static void testBootAndCreate(void)
+{
+	HOST_CHECK(waitLcd(0, "Final Project", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(waitLcd(0, "Made By", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == TRUE);
+
+	typePassword("12345");
+	HOST_CHECK(waitLcd(0, "plz re-enter the", SCREEN_WAIT_MS) == TRUE);
+	typePassword("12345");
+	HOST_CHECK(waitLcd(0, "+ : Open Door", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(waitLcd(1, "- : Change Pass", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(g_hostSimStats.hmiToControlBytes != 0);
+	HOST_CHECK(g_hostSimStats.controlToHmiBytes != 0);
+}
+
+/*
+ * Description :
+ * The correct password opens the door, the motor turns clock wise while the
+ * HMI shows the unlocking, stops while the door is open, then turns anti
+ * clock wise while it is locking.
+ */
+static void testOpenDoor(void)
+{
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_STOP);
+	pressKey('+');
+	HOST_CHECK(waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == TRUE);
+	typePassword("12345");
+	HOST_CHECK(waitLcd(1, "Unlocking", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(lcdShows(0, "Door is") == TRUE);
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_CLOCK_WISE);
+	HOST_CHECK(g_control->motor->duty == 255);
+
+	HOST_CHECK(waitLcd(1, "Open", DOOR_MOVE_MS + SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_STOP);
+	HOST_CHECK(waitLcd(1, "locking", SCREEN_WAIT_MS * 4) == TRUE);
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_ANTI_CLOCK_WISE);
+	HOST_CHECK(waitLcd(0, "+ : Open Door", DOOR_MOVE_MS + SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_STOP);
+}
+
+/*
+ * Description :
+ * Three wrong passwords start the lockout, the buzzer sounds and the HMI
+ * shows the lockout screen. They are different since the same request in
+ * REQUEST_REPEAT_PERIOD_MS of Control_ECU.c is answered as a retry of HMI ECU.
+ */
+static void testLockout(void)
+{
+	uint8 i;
+
+	HOST_CHECK(g_control->buzzer->on == FALSE);
+	pressKey('+');
+	for (i = 0; i < 3; i++)
+	{
+		HOST_CHECK(waitLcd(0, "plz enter pass:", SCREEN_WAIT_MS) == TRUE);
+		typePassword(g_wrongPasswords[i]);
+	}
+	HOST_CHECK(waitLcd(0, "LOCKED OUT", SCREEN_WAIT_MS) == TRUE);
+	HOST_CHECK(g_control->buzzer->on == TRUE);
+	HOST_CHECK(g_control->motor->direction == HOST_MOTOR_STOP);
+}
+
+int main(void)
+{
+	HOST_simInit(TEST_SEED);
+	testBootAndCreate();
+	testOpenDoor();
+	testLockout();
+	HOST_CHECK(g_hmi->ecu.uartOverruns() == 0);
+	HOST_CHECK(g_control->ecu.uartOverruns() == 0);
+	return HOST_TEST_END();
+}
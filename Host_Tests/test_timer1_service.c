@@ -0,0 +1,471 @@
+/*
+ ============================================================================
+ Name        : test_timer1_service.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the TIMER1 software timers and the cost of their tick
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_blocks.h"
+#include "MCAL/TIMER1/timer1_service.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define LOG_SIZE			64
+#define NO_EXPIRY			0xFFFFFFFFUL
+
+#define STRESS_TICKS		20000
+#define STRESS_MAX_MS		40
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* The reference model of one software timer */
+typedef struct
+{
+	uint32 expiry; /* tick of the next expiry, NO_EXPIRY if stopped */
+	uint32 order; /* start order, the timers of one tick expire in this order */
+	uint16 period;
+	uint8 mode;
+} ReferenceTimerType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The ticks given to the service since its init */
+static uint32 g_now = 0;
+
+/* The call backs in the order of their calls */
+static uint8 g_log[LOG_SIZE];
+static uint8 g_logLength = 0;
+
+static uint8 g_ids[TIMER1_SERVICE_MAX_TIMERS];
+
+/* The timer started again and the timer stopped by the call backs */
+static uint8 g_rearmId;
+static uint8 g_stopId;
+
+static ReferenceTimerType g_reference[TIMER1_SERVICE_MAX_TIMERS];
+static uint32 g_order = 0;
+
+static uint32 g_random = 2463534242UL;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/* The compare match ISR of TIMER1, the test calls it as the interrupt */
+void TIMER1_COMPA_vect(void);
+
+/*
+ * Description :
+ * Return a pseudo random number from 0 to limit - 1 (xorshift32).
+ */
+static uint16 randomBelow(uint16 limit)
+{
+	g_random ^= g_random << 13;
+	g_random ^= g_random >> 17;
+	g_random ^= g_random << 5;
+	return (uint16) (g_random % limit);
+}
+
+/*
+ * Description :
+ * One compare match of TIMER1, one millisecond.
+ */
+static void tick(void)
+{
+	g_now++;
+	TIMER1_COMPA_vect();
+}
+
+/* Call backs of the timers, each one logs its id */
+#define DEFINE_CALL_BACK(n) \
+	static void callBack##n(void) \
+	{ \
+		if (g_logLength < LOG_SIZE) \
+		{ \
+			g_log[g_logLength++] = g_ids[n]; \
+		} \
+	}
+DEFINE_CALL_BACK(0)
+DEFINE_CALL_BACK(1)
+DEFINE_CALL_BACK(2)
+DEFINE_CALL_BACK(3)
+DEFINE_CALL_BACK(4)
+DEFINE_CALL_BACK(5)
+DEFINE_CALL_BACK(6)
+DEFINE_CALL_BACK(7)
+
+static void (*const g_callBacks[TIMER1_SERVICE_MAX_TIMERS])(void) =
+{ callBack0, callBack1, callBack2, callBack3, callBack4, callBack5, callBack6,
+		callBack7 };
+
+/*
+ * Description :
+ * Start the service again and create all its timers with their call backs.
+ */
+static void restart(TIMER1_TimerModeType mode)
+{
+	uint8 i;
+
+	Timer1_serviceInit();
+	g_now = 0;
+	g_logLength = 0;
+	for (i = 0; i < TIMER1_SERVICE_MAX_TIMERS; i++)
+	{
+		g_ids[i] = Timer1_createTimer(mode, g_callBacks[i]);
+		HOST_CHECK(g_ids[i] == i);
+	}
+}
+
+/*
+ * Description :
+ * The registers of the 1 ms tick and the number of the timers.
+ */
+static void testInit(void)
+{
+	Timer1_serviceInit();
+	HOST_CHECK(host_TCCR1B.Bits.WGM12_Bit == 1);
+	HOST_CHECK(host_TCCR1B.Bits.WGM13_Bit == 0);
+	HOST_CHECK(host_TCCR1A.Bits.WGM10_Bit == 0);
+	HOST_CHECK(host_TCCR1A.Bits.WGM11_Bit == 0);
+	/* prescaler 8 */
+	HOST_CHECK((host_TCCR1B.Byte & 0x07) == 0x02);
+	HOST_CHECK(host_OCR1A == TIMER1_SERVICE_TICK_COMPARE);
+	HOST_CHECK(TIMER1_SERVICE_TICK_COMPARE == 999);
+	HOST_CHECK(host_TIMSK.Bits.OCIE1A_Bit == 1);
+	HOST_CHECK(host_TIMSK.Bits.TOIE1_Bit == 0);
+
+	restart(TIMER1_ONE_SHOT);
+	HOST_CHECK(Timer1_createTimer(TIMER1_ONE_SHOT, NULL_PTR)
+			== TIMER1_SERVICE_INVALID_ID);
+	/* the ids which were not created are ignored */
+	Timer1_startTimer(TIMER1_SERVICE_MAX_TIMERS, 5);
+	HOST_CHECK(Timer1_getRemainingTime(TIMER1_SERVICE_MAX_TIMERS) == 0);
+	HOST_CHECK(Timer1_isTimerExpired(TIMER1_SERVICE_MAX_TIMERS) == FALSE);
+}
+
+/*
+ * Description :
+ * The timers expire at their tick in the order of their expiry, the timers of
+ * one tick in their start order, and a stopped timer gives its ticks to the
+ * next one so the later timers don't move.
+ */
+static void testOrderAndCancel(void)
+{
+	const uint8 order[] = { 1, 3, 5, 4, 0 };
+	uint8 i;
+
+	restart(TIMER1_ONE_SHOT);
+	Timer1_startTimer(0, 8);
+	Timer1_startTimer(1, 3);
+	Timer1_startTimer(2, 5);
+	Timer1_startTimer(3, 3);
+	Timer1_startTimer(4, 5);
+	Timer1_startTimer(5, 12);
+	/* zero is one tick */
+	Timer1_startTimer(6, 0);
+	HOST_CHECK(Timer1_getRemainingTime(0) == 8);
+	HOST_CHECK(Timer1_getRemainingTime(4) == 5);
+	HOST_CHECK(Timer1_getRemainingTime(6) == 1);
+	HOST_CHECK(Timer1_getRemainingTime(7) == 0);
+
+	tick();
+	HOST_CHECK((g_logLength == 1) && (g_log[0] == 6));
+	HOST_CHECK(Timer1_isTimerExpired(6) == TRUE);
+	HOST_CHECK(Timer1_isTimerExpired(6) == FALSE);
+	g_logLength = 0;
+
+	/* cancel the first of the two timers of tick 5, and the last one */
+	Timer1_stopTimer(2);
+	Timer1_stopTimer(5);
+	HOST_CHECK(Timer1_getRemainingTime(2) == 0);
+	HOST_CHECK(Timer1_getRemainingTime(4) == 4);
+	HOST_CHECK(Timer1_getRemainingTime(0) == 7);
+	/* stopping a stopped timer changes nothing */
+	Timer1_stopTimer(2);
+	/* a restart of a running timer moves it */
+	Timer1_startTimer(0, 9);
+	Timer1_startTimer(5, 2);
+
+	while (g_now < 20)
+	{
+		tick();
+	}
+	HOST_CHECK(g_logLength == sizeof(order));
+	for (i = 0; i < sizeof(order); i++)
+	{
+		HOST_CHECK(g_log[i] == order[i]);
+	}
+	HOST_CHECK(Timer1_isTimerExpired(2) == FALSE);
+	HOST_CHECK(Timer1_getTicks() == 20);
+}
+
+/*
+ * Description :
+ * The call back of timer 0 starts itself again, the call back of timer 1
+ * stops timer 2 which expires at the same tick after it.
+ */
+static void rearmCallBack(void)
+{
+	callBack0();
+	Timer1_startTimer(g_rearmId, 3);
+}
+
+static void stopCallBack(void)
+{
+	callBack1();
+	Timer1_stopTimer(g_stopId);
+}
+
+static void testCallBacks(void)
+{
+	uint8 i;
+
+	Timer1_serviceInit();
+	g_now = 0;
+	g_logLength = 0;
+	g_ids[0] = g_rearmId = Timer1_createTimer(TIMER1_ONE_SHOT, rearmCallBack);
+	g_ids[1] = Timer1_createTimer(TIMER1_ONE_SHOT, stopCallBack);
+	g_ids[2] = g_stopId = Timer1_createTimer(TIMER1_ONE_SHOT, callBack2);
+	g_ids[3] = Timer1_createTimer(TIMER1_PERIODIC, callBack3);
+
+	Timer1_startTimer(g_ids[0], 3);
+	Timer1_startTimer(g_ids[1], 4);
+	Timer1_startTimer(g_ids[2], 4);
+	Timer1_startTimer(g_ids[3], 4);
+
+	for (i = 0; i < 12; i++)
+	{
+		tick();
+	}
+	/*
+	 * timer 0 at 3, 6, 9, 12, timer 1 at 4 stops timer 2, the periodic
+	 * timer 3 at 4, 8, 12, before timer 0 at 12 as it was started again first
+	 */
+	{
+		const uint8 expected[] = { 0, 1, 3, 0, 3, 0, 3, 0 };
+		HOST_CHECK(g_logLength == sizeof(expected));
+		for (i = 0; i < sizeof(expected); i++)
+		{
+			HOST_CHECK(g_log[i] == expected[i]);
+		}
+	}
+	HOST_CHECK(Timer1_isTimerExpired(g_ids[2]) == FALSE);
+}
+
+/*
+ * Description :
+ * A periodic timer doesn't drift: each period is counted from the previous
+ * expiry, not from the service of its call back.
+ */
+static void testPeriodicAccuracy(void)
+{
+	uint32 i;
+	uint16 count = 0;
+
+	restart(TIMER1_PERIODIC);
+	Timer1_startTimer(0, 7);
+	Timer1_startTimer(1, 1);
+	for (i = 0; i < 7000; i++)
+	{
+		tick();
+		if (Timer1_isTimerExpired(0) == TRUE)
+		{
+			HOST_CHECK((g_now % 7) == 0);
+			count++;
+		}
+	}
+	HOST_CHECK(count == 1000);
+	HOST_CHECK(Timer1_getRemainingTime(0) == 7);
+}
+
+/*
+ * Description :
+ * The microseconds count the ticks and TCNT1, and a compare match which is not
+ * serviced yet is counted when TCNT1 already started again.
+ */
+static void testMicros(void)
+{
+	restart(TIMER1_ONE_SHOT);
+	tick();
+	tick();
+	host_TCNT1 = 250;
+	host_TIFR.Bits.OCF1A_Bit = 0;
+	HOST_CHECK(Timer1_getMicros() == 2250);
+	host_TCNT1 = 3;
+	host_TIFR.Bits.OCF1A_Bit = 1;
+	HOST_CHECK(Timer1_getMicros() == 3003);
+	host_TCNT1 = 998;
+	HOST_CHECK(Timer1_getMicros() == 2998);
+	host_TIFR.Bits.OCF1A_Bit = 0;
+	/* the critical section keeps the interrupt enable */
+	HOST_CHECK(host_TIMSK.Bits.OCIE1A_Bit == 1);
+	host_TIMSK.Bits.OCIE1A_Bit = 0;
+	Timer1_getTicks();
+	HOST_CHECK(host_TIMSK.Bits.OCIE1A_Bit == 0);
+	host_TIMSK.Bits.OCIE1A_Bit = 1;
+}
+
+/*
+ * Description :
+ * Random starts, restarts and stops of all the timers against the reference
+ * model: each timer expires at its tick and the timers of one tick expire in
+ * their start order, a periodic timer being started again at its expiry.
+ */
+static void testRandomAgainstReference(void)
+{
+	uint32 step;
+	uint32 bestOrder;
+	uint8 i, id, best, expected[TIMER1_SERVICE_MAX_TIMERS], count;
+	uint16 ms;
+
+	for (i = 0; i < TIMER1_SERVICE_MAX_TIMERS; i++)
+	{
+		g_reference[i].expiry = NO_EXPIRY;
+		g_reference[i].mode = (i & 1) ? TIMER1_PERIODIC : TIMER1_ONE_SHOT;
+	}
+	Timer1_serviceInit();
+	g_now = 0;
+	for (i = 0; i < TIMER1_SERVICE_MAX_TIMERS; i++)
+	{
+		g_ids[i] = Timer1_createTimer(g_reference[i].mode, g_callBacks[i]);
+	}
+
+	for (step = 0; step < STRESS_TICKS; step++)
+	{
+		/* some calls between two ticks */
+		while (randomBelow(3) == 0)
+		{
+			id = (uint8) randomBelow(TIMER1_SERVICE_MAX_TIMERS);
+			if (randomBelow(4) == 0)
+			{
+				Timer1_stopTimer(id);
+				g_reference[id].expiry = NO_EXPIRY;
+			}
+			else
+			{
+				ms = randomBelow(STRESS_MAX_MS);
+				Timer1_startTimer(id, ms);
+				g_reference[id].period = (ms == 0) ? 1 : ms;
+				g_reference[id].expiry = g_now + g_reference[id].period;
+				g_reference[id].order = g_order++;
+			}
+		}
+		for (i = 0; i < TIMER1_SERVICE_MAX_TIMERS; i++)
+		{
+			HOST_CHECK(Timer1_getRemainingTime(i)
+					== ((g_reference[i].expiry == NO_EXPIRY) ?
+							0 : g_reference[i].expiry - g_now));
+		}
+
+		/* the expected call backs of the next tick */
+		count = 0;
+		while (1)
+		{
+			best = TIMER1_SERVICE_MAX_TIMERS;
+			bestOrder = 0xFFFFFFFFUL;
+			for (i = 0; i < TIMER1_SERVICE_MAX_TIMERS; i++)
+			{
+				if ((g_reference[i].expiry == g_now + 1)
+						&& (g_reference[i].order < bestOrder))
+				{
+					best = i;
+					bestOrder = g_reference[i].order;
+				}
+			}
+			if (best == TIMER1_SERVICE_MAX_TIMERS)
+			{
+				break;
+			}
+			expected[count++] = best;
+			if (g_reference[best].mode == TIMER1_PERIODIC)
+			{
+				g_reference[best].expiry += g_reference[best].period;
+				g_reference[best].order = g_order++;
+			}
+			else
+			{
+				g_reference[best].expiry = NO_EXPIRY;
+			}
+		}
+
+		g_logLength = 0;
+		tick();
+		HOST_CHECK(g_logLength == count);
+		for (i = 0; (i < count) && (i < g_logLength); i++)
+		{
+			HOST_CHECK(g_log[i] == expected[i]);
+		}
+		if (g_hostTestFailures != 0)
+		{
+			printf("random test failed at tick %lu\n", (unsigned long) g_now);
+			return;
+		}
+	}
+}
+
+/*
+ * Description :
+ * The cost of the tick in basic blocks: it doesn't grow with the number of the
+ * running timers, and grows by the same cost for each expired timer.
+ */
+static void testTickCost(void)
+{
+	uint32 costs[TIMER1_SERVICE_MAX_TIMERS + 1];
+	uint32 cost;
+	uint8 running, expired;
+
+	for (running = 1; running <= TIMER1_SERVICE_MAX_TIMERS; running++)
+	{
+		Timer1_serviceInit();
+		for (expired = 0; expired < running; expired++)
+		{
+			Timer1_startTimer(Timer1_createTimer(TIMER1_ONE_SHOT, NULL_PTR),
+					(uint16) (100 + (10 * expired)));
+		}
+		g_hostBlocks = 0;
+		TIMER1_COMPA_vect();
+		costs[running] = g_hostBlocks;
+		HOST_CHECK(costs[running] == costs[1]);
+	}
+
+	for (expired = 1; expired <= TIMER1_SERVICE_MAX_TIMERS; expired++)
+	{
+		Timer1_serviceInit();
+		for (running = 0; running < expired; running++)
+		{
+			Timer1_startTimer(Timer1_createTimer(TIMER1_ONE_SHOT, NULL_PTR), 1);
+		}
+		g_hostBlocks = 0;
+		TIMER1_COMPA_vect();
+		costs[expired] = g_hostBlocks;
+		if (expired >= 2)
+		{
+			cost = costs[expired] - costs[expired - 1];
+			HOST_CHECK(cost == costs[2] - costs[1]);
+		}
+	}
+}
+
+int main(void)
+{
+	testInit();
+	testOrderAndCancel();
+	testCallBacks();
+	testPeriodicAccuracy();
+	testMicros();
+	testRandomAgainstReference();
+	testTickCost();
+	return HOST_TEST_END();
+}
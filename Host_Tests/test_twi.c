@@ -0,0 +1,386 @@
+/*
+ ============================================================================
+ Name        : test_twi.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the interrupt driven TWI engine against the 24C16 model
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "shim/host_blocks.h"
+#include "shim/host_twi_eeprom.h"
+#include "MCAL/I2C/twi.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* The bit rate of the Control ECU, TWBR = 12 and an SCL period of 40 cycles at 8 MHz */
+#define BIT_RATE		200000UL
+#define PERIOD_CYCLES	40
+
+/* Longest wait of a transaction, the retries of 200 restarts are about 11 ms */
+#define TIMEOUT_US		50000UL
+
+/* Memory address of the tests, in the block 1 of the 24C16 */
+#define TEST_ADDRESS	0x123
+
+#define MAX_COMPLETIONS	8
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The transactions in the order of their completion call backs */
+static TWI_TransactionType *g_completed[MAX_COMPLETIONS];
+static uint8 g_completedCount = 0;
+
+/* Transaction submitted by the call back of another one */
+static TWI_TransactionType g_chained;
+static uint8 g_chainedData[4];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The devices of the test, stepped on the virtual clock.
+ */
+static void stepDevices(void)
+{
+	HOST_twiEepromStep(g_hostCycles);
+}
+
+/*
+ * Description :
+ * Call back which records the order of the completions.
+ */
+static void recordCompletion(TWI_TransactionType *a_transaction)
+{
+	if (g_completedCount < MAX_COMPLETIONS)
+	{
+		g_completed[g_completedCount] = a_transaction;
+	}
+	g_completedCount++;
+}
+
+/*
+ * Description :
+ * Call back which records the completion then submits g_chained from the ISR.
+ */
+static void submitChained(TWI_TransactionType *a_transaction)
+{
+	recordCompletion(a_transaction);
+	HOST_CHECK(TWI_submitTransaction(&g_chained) == TRUE);
+}
+
+/*
+ * Description :
+ * Fill a transaction to the address of the 24C16: the memory address, then
+ * the bytes to write or to read after a REPEATED START.
+ */
+static void setTransaction(TWI_TransactionType *a_transaction, uint16 address,
+		const uint8 *writeData, uint16 writeLength, uint8 *readData,
+		uint16 readLength)
+{
+	a_transaction->slaveAddress = 0xA0 | ((address & 0x700) >> 7);
+	a_transaction->command[0] = (uint8) address;
+	a_transaction->commandLength = 1;
+	a_transaction->writeData = writeData;
+	a_transaction->writeLength = writeLength;
+	a_transaction->readData = readData;
+	a_transaction->readLength = readLength;
+	a_transaction->callBack = recordCompletion;
+	a_transaction->status = TWI_TRANSACTION_IDLE;
+}
+
+/*
+ * Description :
+ * Run the clock until the engine is idle.
+ * Return the time in microseconds.
+ */
+static uint32 waitIdle(void)
+{
+	uint64 start = g_hostCycles;
+
+	while ((TWI_isIdle() == FALSE)
+			&& ((g_hostCycles - start) < (TIMEOUT_US * HOST_CYCLES_PER_US)))
+	{
+		HOST_run(PERIOD_CYCLES);
+	}
+	HOST_CHECK(TWI_isIdle() == TRUE);
+	/* the final STOP */
+	HOST_run(2 * PERIOD_CYCLES);
+	return (uint32) ((g_hostCycles - start) / HOST_CYCLES_PER_US);
+}
+
+/*
+ * Description :
+ * Run the clock to the end of the write cycle of the 24C16.
+ */
+static void waitWriteCycle(void)
+{
+	while (HOST_twiEepromIsWriting(g_hostCycles) == TRUE)
+	{
+		HOST_run(1000);
+	}
+}
+
+/*
+ * Description :
+ * Start from an erased 24C16 and a fresh engine at 200 kHz.
+ */
+static void testInit(void)
+{
+	TWI_ConfigType config = { MC_ADDRESS, BIT_RATE };
+
+	HOST_twiEepromReset(HOST_TWI_EEPROM_WRITE_CYCLE_US);
+	g_hostDevices = stepDevices;
+	host_SREG.Bits.I_Bit = 1;
+	HOST_CHECK(TWI_init(&config) == TRUE);
+	HOST_CHECK(host_TWBR.Byte == 12);
+	HOST_CHECK(TWI_isIdle() == TRUE);
+}
+
+/*
+ * Description :
+ * A write of a page part, then the same bytes read back with a REPEATED START
+ * once the write cycle is over. The bus time and the interrupts of each.
+ */
+static void testWriteThenRead(void)
+{
+	static const uint8 data[5] = { 0x11, 0x22, 0x33, 0x44, 0x55 };
+	TWI_TransactionType write, read;
+	uint8 readData[5];
+	uint32 time;
+
+	g_completedCount = 0;
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	setTransaction(&write, TEST_ADDRESS, data, sizeof(data), NULL_PTR, 0);
+	HOST_CHECK(TWI_submitTransaction(&write) == TRUE);
+	HOST_CHECK(host_SREG.Bits.I_Bit == 1);
+	HOST_CHECK(TWI_isIdle() == FALSE);
+	time = waitIdle();
+	HOST_CHECK(write.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK((g_completedCount == 1) && (g_completed[0] == &write));
+	HOST_CHECK(memcmp(&g_hostTwiEeprom[TEST_ADDRESS], data, sizeof(data)) == 0);
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 1);
+	/* START, SLA+W, the memory address and 5 bytes */
+	HOST_CHECK(g_hostTwiEepromStats.interrupts == 8);
+	/* 1 + 9 + 6 * 9 + 1 SCL periods on the bus, with the ISRs between them */
+	HOST_CHECK(time >= (65UL * PERIOD_CYCLES) / HOST_CYCLES_PER_US);
+	printf("write of 5 bytes: %lu us, %lu ISR blocks\n", (unsigned long) time,
+			(unsigned long) g_hostTwiEepromStats.isrBlocks);
+
+	waitWriteCycle();
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	setTransaction(&read, TEST_ADDRESS, NULL_PTR, 0, readData, sizeof(readData));
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK(memcmp(readData, data, sizeof(data)) == 0);
+	HOST_CHECK(g_hostTwiEepromStats.starts == 2);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks == 0);
+	/* START, SLA+W, the memory address, REPEATED START, SLA+R and 5 bytes */
+	HOST_CHECK(g_hostTwiEepromStats.interrupts == 10);
+}
+
+/*
+ * Description :
+ * A read submitted in the write cycle: the 24C16 NACKs its address and the
+ * engine restarts the transaction until it answers (ACK polling).
+ */
+static void testRetryInWriteCycle(void)
+{
+	static const uint8 data[2] = { 0xA5, 0x5A };
+	TWI_TransactionType write, read;
+	uint8 readData[2];
+	uint32 time;
+
+	setTransaction(&write, TEST_ADDRESS, data, sizeof(data), NULL_PTR, 0);
+	HOST_CHECK(TWI_submitTransaction(&write) == TRUE);
+	waitIdle();
+	HOST_CHECK(HOST_twiEepromIsWriting(g_hostCycles) == TRUE);
+
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	setTransaction(&read, TEST_ADDRESS, NULL_PTR, 0, readData, sizeof(readData));
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	time = waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK(memcmp(readData, data, sizeof(data)) == 0);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks > 0);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks < TWI_MAX_RETRIES);
+	HOST_CHECK(time < HOST_TWI_EEPROM_WRITE_CYCLE_US + 1000);
+	printf("read in the write cycle: %lu us, %lu address NACKs\n",
+			(unsigned long) time,
+			(unsigned long) g_hostTwiEepromStats.addressNacks);
+}
+
+/*
+ * Description :
+ * A missing 24C16 fails the transaction after TWI_MAX_RETRIES restarts, then
+ * the engine works again when it answers.
+ */
+static void testMissingDevice(void)
+{
+	TWI_TransactionType read;
+	uint8 readData[2];
+
+	waitWriteCycle();
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	HOST_twiEepromRemove(TRUE);
+	setTransaction(&read, TEST_ADDRESS, NULL_PTR, 0, readData, sizeof(readData));
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_FAILED);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks == TWI_MAX_RETRIES + 1);
+	HOST_CHECK(g_hostTwiEepromStats.starts == TWI_MAX_RETRIES + 1);
+
+	HOST_twiEepromRemove(FALSE);
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+}
+
+/*
+ * Description :
+ * A lost arbitration restarts the transaction with a START only, the bus is
+ * already released, and doesn't count as a NACK of the 24C16.
+ */
+static void testArbitrationLost(void)
+{
+	TWI_TransactionType read;
+	uint8 readData[2];
+
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	HOST_twiEepromLoseArbitration(3);
+	setTransaction(&read, TEST_ADDRESS, NULL_PTR, 0, readData, sizeof(readData));
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK((readData[0] == 0xA5) && (readData[1] == 0x5A));
+	HOST_CHECK(g_hostTwiEepromStats.arbitrationsLost == 3);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks == 0);
+	/* three lost STARTs, the START which wins and the REPEATED START */
+	HOST_CHECK(g_hostTwiEepromStats.starts == 5);
+}
+
+/*
+ * Description :
+ * The queue runs the transactions in order, a transaction submitted by a call
+ * back runs after them, and a NACKed data byte fails its transaction without
+ * a retry and without a write cycle while the next one still runs.
+ */
+static void testQueue(void)
+{
+	static const uint8 data[3] = { 1, 2, 3 };
+	TWI_TransactionType write, first, second;
+	uint8 firstData[3], secondData[2];
+
+	g_completedCount = 0;
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	HOST_twiEepromNackNextData();
+	setTransaction(&write, 0x400, data, sizeof(data), NULL_PTR, 0);
+	write.callBack = submitChained;
+	setTransaction(&first, TEST_ADDRESS, NULL_PTR, 0, firstData, sizeof(firstData));
+	setTransaction(&second, 0x7FF, NULL_PTR, 0, secondData, sizeof(secondData));
+	setTransaction(&g_chained, TEST_ADDRESS, NULL_PTR, 0, g_chainedData,
+			sizeof(g_chainedData));
+
+	HOST_CHECK(TWI_submitTransaction(&write) == TRUE);
+	HOST_CHECK(TWI_submitTransaction(&first) == TRUE);
+	HOST_CHECK(TWI_submitTransaction(&second) == TRUE);
+	/* a pending transaction can't be queued twice */
+	HOST_CHECK(TWI_submitTransaction(&first) == FALSE);
+	waitIdle();
+
+	HOST_CHECK(g_completedCount == 4);
+	HOST_CHECK((g_completed[0] == &write) && (g_completed[1] == &first)
+			&& (g_completed[2] == &second) && (g_completed[3] == &g_chained));
+	HOST_CHECK(write.status == TWI_TRANSACTION_FAILED);
+	HOST_CHECK(g_hostTwiEeprom[0x400] == 0xFF);
+	HOST_CHECK(g_hostTwiEepromStats.writeCycles == 0);
+	HOST_CHECK(g_hostTwiEepromStats.addressNacks == 0);
+	HOST_CHECK(first.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK((firstData[0] == 0xA5) && (firstData[1] == 0x5A)
+			&& (firstData[2] == 0x33));
+	/* the address counter of a read rolls over at the end of the memory */
+	HOST_CHECK(second.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK((secondData[0] == 0xFF) && (secondData[1] == 0xFF));
+	HOST_CHECK(g_chained.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK(g_chainedData[3] == 0x44);
+}
+
+/*
+ * Description :
+ * A submit with the interrupts disabled keeps them disabled, the engine waits
+ * in its first TWINT until they are enabled.
+ */
+static void testInterruptsDisabled(void)
+{
+	TWI_TransactionType read;
+	uint8 readData[1];
+
+	memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+	host_SREG.Bits.I_Bit = 0;
+	setTransaction(&read, TEST_ADDRESS, NULL_PTR, 0, readData, sizeof(readData));
+	HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+	HOST_CHECK(host_SREG.Bits.I_Bit == 0);
+	HOST_run(100 * PERIOD_CYCLES);
+	HOST_CHECK(read.status == TWI_TRANSACTION_PENDING);
+	HOST_CHECK(g_hostTwiEepromStats.interrupts == 0);
+	HOST_CHECK(host_TWCR.Bits.TWINT_Bit == 1);
+
+	host_SREG.Bits.I_Bit = 1;
+	waitIdle();
+	HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+	HOST_CHECK(readData[0] == 0xA5);
+}
+
+/*
+ * Description :
+ * The cost of the ISR for each byte read is the same for any length, a long
+ * read costs its bytes and no more.
+ */
+static void testIsrCost(void)
+{
+	static const uint16 lengths[3] = { 16, 32, 64 };
+	static uint8 readData[64];
+	uint32 blocks[3];
+	TWI_TransactionType read;
+	uint8 i;
+
+	for (i = 0; i < 3; i++)
+	{
+		memset(&g_hostTwiEepromStats, 0, sizeof(g_hostTwiEepromStats));
+		setTransaction(&read, 0, NULL_PTR, 0, readData, lengths[i]);
+		HOST_CHECK(TWI_submitTransaction(&read) == TRUE);
+		waitIdle();
+		HOST_CHECK(read.status == TWI_TRANSACTION_DONE);
+		HOST_CHECK(g_hostTwiEepromStats.interrupts == lengths[i] + 5);
+		blocks[i] = g_hostTwiEepromStats.isrBlocks;
+	}
+	HOST_CHECK((blocks[2] - blocks[1]) == 2 * (blocks[1] - blocks[0]));
+	printf("TWI ISR: %lu blocks for each byte read, %lu for a 16 bytes read\n",
+			(unsigned long) ((blocks[1] - blocks[0]) / 16),
+			(unsigned long) blocks[0]);
+}
+
+int main(void)
+{
+	testInit();
+	testWriteThenRead();
+	testRetryInWriteCycle();
+	testMissingDevice();
+	testArbitrationLost();
+	testQueue();
+	testInterruptsDisabled();
+	testIsrCost();
+	return HOST_TEST_END();
+}
@@ -0,0 +1,139 @@
+/*
+ ============================================================================
+ Name        : test_twi_bit_rate.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the TWI bit rate calculation for one F_CPU
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "MCAL/I2C/twi.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The required bit rates, from above F_CPU / 16 down to below the minimum */
+static const uint32 g_bitRates[] =
+{
+	5000000, 1000000, 400000, 250000, 222222, 200000, 100000, 50000,
+	10000, 5000, 1000, 500, 250, 100, 30, 1, 0
+};
+
+#define NUM_BIT_RATES	(sizeof(g_bitRates) / sizeof(g_bitRates[0]))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The SCL frequency of the TWBR value and the prescaler.
+ */
+static uint32 sclFrequency(uint32 twbr, uint32 prescaler)
+{
+	return F_CPU / (16UL + (2UL * twbr * prescaler));
+}
+
+/*
+ * Description :
+ * Check one required bit rate against the datasheet: the smallest prescaler
+ * which has a TWBR up to 255, the smallest TWBR which doesn't make the SCL
+ * frequency higher than the required one, and TWBR not below TWI_MIN_TWBR.
+ */
+static void checkBitRate(uint32 bitRate)
+{
+	TWI_ConfigType config = { 1, 0 };
+	uint32 prescaler;
+	uint32 twbr = 256;
+	uint32 best = 0;
+	uint8 result;
+
+	/* the expected setting by a search of all the settings */
+	for (prescaler = 1; (prescaler <= 64) && (bitRate != 0); prescaler *= 4)
+	{
+		for (twbr = 0; twbr <= 255; twbr++)
+		{
+			if ((uint64) bitRate * (16UL + (2UL * twbr * prescaler)) >= F_CPU)
+			{
+				break;
+			}
+		}
+		if (twbr <= 255)
+		{
+			if (twbr >= TWI_MIN_TWBR)
+			{
+				best = sclFrequency(twbr, prescaler);
+			}
+			break;
+		}
+	}
+
+	config.bitRate = bitRate;
+	host_TWBR.Byte = 0;
+	host_TWSR.Byte = 0;
+	host_TWCR.Byte = 0;
+	result = TWI_init(&config);
+
+	if (best == 0)
+	{
+		HOST_CHECK(result == FALSE);
+		HOST_CHECK(host_TWCR.Bits.TWEN_Bit == 0);
+		if (result != FALSE)
+		{
+			printf("  F_CPU %lu bit rate %lu accepted\n",
+					(unsigned long) F_CPU, (unsigned long) bitRate);
+		}
+		return;
+	}
+	HOST_CHECK(result == TRUE);
+	HOST_CHECK(host_TWCR.Bits.TWEN_Bit == 1);
+	HOST_CHECK(host_TWBR.Byte >= TWI_MIN_TWBR);
+	HOST_CHECK(TWI_getBitRate() == best);
+	HOST_CHECK(TWI_getBitRate() <= bitRate);
+	if (TWI_getBitRate() != best)
+	{
+		printf("  F_CPU %lu bit rate %lu: got %lu expected %lu\n",
+				(unsigned long) F_CPU, (unsigned long) bitRate,
+				(unsigned long) TWI_getBitRate(), (unsigned long) best);
+	}
+}
+
+int main(void)
+{
+	uint8 i;
+
+	for (i = 0; i < NUM_BIT_RATES; i++)
+	{
+		checkBitRate(g_bitRates[i]);
+	}
+
+	/* the compile time check agrees with TWI_init */
+#if TWI_BIT_RATE_IS_VALID(TWI_STANDARD_MODE_BIT_RATE)
+	checkBitRate(TWI_STANDARD_MODE_BIT_RATE);
+	HOST_CHECK(TWI_getBitRate() <= TWI_STANDARD_MODE_BIT_RATE);
+#endif
+#if TWI_BIT_RATE_IS_VALID(TWI_FAST_MODE_BIT_RATE)
+	HOST_CHECK(F_CPU >= (36UL * TWI_FAST_MODE_BIT_RATE));
+#endif
+
+#if (F_CPU == 8000000UL)
+	{
+		/* the settings of the Control ECU */
+		TWI_ConfigType config = { 1, 200000UL };
+		HOST_CHECK(TWI_init(&config) == TRUE);
+		HOST_CHECK(host_TWBR.Byte == 12);
+		HOST_CHECK(TWI_getBitRate() == 200000UL);
+		config.bitRate = TWI_FAST_MODE_BIT_RATE;
+		HOST_CHECK(TWI_init(&config) == FALSE);
+		config.bitRate = TWI_STANDARD_MODE_BIT_RATE;
+		HOST_CHECK(TWI_init(&config) == TRUE);
+		HOST_CHECK(host_TWBR.Byte == 32);
+	}
+#endif
+	return HOST_TEST_END();
+}
@@ -0,0 +1,321 @@
+/*
+ ============================================================================
+ Name        : test_uart.c
+ Author      : Ahmed Ali
+ Module Name : HOST_TESTS
+ Date        : 18 Oct 2026
+ Description : Host test of the UART ring buffers driven through their ISRs
+ ============================================================================
+ */
+
+#include "shim/host_test.h"
+#include "MCAL/UART/uart.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* A ring buffer keeps one place free to tell full from empty */
+#define RX_CAPACITY		(UART_RX_BUFFER_SIZE - 1)
+#define TX_CAPACITY		(UART_TX_BUFFER_SIZE - 1)
+
+#define BURST_BYTES		5000
+#define WIRE_SIZE		(BURST_BYTES + 64)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+int g_hostTestFailures = 0;
+
+/* The bytes which left the transmitter through UDR */
+static uint8 g_txWire[WIRE_SIZE];
+static uint16 g_txLength = 0;
+
+/* State of the pseudo random generator of the bursts */
+static uint32 g_random = 12345;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/* The ISRs of the driver, the test calls them as the interrupts */
+void USART_RXC_vect(void);
+void USART_UDRE_vect(void);
+
+/*
+ * Description :
+ * Return a pseudo random number from 0 to limit - 1 (xorshift32).
+ */
+static uint16 randomBelow(uint16 limit)
+{
+	g_random ^= g_random << 13;
+	g_random ^= g_random >> 17;
+	g_random ^= g_random << 5;
+	return (uint16) (g_random % limit);
+}
+
+/*
+ * Description :
+ * A byte arrives at the receiver, the RX Complete interrupt is taken if it is enabled.
+ */
+static void receiveByte(uint8 data)
+{
+	host_UDR = data;
+	host_UCSRA.Bits.RXC_Bit = 1;
+	if (host_UCSRB.Bits.RXCIE_Bit == 1)
+	{
+		USART_RXC_vect();
+	}
+}
+
+/*
+ * Description :
+ * The transmitter takes up to count bytes, one Data Register Empty interrupt
+ * for each while the interrupt is enabled.
+ * Return the number of the interrupts.
+ */
+static uint16 transmitBytes(uint16 count)
+{
+	uint16 interrupts = 0;
+
+	while ((count > 0) && (host_UCSRB.Bits.UDRIE_Bit == 1))
+	{
+		host_UDR = HOST_UDR_EMPTY;
+		USART_UDRE_vect();
+		interrupts++;
+		if (host_UDR != HOST_UDR_EMPTY)
+		{
+			HOST_CHECK(g_txLength < WIRE_SIZE);
+			g_txWire[g_txLength++] = (uint8) host_UDR;
+			count--;
+		}
+	}
+	return interrupts;
+}
+
+/*
+ * Description :
+ * The registers of 9600 baud 8N1 with double speed at 8 MHz.
+ */
+static void testInit(void)
+{
+	UART_ConfigType config =
+	{ ASYNCHRONOUS, DISABLED_PARITY, STOP_1_BIT, DATA_8_BIT, BAUD_RATE_9600 };
+
+	UART_init(&config);
+	HOST_CHECK(host_UCSRA.Bits.U2X_Bit == 1);
+	HOST_CHECK(host_UCSRB.Bits.RXEN_Bit == 1);
+	HOST_CHECK(host_UCSRB.Bits.TXEN_Bit == 1);
+	HOST_CHECK(host_UCSRB.Bits.RXCIE_Bit == 1);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 0);
+	HOST_CHECK(host_UCSRC.Bits.URSEL_Bit == 1);
+	HOST_CHECK(host_UCSRC.Bits.UMSEL_Bit == 0);
+	HOST_CHECK(host_UCSRC.Bits.UPM0_Bit == 0);
+	HOST_CHECK(host_UCSRC.Bits.UPM1_Bit == 0);
+	HOST_CHECK(host_UCSRC.Bits.USBS_Bit == 0);
+	HOST_CHECK(host_UCSRC.Bits.UCSZ0_Bit == 1);
+	HOST_CHECK(host_UCSRC.Bits.UCSZ1_Bit == 1);
+	/* 8 MHz / (8 * 9600) - 1 = 103 */
+	HOST_CHECK(host_UBRRL == 103);
+	HOST_CHECK(host_UBRRH == 0);
+}
+
+/*
+ * Description :
+ * The transmit ring takes TX_CAPACITY bytes, UDRIE is set while it has bytes
+ * and the interrupt after the last byte clears it without a write of UDR.
+ */
+static void testTransmitBoundaries(void)
+{
+	uint8 data[TX_CAPACITY + 8];
+	uint8 i;
+
+	for (i = 0; i < sizeof(data); i++)
+	{
+		data[i] = i;
+	}
+	g_txLength = 0;
+
+	/* nothing queued, the interrupt is not started */
+	HOST_CHECK(UART_write(data, 0) == 0);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 0);
+
+	/* full ring */
+	HOST_CHECK(UART_write(data, sizeof(data)) == TX_CAPACITY);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 1);
+	HOST_CHECK(UART_write(&data[TX_CAPACITY], 1) == 0);
+
+	/* one byte sent gives one free place */
+	HOST_CHECK(transmitBytes(1) == 1);
+	HOST_CHECK(UART_write(&data[TX_CAPACITY], 2) == 1);
+
+	/* all sent in order, then one more interrupt to see the empty ring */
+	HOST_CHECK(transmitBytes(TX_CAPACITY) == TX_CAPACITY);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 1);
+	HOST_CHECK(transmitBytes(1) == 1);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 0);
+	HOST_CHECK(g_txLength == TX_CAPACITY + 1);
+	HOST_CHECK(memcmp(g_txWire, data, TX_CAPACITY + 1) == 0);
+
+	/* a spurious interrupt on the empty ring sends nothing */
+	host_UCSRB.Bits.UDRIE_Bit = 1;
+	host_UDR = HOST_UDR_EMPTY;
+	USART_UDRE_vect();
+	HOST_CHECK(host_UDR == HOST_UDR_EMPTY);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 0);
+
+	/* the blocking send only waits for a free place */
+	g_txLength = 0;
+	UART_sendString((const uint8 *) "OK");
+	HOST_CHECK(transmitBytes(3) == 3);
+	HOST_CHECK((g_txLength == 2) && (g_txWire[0] == 'O') && (g_txWire[1] == 'K'));
+}
+
+/*
+ * Description :
+ * Writes and interrupts of random sizes, the indexes wrap around the ring many
+ * times and every byte leaves UDR once and in order.
+ */
+static void testTransmitBurst(void)
+{
+	uint8 chunk[UART_TX_BUFFER_SIZE];
+	uint16 queued = 0;
+	uint16 sent;
+	uint8 length, accepted, i;
+
+	g_txLength = 0;
+	while (queued < BURST_BYTES)
+	{
+		length = (uint8) (1 + randomBelow(UART_TX_BUFFER_SIZE));
+		for (i = 0; i < length; i++)
+		{
+			chunk[i] = (uint8) ((queued + i) * 7);
+		}
+		sent = g_txLength;
+		accepted = UART_write(chunk, length);
+		/* a write takes all the free places, no more */
+		HOST_CHECK(accepted <= length);
+		HOST_CHECK((accepted == length)
+				|| ((queued + accepted - sent) == TX_CAPACITY));
+		queued += accepted;
+		transmitBytes(randomBelow(UART_TX_BUFFER_SIZE + 4));
+	}
+	transmitBytes(UART_TX_BUFFER_SIZE + 1);
+	HOST_CHECK(host_UCSRB.Bits.UDRIE_Bit == 0);
+	HOST_CHECK(g_txLength == queued);
+	for (sent = 0; sent < g_txLength; sent++)
+	{
+		if (g_txWire[sent] != (uint8) (sent * 7))
+		{
+			HOST_CHECK(g_txWire[sent] == (uint8) (sent * 7));
+			break;
+		}
+	}
+}
+
+/*
+ * Description :
+ * The receive ring takes RX_CAPACITY bytes, the next ones are dropped and
+ * counted while the received ones are kept.
+ */
+static void testReceiveBoundaries(void)
+{
+	uint8 data[RX_CAPACITY + 8];
+	uint16 dropped = UART_getDroppedBytes();
+	uint8 i;
+
+	HOST_CHECK(UART_available() == 0);
+	HOST_CHECK(UART_read(data, sizeof(data)) == 0);
+
+	for (i = 0; i < RX_CAPACITY + 3; i++)
+	{
+		receiveByte(i);
+	}
+	HOST_CHECK(UART_available() == RX_CAPACITY);
+	HOST_CHECK(UART_getDroppedBytes() == dropped + 3);
+	HOST_CHECK(host_UCSRB.Bits.RXCIE_Bit == 1);
+
+	/* one byte read gives one free place */
+	HOST_CHECK(UART_recieveByte() == 0);
+	receiveByte(0xEE);
+	HOST_CHECK(UART_getDroppedBytes() == dropped + 3);
+	HOST_CHECK(UART_read(data, sizeof(data)) == RX_CAPACITY);
+	for (i = 0; i < RX_CAPACITY - 1; i++)
+	{
+		HOST_CHECK(data[i] == i + 1);
+	}
+	HOST_CHECK(data[RX_CAPACITY - 1] == 0xEE);
+	HOST_CHECK(UART_available() == 0);
+
+	/* the atomic read of the counter keeps a disabled interrupt disabled */
+	host_UCSRB.Bits.RXCIE_Bit = 0;
+	HOST_CHECK(UART_getDroppedBytes() == dropped + 3);
+	HOST_CHECK(host_UCSRB.Bits.RXCIE_Bit == 0);
+	host_UCSRB.Bits.RXCIE_Bit = 1;
+
+	/* a string up to '#' */
+	receiveByte('A');
+	receiveByte('B');
+	receiveByte('#');
+	UART_receiveString(data);
+	HOST_CHECK(strcmp((const char *) data, "AB") == 0);
+}
+
+/*
+ * Description :
+ * A burst of bytes while the application reads at random times and sizes,
+ * checked against a reference queue: the kept bytes come out in order and
+ * each byte which found the ring full is counted once.
+ */
+static void testReceiveBurst(void)
+{
+	static uint8 reference[WIRE_SIZE];
+	static uint8 received[WIRE_SIZE];
+	uint16 head = 0, tail = 0, receivedLength = 0;
+	uint16 expectedDropped = UART_getDroppedBytes();
+	uint16 i, overruns = 0;
+	uint8 length;
+
+	for (i = 0; i < BURST_BYTES; i++)
+	{
+		/* the reference ring */
+		if ((head - tail) < RX_CAPACITY)
+		{
+			reference[head++] = (uint8) (i ^ 0x5A);
+		}
+		else
+		{
+			expectedDropped++;
+			overruns++;
+		}
+		receiveByte((uint8) (i ^ 0x5A));
+
+		/* the application reads a chunk about each 24 bytes, it falls behind at times */
+		if (randomBelow(24) == 0)
+		{
+			length = UART_read(&received[receivedLength],
+					(uint8) randomBelow(UART_RX_BUFFER_SIZE + 1));
+			receivedLength += length;
+			tail += length;
+		}
+		HOST_CHECK(UART_available() == (uint8) (head - tail));
+	}
+	receivedLength += UART_read(&received[receivedLength], UART_RX_BUFFER_SIZE);
+
+	HOST_CHECK(overruns > 0);
+	HOST_CHECK(UART_getDroppedBytes() == expectedDropped);
+	HOST_CHECK(receivedLength == head);
+	HOST_CHECK(memcmp(received, reference, head) == 0);
+}
+
+int main(void)
+{
+	testInit();
+	testTransmitBoundaries();
+	testTransmitBurst();
+	testReceiveBoundaries();
+	testReceiveBurst();
+	return HOST_TEST_END();
+}